@@ -0,0 +1,550 @@
+/* ****************************************************************** **
+**    OpenSees - Open System for Earthquake Engineering Simulation    **
+**          Pacific Earthquake Engineering Research Center            **
+**                                                                    **
+**                                                                    **
+** (C) Copyright 1999, The Regents of the University of California    **
+** All Rights Reserved.                                               **
+**                                                                    **
+** Commercial use of this program without express permission of the   **
+** University of California, Berkeley, is strictly prohibited.  See   **
+** file 'COPYRIGHT'  in main directory for information on usage and   **
+** redistribution,  and for a DISCLAIMER OF ALL WARRANTIES.           **
+**                                                                    **
+** Developed by:                                                      **
+**   Frank McKenna (fmckenna@ce.berkeley.edu)                         **
+**   Gregory L. Fenves (fenves@ce.berkeley.edu)                       **
+**   Filip C. Filippou (filippou@ce.berkeley.edu)                     **
+**                                                                    **
+** ****************************************************************** */
+
+// Purpose: This file contains the implementation of the methods needed
+// to define the SharedMemoryChannel class interface.
+
+#include <SharedMemoryChannel.h>
+#include <OPS_Globals.h>
+#include <Matrix.h>
+#include <Vector.h>
+#include <ID.h>
+#include <Message.h>
+#include <MovableObject.h>
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <atomic>
+#include <new>
+
+#ifndef _WIN32
+#include <errno.h>
+#include <fcntl.h>
+#include <signal.h>
+#include <unistd.h>
+#include <sched.h>
+#include <time.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
+
+#define SHM_MAGIC 0x4f50534d   // "OPSM"
+#define SHM_DEFAULT_RING_SIZE (1 << 20)
+#define SHM_SPINS_BEFORE_YIELD 4096
+#define SHM_CONNECT_TIMEOUT 120        // seconds to wait for the other process
+
+// the counters are shared by two processes, which only works if the
+// atomics are lock-free (a lock would be local to each process)
+static_assert(std::atomic<long long>::is_always_lock_free,
+    "SharedMemoryChannel needs lock-free 64 bit atomics");
+static_assert(std::atomic<int>::is_always_lock_free,
+    "SharedMemoryChannel needs lock-free 32 bit atomics");
+
+// the positions are byte counts that only ever increase, each one is
+// written by one side only and on a cache line of its own
+struct SharedMemoryRing {
+    std::atomic<long long> head;   // bytes written by the producer
+    char pad0[64 - sizeof(std::atomic<long long>)];
+    std::atomic<long long> tail;   // bytes read by the consumer
+    char pad1[64 - sizeof(std::atomic<long long>)];
+};
+
+struct SharedMemoryHeader {
+    std::atomic<int> magic;
+    int version;
+    long long ringSize;
+    long long serverPid;                      // to detect a segment left by a crashed server
+    long long generation;                     // set by the server, echoed by the client
+    std::atomic<long long> clientReady;
+    std::atomic<int> serverClosed;
+    std::atomic<int> clientClosed;
+    alignas(64) SharedMemoryRing rings[2];    // 0: client to server, 1: server to client
+};
+
+
+#ifndef _WIN32
+// seconds since an arbitrary start
+static double
+elapsedTime(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + 1.0e-9*ts.tv_nsec;
+}
+
+static void
+sleepMilliseconds(long ms)
+{
+    struct timespec ts = {0, ms*1000000};
+    nanosleep(&ts, 0);
+}
+
+// true if a segment of this name belongs to a server that is still
+// running, one whose server has gone was left by a crashed run
+static bool
+isSegmentInUse(const char *name)
+{
+    int fd = shm_open(name, O_RDONLY, 0600);
+    if (fd < 0)
+        return false;
+
+    // a server creating the segment sizes it and then sets the magic
+    // number, one never initialized within a second was left half made
+    bool inUse = false;
+    double start = elapsedTime();
+    while (elapsedTime() - start < 1.0) {
+        struct stat st;
+        if (fstat(fd, &st) == 0 && st.st_size >= (off_t)sizeof(SharedMemoryHeader)) {
+            void *addr = mmap(0, sizeof(SharedMemoryHeader), PROT_READ, MAP_SHARED, fd, 0);
+            if (addr != MAP_FAILED) {
+                SharedMemoryHeader *theHeader = (SharedMemoryHeader *)addr;
+                bool ready = (theHeader->magic.load(std::memory_order_acquire) == SHM_MAGIC);
+                pid_t pid = (pid_t)theHeader->serverPid;
+                munmap(addr, sizeof(SharedMemoryHeader));
+                if (ready) {
+                    inUse = (kill(pid, 0) == 0 || errno != ESRCH);
+                    break;
+                }
+            }
+        }
+        sleepMilliseconds(1);
+    }
+
+    close(fd);
+    return inUse;
+}
+#endif
+
+
+SharedMemoryChannel::SharedMemoryChannel(unsigned int thePort, bool isServer,
+    bool busy, int theRingSize)
+    :port(thePort), server(isServer), busyPoll(busy), ringSize(theRingSize),
+    segment(0), segmentSize(0), header(0),
+    sendRing(0), recvRing(0), sendData(0), recvData(0)
+{
+    snprintf(name, 32, "/OpenSees.%u", port);
+
+    if (ringSize <= 0)
+        ringSize = SHM_DEFAULT_RING_SIZE;
+    // keep the data of each ring on whole cache lines
+    ringSize = (ringSize + 63) & ~63LL;
+
+#ifdef _WIN32
+    opserr << "SharedMemoryChannel::SharedMemoryChannel() - "
+        << "shared memory channels are not available on this platform\n";
+#else
+    if (server == false)
+        return;
+
+    // create the segment: one of the same name whose server is running
+    // makes this fail, as binding a port in use would, and one left over
+    // by a crashed run is removed
+    if (isSegmentInUse(name)) {
+        opserr << "SharedMemoryChannel::SharedMemoryChannel() - "
+            << "shared memory " << name << " is in use by another server\n";
+        return;
+    }
+    shm_unlink(name);
+    int fd = shm_open(name, O_CREAT | O_EXCL | O_RDWR, 0600);
+    if (fd < 0) {
+        opserr << "SharedMemoryChannel::SharedMemoryChannel() - "
+            << "could not create shared memory " << name << endln;
+        return;
+    }
+
+    segmentSize = sizeof(SharedMemoryHeader) + 2*ringSize;
+    if (ftruncate(fd, segmentSize) != 0) {
+        opserr << "SharedMemoryChannel::SharedMemoryChannel() - "
+            << "could not size shared memory " << name << endln;
+        close(fd);
+        shm_unlink(name);
+        return;
+    }
+
+    void *addr = mmap(0, segmentSize, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    close(fd);
+    if (addr == MAP_FAILED) {
+        opserr << "SharedMemoryChannel::SharedMemoryChannel() - "
+            << "could not map shared memory " << name << endln;
+        shm_unlink(name);
+        return;
+    }
+    segment = (char *)addr;
+
+    header = new (segment) SharedMemoryHeader;
+    header->version = 1;
+    header->ringSize = ringSize;
+    header->serverPid = (long long)getpid();
+    header->generation = ((long long)time(0) << 20) ^ (long long)getpid() ^ (long long)(elapsedTime()*1.0e6);
+    if (header->generation == 0)
+        header->generation = 1;
+    header->clientReady.store(0);
+    header->serverClosed.store(0);
+    header->clientClosed.store(0);
+    for (int i = 0; i < 2; i++) {
+        header->rings[i].head.store(0);
+        header->rings[i].tail.store(0);
+    }
+
+    sendRing = &header->rings[1];
+    recvRing = &header->rings[0];
+    recvData = segment + sizeof(SharedMemoryHeader);
+    sendData = recvData + ringSize;
+
+    // the client attaches only once the magic number is there
+    header->magic.store(SHM_MAGIC, std::memory_order_release);
+#endif
+}
+
+
+SharedMemoryChannel::~SharedMemoryChannel()
+{
+#ifndef _WIN32
+    if (header != 0) {
+        if (server) {
+            header->serverClosed.store(1, std::memory_order_release);
+            if (header->clientReady.load() == 0)
+                shm_unlink(name);
+        } else
+            header->clientClosed.store(1, std::memory_order_release);
+    }
+    if (segment != 0)
+        munmap(segment, segmentSize);
+#endif
+}
+
+
+int
+SharedMemoryChannel::setUpConnection()
+{
+#ifdef _WIN32
+    return -1;
+#else
+    if (server) {
+        if (header == 0)
+            return -1;
+
+        // wait for the client to attach, it echoes the generation of
+        // this segment
+        double start = elapsedTime();
+        while (header->clientReady.load(std::memory_order_acquire) != header->generation) {
+            if (elapsedTime() - start > SHM_CONNECT_TIMEOUT) {
+                opserr << "SharedMemoryChannel::setUpConnection() - "
+                    << "no client attached to " << name << " in " << SHM_CONNECT_TIMEOUT << " seconds\n";
+                return -1;
+            }
+            sleepMilliseconds(1);
+        }
+
+        // both processes have it mapped, the name is not needed any more
+        shm_unlink(name);
+        return 0;
+    }
+
+    // client: wait for the server to create the segment, a segment whose
+    // server has gone is one left by a crashed run that the server will
+    // replace
+    double start = elapsedTime();
+    while (true) {
+        if (elapsedTime() - start > SHM_CONNECT_TIMEOUT) {
+            opserr << "SharedMemoryChannel::setUpConnection() - "
+                << "no server created " << name << " in " << SHM_CONNECT_TIMEOUT << " seconds\n";
+            return -1;
+        }
+
+        struct stat st;
+        int fd = shm_open(name, O_RDWR, 0600);
+        if (fd < 0) {
+            sleepMilliseconds(1);
+            continue;
+        }
+        if (fstat(fd, &st) != 0 || st.st_size < (off_t)sizeof(SharedMemoryHeader)) {
+            close(fd);
+            sleepMilliseconds(1);
+            continue;
+        }
+
+        segmentSize = st.st_size;
+        void *addr = mmap(0, segmentSize, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        close(fd);
+        if (addr == MAP_FAILED) {
+            opserr << "SharedMemoryChannel::setUpConnection() - "
+                << "could not map shared memory " << name << endln;
+            return -1;
+        }
+        segment = (char *)addr;
+        header = (SharedMemoryHeader *)segment;
+
+        if (header->magic.load(std::memory_order_acquire) == SHM_MAGIC &&
+            header->version == 1 && header->clientReady.load() == 0 &&
+            (kill((pid_t)header->serverPid, 0) == 0 || errno == EPERM))
+            break;
+
+        // not initialized yet, or stale
+        munmap(segment, segmentSize);
+        segment = 0;
+        header = 0;
+        sleepMilliseconds(1);
+    }
+
+    ringSize = header->ringSize;
+    if ((long long)sizeof(SharedMemoryHeader) + 2*ringSize > segmentSize) {
+        opserr << "SharedMemoryChannel::setUpConnection() - "
+            << "shared memory " << name << " has the wrong size\n";
+        return -1;
+    }
+
+    sendRing = &header->rings[0];
+    recvRing = &header->rings[1];
+    sendData = segment + sizeof(SharedMemoryHeader);
+    recvData = sendData + ringSize;
+
+    header->clientReady.store(header->generation, std::memory_order_release);
+
+    return 0;
+#endif
+}
+
+
+char *
+SharedMemoryChannel::addToProgram()
+{
+    // channel type 3 and the port that names the segment
+    char *newStuff = (char *)malloc(32*sizeof(char));
+    snprintf(newStuff, 32, " 3 %u", port);
+    return newStuff;
+}
+
+
+int
+SharedMemoryChannel::setNextAddress(const ChannelAddress &theAddress)
+{
+    // only ever connected to one other process
+    return 0;
+}
+
+
+// wait for the other side, returns -1 once it has gone away
+int
+SharedMemoryChannel::wait(int &numSpins)
+{
+#ifndef _WIN32
+    std::atomic<int> &otherClosed = server ? header->clientClosed : header->serverClosed;
+    if (otherClosed.load(std::memory_order_acquire) != 0)
+        return -1;
+
+    if (busyPoll == false && ++numSpins > SHM_SPINS_BEFORE_YIELD)
+        sched_yield();
+#endif
+    return 0;
+}
+
+
+int
+SharedMemoryChannel::sendBytes(const char *data, long long numBytes)
+{
+    if (sendRing == 0) {
+        opserr << "SharedMemoryChannel::sendBytes() - channel is not connected\n";
+        return -1;
+    }
+
+    int numSpins = 0;
+    long long head = sendRing->head.load(std::memory_order_relaxed);
+    while (numBytes > 0) {
+        long long tail = sendRing->tail.load(std::memory_order_acquire);
+        long long space = ringSize - (head - tail);
+        if (space == 0) {
+            if (this->wait(numSpins) < 0) {
+                opserr << "SharedMemoryChannel::sendBytes() - other process has closed the channel\n";
+                return -1;
+            }
+            continue;
+        }
+
+        // up to the end of the ring at a time
+        long long pos = head % ringSize;
+        long long num = ringSize - pos;
+        if (num > space)
+            num = space;
+        if (num > numBytes)
+            num = numBytes;
+        memcpy(sendData + pos, data, num);
+
+        head += num;
+        data += num;
+        numBytes -= num;
+        sendRing->head.store(head, std::memory_order_release);
+        numSpins = 0;
+    }
+
+    return 0;
+}
+
+
+int
+SharedMemoryChannel::recvBytes(char *data, long long numBytes)
+{
+    if (recvRing == 0) {
+        opserr << "SharedMemoryChannel::recvBytes() - channel is not connected\n";
+        return -1;
+    }
+
+    int numSpins = 0;
+    long long tail = recvRing->tail.load(std::memory_order_relaxed);
+    while (numBytes > 0) {
+        long long head = recvRing->head.load(std::memory_order_acquire);
+        long long avail = head - tail;
+        if (avail == 0) {
+            if (this->wait(numSpins) < 0) {
+                // data written just before closing is still read
+                if (recvRing->head.load(std::memory_order_acquire) != tail)
+                    continue;
+                opserr << "SharedMemoryChannel::recvBytes() - other process has closed the channel\n";
+                return -1;
+            }
+            continue;
+        }
+
+        long long pos = tail % ringSize;
+        long long num = ringSize - pos;
+        if (num > avail)
+            num = avail;
+        if (num > numBytes)
+            num = numBytes;
+        memcpy(data, recvData + pos, num);
+
+        tail += num;
+        data += num;
+        numBytes -= num;
+        recvRing->tail.store(tail, std::memory_order_release);
+        numSpins = 0;
+    }
+
+    return 0;
+}
+
+
+int
+SharedMemoryChannel::sendObj(int commitTag,
+    MovableObject &theObject, ChannelAddress *theAddress)
+{
+    return theObject.sendSelf(commitTag, *this);
+}
+
+
+int
+SharedMemoryChannel::recvObj(int commitTag,
+    MovableObject &theObject, FEM_ObjectBroker &theBroker,
+    ChannelAddress *theAddress)
+{
+    return theObject.recvSelf(commitTag, *this, theBroker);
+}
+
+
+int
+SharedMemoryChannel::sendMsg(int dbTag, int commitTag,
+    const Message &msg, ChannelAddress *theAddress)
+{
+    return this->sendBytes(msg.data, msg.length);
+}
+
+
+int
+SharedMemoryChannel::recvMsg(int dbTag, int commitTag,
+    Message &msg, ChannelAddress *theAddress)
+{
+    return this->recvBytes(msg.data, msg.length);
+}
+
+
+int
+SharedMemoryChannel::recvMsgUnknownSize(int dbTag, int commitTag,
+    Message &msg, ChannelAddress *theAddress)
+{
+    // read up to and including the end of line, as TCP_Socket does
+    char *gMsg = msg.data;
+    int nleft = msg.length;
+    while (nleft > 0) {
+        if (this->recvBytes(gMsg, 1) < 0)
+            return -1;
+        nleft--;
+        if (*gMsg++ == '\n')
+            break;
+    }
+    if (nleft > 0)
+        *gMsg = '\0';
+
+    return 0;
+}
+
+
+int
+SharedMemoryChannel::sendMatrix(int dbTag, int commitTag,
+    const Matrix &theMatrix, ChannelAddress *theAddress)
+{
+    return this->sendBytes((const char *)theMatrix.data,
+        (long long)theMatrix.dataSize * sizeof(double));
+}
+
+
+int
+SharedMemoryChannel::recvMatrix(int dbTag, int commitTag,
+    Matrix &theMatrix, ChannelAddress *theAddress)
+{
+    return this->recvBytes((char *)theMatrix.data,
+        (long long)theMatrix.dataSize * sizeof(double));
+}
+
+
+int
+SharedMemoryChannel::sendVector(int dbTag, int commitTag,
+    const Vector &theVector, ChannelAddress *theAddress)
+{
+    return this->sendBytes((const char *)theVector.theData,
+        (long long)theVector.sz * sizeof(double));
+}
+
+
+int
+SharedMemoryChannel::recvVector(int dbTag, int commitTag,
+    Vector &theVector, ChannelAddress *theAddress)
+{
+    return this->recvBytes((char *)theVector.theData,
+        (long long)theVector.sz * sizeof(double));
+}
+
+
+int
+SharedMemoryChannel::sendID(int dbTag, int commitTag,
+    const ID &theID, ChannelAddress *theAddress)
+{
+    return this->sendBytes((const char *)theID.data,
+        (long long)theID.sz * sizeof(int));
+}
+
+
+int
+SharedMemoryChannel::recvID(int dbTag, int commitTag,
+    ID &theID, ChannelAddress *theAddress)
+{
+    return this->recvBytes((char *)theID.data,
+        (long long)theID.sz * sizeof(int));
+}
@@ -0,0 +1,119 @@
+/* ****************************************************************** **
+**    OpenSees - Open System for Earthquake Engineering Simulation    **
+**          Pacific Earthquake Engineering Research Center            **
+**                                                                    **
+**                                                                    **
+** (C) Copyright 1999, The Regents of the University of California    **
+** All Rights Reserved.                                               **
+**                                                                    **
+** Commercial use of this program without express permission of the   **
+** University of California, Berkeley, is strictly prohibited.  See   **
+** file 'COPYRIGHT'  in main directory for information on usage and   **
+** redistribution,  and for a DISCLAIMER OF ALL WARRANTIES.           **
+**                                                                    **
+** Developed by:                                                      **
+**   Frank McKenna (fmckenna@ce.berkeley.edu)                         **
+**   Gregory L. Fenves (fenves@ce.berkeley.edu)                       **
+**   Filip C. Filippou (filippou@ce.berkeley.edu)                     **
+**                                                                    **
+** ****************************************************************** */
+
+// Purpose: This file contains the class definition for SharedMemoryChannel.
+// SharedMemoryChannel is a sub-class of channel for two processes on the
+// same machine. It is implemented with a POSIX shared memory segment
+// named after the port number, holding one lock-free single producer,
+// single consumer ring buffer for each direction. Like a TCP_Socket the
+// data is a reliable, ordered stream and communication is full-duplex
+// between the two processes.
+//
+// The process constructed with server = true creates the segment and
+// waits in setUpConnection() for the other one to attach; either side
+// gives up with an error after two minutes. A segment left behind by a
+// crashed server is replaced by the server and ignored by the client,
+// which only attaches to a segment whose server is alive; a server
+// finding the segment of a live one fails, as a TCP bind would. A waiting
+// send or receive spins for a while and then yields the processor, or
+// keeps spinning if busyPoll is set, which gives the lowest latency when
+// each process has a core of its own.
+
+#ifndef SharedMemoryChannel_h
+#define SharedMemoryChannel_h
+
+#include <Channel.h>
+
+struct SharedMemoryHeader;
+struct SharedMemoryRing;
+
+class SharedMemoryChannel : public Channel
+{
+  public:
+    SharedMemoryChannel(unsigned int port, bool server,
+        bool busyPoll = false, int ringSize = 0);
+    ~SharedMemoryChannel();
+
+    char *addToProgram();
+
+    virtual int setUpConnection();
+
+    int setNextAddress(const ChannelAddress &otherChannelAddress);
+    virtual ChannelAddress *getLastSendersAddress(){ return 0;};
+
+    int sendObj(int commitTag,
+		MovableObject &theObject,
+		ChannelAddress *theAddress =0);
+    int recvObj(int commitTag,
+		MovableObject &theObject,
+		FEM_ObjectBroker &theBroker,
+		ChannelAddress *theAddress =0);
+
+    int sendMsg(int dbTag, int commitTag,
+		const Message &,
+		ChannelAddress *theAddress =0);
+    int recvMsg(int dbTag, int commitTag,
+		Message &,
+		ChannelAddress *theAddress =0);
+    int recvMsgUnknownSize(int dbTag, int commitTag,
+		Message &,
+		ChannelAddress *theAddress =0);
+
+    int sendMatrix(int dbTag, int commitTag,
+		   const Matrix &theMatrix,
+		   ChannelAddress *theAddress =0);
+    int recvMatrix(int dbTag, int commitTag,
+		   Matrix &theMatrix,
+		   ChannelAddress *theAddress =0);
+
+    int sendVector(int dbTag, int commitTag,
+		   const Vector &theVector,
+		   ChannelAddress *theAddress =0);
+    int recvVector(int dbTag, int commitTag,
+		   Vector &theVector,
+		   ChannelAddress *theAddress =0);
+
+    int sendID(int dbTag, int commitTag,
+	       const ID &theID,
+	       ChannelAddress *theAddress =0);
+    int recvID(int dbTag, int commitTag,
+	       ID &theID,
+	       ChannelAddress *theAddress =0);
+
+  private:
+    int sendBytes(const char *data, long long numBytes);
+    int recvBytes(char *data, long long numBytes);
+    int wait(int &numSpins);
+
+    char name[32];
+    unsigned int port;
+    bool server;
+    bool busyPoll;
+    long long ringSize;
+
+    // the mapped segment
+    char *segment;
+    long long segmentSize;
+    SharedMemoryHeader *header;
+    SharedMemoryRing *sendRing, *recvRing;
+    char *sendData, *recvData;
+};
+
+#endif
@@ -52,6 +52,7 @@ class Message
     friend class TCP_SocketSSL;
     friend class TCP_SocketNoDelay;
     friend class MPI_Channel;
+    friend class SharedMemoryChannel;
     
   private:
     int length;
@@ -523,6 +523,7 @@
 #include "LinearSeries.h"
 #include "PathSeries.h"
 #include "PathTimeSeries.h"
+#include "MappedTimeSeries.h"
 #include "RectangularSeries.h"
 #include "ConstantSeries.h"
 #include "TrigSeries.h"
@@ -1764,6 +1765,9 @@ FEM_ObjectBrokerAllClasses::getNewTimeSeries(int classTag)
         case TSERIES_TAG_PathTimeSeries:
 	  return new PathTimeSeries;
 
+        case TSERIES_TAG_MappedTimeSeries:
+	  return new MappedTimeSeries;
+
         case TSERIES_TAG_PathSeries:
 	  return new PathSeries;
 
@@ -55,6 +55,7 @@
 #include <Matrix.h>
 #include <ID.h>
 #include <Graph.h>
+#include <MemoryStats.h>
 
 // Constructor
 //    sets theModel and theSysOFEqn to 0 and the Algorithm to the one supplied
@@ -135,6 +136,9 @@ DirectIntegrationAnalysis::clearAll(void)
     theSOE =0;
     theEigenSOE =0;
     theTest =0;
+
+    MemoryStats::clear(MemoryStats::AnalysisModel);
+    MemoryStats::clear(MemoryStats::SOE);
 }    
 
 #include <NodeIter.h>
@@ -395,6 +399,7 @@ DirectIntegrationAnalysis::domainChanged(void)
     // now we invoke handle() on the constraint handler which
     // causes the creation of FE_Element and DOF_Group objects
     // and their addition to the AnalysisModel.
+    MemoryStats::mark();
     theConstraintHandler->handle();
 
     // we now invoke number() on the numberer which causes
@@ -408,12 +413,14 @@ DirectIntegrationAnalysis::domainChanged(void)
     // causes that object to determine its size
     Graph &theGraph = theAnalysisModel->getDOFGraph();
 
+    MemoryStats::mark();
     int result = theSOE->setSize(theGraph);
     if (result < 0) {
 	opserr << "DirectIntegrationAnalysis::handle() - ";
 	opserr << "LinearSOE::setSize() failed";
 	return -3;
     }	    
+    MemoryStats::resize(MemoryStats::SOE, theSOE->getClassTag(), theSOE->getClassType());
 
     if (theEigenSOE != 0) {
       result = theEigenSOE->setSize(theGraph);
@@ -422,6 +429,7 @@ DirectIntegrationAnalysis::domainChanged(void)
 	opserr << "EigenSOE::setSize() failed";
 	return -3;
       }	    
+      MemoryStats::resize(MemoryStats::SOE, theEigenSOE->getClassTag(), theEigenSOE->getClassType());
     }
 
     theAnalysisModel->clearDOFGraph();
@@ -499,6 +507,7 @@ DirectIntegrationAnalysis::setLinearSOE(LinearSOE &theNewSOE)
   // invoke the destructor on the old one
   if (theSOE != 0)
     delete theSOE;
+  MemoryStats::clear(MemoryStats::SOE);
 
   // set the links needed by the other objects in the aggregation
   theSOE = &theNewSOE;
@@ -38,9 +38,16 @@
 #include <elementAPI.h>
 #include <Node.h>
 #include <NodeIter.h>
+#include <Element.h>
+#include <ElementIter.h>
+#include <Response.h>
+#include <Information.h>
+#include <DummyStream.h>
 #include <vector>
 #include <algorithm>
 #include <cmath>
+#include <fstream>
+#include <iomanip>
 
 #ifndef M_PI
 #define M_PI 3.14159265358979323846
@@ -60,7 +67,8 @@
 void
 OPS_ResponseSpectrumAnalysis(void)
 {
-	// responseSpectrum $tsTag $dir <-scale $scale>
+	// responseSpectrum $tsTag $dir <-scale $scale> <-mode $mode>
+	//     <-combine SRSS|CQC|ABSSUM <-damp $damp> -file $fname <-eleResponse $args...>>
 
 	// some kudos
 	static bool first_done = false;
@@ -121,6 +129,10 @@ OPS_ResponseSpectrumAnalysis(void)
 	int loc = 0;
 	int mode_id = 0;
 	bool single_mode = false;
+	int combination = ResponseSpectrumAnalysis::NoCombination;
+	double damping = 0.05;
+	std::string filename;
+	std::vector<std::string> ele_response;
 	while (loc < nargs) {
 		const char* value = OPS_GetString();
 		if (strcmp(value, "-scale") == 0) {
@@ -151,12 +163,75 @@ OPS_ResponseSpectrumAnalysis(void)
 				exit(-1);
 			}
 		}
+		else if (strcmp(value, "-combine") == 0) {
+			if (loc < nargs - 1) {
+				const char* type = OPS_GetString();
+				if (strcmp(type, "SRSS") == 0 || strcmp(type, "srss") == 0)
+					combination = ResponseSpectrumAnalysis::SRSS;
+				else if (strcmp(type, "CQC") == 0 || strcmp(type, "cqc") == 0)
+					combination = ResponseSpectrumAnalysis::CQC;
+				else if (strcmp(type, "ABSSUM") == 0 || strcmp(type, "abssum") == 0)
+					combination = ResponseSpectrumAnalysis::ABSSUM;
+				else {
+					opserr << "responseSpectrum Error: unknown combination " << type << ", want SRSS, CQC or ABSSUM.\n";
+					exit(-1);
+				}
+				++loc;
+			}
+			else {
+				opserr << "responseSpectrum Error: combination requested but not provided.\n";
+				exit(-1);
+			}
+		}
+		else if (strcmp(value, "-damp") == 0) {
+			if (loc < nargs - 1) {
+				if (OPS_GetDouble(numData, &damping) < 0) {
+					opserr << "responseSpectrum Error: Failed to get damping ratio.\n";
+					exit(-1);
+				}
+				++loc;
+			}
+			else {
+				opserr << "responseSpectrum Error: damping ratio requested but not provided.\n";
+				exit(-1);
+			}
+		}
+		else if (strcmp(value, "-file") == 0) {
+			if (loc < nargs - 1) {
+				filename = OPS_GetString();
+				++loc;
+			}
+			else {
+				opserr << "responseSpectrum Error: file name requested but not provided.\n";
+				exit(-1);
+			}
+		}
+		else if (strcmp(value, "-eleResponse") == 0) {
+			// all remaining arguments define the element response
+			while (loc < nargs - 1) {
+				ele_response.push_back(OPS_GetString());
+				++loc;
+			}
+		}
 		++loc;
 	}
 
+	if (combination != ResponseSpectrumAnalysis::NoCombination) {
+		if (single_mode) {
+			opserr << "responseSpectrum Error: -combine cannot be used with -mode.\n";
+			exit(-1);
+		}
+		if (filename.empty()) {
+			opserr << "responseSpectrum Error: -combine requires -file $fname.\n";
+			exit(-1);
+		}
+	}
+
 	// ok, create the response spectrum analysis and run it here... 
 	// no need to store it
 	ResponseSpectrumAnalysis rsa(theAnalysisModel, ts, dir, scale);
+	if (combination != ResponseSpectrumAnalysis::NoCombination)
+		rsa.setCombination(combination, damping, filename, ele_response);
 	if (single_mode)
 		rsa.analyze(mode_id);
 	else
@@ -175,12 +250,28 @@ ResponseSpectrumAnalysis::ResponseSpectrumAnalysis(
 	, m_direction(theDirection)
 	, m_scale(scale)
 	, m_current_mode(0)
+	, m_combination(NoCombination)
+	, m_damping(0.05)
+	, m_num_components(0)
+	, m_num_modes_combined(0)
 {
 
 }
 
 ResponseSpectrumAnalysis::~ResponseSpectrumAnalysis()
 {
+	for (Response* r : m_ele_responses)
+		if (r)
+			delete r;
+}
+
+void ResponseSpectrumAnalysis::setCombination(int type, double damping, const std::string& filename,
+	const std::vector<std::string>& ele_response)
+{
+	m_combination = type;
+	m_damping = damping;
+	m_filename = filename;
+	m_ele_response = ele_response;
 }
 
 void ResponseSpectrumAnalysis::analyze()
@@ -203,7 +294,12 @@ void ResponseSpectrumAnalysis::analyze()
 	// modal combination otherwise derived results cannot be computed.
 	// for each mode, this analysis produces a new analysis step.
 	// modal combination of displacements (or any derived results)
-	// it's up to the user.
+	// it's up to the user, unless a combination has been requested:
+	// then the responses of each mode are combined here, in memory,
+	// and the domain is not committed.
+	if (m_combination != NoCombination)
+		beginCombination();
+
 	for (m_current_mode = 0; m_current_mode < num_eigen; ++m_current_mode)
 	{
 		// init the new step
@@ -216,8 +312,14 @@ void ResponseSpectrumAnalysis::analyze()
 		// done with the current step.
 		// here the modal displacements will be recorded (and all other results
 		// if requested via recorders...)
-		endMode();
+		if (m_combination != NoCombination)
+			addModeToCombination();
+		else
+			endMode();
 	}
+
+	if (m_combination != NoCombination)
+		endCombination();
 }
 
 void ResponseSpectrumAnalysis::analyze(int mode_id)
@@ -373,3 +475,198 @@ void ResponseSpectrumAnalysis::solveMode()
 	}
 }
 
+
+void ResponseSpectrumAnalysis::beginCombination()
+{
+	// get the domain
+	Domain* domain = m_model->getDomainPtr();
+
+	// the node displacements
+	m_node_tags.clear();
+	m_node_offset.clear();
+	m_num_components = 0;
+	Node* node;
+	NodeIter& theNodes = domain->getNodes();
+	while ((node = theNodes()) != 0) {
+		m_node_tags.push_back(node->getTag());
+		m_node_offset.push_back(m_num_components);
+		m_num_components += node->getNumberDOF();
+	}
+	m_node_offset.push_back(m_num_components);
+
+	// the element responses, their sizes are known after the first mode
+	for (Response* r : m_ele_responses)
+		if (r)
+			delete r;
+	m_ele_tags.clear();
+	m_ele_responses.clear();
+	m_ele_offset.clear();
+	if (m_ele_response.size() > 0) {
+		std::vector<const char*> argv(m_ele_response.size());
+		for (size_t i = 0; i < m_ele_response.size(); ++i)
+			argv[i] = m_ele_response[i].c_str();
+		DummyStream dummy;
+		Element* ele;
+		ElementIter& theEles = domain->getElements();
+		while ((ele = theEles()) != 0) {
+			Response* r = ele->setResponse(argv.data(), (int)argv.size(), dummy);
+			if (r) {
+				m_ele_tags.push_back(ele->getTag());
+				m_ele_responses.push_back(r);
+			}
+		}
+	}
+
+	m_modal_response.clear();
+	m_omega.clear();
+	m_num_modes_combined = 0;
+}
+
+void ResponseSpectrumAnalysis::addModeToCombination()
+{
+	// update the domain with the modal displacements, no commit
+	if (m_model->updateDomain() < 0) {
+		DMP_ERR(
+			"ResponseSpectrumAnalysis::analyze() - the AnalysisModel failed in updateDomain"
+			" at mode " << m_current_mode << "\n"
+		);
+	}
+
+	// get the domain
+	Domain* domain = m_model->getDomainPtr();
+
+	// evaluate the element responses. they are evaluated one element at a time,
+	// as most elements use static work arrays in getResponse()
+	int num_ele = (int)m_ele_responses.size();
+	for (int i = 0; i < num_ele; ++i)
+		m_ele_responses[i]->getResponse();
+
+	// size the element components on the first mode
+	if (m_num_modes_combined == 0) {
+		int num_node_components = m_node_offset.back();
+		m_num_components = num_node_components;
+		m_ele_offset.resize(num_ele + 1);
+		for (int i = 0; i < num_ele; ++i) {
+			m_ele_offset[i] = m_num_components;
+			m_num_components += m_ele_responses[i]->getInformation().getData().Size();
+		}
+		m_ele_offset[num_ele] = m_num_components;
+	}
+
+	// the responses of this mode
+	std::vector<double> modal(m_num_components, 0.0);
+	// the nodes come in the same order as in beginCombination()
+	int num_nodes = (int)m_node_tags.size();
+	Node* node;
+	NodeIter& theNodes = domain->getNodes();
+	for (int i = 0; i < num_nodes && (node = theNodes()) != 0; ++i) {
+		const Vector& U = node->getTrialDisp();
+		int n = std::min(U.Size(), m_node_offset[i + 1] - m_node_offset[i]);
+		for (int j = 0; j < n; ++j)
+			modal[m_node_offset[i] + j] = U(j);
+	}
+	for (int i = 0; i < num_ele; ++i) {
+		const Vector& data = m_ele_responses[i]->getInformation().getData();
+		int n = std::min(data.Size(), m_ele_offset[i + 1] - m_ele_offset[i]);
+		for (int j = 0; j < n; ++j)
+			modal[m_ele_offset[i] + j] = data(j);
+	}
+
+	// accumulate
+	int nc = m_num_components;
+	if (m_combination == CQC) {
+		// the cross terms need all modes, keep them
+		m_modal_response.insert(m_modal_response.end(), modal.begin(), modal.end());
+		const DomainModalProperties& mp = domain->getModalProperties();
+		m_omega.push_back(std::sqrt(mp.eigenvalues()(m_current_mode)));
+	}
+	else {
+		if (m_num_modes_combined == 0)
+			m_modal_response.assign(nc, 0.0);
+		double* sum = m_modal_response.data();
+		const double* u = modal.data();
+		if (m_combination == SRSS) {
+#pragma omp parallel for
+			for (int j = 0; j < nc; ++j)
+				sum[j] += u[j] * u[j];
+		}
+		else {
+#pragma omp parallel for
+			for (int j = 0; j < nc; ++j)
+				sum[j] += std::abs(u[j]);
+		}
+	}
+	++m_num_modes_combined;
+}
+
+void ResponseSpectrumAnalysis::endCombination()
+{
+	int nc = m_num_components;
+	int nm = m_num_modes_combined;
+	std::vector<double> combined(nc, 0.0);
+
+	if (m_combination == CQC) {
+		// correlation coefficients, Der Kiureghian (1981), equal damping
+		std::vector<double> rho(nm * nm, 0.0);
+		double z = m_damping;
+		for (int i = 0; i < nm; ++i) {
+			for (int j = 0; j < nm; ++j) {
+				double r = m_omega[j] / m_omega[i];
+				double num = 8.0 * z * z * (1.0 + r) * std::pow(r, 1.5);
+				double den = (1.0 - r * r) * (1.0 - r * r) + 4.0 * z * z * r * (1.0 + r) * (1.0 + r);
+				rho[i * nm + j] = den > 0.0 ? num / den : 1.0;
+			}
+		}
+		const double* u = m_modal_response.data();
+#pragma omp parallel for
+		for (int k = 0; k < nc; ++k) {
+			double sum = 0.0;
+			for (int i = 0; i < nm; ++i) {
+				double ui = u[(size_t)i * nc + k];
+				if (ui == 0.0)
+					continue;
+				sum += ui * ui;
+				for (int j = i + 1; j < nm; ++j)
+					sum += 2.0 * rho[i * nm + j] * ui * u[(size_t)j * nc + k];
+			}
+			combined[k] = std::sqrt(std::max(sum, 0.0));
+		}
+	}
+	else if (m_combination == SRSS) {
+		for (int k = 0; k < nc; ++k)
+			combined[k] = std::sqrt(m_modal_response[k]);
+	}
+	else {
+		combined = m_modal_response;
+		combined.resize(nc, 0.0);
+	}
+
+	// write the combined responses
+	std::ofstream out(m_filename.c_str());
+	if (!out.is_open())
+		DMP_ERR("ResponseSpectrumAnalysis::analyze() - could not open file " << m_filename.c_str() << "\n");
+	out << std::setprecision(10);
+	const char* name = m_combination == CQC ? "CQC" : (m_combination == SRSS ? "SRSS" : "ABSSUM");
+	out << "# responseSpectrum " << name << " of " << nm << " modes\n";
+	for (size_t i = 0; i < m_node_tags.size(); ++i) {
+		out << "node " << m_node_tags[i];
+		for (int k = m_node_offset[i]; k < m_node_offset[i + 1]; ++k)
+			out << " " << combined[k];
+		out << "\n";
+	}
+	for (size_t i = 0; i < m_ele_tags.size(); ++i) {
+		out << "element " << m_ele_tags[i];
+		for (int k = m_ele_offset[i]; k < m_ele_offset[i + 1]; ++k)
+			out << " " << combined[k];
+		out << "\n";
+	}
+	out.close();
+
+	// nothing has been committed, go back to the state before the analysis
+	if (m_model->revertDomainToLastCommit() < 0) {
+		DMP_ERR("ResponseSpectrumAnalysis::analyze() - the AnalysisModel failed in revertDomainToLastCommit\n");
+	}
+
+	m_modal_response.clear();
+	m_modal_response.shrink_to_fit();
+}
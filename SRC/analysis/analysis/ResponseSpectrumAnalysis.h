@@ -33,8 +33,12 @@
 #ifndef ResponseSpectrumAnalysis_h
 #define ResponseSpectrumAnalysis_h
 
+#include <vector>
+#include <string>
+
 class AnalysisModel;
 class TimeSeries;
+class Response;
 
 class ResponseSpectrumAnalysis
 {
@@ -47,15 +51,33 @@ public:
 	);
 	~ResponseSpectrumAnalysis();
 
+public:
+	// modal combination rules
+	enum CombinationType {
+		NoCombination = 0,
+		SRSS,
+		CQC,
+		ABSSUM
+	};
+
 public:
 	void analyze();
 	void analyze(int mode_id);
 
+	// combine the modal responses in memory instead of committing each mode.
+	// node displacements and the requested element responses of all modes
+	// are combined and written to the given file
+	void setCombination(int type, double damping, const std::string& filename,
+		const std::vector<std::string>& ele_response);
+
 private:
 	void check();
 	void beginMode();
 	void endMode();
 	void solveMode();
+	void beginCombination();
+	void addModeToCombination();
+	void endCombination();
 
 private:
 	// the model
@@ -68,6 +90,23 @@ private:
 	double m_scale;
 	// current mode
 	int m_current_mode;
+	// modal combination
+	int m_combination;
+	double m_damping;
+	std::string m_filename;
+	std::vector<std::string> m_ele_response;
+	// the responses combined: node displacements first, then element
+	// responses, each with its offset in the modal response vectors
+	std::vector<int> m_node_tags;
+	std::vector<int> m_node_offset;
+	std::vector<int> m_ele_tags;
+	std::vector<Response*> m_ele_responses;
+	std::vector<int> m_ele_offset;
+	int m_num_components;
+	// running sums (SRSS and ABSSUM) or all modal responses (CQC)
+	std::vector<double> m_modal_response;
+	std::vector<double> m_omega;
+	int m_num_modes_combined;
 };
 
 #endif
@@ -46,6 +46,7 @@
 #include <Matrix.h>
 #include <ID.h>
 #include <Graph.h>
+#include <MemoryStats.h>
 //#include <Timer.h>
 #include <Integrator.h>//Abbas
 
@@ -120,6 +121,9 @@ StaticAnalysis::clearAll(void)
   theSOE =0;
   theEigenSOE =0;
   theTest = 0;
+
+  MemoryStats::clear(MemoryStats::AnalysisModel);
+  MemoryStats::clear(MemoryStats::SOE);
 }    
 
 
@@ -376,6 +380,7 @@ StaticAnalysis::domainChanged(void)
     // causes the creation of FE_Element and DOF_Group objects
     // and their addition to the AnalysisModel.
 
+    MemoryStats::mark();
     result = theConstraintHandler->handle();
     if (result < 0) {
 	opserr << "StaticAnalysis::handle() - ";
@@ -406,12 +411,14 @@ StaticAnalysis::domainChanged(void)
 
     Graph &theGraph = theAnalysisModel->getDOFGraph();
 
+    MemoryStats::mark();
     result = theSOE->setSize(theGraph);
     if (result < 0) {
 	opserr << "StaticAnalysis::handle() - ";
 	opserr << "LinearSOE::setSize() failed";
 	return -3;
     }	    
+    MemoryStats::resize(MemoryStats::SOE, theSOE->getClassTag(), theSOE->getClassType());
 
     if (theEigenSOE != 0) {
       result = theEigenSOE->setSize(theGraph);
@@ -420,6 +427,7 @@ StaticAnalysis::domainChanged(void)
 	opserr << "EigenSOE::setSize() failed";
 	return -3;
       }	    
+      MemoryStats::resize(MemoryStats::SOE, theEigenSOE->getClassTag(), theEigenSOE->getClassType());
     }
 
     theAnalysisModel->clearDOFGraph();
@@ -519,6 +527,7 @@ StaticAnalysis::setLinearSOE(LinearSOE &theNewSOE)
     // invoke the destructor on the old one
     if (theSOE != 0)
 	delete theSOE;
+    MemoryStats::clear(MemoryStats::SOE);
 
     // set the links needed by the other objects in the aggregation
     theSOE = &theNewSOE;
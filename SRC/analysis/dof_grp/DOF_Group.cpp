@@ -807,6 +807,18 @@ DOF_Group::getT(void)
     return 0;
 }
 
+bool
+DOF_Group::isTimeVaryingT(void)
+{
+    return false;
+}
+
+Node *
+DOF_Group::getScatterNode(void)
+{
+    return myNode;
+}
+
 
 
 void  
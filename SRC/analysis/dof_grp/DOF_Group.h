@@ -97,6 +97,10 @@ class DOF_Group: public TaggedObject
     virtual void incrNodeVel(const Vector &udot);
     virtual void incrNodeAccel(const Vector &udotdot);
 
+    // the node if the methods above only copy the free dof into it,
+    // so that the response can be set in the node directly
+    virtual Node *getScatterNode(void);
+
     virtual const Vector & getTrialDisp();
     virtual const Vector & getTrialVel();
     virtual const Vector & getTrialAccel();
@@ -108,8 +112,9 @@ class DOF_Group: public TaggedObject
     virtual double getDampingBetaFactor(int mode, double ratio, double wn);
     virtual const Vector &getDampingBetaForce(int mode, double beta);
 	
-    // method added for TransformationDOF_Groups
+    // methods added for TransformationDOF_Groups
     virtual Matrix *getT(void);
+    virtual bool isTimeVaryingT(void);
 
 // AddingSensitivity:BEGIN ////////////////////////////////////
     virtual void addM_ForceSensitivity(const Vector &Udotdot, double fact = 1.0);        
@@ -866,6 +866,23 @@ TransformationDOF_Group::getT(void)
     return Trans;    
 }
 
+bool
+TransformationDOF_Group::isTimeVaryingT(void)
+{
+    // T is formed in doneID() unless the constraint is time varying
+    if (theMP == 0)
+	return false;
+
+    return theMP->isTimeVarying();
+}
+
+Node *
+TransformationDOF_Group::getScatterNode(void)
+{
+    // the response of the node goes through T
+    return 0;
+}
+
 
 int
 TransformationDOF_Group::doneID(void)
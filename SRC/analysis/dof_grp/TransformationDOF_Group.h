@@ -56,6 +56,7 @@ class TransformationDOF_Group: public DOF_Group
     const ID &getID(void) const; 
     virtual void setID(int dof, int value);    
     Matrix *getT(void);
+    bool isTimeVaryingT(void);
     virtual int getNumDOF(void) const;    
     virtual int getNumFreeDOF(void) const;
     virtual int getNumConstrainedDOF(void) const;
@@ -80,6 +81,7 @@ class TransformationDOF_Group: public DOF_Group
     void setNodeDisp(const Vector &u);
     void setNodeVel(const Vector &udot);
     void setNodeAccel(const Vector &udotdot);
+    Node *getScatterNode(void);
 
     void incrNodeDisp(const Vector &u);
     void incrNodeVel(const Vector &udot);
@@ -41,26 +41,19 @@
 #include <Matrix.h>
 #include <Vector.h>
 #include <TransformationConstraintHandler.h>
+#include <vector>
 
-#define MAX_NUM_DOF 64
-
-// static variables initialisation
-Matrix **TransformationFE::modMatrices; 
-Vector **TransformationFE::modVectors;  
-Matrix **TransformationFE::theTransformations; 
-int TransformationFE::numTransFE(0);           
-int TransformationFE::transCounter(0);           
-int TransformationFE::sizeTransformations(0);          
-double *TransformationFE::dataBuffer = 0;          
-double *TransformationFE::localKbuffer = 0;          
-int    *TransformationFE::dofData = 0;    ;          
-int TransformationFE::sizeBuffer(0);            
+// work areas for the transformations, one for each thread so that
+// the elements can be transformed concurrently
+static thread_local std::vector<double> workKT;
+static thread_local std::vector<double> workResponse;
 
 //  TransformationFE(Element *, Integrator *theIntegrator);
 //	construictor that take the corresponding model element.
 TransformationFE::TransformationFE(int tag, Element *ele)
 :FE_Element(tag, ele), theDOFs(0), numSPs(0), theSPs(0), modID(0), 
-  modTangent(0), modResidual(0), numGroups(0), numTransformedDOF(0)
+  modTangent(0), modResidual(0), numGroups(0), numTransformedDOF(0),
+  tRowStart(0), tCol(0), tVal(0), sizeT(0), identityT(true), timeVaryingT(false)
 {
   // set number of original dof at ele
     numOriginalDOF = ele->getNumDOF();
@@ -95,46 +88,7 @@ TransformationFE::TransformationFE(int tag, Element *ele)
 	theDOFs[i] = theDofGroup;
     }
 
-    // see if theTransformation array is big enough
-    // if not delete the old and create a new one
-    if (numNodes > sizeTransformations) {
-	if (theTransformations != 0) 
-	    delete [] theTransformations;
-	
-	theTransformations = new Matrix *[numNodes];
-	if (theTransformations == 0) {
-	    opserr << "FATAL TransformationFE::TransformationFE() - out of memory ";
-	    opserr << "for array of pointers for Transformation matrices of size ";
-	    opserr << numNodes;
-	    exit(-1);
-	}		    
-	sizeTransformations = numNodes;
-    }	
-
-    // if this is the first element of this type create the arrays for 
-    // modified tangent and residual matrices
-    if (numTransFE == 0) {
-
-	modMatrices = new Matrix *[MAX_NUM_DOF+1];
-	modVectors  = new Vector *[MAX_NUM_DOF+1];
-	dataBuffer = new double[MAX_NUM_DOF*MAX_NUM_DOF];
-	localKbuffer = new double[MAX_NUM_DOF*MAX_NUM_DOF];
-	dofData      = new int[MAX_NUM_DOF];
-	sizeBuffer = MAX_NUM_DOF*MAX_NUM_DOF;
-	
-	if (modMatrices == 0 || modVectors == 0 || dataBuffer == 0 ||
-	    localKbuffer == 0 || dofData == 0) {
-	    opserr << "TransformationFE::TransformationFE(Element *) ";
-	    opserr << " ran out of memory";	    
-	}
-	for (int i=0; i<MAX_NUM_DOF; i++) {
-	    modMatrices[i] = 0;
-	    modVectors[i] = 0;
-	}
-    }
-
-    // increment the number of transformations
-    numTransFE++;
+    tRowStart = new int[numOriginalDOF+1];
 }
 
 
@@ -145,51 +99,20 @@ TransformationFE::TransformationFE(int tag, Element *ele)
 TransformationFE::~TransformationFE()
 {
 
-    numTransFE--;
-    
     if (theDOFs != 0)
 	delete [] theDOFs;
     if (theSPs != 0)
 	delete [] theSPs;
 
-    int numDOF = 0;    
-    if (modID != 0)
-	numDOF = modID->Size();
-    
+    if (tRowStart != 0) delete [] tRowStart;
+    if (tCol != 0) delete [] tCol;
+    if (tVal != 0) delete [] tVal;
+
     if (modID != 0)
 	delete modID;
 
-    if (numDOF > MAX_NUM_DOF) {
-	// tangent and residual may have been  created specially
-	if (modTangent != 0) delete modTangent;
-	if (modResidual != 0) delete modResidual;
-    }
-
-    // if this is the last FE_Element, clean up the
-    // storage for the matrix and vector objects
-    if (numTransFE == 0) {
-	for (int i=0; i<MAX_NUM_DOF; i++) {
-	    if (modVectors[i] != 0)
-		delete modVectors[i];
-	    if (modMatrices[i] != 0)
-		delete modMatrices[i];
-	}
-	delete [] modMatrices;
-	delete [] modVectors;
-	delete [] theTransformations;
-	delete [] dataBuffer;
-	delete [] localKbuffer;
-	delete [] dofData;
-	modMatrices = 0;
-	modVectors = 0;
-	theTransformations = 0;
-	dataBuffer = 0;
-	localKbuffer = 0;
-	dofData = 0;
-	sizeTransformations = 0;
-	sizeBuffer = 0;
-	transCounter = 0;
-    }
+    if (modTangent != 0) delete modTangent;
+    if (modResidual != 0) delete modResidual;
 }    
 
 
@@ -252,31 +175,15 @@ TransformationFE::setID(void)
 	    }		
     }
     
-    // set the pointers to the modified tangent matrix and residual vector
-    if (numTransformedDOF <= MAX_NUM_DOF) {
-	// use class wide objects
-	if (modVectors[numTransformedDOF] == 0) {
-	    modVectors[numTransformedDOF] = new Vector(numTransformedDOF);
-	    modMatrices[numTransformedDOF] = new Matrix(numTransformedDOF,numTransformedDOF);
-	    modResidual = modVectors[numTransformedDOF];
-	    modTangent = modMatrices[numTransformedDOF];
-	    if (modResidual == 0 || modResidual->Size() != numTransformedDOF ||	
-		modTangent == 0 || modTangent->noCols() != numTransformedDOF)	{  
-		opserr << "TransformationFE::setID() ";
-		opserr << " ran out of memory for vector/Matrix of size :";
-		opserr << numTransformedDOF << endln;
-		exit(-1);
-	    }
-	} else {
-	    modResidual = modVectors[numTransformedDOF];
-	    modTangent = modMatrices[numTransformedDOF];
-	}
-    } else {
-	// create matrices and vectors for each object instance
+    // create the modified tangent matrix and residual vector for each
+    // object instance, so that elements can be transformed concurrently
+    if (modResidual == 0 || modResidual->Size() != numTransformedDOF) {
+	if (modTangent != 0) delete modTangent;
+	if (modResidual != 0) delete modResidual;
 	modResidual = new Vector(numTransformedDOF);
 	modTangent = new Matrix(numTransformedDOF, numTransformedDOF);
-	if (modResidual == 0 || modResidual->Size() ==0 ||
-	    modTangent ==0 || modTangent->noRows() ==0) {
+	if (modResidual == 0 || modResidual->Size() != numTransformedDOF ||
+	    modTangent ==0 || modTangent->noRows() != numTransformedDOF) {
 	    
 	    opserr << "TransformationFE::setID() ";
 	    opserr << " ran out of memory for vector/Matrix of size :";
@@ -285,103 +192,147 @@ TransformationFE::setID(void)
 	}
     }     
 
-    return 0;
+    // the DOF_Groups have formed their T in doneID(), keep it here
+    return this->formT();
 }
 
-const Matrix &
-TransformationFE::getTangent(Integrator *theNewIntegrator)
+
+int 
+TransformationFE::formT(void)
 {
-    const Matrix &theTangent = this->FE_Element::getTangent(theNewIntegrator);
+    // count the nonzero entries of the T matrices, the dof of a
+    // DOF_Group without a T map to themselves
+    int numEntries = 0;
+    identityT = true;
+    timeVaryingT = false;
+    for (int a=0; a<numGroups; a++) {
+	const Matrix *theT = theDOFs[a]->getT();
+	if (theT == 0)
+	    numEntries += theDOFs[a]->getNumDOF();
+	else {
+	    identityT = false;
+	    if (theDOFs[a]->isTimeVaryingT() == true)
+		timeVaryingT = true;
+	    for (int j=0; j<theT->noCols(); j++)
+		for (int i=0; i<theT->noRows(); i++)
+		    if ((*theT)(i,j) != 0.0)
+			numEntries++;
+	}
+    }
 
-    static ID numDOFs(dofData, 1);
-    numDOFs.setData(dofData, numGroups);
-    
-    // DO THE SP STUFF TO THE TANGENT 
-    
-    // get the transformation matrix from each dof group & number of local dof
-    // for original node.
-    int numNode = numGroups;
-    for (int a = 0; a<numNode; a++) {
-      Matrix *theT = theDOFs[a]->getT();
-      theTransformations[a] = theT;
-      if (theT != 0)
-	numDOFs[a] = theT->noRows(); // T^ 
-      else
-	numDOFs[a] = theDOFs[a]->getNumDOF();
+    if (numEntries > sizeT) {
+	if (tCol != 0) delete [] tCol;
+	if (tVal != 0) delete [] tVal;
+	tCol = new int[numEntries];
+	tVal = new double[numEntries];
+	sizeT = numEntries;
     }
 
-    // perform Tt K T -- as T is block diagonal do T(i)^T K(i,j) T(j)
-    // where blocks are of size equal to num ele dof at a node
+    // now fill in T by rows
+    int row = 0;
+    int col = 0;
+    int loc = 0;
+    for (int a=0; a<numGroups; a++) {
+	const Matrix *theT = theDOFs[a]->getT();
+	int numRows, numCols;
+	if (theT != 0) {
+	    numRows = theT->noRows();
+	    numCols = theT->noCols();
+	} else {
+	    numRows = theDOFs[a]->getNumDOF();
+	    numCols = numRows;
+	}
 
-    int startRow = 0;
-    int noRowsTransformed = 0;
-    int noRowsOriginal = 0;
+	if (row + numRows > numOriginalDOF) {
+	    opserr << "WARNING TransformationFE::formT() - number of dof at the";
+	    opserr << " DOF_Groups exceeds that of the element\n";
+	    return -1;
+	}
 
-    static Matrix localK;
+	for (int i=0; i<numRows; i++) {
+	    tRowStart[row++] = loc;
+	    if (theT == 0) {
+		tCol[loc] = col + i;
+		tVal[loc++] = 1.0;
+	    } else {
+		for (int j=0; j<numCols; j++) {
+		    double value = (*theT)(i,j);
+		    if (value != 0.0) {
+			tCol[loc] = col + j;
+			tVal[loc++] = value;
+		    }
+		}
+	    }		
+	}
+	col += numCols;
+    }
+    tRowStart[row] = loc;
 
-    // foreach block row, for each block col do
-    for (int i=0; i<numNode; i++) {
+    if (row != numOriginalDOF) {
+	opserr << "WARNING TransformationFE::formT() - number of dof at the";
+	opserr << " DOF_Groups differs from that of the element\n";
+	return -1;
+    }
 
-	int startCol = 0;
-	int numDOFi = numDOFs[i];	
-	int noColsOriginal = 0;
+    return 0;
+}
 
-	for (int j=0; j<numNode; j++) {
 
-	    const Matrix *Ti = theTransformations[i];
-	    const Matrix *Tj = theTransformations[j];
-	    int numDOFj = numDOFs[j];	
-	    localK.setData(localKbuffer, numDOFi, numDOFj);
+void  
+TransformationFE::transformTangent(const Matrix &theTangent)
+{
+    if (timeVaryingT == true)
+	this->formT();
 
-	    // copy K(i,j) into localK matrix
-	    // CHECK SIZE OF BUFFER	    
-	    for (int a=0; a<numDOFi; a++)
-		for (int b=0; b<numDOFj; b++)
-		    localK(a,b) = theTangent(noRowsOriginal+a, noColsOriginal+b);
+    if (identityT == true) {
+	*modTangent = theTangent;
+	return;
+    }
 
-	    // now perform the matrix computation T(i)^T localK T(j)
-	    // note: if T == 0 then the Identity is assumed
-	    int noColsTransformed = 0;
-	    static Matrix localTtKT;
-	    
-	    if (Ti != 0 && Tj != 0) {
-		noRowsTransformed = Ti->noCols();
-		noColsTransformed = Tj->noCols();
-		// CHECK SIZE OF BUFFER
-		localTtKT.setData(dataBuffer, noRowsTransformed, noColsTransformed);
-		//localTtKT = (*Ti) ^ localK * (*Tj);
-		localTtKT.addMatrixTripleProduct(0.0, *Ti, localK, *Tj, 1.0);
-	    } else if (Ti == 0 && Tj != 0) {
-		noRowsTransformed = numDOFi;
-		noColsTransformed = Tj->noCols();
-		// CHECK SIZE OF BUFFER
-		localTtKT.setData(dataBuffer, noRowsTransformed, noColsTransformed);
-		// localTtKT = localK * (*Tj);	       
-		localTtKT.addMatrixProduct(0.0, localK, *Tj, 1.0);
-	    } else if (Ti != 0 && Tj == 0) {
-		noRowsTransformed = Ti->noCols();
-		noColsTransformed = numDOFj;
-		localTtKT.setData(dataBuffer, noRowsTransformed, noColsTransformed);
-		//localTtKT = (*Ti) ^ localK;
-		localTtKT.addMatrixTransposeProduct(0.0, *Ti, localK, 1.0);
-	    } else {
-		noRowsTransformed = numDOFi;
-		noColsTransformed = numDOFj;
-		localTtKT.setData(dataBuffer, noRowsTransformed, noColsTransformed);
-		localTtKT = localK;
-	    }
-	    // now copy into modTangent the T(i)^t K(i,j) T(j) product
-	    for (int c=0; c<noRowsTransformed; c++) 
-		for (int d=0; d<noColsTransformed; d++) 
-		    (*modTangent)(startRow+c, startCol+d) = localTtKT(c,d);
-	    
-	    startCol += noColsTransformed;
-	    noColsOriginal += numDOFj;
+    // perform Tt K T in two passes, W = K T and Tt W, over the
+    // nonzero entries of T only
+
+    int n = numOriginalDOF;
+    int m = numTransformedDOF;
+    if (int(workKT.size()) < n*m)
+	workKT.resize(n*m);
+    double *W = &workKT[0];
+    for (int i=0; i<n*m; i++)
+	W[i] = 0.0;
+
+    // W(:,d) += K(:,s) T(s,d), W stored by columns
+    for (int s=0; s<n; s++) {
+	for (int p=tRowStart[s]; p<tRowStart[s+1]; p++) {
+	    double *Wd = &W[tCol[p]*n];
+	    double value = tVal[p];
+	    for (int r=0; r<n; r++)
+		Wd[r] += theTangent(r,s)*value;
 	}
+    }
 
-	noRowsOriginal += numDOFi;
-	startRow += noRowsTransformed;
+    // modTangent(c,d) = sum T(r,c) W(r,d)
+    modTangent->Zero();
+    for (int d=0; d<m; d++) {
+	const double *Wd = &W[d*n];
+	for (int r=0; r<n; r++) {
+	    double value = Wd[r];
+	    if (value == 0.0)
+		continue;
+	    for (int p=tRowStart[r]; p<tRowStart[r+1]; p++)
+		(*modTangent)(tCol[p], d) += tVal[p]*value;
+	}
     }
+}
+
+
+const Matrix &
+TransformationFE::getTangent(Integrator *theNewIntegrator)
+{
+    const Matrix &theTangent = this->FE_Element::getTangent(theNewIntegrator);
+
+    // DO THE SP STUFF TO THE TANGENT 
+    
+    this->transformTangent(theTangent);
 
     return *modTangent;
 }
@@ -394,48 +345,22 @@ TransformationFE::getResidual(Integrator *theNewIntegrator)
     const Vector &theResidual = this->FE_Element::getResidual(theNewIntegrator);
     // DO THE SP STUFF TO THE TANGENT
     
-    // perform Tt R  -- as T is block diagonal do T(i)^T R(i)
-    // where blocks are of size equal to num ele dof at a node
-
-    int startRowTransformed = 0;
-    int startRowOriginal = 0;
-    int numNode = numGroups;
-
-    // foreach block row, for each block col do
-    for (int i=0; i<numNode; i++) {
-	int noRows = 0;
-	int noCols = 0;
-	const Matrix *Ti = theDOFs[i]->getT();
-	if (Ti != 0) {
-	  noRows = Ti->noCols(); // T^
-	  noCols = Ti->noRows();
-
-	  /*
-	  Vector orig(noCols);
-	  Vector mod(noRows);
-	  for (int k=startRowOriginal; k<startRowOriginal+noCols; k++)
-	    orig(k-startRowOriginal)= theResidual(k);
-	  mod = (*Ti)^orig;
-	  for (int k=startRowTransformed; k<startRowTransformed+noRows; k++)
-	    (*modResidual)(k) = mod (k-startRowTransformed);
-
-	  */
-
-	  for (int j=0; j<noRows; j++) {
-	    double sum = 0.0;
-	    for (int k=0; k<noCols; k++)
-	      sum += (*Ti)(k,j) * theResidual(startRowOriginal + k);
-	    (*modResidual)(startRowTransformed +j) = sum;
-	  }
+    if (timeVaryingT == true)
+	this->formT();
 
-	} else {
-	  noCols = theDOFs[i]->getNumDOF();
-	  noRows = noCols;
-	  for (int j=0; j<noRows; j++)
-	    (*modResidual)(startRowTransformed +j) = theResidual(startRowOriginal + j);
-	}
-	startRowTransformed += noRows;
-	startRowOriginal += noCols;
+    if (identityT == true) {
+	*modResidual = theResidual;
+	return *modResidual;
+    }
+
+    // perform Tt R
+    modResidual->Zero();
+    for (int r=0; r<numOriginalDOF; r++) {
+	double value = theResidual(r);
+	if (value == 0.0)
+	    continue;
+	for (int p=tRowStart[r]; p<tRowStart[r+1]; p++)
+	    (*modResidual)(tCol[p]) += tVal[p]*value;
     }
 
     return *modResidual;
@@ -459,96 +384,9 @@ TransformationFE::getK_Force(const Vector &accel, double fact)
   this->FE_Element::addKtToTang();    
   const Matrix &theTangent = this->FE_Element::getTangent(0);
 
-  static ID numDOFs(dofData, 1);
-  numDOFs.setData(dofData, numGroups);
-    
   // DO THE SP STUFF TO THE TANGENT 
   
-  // get the transformation matrix from each dof group & number of local dof
-  // for original node.
-  int numNode = numGroups;
-  for (int a = 0; a<numNode; a++) {
-    Matrix *theT = theDOFs[a]->getT();
-    theTransformations[a] = theT;
-    if (theT != 0)
-      numDOFs[a] = theT->noRows(); // T^ 
-    else
-      numDOFs[a] = theDOFs[a]->getNumDOF();
-  }
-  
-  // perform Tt K T -- as T is block diagonal do T(i)^T K(i,j) T(j)
-  // where blocks are of size equal to num ele dof at a node
-  
-  int startRow = 0;
-  int noRowsTransformed = 0;
-  int noRowsOriginal = 0;
-  
-  static Matrix localK;
-  
-  // foreach block row, for each block col do
-  for (int i=0; i<numNode; i++) {
-    
-    int startCol = 0;
-    int numDOFi = numDOFs[i];	
-    int noColsOriginal = 0;
-    
-    for (int j=0; j<numNode; j++) {
-      
-      const Matrix *Ti = theTransformations[i];
-      const Matrix *Tj = theTransformations[j];
-      int numDOFj = numDOFs[j];	
-      localK.setData(localKbuffer, numDOFi, numDOFj);
-      
-      // copy K(i,j) into localK matrix
-      // CHECK SIZE OF BUFFER	    
-      for (int a=0; a<numDOFi; a++)
-	for (int b=0; b<numDOFj; b++)
-	  localK(a,b) = theTangent(noRowsOriginal+a, noColsOriginal+b);
-      
-      // now perform the matrix computation T(i)^T localK T(j)
-      // note: if T == 0 then the Identity is assumed
-      int noColsTransformed = 0;
-      static Matrix localTtKT;
-      
-      if (Ti != 0 && Tj != 0) {
-	noRowsTransformed = Ti->noCols();
-	noColsTransformed = Tj->noCols();
-	// CHECK SIZE OF BUFFER
-	localTtKT.setData(dataBuffer, noRowsTransformed, noColsTransformed);
-	//localTtKT = (*Ti) ^ localK * (*Tj);
-	localTtKT.addMatrixTripleProduct(0.0, *Ti, localK, *Tj, 1.0);
-      } else if (Ti == 0 && Tj != 0) {
-	noRowsTransformed = numDOFi;
-	noColsTransformed = Tj->noCols();
-	// CHECK SIZE OF BUFFER
-	localTtKT.setData(dataBuffer, noRowsTransformed, noColsTransformed);
-	// localTtKT = localK * (*Tj);	       
-	localTtKT.addMatrixProduct(0.0, localK, *Tj, 1.0);
-      } else if (Ti != 0 && Tj == 0) {
-	noRowsTransformed = Ti->noCols();
-	noColsTransformed = numDOFj;
-	// CHECK SIZE OF BUFFER
-	localTtKT.setData(dataBuffer, noRowsTransformed, noColsTransformed);
-	//localTtKT = (*Ti) ^ localK;
-	localTtKT.addMatrixTransposeProduct(0.0, *Ti, localK, 1.0);
-      } else {
-	noRowsTransformed = numDOFi;
-	noColsTransformed = numDOFj;
-	localTtKT.setData(dataBuffer, noRowsTransformed, noColsTransformed);
-	localTtKT = localK;
-      }
-      // now copy into modTangent the T(i)^t K(i,j) T(j) product
-      for (int c=0; c<noRowsTransformed; c++) 
-	for (int d=0; d<noColsTransformed; d++) 
-	  (*modTangent)(startRow+c, startCol+d) = localTtKT(c,d);
-      
-      startCol += noColsTransformed;
-      noColsOriginal += numDOFj;
-    }
-    
-    noRowsOriginal += numDOFi;
-    startRow += noRowsTransformed;
-  }
+  this->transformTangent(theTangent);
   
   // get the components we need out of the vector
   // and place in a temporary vector
@@ -574,96 +412,9 @@ TransformationFE::getKi_Force(const Vector &accel, double fact)
   this->FE_Element::addKiToTang();    
   const Matrix &theTangent = this->FE_Element::getTangent(0);
 
-  static ID numDOFs(dofData, 1);
-  numDOFs.setData(dofData, numGroups);
-    
   // DO THE SP STUFF TO THE TANGENT 
   
-  // get the transformation matrix from each dof group & number of local dof
-  // for original node.
-  int numNode = numGroups;
-  for (int a = 0; a<numNode; a++) {
-    Matrix *theT = theDOFs[a]->getT();
-    theTransformations[a] = theT;
-    if (theT != 0)
-      numDOFs[a] = theT->noRows(); // T^ 
-    else
-      numDOFs[a] = theDOFs[a]->getNumDOF();
-  }
-  
-  // perform Tt K T -- as T is block diagonal do T(i)^T K(i,j) T(j)
-  // where blocks are of size equal to num ele dof at a node
-  
-  int startRow = 0;
-  int noRowsTransformed = 0;
-  int noRowsOriginal = 0;
-  
-  static Matrix localK;
-  
-  // foreach block row, for each block col do
-  for (int i=0; i<numNode; i++) {
-    
-    int startCol = 0;
-    int numDOFi = numDOFs[i];	
-    int noColsOriginal = 0;
-    
-    for (int j=0; j<numNode; j++) {
-      
-      const Matrix *Ti = theTransformations[i];
-      const Matrix *Tj = theTransformations[j];
-      int numDOFj = numDOFs[j];	
-      localK.setData(localKbuffer, numDOFi, numDOFj);
-      
-      // copy K(i,j) into localK matrix
-      // CHECK SIZE OF BUFFER	    
-      for (int a=0; a<numDOFi; a++)
-	for (int b=0; b<numDOFj; b++)
-	  localK(a,b) = theTangent(noRowsOriginal+a, noColsOriginal+b);
-      
-      // now perform the matrix computation T(i)^T localK T(j)
-      // note: if T == 0 then the Identity is assumed
-      int noColsTransformed = 0;
-      static Matrix localTtKT;
-      
-      if (Ti != 0 && Tj != 0) {
-	noRowsTransformed = Ti->noCols();
-	noColsTransformed = Tj->noCols();
-	// CHECK SIZE OF BUFFER
-	localTtKT.setData(dataBuffer, noRowsTransformed, noColsTransformed);
-	//localTtKT = (*Ti) ^ localK * (*Tj);
-	localTtKT.addMatrixTripleProduct(0.0, *Ti, localK, *Tj, 1.0);
-      } else if (Ti == 0 && Tj != 0) {
-	noRowsTransformed = numDOFi;
-	noColsTransformed = Tj->noCols();
-	// CHECK SIZE OF BUFFER
-	localTtKT.setData(dataBuffer, noRowsTransformed, noColsTransformed);
-	// localTtKT = localK * (*Tj);	       
-	localTtKT.addMatrixProduct(0.0, localK, *Tj, 1.0);
-      } else if (Ti != 0 && Tj == 0) {
-	noRowsTransformed = Ti->noCols();
-	noColsTransformed = numDOFj;
-	// CHECK SIZE OF BUFFER
-	localTtKT.setData(dataBuffer, noRowsTransformed, noColsTransformed);
-	//localTtKT = (*Ti) ^ localK;
-	localTtKT.addMatrixTransposeProduct(0.0, *Ti, localK, 1.0);
-      } else {
-	noRowsTransformed = numDOFi;
-	noColsTransformed = numDOFj;
-	localTtKT.setData(dataBuffer, noRowsTransformed, noColsTransformed);
-	localTtKT = localK;
-      }
-      // now copy into modTangent the T(i)^t K(i,j) T(j) product
-      for (int c=0; c<noRowsTransformed; c++) 
-	for (int d=0; d<noColsTransformed; d++) 
-	  (*modTangent)(startRow+c, startCol+d) = localTtKT(c,d);
-      
-      startCol += noColsTransformed;
-      noColsOriginal += numDOFj;
-    }
-    
-    noRowsOriginal += numDOFi;
-    startRow += noRowsTransformed;
-  }
+  this->transformTangent(theTangent);
   
   // get the components we need out of the vector
   // and place in a temporary vector
@@ -688,96 +439,9 @@ TransformationFE::getM_Force(const Vector &accel, double fact)
   this->FE_Element::addMtoTang();    
   const Matrix &theTangent = this->FE_Element::getTangent(0);
 
-  static ID numDOFs(dofData, 1);
-  numDOFs.setData(dofData, numGroups);
-    
   // DO THE SP STUFF TO THE TANGENT 
   
-  // get the transformation matrix from each dof group & number of local dof
-  // for original node.
-  int numNode = numGroups;
-  for (int a = 0; a<numNode; a++) {
-    Matrix *theT = theDOFs[a]->getT();
-    theTransformations[a] = theT;
-    if (theT != 0)
-      numDOFs[a] = theT->noRows(); // T^ 
-    else
-      numDOFs[a] = theDOFs[a]->getNumDOF();
-  }
-  
-  // perform Tt K T -- as T is block diagonal do T(i)^T K(i,j) T(j)
-  // where blocks are of size equal to num ele dof at a node
-  
-  int startRow = 0;
-  int noRowsTransformed = 0;
-  int noRowsOriginal = 0;
-  
-  static Matrix localK;
-  
-  // foreach block row, for each block col do
-  for (int i=0; i<numNode; i++) {
-    
-    int startCol = 0;
-    int numDOFi = numDOFs[i];	
-    int noColsOriginal = 0;
-    
-    for (int j=0; j<numNode; j++) {
-      
-      const Matrix *Ti = theTransformations[i];
-      const Matrix *Tj = theTransformations[j];
-      int numDOFj = numDOFs[j];	
-      localK.setData(localKbuffer, numDOFi, numDOFj);
-      
-      // copy K(i,j) into localK matrix
-      // CHECK SIZE OF BUFFER	    
-      for (int a=0; a<numDOFi; a++)
-	for (int b=0; b<numDOFj; b++)
-	  localK(a,b) = theTangent(noRowsOriginal+a, noColsOriginal+b);
-      
-      // now perform the matrix computation T(i)^T localK T(j)
-      // note: if T == 0 then the Identity is assumed
-      int noColsTransformed = 0;
-      static Matrix localTtKT;
-      
-      if (Ti != 0 && Tj != 0) {
-	noRowsTransformed = Ti->noCols();
-	noColsTransformed = Tj->noCols();
-	// CHECK SIZE OF BUFFER
-	localTtKT.setData(dataBuffer, noRowsTransformed, noColsTransformed);
-	//localTtKT = (*Ti) ^ localK * (*Tj);
-	localTtKT.addMatrixTripleProduct(0.0, *Ti, localK, *Tj, 1.0);
-      } else if (Ti == 0 && Tj != 0) {
-	noRowsTransformed = numDOFi;
-	noColsTransformed = Tj->noCols();
-	// CHECK SIZE OF BUFFER
-	localTtKT.setData(dataBuffer, noRowsTransformed, noColsTransformed);
-	// localTtKT = localK * (*Tj);	       
-	localTtKT.addMatrixProduct(0.0, localK, *Tj, 1.0);
-      } else if (Ti != 0 && Tj == 0) {
-	noRowsTransformed = Ti->noCols();
-	noColsTransformed = numDOFj;
-	// CHECK SIZE OF BUFFER
-	localTtKT.setData(dataBuffer, noRowsTransformed, noColsTransformed);
-	//localTtKT = (*Ti) ^ localK;
-	localTtKT.addMatrixTransposeProduct(0.0, *Ti, localK, 1.0);
-      } else {
-	noRowsTransformed = numDOFi;
-	noColsTransformed = numDOFj;
-	localTtKT.setData(dataBuffer, noRowsTransformed, noColsTransformed);
-	localTtKT = localK;
-      }
-      // now copy into modTangent the T(i)^t K(i,j) T(j) product
-      for (int c=0; c<noRowsTransformed; c++) 
-	for (int d=0; d<noColsTransformed; d++) 
-	  (*modTangent)(startRow+c, startCol+d) = localTtKT(c,d);
-      
-      startCol += noColsTransformed;
-      noColsOriginal += numDOFj;
-    }
-    
-    noRowsOriginal += numDOFi;
-    startRow += noRowsTransformed;
-  }
+  this->transformTangent(theTangent);
   
   // get the components we need out of the vector
   // and place in a temporary vector
@@ -802,96 +466,9 @@ TransformationFE::getC_Force(const Vector &accel, double fact)
   this->FE_Element::addCtoTang();    
   const Matrix &theTangent = this->FE_Element::getTangent(0);
 
-  static ID numDOFs(dofData, 1);
-  numDOFs.setData(dofData, numGroups);
-    
   // DO THE SP STUFF TO THE TANGENT 
   
-  // get the transformation matrix from each dof group & number of local dof
-  // for original node.
-  int numNode = numGroups;
-  for (int a = 0; a<numNode; a++) {
-    Matrix *theT = theDOFs[a]->getT();
-    theTransformations[a] = theT;
-    if (theT != 0)
-      numDOFs[a] = theT->noRows(); // T^ 
-    else
-      numDOFs[a] = theDOFs[a]->getNumDOF();
-  }
-  
-  // perform Tt K T -- as T is block diagonal do T(i)^T K(i,j) T(j)
-  // where blocks are of size equal to num ele dof at a node
-  
-  int startRow = 0;
-  int noRowsTransformed = 0;
-  int noRowsOriginal = 0;
-  
-  static Matrix localK;
-  
-  // foreach block row, for each block col do
-  for (int i=0; i<numNode; i++) {
-    
-    int startCol = 0;
-    int numDOFi = numDOFs[i];	
-    int noColsOriginal = 0;
-    
-    for (int j=0; j<numNode; j++) {
-      
-      const Matrix *Ti = theTransformations[i];
-      const Matrix *Tj = theTransformations[j];
-      int numDOFj = numDOFs[j];	
-      localK.setData(localKbuffer, numDOFi, numDOFj);
-      
-      // copy K(i,j) into localK matrix
-      // CHECK SIZE OF BUFFER	    
-      for (int a=0; a<numDOFi; a++)
-	for (int b=0; b<numDOFj; b++)
-	  localK(a,b) = theTangent(noRowsOriginal+a, noColsOriginal+b);
-      
-      // now perform the matrix computation T(i)^T localK T(j)
-      // note: if T == 0 then the Identity is assumed
-      int noColsTransformed = 0;
-      static Matrix localTtKT;
-      
-      if (Ti != 0 && Tj != 0) {
-	noRowsTransformed = Ti->noCols();
-	noColsTransformed = Tj->noCols();
-	// CHECK SIZE OF BUFFER
-	localTtKT.setData(dataBuffer, noRowsTransformed, noColsTransformed);
-	//localTtKT = (*Ti) ^ localK * (*Tj);
-	localTtKT.addMatrixTripleProduct(0.0, *Ti, localK, *Tj, 1.0);
-      } else if (Ti == 0 && Tj != 0) {
-	noRowsTransformed = numDOFi;
-	noColsTransformed = Tj->noCols();
-	// CHECK SIZE OF BUFFER
-	localTtKT.setData(dataBuffer, noRowsTransformed, noColsTransformed);
-	// localTtKT = localK * (*Tj);	       
-	localTtKT.addMatrixProduct(0.0, localK, *Tj, 1.0);
-      } else if (Ti != 0 && Tj == 0) {
-	noRowsTransformed = Ti->noCols();
-	noColsTransformed = numDOFj;
-	// CHECK SIZE OF BUFFER
-	localTtKT.setData(dataBuffer, noRowsTransformed, noColsTransformed);
-	//localTtKT = (*Ti) ^ localK;
-	localTtKT.addMatrixTransposeProduct(0.0, *Ti, localK, 1.0);
-      } else {
-	noRowsTransformed = numDOFi;
-	noColsTransformed = numDOFj;
-	localTtKT.setData(dataBuffer, noRowsTransformed, noColsTransformed);
-	localTtKT = localK;
-      }
-      // now copy into modTangent the T(i)^t K(i,j) T(j) product
-      for (int c=0; c<noRowsTransformed; c++) 
-	for (int d=0; d<noColsTransformed; d++) 
-	  (*modTangent)(startRow+c, startCol+d) = localTtKT(c,d);
-      
-      startCol += noColsTransformed;
-      noColsOriginal += numDOFj;
-    }
-    
-    noRowsOriginal += numDOFi;
-    startRow += noRowsTransformed;
-  }
+  this->transformTangent(theTangent);
   
   // get the components we need out of the vector
   // and place in a temporary vector
@@ -916,8 +493,9 @@ TransformationFE::addD_Force(const Vector &disp,  double fact)
     if (fact == 0.0)
 	return;
 
-    static Vector response;
-    response.setData(dataBuffer, numOriginalDOF);
+    if (int(workResponse.size()) < numOriginalDOF)
+	workResponse.resize(numOriginalDOF);
+    Vector response(&workResponse[0], numOriginalDOF);
 		    
     for (int i=0; i<numTransformedDOF; i++) {
 	int loc = (*modID)(i);
@@ -936,8 +514,9 @@ TransformationFE::addM_Force(const Vector &disp,  double fact)
     if (fact == 0.0)
 	return;
 
-    static Vector response;
-    response.setData(dataBuffer, numOriginalDOF);
+    if (int(workResponse.size()) < numOriginalDOF)
+	workResponse.resize(numOriginalDOF);
+    Vector response(&workResponse[0], numOriginalDOF);
 		    
     for (int i=0; i<numTransformedDOF; i++) {
 	int loc = (*modID)(i);
@@ -978,34 +557,16 @@ int
 TransformationFE::transformResponse(const Vector &modResp, 
 				    Vector &unmodResp)
 {
-    // perform T R  -- as T is block diagonal do T(i) R(i)
-    // where blocks are of size equal to num ele dof at a node
-
-    int startRowOriginal = 0;
-    int startRowTransformed = 0;
-    int numNode = numGroups;
-    int noRows = 0;
-    int noCols = 0;
-
-    for (int i=0; i<numNode; i++) {
-	const Matrix *Ti = theDOFs[i]->getT();
-	if (Ti != 0) {
-	    noRows = Ti->noRows();
-	    noCols = Ti->noCols();
-	    for (int j=0; j<noRows; j++) {
-		double sum = 0.0;
-		for (int k=0; k<noCols; k++)
-		    sum += (*Ti)(j,k) * modResp(startRowTransformed +k) ;
-		unmodResp(startRowOriginal + j) = sum;
-	    }
-	} else {
-	    noCols = theDOFs[i]->getNumDOF();
-	    noRows = noCols;
-	    for (int j=0; j<noCols; j++)
-		unmodResp(startRowOriginal + j) = modResp(startRowTransformed +j);
-	}
-	startRowOriginal += noRows;
-	startRowTransformed += noCols;
+    // perform T R over the nonzero entries of T
+
+    if (timeVaryingT == true)
+	this->formT();
+
+    for (int r=0; r<numOriginalDOF; r++) {
+	double sum = 0.0;
+	for (int p=tRowStart[r]; p<tRowStart[r+1]; p++)
+	    sum += tVal[p] * modResp(tCol[p]);
+	unmodResp(r) = sum;
     }
 
     return 0;
@@ -1019,8 +580,9 @@ TransformationFE::addD_ForceSensitivity(int gradNumber, const Vector &disp,  dou
     if (fact == 0.0)
 	return;
 
-    static Vector response;
-    response.setData(dataBuffer, numOriginalDOF);
+    if (int(workResponse.size()) < numOriginalDOF)
+	workResponse.resize(numOriginalDOF);
+    Vector response(&workResponse[0], numOriginalDOF);
 		    
     for (int i=0; i<numTransformedDOF; i++) {
 	int loc = (*modID)(i);
@@ -1039,8 +601,9 @@ TransformationFE::addM_ForceSensitivity(int gradNumber, const Vector &disp,  dou
     if (fact == 0.0)
 	return;
 
-    static Vector response;
-    response.setData(dataBuffer, numOriginalDOF);
+    if (int(workResponse.size()) < numOriginalDOF)
+	workResponse.resize(numOriginalDOF);
+    Vector response(&workResponse[0], numOriginalDOF);
 		    
     for (int i=0; i<numTransformedDOF; i++) {
 	int loc = (*modID)(i);
@@ -79,6 +79,8 @@ class TransformationFE: public FE_Element
     int transformResponse(const Vector &modResponse, Vector &unmodResponse);
     
   private:
+    int formT(void);
+    void transformTangent(const Matrix &theTangent);
     
     // private variables - a copy for each object of the class        
     DOF_Group **theDOFs;
@@ -90,18 +92,15 @@ class TransformationFE: public FE_Element
     int numGroups;
     int numTransformedDOF;
     int numOriginalDOF;
-    
-    // static variables - single copy for all objects of the class	
-    static Matrix **modMatrices; // array of pointers to class wide matrices
-    static Vector **modVectors;  // array of pointers to class widde vectors
-    static Matrix **theTransformations; // for holding pointers to the T matrices
-    static int numTransFE;     // number of objects    
-    static int transCounter;   // a counter used to indicate when to do something
-    static int sizeTransformations; // size of theTransformations array
-    static double *dataBuffer;
-    static double *localKbuffer;
-    static int    *dofData;
-    static int sizeBuffer;
+
+    // the block diagonal T stored by rows, one row for each dof of the
+    // element; formed in setID() and again only if a T is time varying
+    int *tRowStart;
+    int *tCol;
+    double *tVal;
+    int sizeT;
+    bool identityT;    // no DOF_Group has a T
+    bool timeVaryingT;
 };
 
 #endif
@@ -376,7 +376,6 @@ int
 HarmonicSteadyState::computeSensitivities(void)
 {
 //  opserr<<" computeSensitivity::start"<<endln;
-    LinearSOE *theSOE = this->getLinearSOE();
 
     /*
   if (theAlgorithm == 0) {
@@ -412,60 +411,6 @@ HarmonicSteadyState::computeSensitivities(void)
 		return -1;
 	}
 	*/
-	// Zero out the old right-hand side of the SOE
-	theSOE->zeroB();
-
-
-	if (this == 0) {
-	  opserr << "ERROR SensitivityAlgorithm::computeSensitivities() -";
-	  opserr << "the SensitivityIntegrator is NULL\n";
-	  return -1;
-	}
-
-	// Form the part of the RHS which are indepent of parameter
-	this->formIndependentSensitivityRHS();
-	AnalysisModel *theModel = this->getAnalysisModel();
-	Domain *theDomain=theModel->getDomainPtr();
-	ParameterIter &paramIter = theDomain->getParameters();
-
-	Parameter *theParam;
-	// De-activate all parameters
-	while ((theParam = paramIter()) != 0)
-	  theParam->activate(false);
-
-	// Now, compute sensitivity wrt each parameter
-	int numGrads = theDomain->getNumParameters();
-	paramIter = theDomain->getParameters();
-
-	while ((theParam = paramIter()) != 0) {
-
-	  // Activate this parameter
-	  theParam->activate(true);
-
-	  // Zero the RHS vector
-	  theSOE->zeroB();
-
-	  // Get the grad index for this parameter
-	  int gradIndex = theParam->getGradIndex();
-
-	  // Form the RHS
-	  this->formSensitivityRHS(gradIndex);
-
-	  // Solve for displacement sensitivity
-
-	  theSOE->solve();
-	  // Save sensitivity to nodes
-	  this->saveSensitivity( theSOE->getX(), gradIndex, numGrads );
-
-
-
-	  // Commit unconditional history variables (also for elastic problems; strain sens may be needed anyway)
-	  this->commitSensitivity(gradIndex, numGrads);
-
-	  // De-activate this parameter for next sensitivity calc
-	  theParam->activate(false);
-	//  opserr<<"HarmonicSteadyState::..........ComputeSensitivities. end"<<endln;
-	}
-
-	return 0;
+	// Form and solve the sensitivity right-hand sides of all parameters
+	return this->solveSensitivities();
 }
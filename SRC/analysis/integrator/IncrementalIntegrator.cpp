@@ -39,6 +39,11 @@
 #include <FE_EleIter.h>
 #include <DOF_GrpIter.h>
 #include <EigenSOE.h>
+#include <Matrix.h>
+#include <Domain.h>
+#include <Parameter.h>
+#include <ParameterIter.h>
+#include <vector>
 #include <cmath>
 
 IncrementalIntegrator::IncrementalIntegrator(int clasTag)
@@ -126,6 +131,91 @@ IncrementalIntegrator::formIndependentSensitivityLHS(int statFlag)
     return this->formTangent(statFlag);
 }
 
+// computes the response sensitivity to all parameters. The right-hand
+// sides of up to maxBlock parameters are formed into the columns of a
+// matrix and solved together with the current factorization of the
+// tangent; the sensitivities are then saved and committed per parameter.
+int
+IncrementalIntegrator::solveSensitivities(void)
+{
+    if (theAnalysisModel == 0 || theSOE == 0) {
+	opserr << "WARNING IncrementalIntegrator::solveSensitivities -";
+	opserr << " no AnalysisModel or LinearSOE has been set\n";
+	return -1;
+    }
+
+    static const int maxBlock = 64;
+
+    // Zero out the old right-hand side of the SOE
+    theSOE->zeroB();
+
+    // Form the part of the RHS which are indepent of parameter
+    this->formIndependentSensitivityRHS();
+
+    Domain *theDomain = theAnalysisModel->getDomainPtr();
+    ParameterIter &paramIter = theDomain->getParameters();
+    Parameter *theParam;
+
+    // De-activate all parameters and collect them
+    std::vector<Parameter *> params;
+    while ((theParam = paramIter()) != 0) {
+	theParam->activate(false);
+	params.push_back(theParam);
+    }
+
+    int numGrads = theDomain->getNumParameters();
+    int numParams = (int)params.size();
+    int n = theSOE->getNumEqn();
+    if (numParams == 0)
+	return 0;
+
+    int blockSize = numParams < maxBlock ? numParams : maxBlock;
+    Matrix B(n, blockSize);
+    Matrix X(n, blockSize);
+    Vector x(n);
+
+    for (int first = 0; first < numParams; first += blockSize) {
+	int num = numParams - first;
+	if (num > blockSize)
+	    num = blockSize;
+	else if (num < blockSize)
+	    B.resize(n, num);
+
+	// Form the RHS of each parameter in the block
+	for (int k = 0; k < num; k++) {
+	    theParam = params[first+k];
+	    theParam->activate(true);
+	    theSOE->zeroB();
+	    this->formSensitivityRHS(theParam->getGradIndex());
+	    const Vector &b = theSOE->getB();
+	    for (int i = 0; i < n; i++)
+		B(i,k) = b(i);
+	    theParam->activate(false);
+	}
+
+	// Solve for displacement sensitivities
+	if (theSOE->solveMultiple(B, X) < 0) {
+	    opserr << "WARNING IncrementalIntegrator::solveSensitivities -";
+	    opserr << " the LinearSOE failed in solveMultiple()\n";
+	    return -1;
+	}
+
+	// Save and commit the sensitivity of each parameter
+	for (int k = 0; k < num; k++) {
+	    theParam = params[first+k];
+	    int gradIndex = theParam->getGradIndex();
+	    theParam->activate(true);
+	    for (int i = 0; i < n; i++)
+		x(i) = X(i,k);
+	    this->saveSensitivity(x, gradIndex, numGrads);
+	    this->commitSensitivity(gradIndex, numGrads);
+	    theParam->activate(false);
+	}
+    }
+
+    return 0;
+}
+
 int 
 IncrementalIntegrator::formUnbalance(void)
 {
@@ -99,6 +99,7 @@ class IncrementalIntegrator : public Integrator
 // AddingSensitivity:BEGIN //////////////////////////////////
     virtual int revertToStart();
     virtual int formIndependentSensitivityLHS(int statusFlag = CURRENT_TANGENT);
+    int solveSensitivities(void);
 // AddingSensitivity:END ////////////////////////////////////
     
     // method introduced for domain decomposition
@@ -948,7 +948,6 @@ int
 Newmark::computeSensitivities(void)
 {
   //  opserr<<" computeSensitivity::start"<<endln; 
-  LinearSOE *theSOE = this->getLinearSOE();
   
   /*
     if (theAlgorithm == 0) {
@@ -984,55 +983,7 @@ Newmark::computeSensitivities(void)
   return -1;
   }
   */
-  // Zero out the old right-hand side of the SOE
-  theSOE->zeroB();
-  
-  // Form the part of the RHS which are indepent of parameter
-  this->formIndependentSensitivityRHS();
-  AnalysisModel *theModel = this->getAnalysisModel();  //Abbas 
-  Domain *theDomain=theModel->getDomainPtr();//Abbas
-  ParameterIter &paramIter = theDomain->getParameters();
-  //	opserr<<" get parameters "<<theDomain->getParameters()<<endln;//Abbas.......
-  Parameter *theParam;
-  // De-activate all parameters
-  while ((theParam = paramIter()) != 0)
-    theParam->activate(false);
-  
-  // Now, compute sensitivity wrt each parameter
-  int numGrads = theDomain->getNumParameters();
-  //opserr<<"the numGrads is "<<numGrads<<endln;//Abbas...............................
-  paramIter = theDomain->getParameters();
-  
-  while ((theParam = paramIter()) != 0) {
-    
-    // Activate this parameter
-    theParam->activate(true);
-    
-    // Zero the RHS vector
-    theSOE->zeroB();
-    
-    // Get the grad index for this parameter
-    int gradIndex = theParam->getGradIndex();
-    //   opserr<<"gradNumber = "<<gradIndex<<endln;
-    // Form the RHS
-    this->formSensitivityRHS(gradIndex);
-    
-    // Solve for displacement sensitivity
-    
-    theSOE->solve();
-    // Save sensitivity to nodes
-    this->saveSensitivity( theSOE->getX(), gradIndex, numGrads );
-    
-    
-    
-    // Commit unconditional history variables (also for elastic problems; strain sens may be needed anyway)
-    this->commitSensitivity(gradIndex, numGrads);
-    
-    // De-activate this parameter for next sensitivity calc
-    theParam->activate(false);
-    //  opserr<<"LoadControl::..........ComputeSensitivities. end"<<endln;
-  }
-  
-  return 0;
+  // Form and solve the sensitivity right-hand sides of all parameters
+  return this->solveSensitivities();
 }
 
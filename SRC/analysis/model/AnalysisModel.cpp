@@ -49,9 +49,11 @@
 #include <Node.h>
 #include <NodeIter.h>
 #include <ConstraintHandler.h>
+#include <NodalStatePool.h>
 
 
 #include <MapOfTaggedObjects.h>
+#include <MemoryStats.h>
 
 #define START_EQN_NUM 0
 #define START_VERTEX_NUM 0
@@ -63,7 +65,8 @@ AnalysisModel::AnalysisModel(int theClassTag)
 :MovableObject(theClassTag),
  myDomain(0), myHandler(0),
  myDOFGraph(0), myGroupGraph(0),
- numFE_Ele(0), numDOF_Grp(0), numEqn(0)
+ numFE_Ele(0), numDOF_Grp(0), numEqn(0),
+ scatterFormed(false), scatterLayout(0)
 {
     theFEs     = new ArrayOfTaggedObjects(1024);
     theDOFs    =  new ArrayOfTaggedObjects(1024);
@@ -77,7 +80,8 @@ AnalysisModel::AnalysisModel()
 :MovableObject(AnaMODEL_TAGS_AnalysisModel),
  myDomain(0), myHandler(0),
  myDOFGraph(0), myGroupGraph(0),
- numFE_Ele(0), numDOF_Grp(0), numEqn(0)
+ numFE_Ele(0), numDOF_Grp(0), numEqn(0),
+ scatterFormed(false), scatterLayout(0)
 {
   theFEs     = new ArrayOfTaggedObjects(256);
   theDOFs    = new ArrayOfTaggedObjects(256);
@@ -90,7 +94,8 @@ AnalysisModel::AnalysisModel(TaggedObjectStorage &theFes, TaggedObjectStorage &t
 :MovableObject(AnaMODEL_TAGS_AnalysisModel),
  myDomain(0), myHandler(0),
  myDOFGraph(0), myGroupGraph(0),
- numFE_Ele(0), numDOF_Grp(0), numEqn(0)
+ numFE_Ele(0), numDOF_Grp(0), numEqn(0),
+ scatterFormed(false), scatterLayout(0)
 {
   theFEs     = &theFes;
   theDOFs    = &theDofs;
@@ -159,6 +164,7 @@ AnalysisModel::addFE_Element(FE_Element *theElement)
   if (result == true) {
     theElement->setAnalysisModel(*this);
     numFE_Ele++;
+    MemoryStats::charge(MemoryStats::AnalysisModel, 0, "FE_Element");
     return true;  // o.k.
   } else
     return false;
@@ -195,6 +201,8 @@ AnalysisModel::addDOF_Group(DOF_Group *theGroup)
   bool result = theDOFs->addComponent(theGroup);
   if (result == true) {
     numDOF_Grp++;
+    scatterFormed = false;
+    MemoryStats::charge(MemoryStats::AnalysisModel, 0, "DOF_Group");
     return true;  // o.k.
   } else
     return false;
@@ -219,6 +227,9 @@ AnalysisModel::clearAll(void)
     numFE_Ele =0;
     numDOF_Grp = 0;
     numEqn = 0;    
+    scatterFormed = false;
+
+    MemoryStats::clear(MemoryStats::AnalysisModel);
 }
 
 void
@@ -279,6 +290,9 @@ void
 AnalysisModel::setNumEqn(int theNumEqn)
 {
     numEqn = theNumEqn;
+
+    // the equation numbers have been set
+    scatterFormed = false;
 }
 
 int 
@@ -431,11 +445,77 @@ AnalysisModel::getDOFGroupGraph(void)
 
 
 
+NodalStatePool *
+AnalysisModel::getScatter(void)
+{
+    if (myDomain == 0)
+	return 0;
+
+    NodalStatePool *thePool = myDomain->getNodalStatePool();
+    if (thePool == 0)
+	return 0;
+
+    if (scatterFormed == true && scatterLayout == thePool->getLayoutTag())
+	return thePool;
+
+    // determine the free dof of the DOF_Groups whose nodes are in the pool
+    scatterNodes.clear();
+    scatterStart.clear();
+    scatterEqn.clear();
+    scatterLoc.clear();
+    otherDOFs.clear();
+    scatterStart.push_back(0);
+
+    DOF_GrpIter &theDOFGrps = this->getDOFs();
+    DOF_Group 	*dofPtr;
+
+    while ((dofPtr = theDOFGrps()) != 0) {
+	Node *theNode = dofPtr->getScatterNode();
+	int offset = thePool->getOffset(theNode);
+	if (offset < 0) {
+	    otherDOFs.push_back(dofPtr);
+	    continue;
+	}
+
+	const ID &id = dofPtr->getID();
+	for (int i=0; i<id.Size(); i++) {
+	    int loc = id(i);
+	    if (loc >= 0) {
+		scatterEqn.push_back(loc);
+		scatterLoc.push_back(offset+i);
+	    }
+	}
+	scatterNodes.push_back(theNode);
+	scatterStart.push_back(int(scatterEqn.size()));
+    }
+
+    scatterFormed = true;
+    scatterLayout = thePool->getLayoutTag();
+
+    return thePool;
+}
+
 void 
 AnalysisModel::setResponse(const Vector &disp,
 			   const Vector &vel, 
 			   const Vector &accel)
 {
+    NodalStatePool *thePool = this->getScatter();
+    if (thePool != 0) {
+	int numDOF = int(scatterEqn.size());
+	thePool->setTrialDisp(disp, int(scatterNodes.size()), scatterNodes.data(),
+			      scatterStart.data(), scatterEqn.data(), scatterLoc.data());
+	thePool->setTrialVel(vel, numDOF, scatterEqn.data(), scatterLoc.data());
+	thePool->setTrialAccel(accel, numDOF, scatterEqn.data(), scatterLoc.data());
+
+	for (size_t i=0; i<otherDOFs.size(); i++) {
+	    otherDOFs[i]->setNodeDisp(disp);
+	    otherDOFs[i]->setNodeVel(vel);
+	    otherDOFs[i]->setNodeAccel(accel);	
+	}
+	return;
+    }
+
     DOF_GrpIter &theDOFGrps = this->getDOFs();
     DOF_Group 	*dofPtr;
 
@@ -449,6 +529,15 @@ AnalysisModel::setResponse(const Vector &disp,
 void 
 AnalysisModel::setDisp(const Vector &disp)
 {
+    NodalStatePool *thePool = this->getScatter();
+    if (thePool != 0) {
+	thePool->setTrialDisp(disp, int(scatterNodes.size()), scatterNodes.data(),
+			      scatterStart.data(), scatterEqn.data(), scatterLoc.data());
+	for (size_t i=0; i<otherDOFs.size(); i++)
+	    otherDOFs[i]->setNodeDisp(disp);
+	return;
+    }
+
     DOF_GrpIter &theDOFGrps = this->getDOFs();
     DOF_Group 	*dofPtr;
 
@@ -459,6 +548,15 @@ AnalysisModel::setDisp(const Vector &disp)
 void 
 AnalysisModel::setVel(const Vector &vel)
 {
+    NodalStatePool *thePool = this->getScatter();
+    if (thePool != 0) {
+	thePool->setTrialVel(vel, int(scatterEqn.size()),
+			     scatterEqn.data(), scatterLoc.data());
+	for (size_t i=0; i<otherDOFs.size(); i++)
+	    otherDOFs[i]->setNodeVel(vel);
+	return;
+    }
+
         DOF_GrpIter &theDOFGrps = this->getDOFs();
     DOF_Group 	*dofPtr;
     
@@ -470,6 +568,15 @@ AnalysisModel::setVel(const Vector &vel)
 void 
 AnalysisModel::setAccel(const Vector &accel)
 {
+    NodalStatePool *thePool = this->getScatter();
+    if (thePool != 0) {
+	thePool->setTrialAccel(accel, int(scatterEqn.size()),
+			       scatterEqn.data(), scatterLoc.data());
+	for (size_t i=0; i<otherDOFs.size(); i++)
+	    otherDOFs[i]->setNodeAccel(accel);
+	return;
+    }
+
     DOF_GrpIter &theDOFGrps = this->getDOFs();
     DOF_Group 	*dofPtr;
     
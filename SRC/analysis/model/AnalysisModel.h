@@ -40,6 +40,7 @@
 // What: "@(#) AnalysisModel.h, revA"
 
 #include <MovableObject.h>
+#include <vector>
 
 class TaggedObjectStorage;
 class Domain;
@@ -51,6 +52,8 @@ class DOF_Group;
 class Vector;
 class FEM_ObjectBroker;
 class ConstraintHandler;
+class Node;
+class NodalStatePool;
 
 class AnalysisModel: public MovableObject
 {
@@ -125,6 +128,8 @@ class AnalysisModel: public MovableObject
 
     
   private:
+    NodalStatePool *getScatter(void);
+
     Domain *myDomain;
     ConstraintHandler *myHandler;
 
@@ -140,6 +145,19 @@ class AnalysisModel: public MovableObject
     
     FE_EleIter    *theFEiter;     
     DOF_GrpIter   *theDOFiter;    
+
+    // when the Domain has a NodalStatePool the response is copied straight
+    // into it: the free dof of the nodes in scatterNodes, with equation
+    // numbers scatterEqn and positions in the pool scatterLoc, the dof of
+    // node n being from scatterStart[n] to scatterStart[n+1]-1. The
+    // DOF_Groups in otherDOFs still set their nodes themselves.
+    bool scatterFormed;
+    int scatterLayout;          // layout tag of the pool it was formed for
+    std::vector<Node *> scatterNodes;
+    std::vector<int> scatterStart;
+    std::vector<int> scatterEqn;
+    std::vector<int> scatterLoc;
+    std::vector<DOF_Group *> otherDOFs;
 };
 
 #endif
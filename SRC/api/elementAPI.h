@@ -182,6 +182,13 @@ extern "C" int         OPS_GetIntInput(int numData, int* data);
 extern "C" int         OPS_SetIntOutput(int numData, int* data, bool scalar);
 extern "C" int         OPS_GetDoubleInput(int numData, double* data);
 extern "C" int         OPS_SetDoubleOutput(int numData, double* data, bool scalar);
+
+// a list argument: a tcl list, a python list/tuple or an array buffer
+class ID;
+class Vector;
+int                    OPS_GetIntListInput(int* size, ID* data);
+int                    OPS_GetDoubleListInput(int* size, Vector* data);
+
 extern "C" const char* OPS_GetString(); // does a strcpy
 extern "C" const char* OPS_GetStringFromAll(char* buffer, int len); // does a strcpy
 extern "C" int         OPS_SetString(const char* str);
@@ -143,6 +143,21 @@ int OPS_GetDoubleInput(int numData, double *data)
   return 0;  
 }
 
+int OPS_GetIntListInput(int *size, ID *data)
+{
+  // there are no list arguments without an interpreter
+  if (size != 0)
+    *size = 0;
+  return -1;
+}
+
+int OPS_GetDoubleListInput(int *size, Vector *data)
+{
+  if (size != 0)
+    *size = 0;
+  return -1;
+}
+
 
 
 extern "C" 
@@ -259,6 +259,62 @@ int OPS_GetDoubleInput(int numData, double* data)
     return 0;
 }
 
+int OPS_GetIntListInput(int* size, ID* data)
+{
+    if (currentArg >= maxArg)
+        return -1;
+
+    // the argument is a tcl list
+    int n = 0;
+    TCL_Char** items = 0;
+    if (Tcl_SplitList(theInterp, currentArgv[currentArg], &n, &items) != TCL_OK)
+        return -1;
+    currentArg++;
+
+    if (data->resize(n) < 0) {
+        Tcl_Free((char*)items);
+        return -1;
+    }
+    for (int i = 0; i < n; i++) {
+        if (Tcl_GetInt(theInterp, items[i], &(*data)(i)) != TCL_OK) {
+            Tcl_Free((char*)items);
+            return -1;
+        }
+    }
+    Tcl_Free((char*)items);
+    *size = n;
+
+    return 0;
+}
+
+int OPS_GetDoubleListInput(int* size, Vector* data)
+{
+    if (currentArg >= maxArg)
+        return -1;
+
+    // the argument is a tcl list
+    int n = 0;
+    TCL_Char** items = 0;
+    if (Tcl_SplitList(theInterp, currentArgv[currentArg], &n, &items) != TCL_OK)
+        return -1;
+    currentArg++;
+
+    if (data->resize(n) < 0) {
+        Tcl_Free((char*)items);
+        return -1;
+    }
+    for (int i = 0; i < n; i++) {
+        if (Tcl_GetDouble(theInterp, items[i], &(*data)(i)) != TCL_OK) {
+            Tcl_Free((char*)items);
+            return -1;
+        }
+    }
+    Tcl_Free((char*)items);
+    *size = n;
+
+    return 0;
+}
+
 extern "C"
 int OPS_SetDoubleOutput(int numData, double* data, bool scalar)
 {
@@ -43,19 +43,40 @@
 #include <CorotCrdTransf3d.h>
 
 // initialize static variables
-Matrix CorotCrdTransf3d::RI(3,3); 
-Matrix CorotCrdTransf3d::RJ(3,3); 
-Matrix CorotCrdTransf3d::Rbar(3,3); 
-Matrix CorotCrdTransf3d::e(3,3); 
 Matrix CorotCrdTransf3d::Tp(6,7); 
-Matrix CorotCrdTransf3d::T(7,12);
-Matrix CorotCrdTransf3d::Tlg(12,12);
-Matrix CorotCrdTransf3d::TlgInv(12, 12);
-Matrix CorotCrdTransf3d::Tbl(6,12);
-Matrix CorotCrdTransf3d::kg(12,12);
-Matrix CorotCrdTransf3d::Lr2(12,3);
-Matrix CorotCrdTransf3d::Lr3(12,3);
-Matrix CorotCrdTransf3d::A(3,3);
+thread_local Matrix CorotCrdTransf3d::Tlg(12,12);
+thread_local Matrix CorotCrdTransf3d::TlgInv(12, 12);
+thread_local Matrix CorotCrdTransf3d::Tbl(6,12);
+thread_local Matrix CorotCrdTransf3d::kg(12,12);
+
+// the element does not resist rigid body translations, so that the
+// translations of node J enter its stiffness only through uI - uJ. The
+// stiffness is formed on the 9 reduced dof [uI-uJ thetaI thetaJ] and
+// expanded into the 12 global dof once: global dof i is reduced dof
+// reducedDOF[i] with sign reducedSign[i]
+static const int reducedDOF[12] = {0, 1, 2, 3, 4, 5, 0, 1, 2, 6, 7, 8};
+static const double reducedSign[12] = {1, 1, 1, 1, 1, 1, -1, -1, -1, 1, 1, 1};
+
+// Tr = the columns of T (7x12) for the reduced dof
+static void
+getReducedTransf(const Matrix &T, Matrix &Tr)
+{
+    for (int i = 0; i < 7; i++) {
+        for (int j = 0; j < 6; j++)
+            Tr(i,j) = T(i,j);
+        for (int j = 6; j < 9; j++)
+            Tr(i,j) = T(i,j+3);
+    }
+}
+
+// kg = P^ kr P, P being the 9x12 matrix [I 0 -I 0; 0 I 0 0; 0 0 0 I]
+static void
+expandReducedStiff(const Matrix &kr, Matrix &kg)
+{
+    for (int i = 0; i < 12; i++)
+        for (int j = 0; j < 12; j++)
+            kg(i,j) = reducedSign[i]*reducedSign[j]*kr(reducedDOF[i],reducedDOF[j]);
+}
 
 void* OPS_CorotCrdTransf3d()
 {
@@ -100,6 +121,8 @@ nodeIPtr(0), nodeJPtr(0), R0(3,3), L(0), Ln(0),
 alphaIq(4), alphaJq(4), 
 alphaIqcommit(4), alphaJqcommit(4), alphaI(3), alphaJ(3),
 ulcommit(7), ul(7),  ulpr(7),
+RI(3,3), RJ(3,3), Rbar(3,3), e(3,3), T(7,12), Lr2(12,3), Lr3(12,3), A(3,3),
+isUpdated(false),
 nodeIInitialDisp(0), nodeJInitialDisp(0), initialDispChecked(false)
 {
     // check vector that defines local xz plane
@@ -182,6 +205,8 @@ nodeIPtr(0), nodeJPtr(0), R0(3,3), L(0), Ln(0),
 alphaIq(4), alphaJq(4), 
 alphaIqcommit(4), alphaJqcommit(4), alphaI(3), alphaJ(3),
 ulcommit(7), ul(7),  ulpr(7),
+RI(3,3), RJ(3,3), Rbar(3,3), e(3,3), T(7,12), Lr2(12,3), Lr3(12,3), A(3,3),
+isUpdated(false),
 nodeIInitialDisp(0), nodeJInitialDisp(0), initialDispChecked(false)
 {
     // Permutation matrix (to renumber basic dof's)
@@ -259,6 +284,7 @@ CorotCrdTransf3d::revertToLastCommit(void)
     alphaIq = alphaIqcommit;
     alphaJq = alphaJqcommit;
     
+    isUpdated = false;
     this->update();
     
     return 0;
@@ -275,6 +301,7 @@ CorotCrdTransf3d::revertToStart(void)
     alphaI.Zero();
     alphaJ.Zero();
     
+    isUpdated = false;
     this->update();
     return 0;
 }
@@ -317,9 +344,9 @@ CorotCrdTransf3d::initialize(Node *nodeIPointer, Node *nodeJPointer)
 	initialDispChecked = true;
     }
     
-    static Vector XAxis(3);
-    static Vector YAxis(3);
-    static Vector ZAxis(3);
+    static thread_local Vector XAxis(3);
+    static thread_local Vector YAxis(3);
+    static thread_local Vector ZAxis(3);
     
     // get 3by3 rotation matrix
     if ((error = this->getLocalAxes(XAxis, YAxis, ZAxis)))
@@ -335,6 +362,7 @@ CorotCrdTransf3d::initialize(Node *nodeIPointer, Node *nodeJPointer)
     
     alphaIq = this->getQuaternionFromRotMatrix(R0);    // pseudo-vector for node I
     alphaJq = this->getQuaternionFromRotMatrix(R0);    // pseudo-vector for node J
+    isUpdated = false;
     
     //opserr << "alphaIq: " << alphaIq;
     //opserr << "alphaJq: " << alphaJq;
@@ -358,8 +386,8 @@ CorotCrdTransf3d::update(void)
      // get the iterative spins dAlphaI and dAlphaJ 
      // (rotational displacement increments at both nodes)
      
-      static Vector dAlphaI(3);
-      static Vector dAlphaJ(3);
+      static thread_local Vector dAlphaI(3);
+      static thread_local Vector dAlphaJ(3);
       
        
         for (k = 0; k < 3; k++)
@@ -370,11 +398,29 @@ CorotCrdTransf3d::update(void)
     **************************************************************/
     
     // determine global displacement increments from last iteration
-    static Vector dispI(6);
-    static Vector dispJ(6);
+    static thread_local Vector dispI(6);
+    static thread_local Vector dispJ(6);
     dispI = nodeIPtr->getTrialDisp();
     dispJ = nodeJPtr->getTrialDisp();
     
+    // if the nodes have not moved since the last update the state
+    // computed then still holds, only the last iteration is now empty
+    if (isUpdated == true) {
+        for (k = 0; k < 6; k++)
+            if (dispI(k) != uTrial[k] || dispJ(k) != uTrial[k+6])
+                break;
+        if (k == 6) {
+            ulpr = ul;
+            return 0;
+        }
+    }
+    
+    isUpdated = false;
+    for (k = 0; k < 6; k++) {
+        uTrial[k] = dispI(k);
+        uTrial[k+6] = dispJ(k);
+    }
+    
     if (nodeIInitialDisp != 0) {
         for (int j=0; j<6; j++)
             dispI(j) -= nodeIInitialDisp[j];
@@ -388,8 +434,8 @@ CorotCrdTransf3d::update(void)
     // get the iterative spins dAlphaI and dAlphaJ 
     // (rotational displacement increments at both nodes)
     
-    static Vector dAlphaI(3);
-    static Vector dAlphaJ(3);
+    static thread_local Vector dAlphaI(3);
+    static thread_local Vector dAlphaJ(3);
     
     for (k = 0; k < 3; k++) {
         dAlphaI(k) = dispI(k+3) - alphaI(k);
@@ -401,8 +447,8 @@ CorotCrdTransf3d::update(void)
     /************** END OF REPLACEMENT **************************/
     
     // update the nodal triads TI and RJ using quaternions
-    static Vector dAlphaIq(4);
-    static Vector dAlphaJq(4);
+    static thread_local Vector dAlphaIq(4);
+    static thread_local Vector dAlphaJq(4);
 
     dAlphaIq = this->getQuaternionFromPseudoRotVector (dAlphaI);
     dAlphaJq = this->getQuaternionFromPseudoRotVector (dAlphaJ);
@@ -414,9 +460,9 @@ CorotCrdTransf3d::update(void)
     RJ = this->getRotationMatrixFromQuaternion (alphaJq);
 
     // compute the mean nodal triad
-    static Matrix dRgamma(3,3); 
-    static Vector gammaq(4);
-    static Vector gammaw(3);
+    static thread_local Matrix dRgamma(3,3); 
+    static thread_local Vector gammaq(4);
+    static thread_local Vector gammaw(3);
     
     dRgamma.Zero();
     
@@ -438,17 +484,17 @@ CorotCrdTransf3d::update(void)
             Rbar.addMatrixProduct(0.0, dRgamma, RI, 1.0);
             
             // compute the base vectors e1, e2, e3
-            static Vector e1(3);
-            static Vector e2(3);
-            static Vector e3(3);
+            static thread_local Vector e1(3);
+            static thread_local Vector e2(3);
+            static thread_local Vector e3(3);
             
             // relative translation displacements
-            static Vector dJI(3);    
+            static thread_local Vector dJI(3);    
             for (int kk = 0; kk < 3; kk++)
                 dJI(kk) = dispJ(kk) - dispI(kk);
             
             // element projection
-            static Vector xJI(3);
+            static thread_local Vector xJI(3);
             xJI = nodeJPtr->getCrds() - nodeIPtr->getCrds();
             
             if (nodeIInitialDisp != 0) {
@@ -463,7 +509,7 @@ CorotCrdTransf3d::update(void)
                 xJI(2) += nodeJInitialDisp[2];
             }
             
-            static Vector dx(3);
+            static thread_local Vector dx(3);
             // dx = xJI + dJI;  
             dx = xJI;
             dx.addVector (1.0, dJI, 1.0);
@@ -483,9 +529,9 @@ CorotCrdTransf3d::update(void)
             
             // 'rotate' the mean rotation matrix Rbar on to e1 to 
             // obtain e2 and e3 (using the 'mid-point' procedure)
-            static Vector r1(3);
-            static Vector r2(3);
-            static Vector r3(3);
+            static thread_local Vector r1(3);
+            static thread_local Vector r2(3);
+            static thread_local Vector r3(3);
             
             for (k = 0; k < 3; k ++)
             {
@@ -497,7 +543,7 @@ CorotCrdTransf3d::update(void)
             //    e2 = r2 - (e1 + r1)*((r2^ e1)*0.5);
             // e3 = r3 - (e1 + r1)*((r3^ e1)*0.5);
             
-            static Vector tmp(3);
+            static thread_local Vector tmp(3);
             tmp = e1;
             tmp += r1;
             
@@ -513,8 +559,8 @@ CorotCrdTransf3d::update(void)
             e3.addVector(-1.0,  r3, 1.0);
             
             // compute the basic rotations
-            static Vector rI1(3), rI2(3), rI3(3);
-            static Vector rJ1(3), rJ2(3), rJ3(3);
+            static thread_local Vector rI1(3), rI2(3), rI3(3);
+            static thread_local Vector rJ1(3), rJ2(3), rJ3(3);
             
             for (k = 0; k < 3; k ++)
             {
@@ -548,6 +594,8 @@ CorotCrdTransf3d::update(void)
             // compute the transformation matrix
             this->compTransfMatrixBasicGlobal();
             
+            isUpdated = true;
+            
             return 0;
 }
 
@@ -559,10 +607,10 @@ CorotCrdTransf3d::compTransfMatrixBasicGlobal(void)
     int i, j, k;
     
     //opserr << "comprTransfMatrixBasicGlobal: *****************************\n";
-    static Vector r1(3), r2(3), r3(3);
-    static Vector e1(3), e2(3), e3(3);
-    static Vector rI1(3), rI2(3), rI3(3);
-    static Vector rJ1(3), rJ2(3), rJ3(3);
+    static thread_local Vector r1(3), r2(3), r3(3);
+    static thread_local Vector e1(3), e2(3), e3(3);
+    static thread_local Vector rI1(3), rI2(3), rI3(3);
+    static thread_local Vector rJ1(3), rJ2(3), rJ3(3);
     
     for (k = 0; k < 3; k ++)
     {
@@ -585,7 +633,7 @@ CorotCrdTransf3d::compTransfMatrixBasicGlobal(void)
     
     // compute the transformation matrix from the basic to the
     // global system
-    static Matrix I(3,3);
+    static thread_local Matrix I(3,3);
     
     //   A = (1/Ln)*(I - e1*e1');
     for (i = 0; i < 3; i++)
@@ -598,8 +646,8 @@ CorotCrdTransf3d::compTransfMatrixBasicGlobal(void)
         Lr2 = this->getLMatrix (r2);
         Lr3 = this->getLMatrix (r3);
         
-        static Matrix Sr1(3,3), Sr2(3,3), Sr3(3,3);
-        static Vector Se(3), At(3);
+        static thread_local Matrix Sr1(3,3), Sr2(3,3), Sr3(3,3);
+        static thread_local Vector Se(3), At(3);
         
         //   T1 = [      O', (-S(rI3)*e2 + S(rI2)*e3)',        O', O']';
         //   T2 = [(A*rI2)', (-S(rI2)*e1 + S(rI1)*e2)', -(A*rI2)', O']';
@@ -692,7 +740,7 @@ CorotCrdTransf3d::compTransfMatrixBasicGlobal(void)
         }
         
         // setup tranformation matrix
-        static Vector Lr(12);
+        static thread_local Vector Lr(12);
         
         // T(:,1) += Lr3*rI2 - Lr2*rI3;
         // T(:,2) +=           Lr2*rI1;
@@ -759,10 +807,10 @@ CorotCrdTransf3d::compTransfMatrixBasicGlobalNew(void)
     int i, j, k;
     
     //opserr << "comprTransfMatrixBasicGlobal: *****************************\n";
-    static Vector r1(3), r2(3), r3(3);
-    static Vector e1(3), e2(3), e3(3);
-    static Vector rI1(3), rI2(3), rI3(3);
-    static Vector rJ1(3), rJ2(3), rJ3(3);
+    static thread_local Vector r1(3), r2(3), r3(3);
+    static thread_local Vector e1(3), e2(3), e3(3);
+    static thread_local Vector rI1(3), rI2(3), rI3(3);
+    static thread_local Vector rJ1(3), rJ2(3), rJ3(3);
     
     for (k = 0; k < 3; k ++)
     {
@@ -785,7 +833,7 @@ CorotCrdTransf3d::compTransfMatrixBasicGlobalNew(void)
     
     // compute the transformation matrix from the basic to the
     // global system
-    static Matrix I(3,3);
+    static thread_local Matrix I(3,3);
     
     //   A = (1/Ln)*(I - e1*e1');
     for (i = 0; i < 3; i++)
@@ -818,8 +866,8 @@ CorotCrdTransf3d::compTransfMatrixBasicGlobalNew(void)
         // opserr << "Lr2: " << Lr2;
         // opserr << "Lr3: " << Lr3;
         
-        static Matrix Sr1(3,3), Sr2(3,3), Sr3(3,3);
-        static Vector Se(3), At(3);
+        static thread_local Matrix Sr1(3,3), Sr2(3,3), Sr3(3,3);
+        static thread_local Vector Se(3), At(3);
         
         
         // O = zeros(3,1);
@@ -830,12 +878,12 @@ CorotCrdTransf3d::compTransfMatrixBasicGlobalNew(void)
         // hJ2 = [(A*rJ3)', O', -(A*rJ3)', (-S(rJ3)*e1 + S(rJ1)*e3)']';
         // hJ3 = [(A*rJ2)', O', -(A*rJ2)', (-S(rJ2)*e1 + S(rJ1)*e2)']';
         
-        static Vector hI1(12);
-        static Vector hI2(12);
-        static Vector hI3(12);
-        static Vector hJ1(12);
-        static Vector hJ2(12);
-        static Vector hJ3(12);
+        static thread_local Vector hI1(12);
+        static thread_local Vector hI2(12);
+        static thread_local Vector hI3(12);
+        static thread_local Vector hJ1(12);
+        static thread_local Vector hJ2(12);
+        static thread_local Vector hJ3(12);
         
         Sr1 = this->getSkewSymMatrix(rI1);
         Sr2 = this->getSkewSymMatrix(rI2);
@@ -928,7 +976,7 @@ CorotCrdTransf3d::compTransfMatrixBasicGlobalNew(void)
         
         // T = F'
         T.Zero();
-        static Vector Lr(12);
+        static thread_local Vector Lr(12);
         
         // f1 =  [-e1' O' e1' O'];
         for (i=0; i<3; i++) {
@@ -936,8 +984,8 @@ CorotCrdTransf3d::compTransfMatrixBasicGlobalNew(void)
             T(i+3,0) = e1(i);
         }
         
-        static Vector thetaI(3);
-        static Vector thetaJ(3);
+        static thread_local Vector thetaI(3);
+        static thread_local Vector thetaJ(3);
         
         
         thetaI(0) = ul(0);
@@ -1025,7 +1073,7 @@ CorotCrdTransf3d::compTransfMatrixBasicLocal(Matrix &Tbl)
     Tbl.Zero();
 
     // first get transformation matrix from basic to global 
-    static Matrix Tbg(6, 12);
+    static thread_local Matrix Tbg(6, 12);
     Tbg.addMatrixProduct(0.0, Tp, T, 1.0);
 
     // get inverse of transformation matrix from local to global
@@ -1041,7 +1089,7 @@ CorotCrdTransf3d::compTransfMatrixBasicLocal(Matrix &Tbl)
 const Vector &
 CorotCrdTransf3d::getBasicTrialDisp(void)
 {
-    static Vector ub(6);
+    static thread_local Vector ub(6);
     
     // use transformation matrix to renumber the degrees of freedom
     ub.addMatrixVector(0.0, Tp, ul, 1.0);
@@ -1053,8 +1101,8 @@ CorotCrdTransf3d::getBasicTrialDisp(void)
 const Vector &
 CorotCrdTransf3d::getBasicIncrDeltaDisp(void)
 {
-    static Vector dub(6);
-    static Vector dul(7);
+    static thread_local Vector dub(6);
+    static thread_local Vector dul(7);
     
     // dul = ul - ulpr;
     dul = ul;
@@ -1070,8 +1118,8 @@ CorotCrdTransf3d::getBasicIncrDeltaDisp(void)
 const Vector &
 CorotCrdTransf3d::getBasicIncrDisp(void)
 {
-    static Vector Dub(6);
-    static Vector Dul(7);
+    static thread_local Vector Dub(6);
+    static thread_local Vector Dul(7);
     
     // Dul = ul - ulcommit;
     Dul = ul;
@@ -1090,7 +1138,7 @@ CorotCrdTransf3d::getBasicTrialVel(void)
     opserr << "WARNING CorotCrdTransf3d::getBasicTrialVel()"
         << " - has not been implemented yet. Returning zeros." << endln;
     
-    static Vector dummy(6);
+    static thread_local Vector dummy(6);
     return dummy;
 }
 
@@ -1101,7 +1149,7 @@ CorotCrdTransf3d::getBasicTrialAccel(void)
     opserr << "WARNING CorotCrdTransf3d::getBasicTrialAccel()"
         << " - has not been implemented yet. Returning zeros." << endln;
     
-    static Vector dummy(6);
+    static thread_local Vector dummy(6);
     return dummy;
 }
 
@@ -1111,13 +1159,13 @@ CorotCrdTransf3d::getGlobalResistingForce(const Vector &pb, const Vector &p0)
 {
     this->update();
     
-    static Vector pg(12);
+    static thread_local Vector pg(12);
     pg.Zero();
     
     // if there are no element loads present
     if (p0 == 0.0) {
         // transform resisting forces from the basic system to local coordinates
-        static Vector pl(7);
+        static thread_local Vector pl(7);
         pl.addMatrixTransposeVector(0.0, Tp, pb, 1.0);    // pl = Tp ^ pb;
 
         // transform resisting forces from local to global coordinates
@@ -1130,7 +1178,7 @@ CorotCrdTransf3d::getGlobalResistingForce(const Vector &pb, const Vector &p0)
         // ===========================================
         /* transform resisting forces from the basic system to local coordinates
         this->compTransfMatrixBasicLocal(Tbl);
-        static Vector pl(12);
+        static thread_local Vector pl(12);
         pl.addMatrixTransposeVector(0.0, Tbl, pb, 1.0);    // pl = Tbl ^ pb;
 
         // add end forces due to element p0 loads
@@ -1147,7 +1195,7 @@ CorotCrdTransf3d::getGlobalResistingForce(const Vector &pb, const Vector &p0)
         // FASTER!!!! TRANSFORM REACTIONS AND ADD AT END
         // =============================================
         // transform resisting forces from the basic system to local coordinates
-        static Vector pl(7);
+        static thread_local Vector pl(7);
         pl.addMatrixTransposeVector(0.0, Tp, pb, 1.0);    // pl = Tp ^ pb;
 
         // transform resisting forces from local to global coordinates
@@ -1155,16 +1203,11 @@ CorotCrdTransf3d::getGlobalResistingForce(const Vector &pb, const Vector &p0)
 
         // add end forces due to element p0 loads
         // assuming member loads are in local system
-        static Vector pl0(12), pg0(12);
-        pl0.Zero();
-        pl0(0) = p0(0);
-        pl0(1) = p0(1);
-        pl0(7) = p0(2);
-        pl0(2) = p0(3);
-        pl0(8) = p0(4);
-        this->compTransfMatrixLocalGlobal(Tlg);
-        pg0.addMatrixTransposeVector(0.0, Tlg, pl0, 1.0);
-        pg.addVector(1.0, pg0, 1.0);
+        // pl0(0:2) = p0(0,1,3), pl0(7:8) = p0(2,4), pg += Tlg ^ pl0
+        for (int i = 0; i < 3; i++) {
+            pg(i)   += R0(i,0)*p0(0) + R0(i,1)*p0(1) + R0(i,2)*p0(3);
+            pg(i+6) += R0(i,1)*p0(2) + R0(i,2)*p0(4);
+        }
     }
     
     return pg;
@@ -1178,32 +1221,35 @@ CorotCrdTransf3d::getGlobalStiffMatrix(const Matrix &kb, const Vector &pb)
     
     int i, j, k;   
     // transform tangent stiffness matrix from the basic system to local coordinates
-    static Matrix kl(7,7);
+    static thread_local Matrix kl(7,7);
     kl.addMatrixTripleProduct(0.0, Tp, kb, 1.0);      // kl = Tp ^ kb * Tp;
 
     //    opserr << "kb: " << kb;
     //    opserr << "Tp: " << Tp;
     
     // transform resisting forces from the basic system to local coordinates
-    static Vector pl(7);
+    static thread_local Vector pl(7);
     pl.addMatrixTransposeVector(0.0, Tp, pb, 1.0);    // pl = Tp ^ pb;
     
-    // transform tangent  stiffness matrix from local to global coordinates
-    //static Matrix kg(12,12);
+    // the stiffness is formed on the reduced dof in kr and expanded
+    // into kg at the end (see expandReducedStiff() above)
+    static thread_local Matrix Tr(7,9);
+    static thread_local Matrix kr(9,9);
+    getReducedTransf(T, Tr);
     
     // compute the tangent stiffness matrix in global coordinates
-    kg.addMatrixTripleProduct(0.0, T, kl, 1.0);
+    kr.addMatrixTripleProduct(0.0, Tr, kl, 1.0);
     
-    static Vector m(6);
+    static thread_local Vector m(6);
     for (i = 0; i < 6; i++)
         m(i) = pl(i)/(2*cos(ul(i)));
     
     // compute the basic rotations
     
-    static Vector e1(3), e2(3), e3(3);
-    static Vector r1(3), r2(3), r3(3);
-    static Vector rI1(3), rI2(3), rI3(3);
-    static Vector rJ1(3), rJ2(3), rJ3(3);
+    static thread_local Vector e1(3), e2(3), e3(3);
+    static thread_local Vector r1(3), r2(3), r3(3);
+    static thread_local Vector rI1(3), rI2(3), rI3(3);
+    static thread_local Vector rJ1(3), rJ2(3), rJ3(3);
     
     for (k = 0; k < 3; k ++)
     {
@@ -1230,9 +1276,9 @@ CorotCrdTransf3d::getGlobalStiffMatrix(const Matrix &kb, const Vector &pb)
     //        m(5)*ks2r2u1 + m(6)*ks2r3u1 + ...
     //        ks3 + ks3' + ks4 + ks5;
     
-    static Matrix Se1(3,3), Se2(3,3), Se3(3,3);
-    static Matrix SrI1(3,3), SrI2(3,3), SrI3(3,3);
-    static Matrix SrJ1(3,3), SrJ2(3,3), SrJ3(3,3);
+    static thread_local Matrix Se1(3,3), Se2(3,3), Se3(3,3);
+    static thread_local Matrix SrI1(3,3), SrI2(3,3), SrI3(3,3);
+    static thread_local Matrix SrJ1(3,3), SrJ2(3,3), SrJ3(3,3);
     
     Se1 = this->getSkewSymMatrix(e1);
     Se2 = this->getSkewSymMatrix(e2);
@@ -1256,10 +1302,7 @@ CorotCrdTransf3d::getGlobalStiffMatrix(const Matrix &kb, const Vector &pb)
     
     double factor;
     
-    kg.Assemble(A, 0, 0,  pl(6));
-    kg.Assemble(A, 0, 6, -pl(6));
-    kg.Assemble(A, 6, 0, -pl(6));
-    kg.Assemble(A, 6, 6,  pl(6));
+    kr.Assemble(A, 0, 0,  pl(6));
     
     //opserr << "kg += ksigma1: " << kg;
     
@@ -1272,34 +1315,42 @@ CorotCrdTransf3d::getGlobalStiffMatrix(const Matrix &kb, const Vector &pb)
     
     //     ks3 = [o kbar2 o kbar4];
     
-    static Matrix Sm(3,3);
-    static Matrix kbar(12,3);
+    static thread_local Matrix Sm(3,3);
+    static thread_local Matrix kbar(9,3);
+    static thread_local Matrix Lr2r(9,3), Lr3r(9,3);
+    
+    // rows of Lr2 and Lr3 for the reduced dof
+    for (i = 0; i < 9; i++)
+        for (k = 0; k < 3; k++) {
+            Lr2r(i,k) = Lr2(i < 6 ? i : i+3, k);
+            Lr3r(i,k) = Lr3(i < 6 ? i : i+3, k);
+        }
     
     Sm.addMatrix(0.0, SrI3,  m(3));
     Sm.addMatrix(1.0, SrI1,  m(1));
     
-    kbar.addMatrixProduct(0.0, Lr2, Sm, -1.0);
+    kbar.addMatrixProduct(0.0, Lr2r, Sm, -1.0);
     
     Sm.addMatrix(0.0, SrI2,  m(3));
     Sm.addMatrix(1.0, SrI1, -m(2));
     
-    kbar.addMatrixProduct(1.0, Lr3, Sm,  1.0);
+    kbar.addMatrixProduct(1.0, Lr3r, Sm,  1.0);
     
-    kg.Assemble(kbar, 0, 3, 1.0);
-    kg.AssembleTranspose(kbar, 3, 0, 1.0);
+    kr.Assemble(kbar, 0, 3, 1.0);
+    kr.AssembleTranspose(kbar, 3, 0, 1.0);
     
     Sm.addMatrix(0.0, SrJ3,  m(3));
     Sm.addMatrix(1.0, SrJ1, -m(4));
     
-    kbar.addMatrixProduct(0.0, Lr2, Sm, 1.0);
+    kbar.addMatrixProduct(0.0, Lr2r, Sm, 1.0);
     
     Sm.addMatrix(0.0, SrJ2, m(3));
     Sm.addMatrix(1.0, SrJ1, m(5));
     
-    kbar.addMatrixProduct(1.0, Lr3, Sm,  -1.0);
+    kbar.addMatrixProduct(1.0, Lr3r, Sm,  -1.0);
     
-    kg.Assemble(kbar, 0, 9, 1.0);
-    kg.AssembleTranspose(kbar, 9, 0, 1.0);
+    kr.Assemble(kbar, 0, 6, 1.0);
+    kr.AssembleTranspose(kbar, 6, 0, 1.0);
     
     //opserr << "kg += ksigma3: " << kg;
     
@@ -1317,7 +1368,7 @@ CorotCrdTransf3d::getGlobalStiffMatrix(const Matrix &kb, const Vector &pb)
     //           O    O     O    O;
     //           O    O     O  Ks4_44];
     
-    static Matrix ks33(3,3);
+    static thread_local Matrix ks33(3,3);
     
     ks33.addMatrixProduct(0.0, Se2, SrI3,  m(3));
     ks33.addMatrixProduct(1.0, Se3, SrI2, -m(3));
@@ -1328,7 +1379,7 @@ CorotCrdTransf3d::getGlobalStiffMatrix(const Matrix &kb, const Vector &pb)
     ks33.addMatrixProduct(1.0, Se3, SrI1,  m(2));
     ks33.addMatrixProduct(1.0, Se1, SrI3, -m(2));
     
-    kg.Assemble(ks33, 3, 3, 1.0);
+    kr.Assemble(ks33, 3, 3, 1.0);
     
     ks33.addMatrixProduct(0.0, Se2, SrJ3, -m(3));
     ks33.addMatrixProduct(1.0, Se3, SrJ2,  m(3));
@@ -1339,7 +1390,7 @@ CorotCrdTransf3d::getGlobalStiffMatrix(const Matrix &kb, const Vector &pb)
     ks33.addMatrixProduct(1.0, Se3, SrJ1,  m(5));
     ks33.addMatrixProduct(1.0, Se1, SrJ3, -m(5));
     
-    kg.Assemble(ks33, 9, 9, 1.0);
+    kr.Assemble(ks33, 6, 6, 1.0);
     
     //opserr << "kg += ksigma4: " << kg;
     
@@ -1351,7 +1402,7 @@ CorotCrdTransf3d::getGlobalStiffMatrix(const Matrix &kb, const Vector &pb)
     //          Ks5_14t     O   -Ks5_14t   O];
     
     // v = (1/Ln)*(m(2)*rI2 + m(3)*rI3 + m(5)*rJ2 + m(6)*rJ3);
-    static Vector v(3);
+    static thread_local Vector v(3);
     v.addVector (0.0, rI2, m(1));
     v.addVector (1.0, rI3, m(2));
     v.addVector (1.0, rJ2, m(4));
@@ -1360,7 +1411,7 @@ CorotCrdTransf3d::getGlobalStiffMatrix(const Matrix &kb, const Vector &pb)
     v /= Ln;
     
     //Ks5_11 = A*v*e1' + e1*v'*A + (e1'*v)*A;
-    static Matrix m33(3,3);
+    static thread_local Matrix m33(3,3);
     double  e1tv = 0;   // dot product e1. v
     
     for (i = 0; i < 3; i++)
@@ -1380,55 +1431,46 @@ CorotCrdTransf3d::getGlobalStiffMatrix(const Matrix &kb, const Vector &pb)
             
             ks33.addMatrixProduct (1.0, m33, A, 1.0);
             
-            kg.Assemble(ks33, 0, 0,  1.0);
-            kg.Assemble(ks33, 0, 6, -1.0);
-            kg.Assemble(ks33, 6, 0, -1.0);
-            kg.Assemble(ks33, 6, 6,  1.0);
+            kr.Assemble(ks33, 0, 0,  1.0);
             
             //Ks5_12 = -(m(2)*A*S(rI2) + m(3)*A*S(rI3));
             
             ks33.addMatrixProduct(0.0, A, SrI2, -m(1));
             ks33.addMatrixProduct(1.0, A, SrI3, -m(2));
             
-            kg.Assemble(ks33, 0, 3,  1.0);
-            kg.Assemble(ks33, 6, 3, -1.0);
-            
-            kg.AssembleTranspose(ks33, 3, 0,  1.0);
-            kg.AssembleTranspose(ks33, 3, 6, -1.0);
+            kr.Assemble(ks33, 0, 3,  1.0);
+            kr.AssembleTranspose(ks33, 3, 0,  1.0);
             
             //  Ks5_14 = -(m(5)*A*S(rJ2) + m(6)*A*S(rJ3));
             
             ks33.addMatrixProduct(0.0, A, SrJ2, -m(4));
             ks33.addMatrixProduct(1.0, A, SrJ3, -m(5));
             
-            kg.Assemble(ks33, 0, 9,  1.0);
-            kg.Assemble(ks33, 6, 9, -1.0);
-            
-            kg.AssembleTranspose(ks33, 9, 0,  1.0);
-            kg.AssembleTranspose(ks33, 9, 6, -1.0);
+            kr.Assemble(ks33, 0, 6,  1.0);
+            kr.AssembleTranspose(ks33, 6, 0,  1.0);
             
             //opserr << "kg += ksigma5: " << kg;
             
             // Ksigma -------------------------------
-            static Vector rm(3);
+            static thread_local Vector rm(3);
             
             rm = rI3;
             rm.addVector (1.0, rJ3, -1.0); 
             //opserr << "ks2(r2,rI3-rJ3):\n "; 
-            kg.addMatrix (1.0, this->getKs2Matrix(r2, rm), m(3));
+            kr.addMatrix (1.0, this->getKs2Matrix(r2, rm), m(3));
             
             rm = rJ2;
             rm.addVector (1.0, rI2, -1.0); 
             //opserr << "ks2(r3,rJ2-rI2):\n "; 
-            kg.addMatrix (1.0, this->getKs2Matrix(r3, rm), m(3));
+            kr.addMatrix (1.0, this->getKs2Matrix(r3, rm), m(3));
             //opserr << "ks2(r2,rI1):\n "; 
-            kg.addMatrix (1.0, this->getKs2Matrix(r2, rI1), m(1));
+            kr.addMatrix (1.0, this->getKs2Matrix(r2, rI1), m(1));
             //opserr << "ks2(r3,rI1):\n "; 
-            kg.addMatrix (1.0, this->getKs2Matrix(r3, rI1), m(2));
+            kr.addMatrix (1.0, this->getKs2Matrix(r3, rI1), m(2));
             //opserr << "ks2(r2,rJ1):\n "; 
-            kg.addMatrix (1.0, this->getKs2Matrix(r2, rJ1), m(4));
+            kr.addMatrix (1.0, this->getKs2Matrix(r2, rJ1), m(4));
             //opserr << "ks2(r3,rJ1):\n "; 
-            kg.addMatrix (1.0, this->getKs2Matrix(r3, rJ1), m(5));
+            kr.addMatrix (1.0, this->getKs2Matrix(r3, rJ1), m(5));
             
             //opserr << "kg += ksigma2: " << kg;
             
@@ -1437,11 +1479,13 @@ CorotCrdTransf3d::getGlobalStiffMatrix(const Matrix &kb, const Vector &pb)
             for (k = 0; k < 6; k++)
             {
                 factor = pl(k) * tan(ul(k));
-                for (i = 0; i < 12; i++)
-                    for (j = 0; j < 12; j++)
-                        kg(i,j) += T(k,i) * factor * T(k,j);
+                for (i = 0; i < 9; i++)
+                    for (j = 0; j < 9; j++)
+                        kr(i,j) += Tr(k,i) * factor * Tr(k,j);
             }
             
+            expandReducedStiff(kr, kg);
+            
 	    //            opserr << "COROATIONAL 3d: kg final: " << kg;
             
             return kg;
@@ -1451,15 +1495,21 @@ CorotCrdTransf3d::getGlobalStiffMatrix(const Matrix &kb, const Vector &pb)
 const Matrix &
 CorotCrdTransf3d::getInitialGlobalStiffMatrix(const Matrix &kb)
 {
+    // T is that of the element only once it has been updated
+    if (isUpdated == false)
+        this->update();
+    
     // transform tangent stiffness matrix from the basic system to local coordinates
-    static Matrix kl(7,7);
+    static thread_local Matrix kl(7,7);
     kl.addMatrixTripleProduct(0.0, Tp, kb, 1.0);      // kl = Tp ^ kb * Tp;
     
-    // transform tangent  stiffness matrix from local to global coordinates
-    //static Matrix kg(12,12);
-    
-    // compute the tangent stiffness matrix in global coordinates
-    kg.addMatrixTripleProduct(0.0, T, kl, 1.0);
+    // compute the tangent stiffness matrix on the reduced dof and
+    // expand it into global coordinates
+    static thread_local Matrix Tr(7,9);
+    static thread_local Matrix kr(9,9);
+    getReducedTransf(T, Tr);
+    kr.addMatrixTripleProduct(0.0, Tr, kl, 1.0);
+    expandReducedStiff(kr, kg);
     
     return kg;
 }
@@ -1470,7 +1520,7 @@ CorotCrdTransf3d::getLocalAxes(Vector &XAxis, Vector &YAxis, Vector &ZAxis)
 {
     // element projection
     
-    static Vector dx(3);
+    static thread_local Vector dx(3);
     
     dx = (nodeJPtr->getCrds() + nodeJOffset) - (nodeIPtr->getCrds() + nodeIOffset);  
     if (nodeIInitialDisp != 0) {
@@ -1502,7 +1552,7 @@ CorotCrdTransf3d::getLocalAxes(Vector &XAxis, Vector &YAxis, Vector &ZAxis)
     XAxis(0) = xAxis(0);    XAxis(1) = xAxis(1);    XAxis(2) = xAxis(2);
     
     // calculate the cross-product y = v * x   
-    static Vector yAxis(3), zAxis(3);
+    static thread_local Vector yAxis(3), zAxis(3);
     
     yAxis(0) = vAxis(1)*xAxis(2) - vAxis(2)*xAxis(1);
     yAxis(1) = vAxis(2)*xAxis(0) - vAxis(0)*xAxis(2);
@@ -1558,7 +1608,7 @@ CorotCrdTransf3d::getQuaternionFromRotMatrix(const Matrix &R) const
     int i, j, k;
     double trR;              // trace of R
     double a    ;
-    static Vector q(4);      // normalized quaternion
+    static thread_local Vector q(4);      // normalized quaternion
     
     trR = R(0,0) + R(1,1) + R(2,2);    
     
@@ -1603,7 +1653,7 @@ CorotCrdTransf3d::getQuaternionFromPseudoRotVector(const Vector  &theta) const
 {
     double t;                // norm of the pseudo rotation vector
     double factor;
-    static Vector q(4);      // normalized quaternion
+    static thread_local Vector q(4);      // normalized quaternion
     
     t = theta.Norm();
     
@@ -1626,10 +1676,10 @@ const Vector &
 CorotCrdTransf3d::quaternionProduct(const Vector &q1, const Vector &q2) const
 {
     
-    static Vector q12(4);
+    static thread_local Vector q12(4);
     int i;
     double q1Tq2= 0;  // dot product
-    static Vector q1xq2(3);     // cross product
+    static thread_local Vector q1xq2(3);     // cross product
     
     // calculate the dot product q1.q2
     for (i = 0; i < 3; i++)       // NOTE i <3, not i<4
@@ -1655,10 +1705,10 @@ CorotCrdTransf3d::getRotationMatrixFromQuaternion(const Vector &q) const
 { 
     int i, j;
     double factor;
-    static Matrix I(3,3); // identity matrix
-    static Matrix qqT(3,3); 
-    static Matrix S(3,3);
-    static Matrix R(3,3);
+    static thread_local Matrix I(3,3); // identity matrix
+    static thread_local Matrix qqT(3,3); 
+    static thread_local Matrix S(3,3);
+    static thread_local Matrix R(3,3);
     
     // R = (q0^2 - q' * q) * I + 2 * q * q' + 2*q0*S(q);
     
@@ -1687,7 +1737,7 @@ CorotCrdTransf3d::getRotationMatrixFromQuaternion(const Vector &q) const
 const Vector &
 CorotCrdTransf3d::getTangScaledPseudoVectorFromQuaternion(const Vector &q) const
 { 
-    static Vector w(3);
+    static thread_local Vector w(3);
     
     for (int i = 0; i < 3; i++)
         w(i) = 2.0 * q(i)/q(3);
@@ -1700,9 +1750,9 @@ const Matrix &
 CorotCrdTransf3d::getRotMatrixFromTangScaledPseudoVector(const Vector &w) const
 { 
     // Rotation matrix in terms of the tangent-scaled pseudo-vector
-    static Matrix S(3,3);
-    static Matrix S2(3,3);
-    static Matrix R(3,3);
+    static thread_local Matrix S(3,3);
+    static thread_local Matrix S2(3,3);
+    static thread_local Matrix R(3,3);
     double normw2;
     
     S = this->getSkewSymMatrix(w);
@@ -1728,7 +1778,7 @@ CorotCrdTransf3d::getRotMatrixFromTangScaledPseudoVector(const Vector &w) const
 const Matrix &
 CorotCrdTransf3d::getSkewSymMatrix(const Vector &theta) const
 {
-    static Matrix S(3,3);
+    static thread_local Matrix S(3,3);
     
     //  St = [   0       -theta(2)  theta(1);
     //         theta(2)     0      -theta(0);
@@ -1756,14 +1806,14 @@ CorotCrdTransf3d::getSkewSymMatrix(const Vector &theta) const
 const Matrix &
 CorotCrdTransf3d::getLMatrix(const Vector &ri) const
 {
-    static Matrix L1(3,3), L2(3,3);
-    static Vector r1(3), e1(3);
+    static thread_local Matrix L1(3,3), L2(3,3);
+    static thread_local Vector r1(3), e1(3);
     double rie1, e1r1k;
-    static Matrix rie1r1(3,3);
-    static Matrix e1e1r1(3,3);
-    static Matrix Sri(3,3);
-    static Matrix Sr1(3,3);
-    static Matrix L(12,3);
+    static thread_local Matrix rie1r1(3,3);
+    static thread_local Matrix e1e1r1(3,3);
+    static thread_local Matrix Sri(3,3);
+    static thread_local Matrix Sr1(3,3);
+    static thread_local Matrix L(12,3);
     
     int j, k;
     
@@ -1828,8 +1878,8 @@ CorotCrdTransf3d::getLMatrix(const Vector &ri) const
 const Matrix &
 CorotCrdTransf3d::getKs2Matrix(const Vector &ri, const Vector &z) const
 {
-    static Matrix ks2(12,12);
-    static Vector e1(3), r1(3);
+    static thread_local Matrix ks2(9,9);
+    static thread_local Vector e1(3), r1(3);
     
     //opserr << "\ngetKs2Matrix:\n";
     //opserr << "ri: " << ri;
@@ -1841,6 +1891,12 @@ CorotCrdTransf3d::getKs2Matrix(const Vector &ri, const Vector &z) const
     //             -K11  -K12  K11  -K12;
     //              K12t  K22 -K12t  K22];
     
+    // returned on the reduced dof of getGlobalStiffMatrix():
+    //
+    //  Ksigma2r = [ K11   K12  K12;
+    //               K12t  K22  K22;
+    //               K12t  K22  K22];
+    
     // U = (-1/2)*A*z*ri'*A + ri'*e1*A*z*e1'/(2*Ln)+...
     //      z'*(e1+r1)*A*ri*e1'/(2*Ln);
     
@@ -1858,9 +1914,9 @@ CorotCrdTransf3d::getKs2Matrix(const Vector &ri, const Vector &z) const
         ztr1  += z(i)*r1(i);
     }
     
-    static Matrix zrit(3,3), ze1t(3,3);
-    static Matrix rizt(3,3), r1e1t(3,3), rie1t(3,3);
-    static Matrix e1zt(3,3);
+    static thread_local Matrix zrit(3,3), ze1t(3,3);
+    static thread_local Matrix rizt(3,3), r1e1t(3,3), rie1t(3,3);
+    static thread_local Matrix e1zt(3,3);
     
     for (i = 0; i < 3; i++)
         for (j = 0; j < 3; j++)
@@ -1873,7 +1929,7 @@ CorotCrdTransf3d::getKs2Matrix(const Vector &ri, const Vector &z) const
             rie1t(i,j) = ri(i)*e1(j);
         }
         
-        static Matrix U(3,3);
+        static thread_local Matrix U(3,3);
         //opserr << " rite1: "<< rite1;
         //opserr << " zte1: "<< zte1;
         //opserr << " ztr1: "<< ztr1;
@@ -1893,7 +1949,7 @@ CorotCrdTransf3d::getKs2Matrix(const Vector &ri, const Vector &z) const
         U.addMatrixProduct (1.0, A, rie1t, (zte1 + ztr1)/(2*Ln));
         
         //opserr << "U: " << U;
-        static Matrix ks(3,3);
+        static thread_local Matrix ks(3,3);
         
         //K11 = U + U' + ri'*e1*(2*(e1'*z)+z'*r1)*A/(2*Ln);
         
@@ -1911,11 +1967,8 @@ CorotCrdTransf3d::getKs2Matrix(const Vector &ri, const Vector &z) const
             ks2.Zero();
             
             ks2.Assemble(ks, 0, 0,  1.0);
-            ks2.Assemble(ks, 0, 6, -1.0);
-            ks2.Assemble(ks, 6, 0, -1.0);
-            ks2.Assemble(ks, 6, 6,  1.0);
             
-            static Matrix Sri(3,3), Sr1(3,3), Sz(3,3), Se1(3,3);
+            static thread_local Matrix Sri(3,3), Sr1(3,3), Sz(3,3), Se1(3,3);
             
             Sri = this->getSkewSymMatrix(ri);  
             Sr1 = this->getSkewSymMatrix(r1);
@@ -1924,7 +1977,7 @@ CorotCrdTransf3d::getKs2Matrix(const Vector &ri, const Vector &z) const
             
             //K12 = (1/4)*(-A*z*e1'*Sri - A*ri*z'*Sr1 - z'*(e1+r1)*A*Sri);
             
-            static Matrix m1(3,3);
+            static thread_local Matrix m1(3,3);
             
             m1.addMatrixProduct(0.0, A, ze1t, -1.0);
             ks.addMatrixProduct(0.0, m1, Sri, 0.25);
@@ -1937,14 +1990,10 @@ CorotCrdTransf3d::getKs2Matrix(const Vector &ri, const Vector &z) const
             //opserr << "Ks2_12: " << ks;
             
             ks2.Assemble(ks, 0, 3,  1.0);
-            ks2.Assemble(ks, 0, 9,  1.0);
-            ks2.Assemble(ks, 6, 3, -1.0);
-            ks2.Assemble(ks, 6, 9, -1.0);
+            ks2.Assemble(ks, 0, 6,  1.0);
             
             ks2.AssembleTranspose(ks, 3, 0,  1.0);
-            ks2.AssembleTranspose(ks, 3, 6, -1.0);
-            ks2.AssembleTranspose(ks, 9, 0,  1.0);
-            ks2.AssembleTranspose(ks, 9, 6, -1.0);
+            ks2.AssembleTranspose(ks, 6, 0,  1.0);
             
             //K22 = (1/8)*((-ri'*e1)*Sz*Sr1 + Sr1*z*e1'*Sri + ...
             //      Sri*e1*z'*Sr1 - (e1+r1)'*z*S(e1)*Sri + 2*Sz*Sri);
@@ -1968,9 +2017,9 @@ CorotCrdTransf3d::getKs2Matrix(const Vector &ri, const Vector &z) const
             //              K12t  K22 -K12t  K22];
             
             ks2.Assemble(ks, 3, 3, 1.0);
-            ks2.Assemble(ks, 3, 9, 1.0);
-            ks2.Assemble(ks, 9, 3, 1.0);
-            ks2.Assemble(ks, 9, 9, 1.0);
+            ks2.Assemble(ks, 3, 6, 1.0);
+            ks2.Assemble(ks, 6, 3, 1.0);
+            ks2.Assemble(ks, 6, 6, 1.0);
             
             return ks2;
 }
@@ -2010,7 +2059,7 @@ CorotCrdTransf3d::getCopy3d(void)
 int 
 CorotCrdTransf3d::sendSelf(int cTag, Channel &theChannel)
 {
-  static Vector data(48);
+  static thread_local Vector data(48);
   for (int i=0; i<7; i++) 
     data(i) = ulcommit(i);
   for (int j=0; j<4; j++) {
@@ -2074,7 +2123,7 @@ CorotCrdTransf3d::sendSelf(int cTag, Channel &theChannel)
 int 
 CorotCrdTransf3d::recvSelf(int cTag, Channel &theChannel, FEM_ObjectBroker &theBroker)
 {
-  static Vector data(48);
+  static thread_local Vector data(48);
   if (theChannel.recvVector(this->getDbTag(), cTag, data) < 0) {
     opserr << " CorotCrdTransf3d::recvSelf() - data could not be received\n" ;
     return -1;
@@ -2124,6 +2173,7 @@ CorotCrdTransf3d::recvSelf(int cTag, Channel &theChannel, FEM_ObjectBroker &theB
   ul = ulcommit;
   alphaIq = alphaIqcommit;
   alphaJq = alphaJqcommit;
+  isUpdated = false;
   
   initialDispChecked = true;
   return 0;  
@@ -2143,7 +2193,7 @@ CorotCrdTransf3d::getGlobalMatrixFromLocal(const Matrix &local)
 const Vector &
 CorotCrdTransf3d::getPointGlobalCoordFromLocal(const Vector &xl)
 {
-    static Vector xg(3);
+    static thread_local Vector xg(3);
     opserr << " CorotCrdTransf3d::getPointGlobalCoordFromLocal: not implemented yet" ;
     
     return xg;  
@@ -2153,7 +2203,7 @@ CorotCrdTransf3d::getPointGlobalCoordFromLocal(const Vector &xl)
 const Vector &
 CorotCrdTransf3d::getPointGlobalDisplFromBasic(double xi, const Vector &uxb)
 {
-    static Vector uxg(3);
+    static thread_local Vector uxg(3);
     opserr << " CorotCrdTransf3d::getPointGlobalDisplFromBasic: not implemented yet" ;
     
     
@@ -2164,7 +2214,7 @@ CorotCrdTransf3d::getPointGlobalDisplFromBasic(double xi, const Vector &uxb)
 const Vector &
 CorotCrdTransf3d::getPointLocalDisplFromBasic(double xi, const Vector &uxb)
 {
-    static Vector uxg(3);
+    static thread_local Vector uxg(3);
     opserr << " CorotCrdTransf3d::getPointLocalDisplFromBasic: not implemented yet" ;
     
     
@@ -126,17 +126,22 @@ private:
     Vector ulcommit;            // commited local displacements
     Vector ulpr;                // previous local displacements
     
-    static Matrix RI;           // nodal triad for node 1
-    static Matrix RJ;           // nodal triad for node 2
-    static Matrix Rbar;         // mean nodal triad 
-    static Matrix e;            // base vectors
+    // state computed by update() and used by the force and stiffness
+    // methods until the nodes move again
+    Matrix RI;                  // nodal triad for node 1
+    Matrix RJ;                  // nodal triad for node 2
+    Matrix Rbar;                // mean nodal triad 
+    Matrix e;                   // base vectors
+    Matrix T;                   // transformation matrix from basic to global system
+    Matrix Lr2, Lr3, A;         // auxiliary matrices
+    double uTrial[12];          // nodal trial displacements at the last update
+    bool isUpdated;             // uTrial and the state above are valid
+    
     static Matrix Tp;           // transformation matrix to renumber dofs
-    static Matrix T;            // transformation matrix from basic to global system
-    static Matrix Tlg;          // transformation matrix from global to local system
-    static Matrix TlgInv;       // inverse of transformation matrix from global to local system
-    static Matrix Tbl;          // transformation matrix from local to basic system
-    static Matrix kg;           // global stiffness matrix
-    static Matrix Lr2, Lr3, A;  // auxiliary matrices
+    static thread_local Matrix Tlg;    // transformation matrix from global to local system
+    static thread_local Matrix TlgInv; // inverse of transformation matrix from global to local system
+    static thread_local Matrix Tbl;    // transformation matrix from local to basic system
+    static thread_local Matrix kg;     // global stiffness matrix
     
     double *nodeIInitialDisp, *nodeJInitialDisp;
     bool initialDispChecked;
@@ -38,18 +38,23 @@
 #include <TaggedObject.h>
 #include <MapOfTaggedObjects.h>
 #include <CrdTransfResponse.h>
+#include <MemoryStats.h>
 
 static MapOfTaggedObjects theCrdTransfObjects;
 
 bool 
 OPS_addCrdTransf(CrdTransf *newComponent) {
-  return theCrdTransfObjects.addComponent(newComponent);
+  bool ret = theCrdTransfObjects.addComponent(newComponent);
+  if (ret == true)
+    MemoryStats::charge(MemoryStats::Domain, newComponent->getClassTag(), newComponent->getClassType());
+  return ret;
 }
 
 bool OPS_removeCrdTransf(int tag)
 {
     TaggedObject* obj = theCrdTransfObjects.removeComponent(tag);
     if (obj != 0) {
+	MemoryStats::uncharge(MemoryStats::Domain, ((CrdTransf *)obj)->getClassTag(), ((CrdTransf *)obj)->getClassType());
 	delete obj;
 	return true;
     }
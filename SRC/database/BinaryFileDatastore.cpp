@@ -0,0 +1,490 @@
+/* ****************************************************************** **
+**    OpenSees - Open System for Earthquake Engineering Simulation    **
+**          Pacific Earthquake Engineering Research Center            **
+**                                                                    **
+**                                                                    **
+** (C) Copyright 1999, The Regents of the University of California    **
+** All Rights Reserved.                                               **
+**                                                                    **
+** Commercial use of this program without express permission of the   **
+** University of California, Berkeley, is strictly prohibited.  See   **
+** file 'COPYRIGHT'  in main directory for information on usage and   **
+** redistribution,  and for a DISCLAIMER OF ALL WARRANTIES.           **
+**                                                                    **
+** Developed by:                                                      **
+**   Frank McKenna (fmckenna@ce.berkeley.edu)                         **
+**   Gregory L. Fenves (fenves@ce.berkeley.edu)                       **
+**   Filip C. Filippou (filippou@ce.berkeley.edu)                     **
+**                                                                    **
+** ****************************************************************** */
+
+// Description: This file contains the class implementation for
+// BinaryFileDatastore.
+
+#include <BinaryFileDatastore.h>
+#include <OPS_Globals.h>
+#include <ID.h>
+#include <Vector.h>
+#include <Matrix.h>
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <algorithm>
+
+#ifdef _WIN32
+#define _BINARY_DATASTORE_READ
+#else
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
+
+// record types
+#define BINARY_RECORD_ID     1
+#define BINARY_RECORD_VECTOR 2
+#define BINARY_RECORD_MATRIX 3
+
+static const char binaryMagic[8] = {'O','P','S','M','O','D','E','L'};
+static const int binaryByteOrder = 0x01020304;
+
+// file layout, all in native byte order
+struct BinaryFileHeader {
+    char magic[8];
+    int version;
+    int byteOrder;
+    long long numRecords;
+    long long indexOffset;
+};
+
+struct BinaryIndexEntry {
+    int type;
+    int dbTag;
+    int commitTag;
+    int size0;
+    int size1;
+    int pad;
+    long long offset;
+};
+
+static size_t
+alignRecord(size_t pos)
+{
+    return (pos + 7) & ~(size_t)7;
+}
+
+bool
+BinaryFileDatastore::RecordKey::operator<(const RecordKey &other) const
+{
+    if (type != other.type) return type < other.type;
+    if (dbTag != other.dbTag) return dbTag < other.dbTag;
+    if (commitTag != other.commitTag) return commitTag < other.commitTag;
+    if (size0 != other.size0) return size0 < other.size0;
+    return size1 < other.size1;
+}
+
+static bool
+entryLess(const BinaryIndexEntry &a, const BinaryIndexEntry &b)
+{
+    if (a.type != b.type) return a.type < b.type;
+    if (a.dbTag != b.dbTag) return a.dbTag < b.dbTag;
+    if (a.commitTag != b.commitTag) return a.commitTag < b.commitTag;
+    if (a.size0 != b.size0) return a.size0 < b.size0;
+    return a.size1 < b.size1;
+}
+
+BinaryFileDatastore::BinaryFileDatastore(const char *name,
+					 Domain &theDomain,
+					 FEM_ObjectBroker &theBroker)
+  :FE_Datastore(theDomain, theBroker), fileName(0), recordsLoaded(false),
+   fileData(0), fileSize(0), fileMapped(false), theIndex(0), numIndex(0)
+{
+    fileName = new char[strlen(name)+1];
+    strcpy(fileName, name);
+
+    // an existing file is opened for restoreState
+    this->openFile();
+}
+
+BinaryFileDatastore::~BinaryFileDatastore()
+{
+    this->closeFile();
+    if (fileName != 0)
+	delete [] fileName;
+}
+
+int
+BinaryFileDatastore::openFile(void)
+{
+    this->closeFile();
+
+#ifdef _BINARY_DATASTORE_READ
+    FILE *fp = fopen(fileName, "rb");
+    if (fp == 0)
+	return 0;
+    fseek(fp, 0, SEEK_END);
+    long size = ftell(fp);
+    fseek(fp, 0, SEEK_SET);
+    if (size <= 0) {
+	fclose(fp);
+	return 0;
+    }
+    fileData = (char *)malloc(size);
+    if (fileData == 0 || fread(fileData, 1, size, fp) != (size_t)size) {
+	opserr << "BinaryFileDatastore - failed to read file " << fileName << endln;
+	if (fileData != 0)
+	    free(fileData);
+	fileData = 0;
+	fclose(fp);
+	return -1;
+    }
+    fclose(fp);
+    fileSize = size;
+#else
+    int fd = open(fileName, O_RDONLY);
+    if (fd < 0)
+	return 0;
+    struct stat st;
+    if (fstat(fd, &st) != 0 || st.st_size <= 0) {
+	close(fd);
+	return 0;
+    }
+    void *addr = mmap(0, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (addr == MAP_FAILED) {
+	opserr << "BinaryFileDatastore - failed to map file " << fileName << endln;
+	return -1;
+    }
+    fileData = (char *)addr;
+    fileSize = st.st_size;
+    fileMapped = true;
+#endif
+
+    // check the header and the index
+    const BinaryFileHeader *header = (const BinaryFileHeader *)fileData;
+    if (fileSize < sizeof(BinaryFileHeader) ||
+	memcmp(header->magic, binaryMagic, sizeof(binaryMagic)) != 0) {
+	opserr << "BinaryFileDatastore - " << fileName << " is not a binary model file\n";
+	this->closeFile();
+	return -1;
+    }
+    if (header->byteOrder != binaryByteOrder) {
+	opserr << "BinaryFileDatastore - " << fileName << " was written with a different byte order\n";
+	this->closeFile();
+	return -1;
+    }
+    if (header->version > version) {
+	opserr << "BinaryFileDatastore - " << fileName << " has version " << header->version
+	       << ", this program reads up to version " << version << endln;
+	this->closeFile();
+	return -1;
+    }
+    if (header->indexOffset < (long long)sizeof(BinaryFileHeader) || header->numRecords < 0 ||
+	(size_t)header->indexOffset + header->numRecords * sizeof(BinaryIndexEntry) > fileSize) {
+	opserr << "BinaryFileDatastore - " << fileName << " is truncated\n";
+	this->closeFile();
+	return -1;
+    }
+
+    theIndex = fileData + header->indexOffset;
+    numIndex = (int)header->numRecords;
+
+    return 0;
+}
+
+void
+BinaryFileDatastore::closeFile(void)
+{
+    if (fileData != 0) {
+#ifdef _BINARY_DATASTORE_READ
+	free(fileData);
+#else
+	if (fileMapped)
+	    munmap(fileData, fileSize);
+#endif
+    }
+    fileData = 0;
+    fileSize = 0;
+    fileMapped = false;
+    theIndex = 0;
+    numIndex = 0;
+}
+
+// copy the records of the file into memory before new ones are added,
+// so that they are written again with the next commit
+int
+BinaryFileDatastore::loadRecords(void)
+{
+    recordsLoaded = true;
+    if (theIndex == 0)
+	return 0;
+
+    const BinaryIndexEntry *entries = (const BinaryIndexEntry *)theIndex;
+    for (int i = 0; i < numIndex; i++) {
+	const BinaryIndexEntry &e = entries[i];
+	RecordKey key = {e.type, e.dbTag, e.commitTag, e.size0, e.size1};
+	size_t numBytes = (size_t)e.size0 * e.size1 *
+	    (e.type == BINARY_RECORD_ID ? sizeof(int) : sizeof(double));
+	if (e.offset < 0 || (size_t)e.offset + numBytes > fileSize) {
+	    opserr << "BinaryFileDatastore - invalid record in " << fileName << endln;
+	    return -1;
+	}
+	std::vector<char> &rec = theRecords[key];
+	rec.assign(fileData + e.offset, fileData + e.offset + numBytes);
+    }
+
+    return 0;
+}
+
+int
+BinaryFileDatastore::send(const RecordKey &key, const void *data, size_t numBytes)
+{
+    if (recordsLoaded == false)
+	if (this->loadRecords() < 0)
+	    return -1;
+
+    std::vector<char> &rec = theRecords[key];
+    rec.resize(numBytes);
+    if (numBytes > 0)
+	memcpy(&rec[0], data, numBytes);
+
+    return 0;
+}
+
+const char *
+BinaryFileDatastore::find(const RecordKey &key, size_t numBytes)
+{
+    // data sent in this run first
+    std::map<RecordKey, std::vector<char> >::const_iterator it = theRecords.find(key);
+    if (it != theRecords.end()) {
+	if (it->second.size() != numBytes)
+	    return 0;
+	return numBytes > 0 ? &(it->second[0]) : (const char *)this;
+    }
+    if (recordsLoaded == true || theIndex == 0)
+	return 0;
+
+    // then the index of the file
+    BinaryIndexEntry target;
+    target.type = key.type;
+    target.dbTag = key.dbTag;
+    target.commitTag = key.commitTag;
+    target.size0 = key.size0;
+    target.size1 = key.size1;
+
+    const BinaryIndexEntry *first = (const BinaryIndexEntry *)theIndex;
+    const BinaryIndexEntry *last = first + numIndex;
+    const BinaryIndexEntry *e = std::lower_bound(first, last, target, entryLess);
+    if (e == last || entryLess(target, *e))
+	return 0;
+    if (e->offset < 0 || (size_t)e->offset + numBytes > fileSize)
+	return 0;
+
+    return fileData + e->offset;
+}
+
+int
+BinaryFileDatastore::writeFile(void)
+{
+    // written to a new file which then replaces the old one, the old
+    // one may still be mapped
+    size_t nameLength = strlen(fileName);
+    char *tmpName = new char[nameLength+5];
+    strcpy(tmpName, fileName);
+    strcpy(&tmpName[nameLength], ".tmp");
+
+    FILE *fp = fopen(tmpName, "wb");
+    if (fp == 0) {
+	opserr << "BinaryFileDatastore::commitState - failed to open " << tmpName << endln;
+	delete [] tmpName;
+	return -1;
+    }
+
+    std::vector<BinaryIndexEntry> entries;
+    entries.reserve(theRecords.size());
+
+    BinaryFileHeader header;
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, binaryMagic, sizeof(binaryMagic));
+    header.version = version;
+    header.byteOrder = binaryByteOrder;
+
+    bool ok = fwrite(&header, sizeof(header), 1, fp) == 1;
+    size_t pos = sizeof(header);
+    static const char zeros[8] = {0,0,0,0,0,0,0,0};
+
+    std::map<RecordKey, std::vector<char> >::const_iterator it;
+    for (it = theRecords.begin(); ok && it != theRecords.end(); it++) {
+	size_t start = alignRecord(pos);
+	if (start > pos)
+	    ok = fwrite(zeros, 1, start-pos, fp) == start-pos;
+	size_t numBytes = it->second.size();
+	if (ok && numBytes > 0)
+	    ok = fwrite(&(it->second[0]), 1, numBytes, fp) == numBytes;
+	pos = start + numBytes;
+
+	BinaryIndexEntry e;
+	e.type = it->first.type;
+	e.dbTag = it->first.dbTag;
+	e.commitTag = it->first.commitTag;
+	e.size0 = it->first.size0;
+	e.size1 = it->first.size1;
+	e.pad = 0;
+	e.offset = start;
+	entries.push_back(e);
+    }
+
+    size_t indexOffset = alignRecord(pos);
+    if (ok && indexOffset > pos)
+	ok = fwrite(zeros, 1, indexOffset-pos, fp) == indexOffset-pos;
+    if (ok && !entries.empty())
+	ok = fwrite(&entries[0], sizeof(BinaryIndexEntry), entries.size(), fp) == entries.size();
+
+    header.numRecords = entries.size();
+    header.indexOffset = indexOffset;
+    if (ok)
+	ok = fseek(fp, 0, SEEK_SET) == 0 && fwrite(&header, sizeof(header), 1, fp) == 1;
+    if (fclose(fp) != 0)
+	ok = false;
+
+    if (ok) {
+	this->closeFile();
+	remove(fileName);
+	ok = rename(tmpName, fileName) == 0;
+    }
+    if (!ok) {
+	opserr << "BinaryFileDatastore::commitState - failed to write " << fileName << endln;
+	remove(tmpName);
+    }
+    delete [] tmpName;
+
+    return ok ? 0 : -1;
+}
+
+int
+BinaryFileDatastore::commitState(int commitTag)
+{
+    int res = FE_Datastore::commitState(commitTag);
+    if (res < 0)
+	return res;
+
+    return this->writeFile();
+}
+
+int
+BinaryFileDatastore::sendMsg(int dataTag, int commitTag,
+			     const Message &,
+			     ChannelAddress *theAddress)
+{
+    opserr << "BinaryFileDatastore::sendMsg() - not yet implemented\n";
+    return -1;
+}
+
+int
+BinaryFileDatastore::recvMsg(int dataTag, int commitTag,
+			     Message &,
+			     ChannelAddress *theAddress)
+{
+    opserr << "BinaryFileDatastore::recvMsg() - not yet implemented\n";
+    return -1;
+}
+
+int
+BinaryFileDatastore::recvMsgUnknownSize(int dataTag, int commitTag,
+					Message &,
+					ChannelAddress *theAddress)
+{
+    opserr << "BinaryFileDatastore::recvMsgUnknownSize() - not yet implemented\n";
+    return -1;
+}
+
+int
+BinaryFileDatastore::sendMatrix(int dataTag, int commitTag,
+				const Matrix &theMatrix,
+				ChannelAddress *theAddress)
+{
+    int noRows = theMatrix.noRows();
+    int noCols = theMatrix.noCols();
+    std::vector<double> data((size_t)noRows * noCols);
+    for (int j = 0; j < noCols; j++)
+	for (int i = 0; i < noRows; i++)
+	    data[(size_t)j*noRows + i] = theMatrix(i,j);
+
+    RecordKey key = {BINARY_RECORD_MATRIX, dataTag, commitTag, noRows, noCols};
+    return this->send(key, data.empty() ? 0 : &data[0], data.size()*sizeof(double));
+}
+
+int
+BinaryFileDatastore::recvMatrix(int dataTag, int commitTag,
+				Matrix &theMatrix,
+				ChannelAddress *theAddress)
+{
+    int noRows = theMatrix.noRows();
+    int noCols = theMatrix.noCols();
+    RecordKey key = {BINARY_RECORD_MATRIX, dataTag, commitTag, noRows, noCols};
+    const char *rec = this->find(key, (size_t)noRows * noCols * sizeof(double));
+    if (rec == 0)
+	return -1;
+
+    const double *data = (const double *)rec;
+    for (int j = 0; j < noCols; j++)
+	for (int i = 0; i < noRows; i++)
+	    theMatrix(i,j) = data[(size_t)j*noRows + i];
+
+    return 0;
+}
+
+int
+BinaryFileDatastore::sendVector(int dataTag, int commitTag,
+				const Vector &theVector,
+				ChannelAddress *theAddress)
+{
+    int size = theVector.Size();
+    RecordKey key = {BINARY_RECORD_VECTOR, dataTag, commitTag, size, 1};
+    return this->send(key, theVector.theData, size*sizeof(double));
+}
+
+int
+BinaryFileDatastore::recvVector(int dataTag, int commitTag,
+				Vector &theVector,
+				ChannelAddress *theAddress)
+{
+    int size = theVector.Size();
+    RecordKey key = {BINARY_RECORD_VECTOR, dataTag, commitTag, size, 1};
+    const char *rec = this->find(key, size*sizeof(double));
+    if (rec == 0)
+	return -1;
+
+    if (size > 0)
+	memcpy(theVector.theData, rec, size*sizeof(double));
+
+    return 0;
+}
+
+int
+BinaryFileDatastore::sendID(int dataTag, int commitTag,
+			    const ID &theID,
+			    ChannelAddress *theAddress)
+{
+    int size = theID.Size();
+    RecordKey key = {BINARY_RECORD_ID, dataTag, commitTag, size, 1};
+    return this->send(key, theID.data, size*sizeof(int));
+}
+
+int
+BinaryFileDatastore::recvID(int dataTag, int commitTag,
+			    ID &theID,
+			    ChannelAddress *theAddress)
+{
+    int size = theID.Size();
+    RecordKey key = {BINARY_RECORD_ID, dataTag, commitTag, size, 1};
+    const char *rec = this->find(key, size*sizeof(int));
+    if (rec == 0)
+	return -1;
+
+    if (size > 0)
+	memcpy(theID.data, rec, size*sizeof(int));
+
+    return 0;
+}
@@ -0,0 +1,131 @@
+/* ****************************************************************** **
+**    OpenSees - Open System for Earthquake Engineering Simulation    **
+**          Pacific Earthquake Engineering Research Center            **
+**                                                                    **
+**                                                                    **
+** (C) Copyright 1999, The Regents of the University of California    **
+** All Rights Reserved.                                               **
+**                                                                    **
+** Commercial use of this program without express permission of the   **
+** University of California, Berkeley, is strictly prohibited.  See   **
+** file 'COPYRIGHT'  in main directory for information on usage and   **
+** redistribution,  and for a DISCLAIMER OF ALL WARRANTIES.           **
+**                                                                    **
+** Developed by:                                                      **
+**   Frank McKenna (fmckenna@ce.berkeley.edu)                         **
+**   Gregory L. Fenves (fenves@ce.berkeley.edu)                       **
+**   Filip C. Filippou (filippou@ce.berkeley.edu)                     **
+**                                                                    **
+** ****************************************************************** */
+
+#ifndef BinaryFileDatastore_h
+#define BinaryFileDatastore_h
+
+// Description: This file contains the class definition for
+// BinaryFileDatastore. BinaryFileDatastore is a concrete subclass of
+// FE_Datastore which stores the data sent by the domain and its
+// components in a single versioned binary file:
+//
+//   header  : magic "OPSMODEL", version, byte order mark,
+//             number of records, offset of the index
+//   records : the raw ID, Vector and Matrix data, 8 byte aligned
+//   index   : one entry per record (type, dbTag, commitTag, sizes,
+//             offset), sorted by key
+//
+// The file is written as a whole on each commitState(). When it is
+// opened for restoreState() it is memory mapped and the records are
+// found by binary search in the index, so nothing is parsed or copied
+// until an object asks for its data. The domain is rebuilt through
+// recvSelf() with the object broker, the same way as from any other
+// datastore:
+//
+//   database Binary model.bin ; save 0       (export)
+//   database Binary model.bin ; restore 0    (load)
+
+#include <FE_Datastore.h>
+
+#include <stddef.h>
+#include <map>
+#include <vector>
+
+class FEM_ObjectBroker;
+
+class BinaryFileDatastore: public FE_Datastore
+{
+  public:
+    BinaryFileDatastore(const char *fileName,
+			Domain &theDomain,
+			FEM_ObjectBroker &theBroker);
+    ~BinaryFileDatastore();
+
+    // methods for sending and receiving the data
+    int sendMsg(int dbTag, int commitTag,
+		const Message &,
+		ChannelAddress *theAddress =0);
+    int recvMsg(int dbTag, int commitTag,
+		Message &,
+		ChannelAddress *theAddress =0);
+    int recvMsgUnknownSize(int dbTag, int commitTag,
+		Message &,
+		ChannelAddress *theAddress =0);
+
+    int sendMatrix(int dbTag, int commitTag,
+		   const Matrix &theMatrix,
+		   ChannelAddress *theAddress =0);
+    int recvMatrix(int dbTag, int commitTag,
+		   Matrix &theMatrix,
+		   ChannelAddress *theAddress =0);
+
+    int sendVector(int dbTag, int commitTag,
+		   const Vector &theVector,
+		   ChannelAddress *theAddress =0);
+    int recvVector(int dbTag, int commitTag,
+		   Vector &theVector,
+		   ChannelAddress *theAddress =0);
+
+    int sendID(int dbTag, int commitTag,
+	       const ID &theID,
+	       ChannelAddress *theAddress =0);
+    int recvID(int dbTag, int commitTag,
+	       ID &theID,
+	       ChannelAddress *theAddress =0);
+
+    int commitState(int commitTag);
+
+    static const int version = 1;
+
+  protected:
+
+  private:
+    struct RecordKey {
+	int type;
+	int dbTag;
+	int commitTag;
+	int size0;
+	int size1;
+	bool operator<(const RecordKey &other) const;
+    };
+
+    int send(const RecordKey &key, const void *data, size_t numBytes);
+    const char *find(const RecordKey &key, size_t numBytes);
+
+    int openFile(void);
+    void closeFile(void);
+    int loadRecords(void);
+    int writeFile(void);
+
+    char *fileName;
+
+    // records sent since the file was opened, written on commitState
+    std::map<RecordKey, std::vector<char> > theRecords;
+    bool recordsLoaded;
+
+    // the mapped file
+    char *fileData;
+    size_t fileSize;
+    bool fileMapped;
+    const char *theIndex;
+    int numIndex;
+};
+
+#endif
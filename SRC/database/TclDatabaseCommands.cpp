@@ -46,6 +46,7 @@
 
 // known databases
 #include <FileDatastore.h>
+#include <BinaryFileDatastore.h>
 
 // linked list of struct for other types of
 // databases that can be added dynamically
@@ -96,7 +97,7 @@ TclAddDatabase(ClientData clientData, Tcl_Interp *interp, int argc, TCL_Char **a
 
   // make sure at least one other argument to contain integrator
   if (argc < 2) {
-    opserr << "WARNING need to specify a Database type; valid type File, MySQL, BerkeleyDB \n";
+    opserr << "WARNING need to specify a Database type; valid type File, Binary, MySQL, BerkeleyDB \n";
     return TCL_ERROR;
   }    
 
@@ -123,6 +124,25 @@ TclAddDatabase(ClientData clientData, Tcl_Interp *interp, int argc, TCL_Char **a
       return TCL_ERROR;
     } 
     
+    return TCL_OK;
+
+  // a single binary model file
+  } else if (strcmp(argv[1],"Binary") == 0) {
+    if (argc < 3) {
+      opserr << "WARNING database Binary fileName? ";
+      return TCL_ERROR;
+    }    
+
+    // delete the old database
+    if (theDatabase != 0)
+      delete theDatabase;
+
+    theDatabase = new BinaryFileDatastore(argv[2], theDomain, theBroker);
+    if (theDatabase == 0) {
+      opserr << "WARNING ran out of memory - database Binary " << argv[2] << endln;
+      return TCL_ERROR;
+    } 
+    
     return TCL_OK;
   } else {
 
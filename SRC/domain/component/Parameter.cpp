@@ -25,6 +25,7 @@
 #include <classTags.h>
 #include <Parameter.h>
 #include <DomainComponent.h>
+#include <Element.h>
 
 Parameter::Parameter(int passedTag,
 		     DomainComponent *parentObject,
@@ -180,6 +181,9 @@ Parameter::update(int newValue)
 {
   theInfo.theInt = newValue;
 
+  // the elements may depend on the parameter, update them all again
+  Element::resetUpdateStamps();
+
   int ok = 0;
 
   for (int i = 0; i < numObjects; i++)
@@ -193,6 +197,9 @@ Parameter::update(double newValue)
 {
   theInfo.theDouble = newValue;
 
+  // the elements may depend on the parameter, update them all again
+  Element::resetUpdateStamps();
+
   int ok = 0;
 
   for (int i = 0; i < numObjects; i++)
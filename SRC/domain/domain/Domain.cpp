@@ -78,9 +78,12 @@
 #include <MeshRegion.h>
 #include <Analysis.h>
 #include <FE_Datastore.h>
+#include <MemoryStats.h>
+#include <NodalStatePool.h>
 #include <FEM_ObjectBroker.h>
 
 #ifdef _CSS
+#include <map>
 #include <ElementRecorder.h>
 #include <EnvelopeElementRecorder.h>
 #include <ResidElementRecorder.h>
@@ -106,8 +109,12 @@ Domain::Domain()
  theBounds(6), theEigenvalues(0), theEigenvalueSetTime(0), 
  theModalProperties(0),
  theModalDampingFactors(0), inclModalMatrix(false),
- lastChannel(0),
+ lastChannel(0), theNodalStatePool(0),
  paramIndex(0), paramSize(0), numParameters(0)
+#ifdef _CSS
+ , energyBalanceOn(false), energiesFormed(false), energyTrackingTag(0),
+ inputEnergy(0.0)
+#endif // _CSS
 {
 
 	// init the arrays for storing the domain components
@@ -162,7 +169,11 @@ Domain::Domain(int numNodes, int numElements, int numSPs, int numMPs,
  theBounds(6), theEigenvalues(0), theEigenvalueSetTime(0), 
  theModalProperties(0),
  theModalDampingFactors(0), inclModalMatrix(false),
- lastChannel(0), paramIndex(0), paramSize(0), numParameters(0)
+ lastChannel(0), theNodalStatePool(0), paramIndex(0), paramSize(0), numParameters(0)
+#ifdef _CSS
+ , energyBalanceOn(false), energiesFormed(false), energyTrackingTag(0),
+ inputEnergy(0.0)
+#endif // _CSS
 {
 	// init the arrays for storing the domain components
 	theElements = new MapOfTaggedObjects();
@@ -223,7 +234,11 @@ Domain::Domain(TaggedObjectStorage &theNodesStorage,
  theBounds(6), theEigenvalues(0), theEigenvalueSetTime(0), 
  theModalProperties(0),
  theModalDampingFactors(0), inclModalMatrix(false),
- lastChannel(0),paramIndex(0), paramSize(0), numParameters(0)
+ lastChannel(0), theNodalStatePool(0), paramIndex(0), paramSize(0), numParameters(0)
+#ifdef _CSS
+ , energyBalanceOn(false), energiesFormed(false), energyTrackingTag(0),
+ inputEnergy(0.0)
+#endif // _CSS
 {
 	// init the arrays for storing the domain components
 	thePCs = new MapOfTaggedObjects();
@@ -282,7 +297,11 @@ Domain::Domain(TaggedObjectStorage &theStorage)
  theBounds(6), theEigenvalues(0), theEigenvalueSetTime(0), 
  theModalProperties(0),
  theModalDampingFactors(0), inclModalMatrix(false),
- lastChannel(0),paramIndex(0), paramSize(0), numParameters(0)
+ lastChannel(0), theNodalStatePool(0), paramIndex(0), paramSize(0), numParameters(0)
+#ifdef _CSS
+ , energyBalanceOn(false), energiesFormed(false), energyTrackingTag(0),
+ inputEnergy(0.0)
+#endif // _CSS
 {
 	// init the arrays for storing the domain components
 	theStorage.clearAll(); // clear the storage just in case populated
@@ -338,6 +357,9 @@ Domain::~Domain()
 	// delete the objects in the domain
 	this->Domain::clearAll();
 
+	if (theNodalStatePool != 0)
+		delete theNodalStatePool;
+
 	// delete all the storage objects
 	// SEGMENT FAULT WILL OCCUR IF THESE OBJECTS WERE NOT CONSTRUCTED
 	// USING NEW
@@ -470,6 +492,14 @@ Domain::addElement(Element* element)
 #endif
 		// mark the Domain as having been changed
 		this->domainChange();
+
+#ifdef _CSS
+		// elements added while the energy balance is on are tracked too
+		if (energyBalanceOn == true)
+			element->setEnergyTracking(true);
+#endif // _CSS
+
+		MemoryStats::charge(MemoryStats::Domain, element->getClassTag(), element->getClassType());
 	}
 	else
 		opserr << "Domain::addElement - element " << eleTag << "could not be added to container\n";
@@ -502,6 +532,12 @@ Domain::addNode(Node* node)
 #endif
 	  this->domainChange();
 
+	  // the nodal state pool is rebuilt when next needed
+	  if (theNodalStatePool != 0)
+		  theNodalStatePool->clear();
+
+	  MemoryStats::charge(MemoryStats::Domain, node->getClassTag(), "Node");
+
       if (!resetBounds) {
           // see if the physical bounds are changed
           // note this assumes 0,0,0,0,0,0 as startup min,max values
@@ -621,6 +657,8 @@ Domain::addSP_Constraint(SP_Constraint* spConstraint)
 #endif
 	this->domainChange();
 
+	MemoryStats::charge(MemoryStats::Domain, spConstraint->getClassTag(), "SP_Constraint");
+
 	return true;
 }
 
@@ -777,6 +815,8 @@ Domain::addMP_Constraint(MP_Constraint* mpConstraint)
 #endif
 		mpConstraint->setDomain(this);
 		this->domainChange();
+
+		MemoryStats::charge(MemoryStats::Domain, mpConstraint->getClassTag(), "MP_Constraint");
 	}
 	else
 		opserr << "Domain::addMP_Constraint - cannot add constraint with tag" <<
@@ -807,6 +847,8 @@ Domain::addLoadPattern(LoadPattern* load)
 			this->_DomainEvent_AddLoadPattern(load);
 #endif
 		this->domainChange();
+
+		MemoryStats::charge(MemoryStats::Domain, load->getClassTag(), "LoadPattern");
 	}
 	else
 		opserr << "Domain::addLoadPattern - cannot add LoadPattern with tag" <<
@@ -960,6 +1002,8 @@ Domain::addNodalLoad(NodalLoad* load, int pattern)
 #endif
 	this->domainChange();
 
+	MemoryStats::charge(MemoryStats::Domain, load->getClassTag(), "NodalLoad");
+
 	return result;
 }
 
@@ -986,6 +1030,8 @@ Domain::addElementalLoad(ElementalLoad* load, int pattern)
 
 	// load->setDomain(this); // done in LoadPattern::addElementalLoad()
 	this->domainChange();
+
+	MemoryStats::charge(MemoryStats::Domain, load->getClassTag(), "ElementalLoad");
 #if _DLL
     if (this->_DomainEvent_AddElementalLoad)
         this->_DomainEvent_AddElementalLoad(load, pattern);
@@ -1020,7 +1066,14 @@ Domain::clearAll(void) {
 
 #endif // _CSS
 
+#ifdef _CSS
+	this->resetEnergyHistory();
+	energyBalanceOn = false;
+#endif // _CSS
+
 	theElements->clearAll();
+	if (theNodalStatePool != 0)
+		theNodalStatePool->clear();
 	theNodes->clearAll();
 	theSPs->clearAll();
 	thePCs->clearAll();
@@ -1053,6 +1106,9 @@ Domain::clearAll(void) {
 		theRegions = 0;
 	}
 
+	MemoryStats::clear(MemoryStats::Domain);
+	MemoryStats::clear(MemoryStats::Recorders);
+
 	// set the time back to 0.0
 	currentTime = 0.0;
 	committedTime = 0.0;
@@ -1127,7 +1183,18 @@ Domain::removeElement(int tag)
 #endif
 	//  result->setDomain(0);
 
+	MemoryStats::uncharge(MemoryStats::Domain, result->getClassTag(), result->getClassType());
+
 #ifdef _CSS
+	// release the request of the energy balance, the element may be added again
+	if (energyBalanceOn == true)
+		result->setEnergyTracking(false);
+
+	// its forces must not be picked up by another element
+	for (size_t i = 0; i < energyElements.size(); i++)
+		if (energyElements[i] == result)
+			energyElements[i] = 0;
+
 	for (int i = 0; i < numRecorders; i++)
 	{
 		if (theRecorders[i] == 0)
@@ -1180,6 +1247,16 @@ Domain::removeNode(int tag)
   // mark the domain has having changed 
   this->domainChange();
 
+  // give the node its own state back, the pool is rebuilt when next needed
+  if (theNodalStatePool != 0)
+    theNodalStatePool->clear();
+
+#ifdef _CSS
+  for (size_t i = 0; i < energyNodes.size(); i++)
+    if (energyNodes[i] == (Node *)mc)
+      energyNodes[i] = 0;
+#endif // _CSS
+
   // adjust node bounds 
   resetBounds = true;
   
@@ -1192,6 +1269,8 @@ Domain::removeNode(int tag)
   if (this->_DomainEvent_RemoveNode)
 	  this->_DomainEvent_RemoveNode(result);
 #endif
+
+  MemoryStats::uncharge(MemoryStats::Domain, result->getClassTag(), "Node");
   return result;
 }
 
@@ -1266,6 +1345,8 @@ Domain::removeSP_Constraint(int tag)
 	if (this->_DomainEvent_RemoveSP)
 		this->_DomainEvent_RemoveSP(result);
 #endif
+	MemoryStats::uncharge(MemoryStats::Domain, result->getClassTag(), "SP_Constraint");
+
 	// should check that theLoad and result are the same    
 	return result;
 }
@@ -1313,6 +1394,8 @@ Domain::removeMP_Constraint(int tag)
 		this->_DomainEvent_RemoveMP(result);
 #endif
 	// result->setDomain(0);
+
+	MemoryStats::uncharge(MemoryStats::Domain, result->getClassTag(), "MP_Constraint");
 	return result;
 }
 
@@ -1342,8 +1425,10 @@ Domain::removeMP_Constraints(int nodeTag)
 		if (this->_DomainEvent_RemoveMP)
 			this->_DomainEvent_RemoveMP((MP_Constraint*)mc);
 #endif
-		if (mc != 0)
+		if (mc != 0) {
+			MemoryStats::uncharge(MemoryStats::Domain, ((MP_Constraint*)mc)->getClassTag(), "MP_Constraint");
 			delete mc;
+		}
 	}
 
 	// mark the domain as having changed    
@@ -1443,6 +1528,8 @@ Domain::removeLoadPattern(int tag)
 	LoadPattern* result = (LoadPattern*)obj;
 	// result->setDomain(0);
 
+	MemoryStats::uncharge(MemoryStats::Domain, result->getClassTag(), "LoadPattern");
+
 	//
 	// now set the Domain pointer for all loads and SP constraints 
 	// in the loadPattern to be 0
@@ -2037,10 +2124,15 @@ Domain::applyLoad(double timeStep)
 	// first loop over nodes and elements getting them to first zero their loads
 	//
 
-	Node* nodePtr;
-	NodeIter& theNodeIter = this->getNodes();
-	while ((nodePtr = theNodeIter()) != 0)
-		nodePtr->zeroUnbalancedLoad();
+	NodalStatePool* thePool = this->getNodalStatePool();
+	if (thePool != 0)
+		thePool->zeroUnbalancedLoad();
+	else {
+		Node* nodePtr;
+		NodeIter& theNodeIter = this->getNodes();
+		while ((nodePtr = theNodeIter()) != 0)
+			nodePtr->zeroUnbalancedLoad();
+	}
 
 	Element* elePtr;
 	ElementIter& theElemIter = this->getElements();
@@ -2142,9 +2234,20 @@ Domain::record(bool fromAnalysis)
 	int res = 0;
 
 	// invoke record on all recorders
-	for (int i = 0; i < numRecorders; i++)
-		if (theRecorders[i] != 0)
-			res += theRecorders[i]->record(commitTag, currentTime);
+	if (MemoryStats::isInstrumented() == false || MemoryStats::isEnabled() == false) {
+		for (int i = 0; i < numRecorders; i++)
+			if (theRecorders[i] != 0)
+				res += theRecorders[i]->record(commitTag, currentTime);
+	}
+	else {
+		// recorders allocate their buffers on the first record
+		for (int i = 0; i < numRecorders; i++)
+			if (theRecorders[i] != 0) {
+				MemoryStats::mark();
+				res += theRecorders[i]->record(commitTag, currentTime);
+				MemoryStats::resize(MemoryStats::Recorders, theRecorders[i]->getClassTag(), theRecorders[i]->getClassType());
+			}
+	}
 
 	// update the commitTag
 	commitTag++;
@@ -2171,6 +2274,229 @@ Domain::recordSingle(int tag)
 	return res;
 }
 
+int
+Domain::setEnergyBalance(bool on)
+{
+	// the balance makes one tracking request on every element and
+	// switching it off releases only that request, the elements asked for
+	// by a recorder stay tracked
+	if (on == energyBalanceOn)
+		return 0;
+	energyBalanceOn = on;
+
+	Element* elePtr;
+	ElementIter& theElemIter = this->getElements();
+	while ((elePtr = theElemIter()) != 0)
+		elePtr->setEnergyTracking(on);
+
+	energiesFormed = false;
+	return 0;
+}
+
+int
+Domain::getEnergyBalance(Vector& energies)
+{
+	// kinetic, damping, hysteretic, input and motion energy
+	if (energies.Size() != 5)
+		energies.resize(5);
+	energies.Zero();
+
+	Node* nodePtr;
+	NodeIter& theNodeIter = this->getNodes();
+	while ((nodePtr = theNodeIter()) != 0) {
+		energies(0) += nodePtr->getKineticEnergy(0);
+		energies(1) += nodePtr->getDampEnergy();
+		energies(4) += nodePtr->getMotionEnergy(0);
+	}
+
+	Element* elePtr;
+	ElementIter& theElemIter = this->getElements();
+	while ((elePtr = theElemIter()) != 0) {
+		energies(1) += elePtr->getDampingEnergy();
+		energies(2) += elePtr->getHystereticEnergy();
+	}
+
+	energies(3) = inputEnergy;
+
+	return 0;
+}
+
+int
+Domain::formEnergies(void)
+{
+	// keep the last forces of the elements and nodes already in the pass
+	std::map<Element*, int> oldEleLoc;
+	for (size_t n = 0; n < energyElements.size(); n++)
+		if (energyElements[n] != 0)
+			oldEleLoc[energyElements[n]] = energyStart[n];
+	std::map<Node*, int> oldNodeLoc;
+	for (size_t n = 0; n < energyNodes.size(); n++)
+		if (energyNodes[n] != 0)
+			oldNodeLoc[energyNodes[n]] = energyNodeStart[n];
+	std::vector<double> oldDampF, oldResF, oldLoad;
+	oldDampF.swap(prevDampF);
+	oldResF.swap(prevResF);
+	oldLoad.swap(prevLoad);
+
+	energyElements.clear();
+	energyStart.assign(1, 0);
+	Element* elePtr;
+	ElementIter& theElemIter = this->getElements();
+	while ((elePtr = theElemIter()) != 0) {
+		if (elePtr->isSubdomain() == true || elePtr->isEnergyTracked() == false)
+			continue;
+		energyElements.push_back(elePtr);
+		energyStart.push_back(energyStart.back() + elePtr->getNumDOF());
+	}
+
+	int size = energyStart.back();
+	prevDampF.assign(size, 0.0);
+	prevResF.assign(size, 0.0);
+	curDampF.assign(size, 0.0);
+	curResF.assign(size, 0.0);
+	energyDU.assign(size, 0.0);
+	for (size_t n = 0; n < energyElements.size(); n++) {
+		std::map<Element*, int>::iterator it = oldEleLoc.find(energyElements[n]);
+		if (it == oldEleLoc.end())
+			continue;
+		for (int i = energyStart[n], j = it->second; i < energyStart[n + 1]; i++, j++) {
+			prevDampF[i] = oldDampF[j];
+			prevResF[i] = oldResF[j];
+		}
+	}
+
+	energyNodes.clear();
+	energyNodeStart.assign(1, 0);
+	if (energyBalanceOn == true) {
+		Node* nodePtr;
+		NodeIter& theNodeIter = this->getNodes();
+		while ((nodePtr = theNodeIter()) != 0) {
+			energyNodes.push_back(nodePtr);
+			energyNodeStart.push_back(energyNodeStart.back() + nodePtr->getNumberDOF());
+		}
+	}
+
+	prevLoad.assign(energyNodeStart.back(), 0.0);
+	for (size_t n = 0; n < energyNodes.size(); n++) {
+		std::map<Node*, int>::iterator it = oldNodeLoc.find(energyNodes[n]);
+		if (it == oldNodeLoc.end())
+			continue;
+		for (int i = energyNodeStart[n], j = it->second; i < energyNodeStart[n + 1]; i++, j++)
+			prevLoad[i] = oldLoad[j];
+	}
+
+	energiesFormed = true;
+	energyTrackingTag = Element::getEnergyTrackingTag();
+	return 0;
+}
+
+// drops the work of the loads and the forces of the last commit, so
+// that the next energy pass starts from zero
+void
+Domain::resetEnergyHistory(void)
+{
+	inputEnergy = 0.0;
+	energyElements.clear();
+	energyStart.clear();
+	energyNodes.clear();
+	energyNodeStart.clear();
+	prevDampF.clear();
+	prevResF.clear();
+	prevLoad.clear();
+	energiesFormed = false;
+}
+
+int
+Domain::computeEnergies(void)
+{
+	if (energiesFormed == false || energyTrackingTag != Element::getEnergyTrackingTag())
+		this->formEnergies();
+
+	//
+	// first gather the committed forces and the displacement increments
+	// of the elements; this is done one element at a time as many
+	// elements return their forces in Vectors shared by the class
+	//
+
+	int numEle = (int)energyElements.size();
+	for (int n = 0; n < numEle; n++) {
+		Element* elePtr = energyElements[n];
+		int start = energyStart[n];
+		int end = energyStart[n + 1];
+		if (elePtr == 0 ||
+			elePtr->getEnergyForces(&curDampF[start], &curResF[start], end - start) < 0) {
+			for (int i = start; i < end; i++) {
+				curDampF[i] = prevDampF[i];
+				curResF[i] = prevResF[i];
+				energyDU[i] = 0.0;
+			}
+			continue;
+		}
+
+		Node** theNodes = elePtr->getNodePtrs();
+		int numNodes = elePtr->getNumExternalNodes();
+		int loc = start;
+		for (int i = 0; i < numNodes; i++) {
+			const Vector& prevDisp = theNodes[i]->getLastCommitDisp();
+			const Vector& thisDisp = theNodes[i]->getDisp();
+			int numDOF = thisDisp.Size();
+			for (int j = 0; j < numDOF && loc < end; j++)
+				energyDU[loc++] = (prevDisp.Size() == numDOF) ? thisDisp(j) - prevDisp(j) : 0.0;
+		}
+		while (loc < end)
+			energyDU[loc++] = 0.0;
+	}
+
+	//
+	// then integrate the energies of all the elements in one pass
+	//
+
+	const double* dU = energyDU.data();
+	double* pDampF = prevDampF.data();
+	double* pResF = prevResF.data();
+	const double* cDampF = curDampF.data();
+	const double* cResF = curResF.data();
+	const int* eStart = energyStart.data();
+	Element** eles = energyElements.data();
+
+#pragma omp parallel for
+	for (int n = 0; n < numEle; n++) {
+		double damping = 0.0;
+		double hysteretic = 0.0;
+		for (int i = eStart[n]; i < eStart[n + 1]; i++) {
+			damping += 0.5 * (pDampF[i] + cDampF[i]) * dU[i];
+			hysteretic += 0.5 * (pResF[i] + cResF[i]) * dU[i];
+			pDampF[i] = cDampF[i];
+			pResF[i] = cResF[i];
+		}
+		if (eles[n] != 0)
+			eles[n]->addEnergies(damping, hysteretic);
+	}
+
+	//
+	// finally the work of the applied nodal loads for the balance
+	//
+
+	int numNodes = (int)energyNodes.size();
+	for (int n = 0; n < numNodes; n++) {
+		Node* nodePtr = energyNodes[n];
+		if (nodePtr == 0)
+			continue;
+		const Vector& load = nodePtr->getUnbalancedLoad();
+		const Vector& prevDisp = nodePtr->getLastCommitDisp();
+		const Vector& thisDisp = nodePtr->getDisp();
+		int numDOF = thisDisp.Size();
+		for (int i = energyNodeStart[n], j = 0; i < energyNodeStart[n + 1]; i++, j++) {
+			if (j < numDOF && prevDisp.Size() == numDOF && load.Size() == numDOF) {
+				inputEnergy += 0.5 * (prevLoad[i] + load(j)) * (thisDisp(j) - prevDisp(j));
+				prevLoad[i] = load(j);
+			}
+		}
+	}
+
+	return 0;
+}
+
 #endif // _CSS
 int
 Domain::commit(void)
@@ -2178,10 +2504,15 @@ Domain::commit(void)
 	// 
 	// first invoke commit on all nodes and elements in the domain
 	//
-	Node* nodePtr;
-	NodeIter& theNodeIter = this->getNodes();
-	while ((nodePtr = theNodeIter()) != 0) {
-		nodePtr->commitState();
+	NodalStatePool* thePool = this->getNodalStatePool();
+	if (thePool != 0)
+		thePool->commit();
+	else {
+		Node* nodePtr;
+		NodeIter& theNodeIter = this->getNodes();
+		while ((nodePtr = theNodeIter()) != 0) {
+			nodePtr->commitState();
+		}
 	}
 
 	Element* elePtr;
@@ -2190,6 +2521,10 @@ Domain::commit(void)
 		elePtr->commitState();
 	}
 
+#ifdef _CSS
+	this->computeEnergies();
+#endif // _CSS
+
 	// set the new committed time in the domain
 	committedTime = currentTime;
 	dT = 0.0;
@@ -2211,10 +2546,15 @@ Domain::revertToLastCommit(void)
 	// first invoke revertToLastCommit  on all nodes and elements in the domain
 	//
 
-	Node* nodePtr;
-	NodeIter& theNodeIter = this->getNodes();
-	while ((nodePtr = theNodeIter()) != 0)
-		nodePtr->revertToLastCommit();
+	NodalStatePool* thePool = this->getNodalStatePool();
+	if (thePool != 0)
+		thePool->revertToLastCommit();
+	else {
+		Node* nodePtr;
+		NodeIter& theNodeIter = this->getNodes();
+		while ((nodePtr = theNodeIter()) != 0)
+			nodePtr->revertToLastCommit();
+	}
 
 	Element* elePtr;
 	ElementIter& theElemIter = this->getElements();
@@ -2262,6 +2602,20 @@ Domain::revertToStart(void)
 	committedTime = 0;
 	currentTime = 0;
 	dT = 0.0;
+
+#ifdef _CSS
+	// the energies start again from zero
+	NodeIter& theEnergyNodes = this->getNodes();
+	while ((nodePtr = theEnergyNodes()) != 0)
+		nodePtr->resetEnergies();
+	ElementIter& theEnergyElements = this->getElements();
+	while ((elePtr = theEnergyElements()) != 0) {
+		elePtr->resetDampingEnergy();
+		elePtr->resetHystereticEnergy();
+	}
+	this->resetEnergyHistory();
+#endif // _CSS
+
 	// apply load for the last committed time
 	this->applyLoad(currentTime);
 
@@ -2277,13 +2631,32 @@ Domain::update(void)
 
 	int ok = 0;
 
-	// invoke update on all the ele's
+	// invoke update on all the ele's; those with a path independent state
+	// whose nodes did not change since their last update are skipped
+	unsigned long stamp = Node::newTrialStamp();
+	unsigned long firstValid = Element::getFirstValidStamp();
+
 	ElementIter& theEles = this->getElements();
 	Element* theEle;
 
 	while ((theEle = theEles()) != 0) {
+		unsigned long eleStamp = theEle->getUpdateStamp();
+		if (eleStamp != 0 && eleStamp >= firstValid &&
+		    theEle->hasPathIndependentState() == true) {
+			Node** theNodes = theEle->getNodePtrs();
+			int numNodes = theEle->getNumExternalNodes();
+			bool changed = (theNodes == 0);
+			for (int i = 0; i < numNodes && changed == false; i++)
+				if (theNodes[i] == 0 || theNodes[i]->getTrialStamp() > eleStamp)
+					changed = true;
+			if (changed == false)
+				continue;
+		}
+
 		ops_TheActiveElement = theEle;
-		ok += theEle->update();
+		int res = theEle->update();
+		ok += res;
+		theEle->setUpdateStamp(res == 0 ? stamp : 0);
 	}
 
 	if (ok != 0)
@@ -2468,11 +2841,42 @@ Domain::setDomainChangeStamp(int newStamp)
 	currentGeoTag = newStamp;
 }
 
+int
+Domain::setNodalStatePool(bool on)
+{
+	if (on == true) {
+		if (theNodalStatePool == 0)
+			theNodalStatePool = new NodalStatePool();
+	} else if (theNodalStatePool != 0) {
+		// clear() gives the nodes their own state back
+		delete theNodalStatePool;
+		theNodalStatePool = 0;
+	}
+
+	return 0;
+}
+
+NodalStatePool *
+Domain::getNodalStatePool(void)
+{
+	if (theNodalStatePool == 0)
+		return 0;
+
+	// (re)build the blocks if the nodes have changed since last time
+	if (theNodalStatePool->hasNodes() == false)
+		theNodalStatePool->setNodes(*this);
+
+	return theNodalStatePool;
+}
+
 
 void
 Domain::domainChange(void)
 {
 	hasDomainChangedFlag = true;
+#ifdef _CSS
+	energiesFormed = false;
+#endif // _CSS
 }
 
 
@@ -2628,6 +3032,7 @@ Domain::addRecorder(Recorder& theRecorder)
 	for (int i = 0; i < numRecorders; i++) {
 		if (theRecorders[i] == 0) {
 			theRecorders[i] = &theRecorder;
+			MemoryStats::charge(MemoryStats::Recorders, theRecorder.getClassTag(), theRecorder.getClassType());
 			return 0;
 		}
 	}
@@ -2647,6 +3052,8 @@ Domain::addRecorder(Recorder& theRecorder)
 
 	theRecorders = newRecorders;
 	numRecorders++;
+
+	MemoryStats::charge(MemoryStats::Recorders, theRecorder.getClassTag(), theRecorder.getClassType());
 	return 0;
 }
 
@@ -2670,6 +3077,8 @@ Domain::removeRecorders(void)
 
 	theRecorders = 0;
 	numRecorders = 0;
+
+	MemoryStats::clear(MemoryStats::Recorders);
 	return 0;
 }
 
@@ -2683,6 +3092,7 @@ Domain::removeRecorder(int tag)
 				if (this->_DomainEvent_RemoveRecorder)
 					this->_DomainEvent_RemoveRecorder(theRecorders[i]);
 #endif
+				MemoryStats::uncharge(MemoryStats::Recorders, theRecorders[i]->getClassTag(), theRecorders[i]->getClassType());
 				delete theRecorders[i];
 				theRecorders[i] = 0;
 				return 0;
@@ -2693,6 +3103,18 @@ Domain::removeRecorder(int tag)
 	return -1;
 }
 
+int
+Domain::getNumRecorders(void) const
+{
+	// removed recorders leave an empty slot
+	int num = 0;
+	for (int i = 0; i < numRecorders; i++)
+		if (theRecorders[i] != 0)
+			num++;
+
+	return num;
+}
+
 
 
 
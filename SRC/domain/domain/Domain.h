@@ -39,6 +39,9 @@
 
 #include <OPS_Stream.h>
 #include <Vector.h>
+#ifdef _CSS
+#include <vector>
+#endif // _CSS
 class DomainModalProperties;
 
 class Element;
@@ -68,6 +71,7 @@ class SingleDomAllSP_Iter;
 class SingleDomParamIter;
 
 class MeshRegion;
+class NodalStatePool;
 class Recorder;
 class Graph;
 class NodeGraph;
@@ -210,6 +214,10 @@ class Domain
     virtual  int  setRayleighDampingFactors(double alphaM, double betaK, double betaK0, double betaKc);
 #ifdef _CSS
     int recordSingle(int tag);
+
+    // methods for the energies, computed in one pass after each commit
+    int setEnergyBalance(bool on);
+    int getEnergyBalance(Vector &energies);
 #endif // _CSS
 
     virtual  int  commit(void);
@@ -240,11 +248,16 @@ class Domain
     virtual void domainChange(void);    
     virtual void setDomainChangeStamp(int newStamp);
 
+    // methods for the optional struct-of-arrays storage of nodal state
+    int setNodalStatePool(bool on);
+    NodalStatePool *getNodalStatePool(void);
+
 
     // methods for output
     virtual int  addRecorder(Recorder &theRecorder);    	
     virtual int  removeRecorders(void);
     virtual int  removeRecorder(int tag);
+    virtual int  getNumRecorders(void) const;
     virtual int  record(bool fromAnalysis=true);
 
     virtual int  addRegion(MeshRegion &theRegion);    	
@@ -353,6 +366,8 @@ class Domain
 
     int lastChannel;
 
+    NodalStatePool *theNodalStatePool; // 0 if nodes keep their own state
+
     // Integer array: index[i] = tag of component i
     // Should put these in another class eventually -- MHS
     int *paramIndex;
@@ -360,6 +375,26 @@ class Domain
     enum {paramSize_grow = 20};
     int paramSize;
     int numParameters;
+
+#ifdef _CSS
+    // the energy pass: the elements whose energies are tracked, the dof
+    // of element n being from energyStart[n] to energyStart[n+1]-1 in
+    // the force buffers, and if the energy balance is on all the nodes
+    // for the work of the applied loads
+    int computeEnergies(void);
+    int formEnergies(void);
+    void resetEnergyHistory(void);
+    bool energyBalanceOn;
+    bool energiesFormed;
+    int energyTrackingTag;
+    double inputEnergy;
+    std::vector<Element *> energyElements;
+    std::vector<int> energyStart;
+    std::vector<double> prevDampF, prevResF, curDampF, curResF, energyDU;
+    std::vector<Node *> energyNodes;
+    std::vector<int> energyNodeStart;
+    std::vector<double> prevLoad;
+#endif // _CSS
 };
 
 #endif
@@ -35,9 +35,12 @@
 // What: "@(#) LoadBalancer.C, revA"
 
 #include <LoadBalancer.h>
+#include <Graph.h>
+#include <VertexIter.h>
+#include <Vertex.h>
  
 LoadBalancer::LoadBalancer()
-:theDomainPartitioner(0)
+:theDomainPartitioner(0), imbalanceThreshold(0.0)
 {
     
 }
@@ -64,3 +67,47 @@ LoadBalancer::getDomainPartitioner(void)
     return theDomainPartitioner;
 }
 
+void
+LoadBalancer::setImbalanceThreshold(double threshold)
+{
+    if (threshold < 0.0)
+	threshold = 0.0;
+    imbalanceThreshold = threshold;
+}
+
+double
+LoadBalancer::getImbalanceThreshold(void) const
+{
+    return imbalanceThreshold;
+}
+
+bool
+LoadBalancer::needsBalancing(Graph &theWeightedGraph)
+{
+    // with no threshold set we always balance
+    if (imbalanceThreshold <= 0.0)
+	return true;
+
+    // determine max and average load, vertices reporting no cost
+    // (e.g. an empty main partition) are not counted
+    VertexIter &theVertices = theWeightedGraph.getVertices();
+    Vertex *vertexPtr;
+    double maxLoad = 0.0;
+    double sumLoad = 0.0;
+    int numLoaded = 0;
+    while ((vertexPtr = theVertices()) != 0) {
+	double load = vertexPtr->getWeight();
+	if (load > 0.0) {
+	    sumLoad += load;
+	    numLoaded++;
+	    if (load > maxLoad)
+		maxLoad = load;
+	}
+    }
+
+    if (numLoaded < 2)
+	return false;
+
+    double avgLoad = sumLoad/numLoaded;
+    return (maxLoad > (1.0 + imbalanceThreshold)*avgLoad);
+}
@@ -31,6 +31,9 @@
 //
 // Description: This file contains the class definition for LoadBalancer.
 // A LoadBalancer is an object used to partition a PartitionedDomain.
+// If an imbalance threshold is set, balance() is only worth invoking
+// when the ratio of the heaviest vertex weight (the measured subdomain
+// cost) to the average exceeds 1 + threshold.
 //
 // What: "@(#) LoadBalancer.h, revA"
 
@@ -39,6 +42,7 @@
 
 #include <DomainPartitioner.h>
 class Vector;
+class Graph;
 
 
 class LoadBalancer
@@ -51,11 +55,16 @@ class LoadBalancer
     virtual void setLinks(DomainPartitioner &thePartitioner);
     virtual int balance(Graph &theWeightedGraph) =0;
 
+    void setImbalanceThreshold(double threshold);
+    double getImbalanceThreshold(void) const;
+    virtual bool needsBalancing(Graph &theWeightedGraph);
+
   protected:    
     DomainPartitioner *getDomainPartitioner(void);
 	
   private:
     DomainPartitioner *theDomainPartitioner;    
+    double imbalanceThreshold;
 };
 
 #endif
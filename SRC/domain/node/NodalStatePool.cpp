@@ -0,0 +1,414 @@
+/* ****************************************************************** **
+**    OpenSees - Open System for Earthquake Engineering Simulation    **
+**          Pacific Earthquake Engineering Research Center            **
+**                                                                    **
+**                                                                    **
+** (C) Copyright 1999, The Regents of the University of California    **
+** All Rights Reserved.                                               **
+**                                                                    **
+** Commercial use of this program without express permission of the   **
+** University of California, Berkeley, is strictly prohibited.  See   **
+** file 'COPYRIGHT'  in main directory for information on usage and   **
+** redistribution,  and for a DISCLAIMER OF ALL WARRANTIES.           **
+**                                                                    **
+** Developed by:                                                      **
+**   Frank McKenna (fmckenna@ce.berkeley.edu)                         **
+**   Gregory L. Fenves (fenves@ce.berkeley.edu)                       **
+**   Filip C. Filippou (filippou@ce.berkeley.edu)                     **
+**                                                                    **
+** ****************************************************************** */
+
+// Description: This file contains the implementation of NodalStatePool.
+
+#include <NodalStatePool.h>
+#include <Node.h>
+#include <NodeIter.h>
+#include <Domain.h>
+#include <Vector.h>
+#include <classTags.h>
+
+#include <string.h>
+
+// a different tag for each layout of the blocks of all the pools
+static int numLayouts = 0;
+
+// points v at size values starting at data, creating it if needed
+static void
+setVectorData(Vector *&v, double *data, int size)
+{
+  if (v == 0)
+    v = new Vector(data, size);
+  else
+    v->setData(data, size);
+}
+
+NodalStatePool::NodalStatePool()
+:nodesSet(false), layoutTag(0), size(0), disp(0), vel(0), accel(0), load(0)
+{
+
+}
+
+NodalStatePool::~NodalStatePool()
+{
+  this->clear();
+}
+
+int
+NodalStatePool::setNodes(Domain &theDomain)
+{
+  this->clear();
+
+  // determine the nodes that go in the blocks and their offsets
+  Node *theNode;
+  NodeIter &theNodeIter = theDomain.getNodes();
+  while ((theNode = theNodeIter()) != 0) {
+    if (theNode->getClassTag() == NOD_TAG_Node && theNode->thePool == 0) {
+      theNodes.push_back(theNode);
+      offsets.push_back(size);
+      size += theNode->getNumberDOF();
+    } else
+      otherNodes.push_back(theNode);
+  }
+
+  nodesSet = true;
+  layoutTag = ++numLayouts;
+  if (size == 0)
+    return 0;
+
+  disp = new double[4*size];
+  vel = new double[2*size];
+  accel = new double[2*size];
+  load = new double[size];
+  for (int i=0; i<4*size; i++)
+    disp[i] = 0.0;
+  for (int i=0; i<2*size; i++) {
+    vel[i] = 0.0;
+    accel[i] = 0.0;
+  }
+  for (int i=0; i<size; i++)
+    load[i] = 0.0;
+
+  // now move the state of each node into the blocks
+  int numNodes = int(theNodes.size());
+  for (int n=0; n<numNodes; n++) {
+    theNode = theNodes[n];
+    int numDOF = theNode->numberDOF;
+    int stride = theNode->stateStride;
+    double *nodeDisp = disp + offsets[n];
+    double *nodeVel = vel + offsets[n];
+    double *nodeAccel = accel + offsets[n];
+    double *nodeLoad = load + offsets[n];
+
+    if (theNode->disp != 0) {
+      for (int k=0; k<4; k++)
+	for (int i=0; i<numDOF; i++)
+	  nodeDisp[i+k*size] = theNode->disp[i+k*stride];
+      delete [] theNode->disp;
+    }
+    if (theNode->vel != 0) {
+      for (int k=0; k<2; k++)
+	for (int i=0; i<numDOF; i++)
+	  nodeVel[i+k*size] = theNode->vel[i+k*stride];
+      delete [] theNode->vel;
+    }
+    if (theNode->accel != 0) {
+      for (int k=0; k<2; k++)
+	for (int i=0; i<numDOF; i++)
+	  nodeAccel[i+k*size] = theNode->accel[i+k*stride];
+      delete [] theNode->accel;
+    }
+    if (theNode->unbalLoad != 0) {
+      for (int i=0; i<numDOF; i++)
+	nodeLoad[i] = (*theNode->unbalLoad)(i);
+      delete theNode->unbalLoad;
+    }
+
+    theNode->disp = nodeDisp;
+    theNode->vel = nodeVel;
+    theNode->accel = nodeAccel;
+    theNode->stateStride = size;
+    theNode->thePool = this;
+
+    setVectorData(theNode->trialDisp, nodeDisp, numDOF);
+    setVectorData(theNode->commitDisp, nodeDisp + size, numDOF);
+    setVectorData(theNode->incrDisp, nodeDisp + 2*size, numDOF);
+    setVectorData(theNode->incrDeltaDisp, nodeDisp + 3*size, numDOF);
+    setVectorData(theNode->trialVel, nodeVel, numDOF);
+    setVectorData(theNode->commitVel, nodeVel + size, numDOF);
+    setVectorData(theNode->trialAccel, nodeAccel, numDOF);
+    setVectorData(theNode->commitAccel, nodeAccel + size, numDOF);
+    theNode->unbalLoad = new Vector(nodeLoad, numDOF);
+  }
+
+  return 0;
+}
+
+void
+NodalStatePool::clear(void)
+{
+  // give the nodes back arrays of their own
+  int numNodes = int(theNodes.size());
+  for (int n=0; n<numNodes; n++) {
+    Node *theNode = theNodes[n];
+    if (theNode == 0)
+      continue;
+
+    int numDOF = theNode->numberDOF;
+    double *nodeDisp = new double[4*numDOF];
+    double *nodeVel = new double[2*numDOF];
+    double *nodeAccel = new double[2*numDOF];
+    for (int k=0; k<4; k++)
+      for (int i=0; i<numDOF; i++)
+	nodeDisp[i+k*numDOF] = theNode->disp[i+k*size];
+    for (int k=0; k<2; k++)
+      for (int i=0; i<numDOF; i++) {
+	nodeVel[i+k*numDOF] = theNode->vel[i+k*size];
+	nodeAccel[i+k*numDOF] = theNode->accel[i+k*size];
+      }
+    Vector *nodeLoad = new Vector(*theNode->unbalLoad);
+    delete theNode->unbalLoad;
+
+    theNode->disp = nodeDisp;
+    theNode->vel = nodeVel;
+    theNode->accel = nodeAccel;
+    theNode->unbalLoad = nodeLoad;
+    theNode->stateStride = numDOF;
+    theNode->thePool = 0;
+
+    theNode->trialDisp->setData(nodeDisp, numDOF);
+    theNode->commitDisp->setData(nodeDisp + numDOF, numDOF);
+    theNode->incrDisp->setData(nodeDisp + 2*numDOF, numDOF);
+    theNode->incrDeltaDisp->setData(nodeDisp + 3*numDOF, numDOF);
+    theNode->trialVel->setData(nodeVel, numDOF);
+    theNode->commitVel->setData(nodeVel + numDOF, numDOF);
+    theNode->trialAccel->setData(nodeAccel, numDOF);
+    theNode->commitAccel->setData(nodeAccel + numDOF, numDOF);
+  }
+
+  theNodes.clear();
+  offsets.clear();
+  otherNodes.clear();
+
+  if (disp != 0) delete [] disp;
+  if (vel != 0) delete [] vel;
+  if (accel != 0) delete [] accel;
+  if (load != 0) delete [] load;
+  disp = 0;
+  vel = 0;
+  accel = 0;
+  load = 0;
+  size = 0;
+  nodesSet = false;
+  layoutTag = 0;
+}
+
+bool
+NodalStatePool::hasNodes(void) const
+{
+  return nodesSet;
+}
+
+void
+NodalStatePool::removeNode(Node *theNode)
+{
+  // invoked by a node being deleted, its part of the blocks is unused
+  int numNodes = int(theNodes.size());
+  for (int n=0; n<numNodes; n++)
+    if (theNodes[n] == theNode)
+      theNodes[n] = 0;
+
+  int numOther = int(otherNodes.size());
+  for (int n=0; n<numOther; n++)
+    if (otherNodes[n] == theNode)
+      otherNodes[n] = 0;
+}
+
+int
+NodalStatePool::getLayoutTag(void) const
+{
+  return layoutTag;
+}
+
+int
+NodalStatePool::commit(void)
+{
+  int res = 0;
+
+#ifdef _CSS
+  // the energy computations are done node by node
+  int numNodes = int(theNodes.size());
+  for (int n=0; n<numNodes; n++)
+    if (theNodes[n] != 0)
+      res += theNodes[n]->commitState();
+#else
+  // commit = trial, incr = incrDelta = 0
+  if (size != 0) {
+    memcpy(disp + size, disp, size*sizeof(double));
+    memset(disp + 2*size, 0, 2*size*sizeof(double));
+    memcpy(vel + size, vel, size*sizeof(double));
+    memcpy(accel + size, accel, size*sizeof(double));
+  }
+#endif // _CSS
+
+  int numOther = int(otherNodes.size());
+  for (int n=0; n<numOther; n++)
+    if (otherNodes[n] != 0)
+      res += otherNodes[n]->commitState();
+
+  return res;
+}
+
+int
+NodalStatePool::revertToLastCommit(void)
+{
+  int res = 0;
+
+  // mark the nodes whose trial displacements change
+  int numNodes = int(theNodes.size());
+  for (int n=0; n<numNodes; n++) {
+    Node *theNode = theNodes[n];
+    if (theNode == 0)
+      continue;
+    const double *trial = disp + offsets[n];
+    const double *committed = trial + size;
+    for (int i=0; i<theNode->numberDOF; i++)
+      if (trial[i] != committed[i]) {
+	theNode->trialStamp = Node::currentStamp;
+	break;
+      }
+  }
+
+  // trial = commit, incr = incrDelta = 0
+  if (size != 0) {
+    memcpy(disp, disp + size, size*sizeof(double));
+    memset(disp + 2*size, 0, 2*size*sizeof(double));
+    memcpy(vel, vel + size, size*sizeof(double));
+    memcpy(accel, accel + size, size*sizeof(double));
+  }
+
+  int numOther = int(otherNodes.size());
+  for (int n=0; n<numOther; n++)
+    if (otherNodes[n] != 0)
+      res += otherNodes[n]->revertToLastCommit();
+
+  return res;
+}
+
+void
+NodalStatePool::zeroUnbalancedLoad(void)
+{
+  if (size != 0)
+    memset(load, 0, size*sizeof(double));
+
+  int numOther = int(otherNodes.size());
+  for (int n=0; n<numOther; n++)
+    if (otherNodes[n] != 0)
+      otherNodes[n]->zeroUnbalancedLoad();
+}
+
+void
+NodalStatePool::setTrialDisp(const Vector &U, int numNodes, Node *const *node,
+			     const int *start, const int *eqn, const int *loc)
+{
+  // same as Node::setTrialDisp() for the dof given
+  double *trial = disp;
+  const double *committed = disp + size;
+  double *incr = disp + 2*size;
+  double *incrDelta = disp + 3*size;
+  unsigned long stamp = Node::currentStamp;
+
+#pragma omp parallel for
+  for (int n=0; n<numNodes; n++) {
+    bool changed = false;
+    for (int j=start[n]; j<start[n+1]; j++) {
+      int i = loc[j];
+      double tDisp = U(eqn[j]);
+      if (tDisp != trial[i])
+	changed = true;
+      incr[i] = tDisp - committed[i];
+      incrDelta[i] = tDisp - trial[i];
+      trial[i] = tDisp;
+    }
+    if (changed == true)
+      node[n]->trialStamp = stamp;
+  }
+}
+
+void
+NodalStatePool::setTrialVel(const Vector &V, int numDOF,
+			    const int *eqn, const int *loc)
+{
+  double *trial = vel;
+
+#pragma omp parallel for
+  for (int j=0; j<numDOF; j++)
+    trial[loc[j]] = V(eqn[j]);
+}
+
+void
+NodalStatePool::setTrialAccel(const Vector &A, int numDOF,
+			      const int *eqn, const int *loc)
+{
+  double *trial = accel;
+
+#pragma omp parallel for
+  for (int j=0; j<numDOF; j++)
+    trial[loc[j]] = A(eqn[j]);
+}
+
+int
+NodalStatePool::getNumNodes(void) const
+{
+  return int(theNodes.size());
+}
+
+Node *
+NodalStatePool::getNode(int i) const
+{
+  return theNodes[i];
+}
+
+int
+NodalStatePool::getOffset(int i) const
+{
+  return offsets[i];
+}
+
+int
+NodalStatePool::getOffset(const Node *theNode) const
+{
+  if (theNode == 0 || theNode->thePool != this)
+    return -1;
+
+  return int(theNode->disp - disp);
+}
+
+int
+NodalStatePool::getSize(void) const
+{
+  return size;
+}
+
+double *
+NodalStatePool::getDisp(void)
+{
+  return disp;
+}
+
+double *
+NodalStatePool::getVel(void)
+{
+  return vel;
+}
+
+double *
+NodalStatePool::getAccel(void)
+{
+  return accel;
+}
+
+double *
+NodalStatePool::getUnbalancedLoad(void)
+{
+  return load;
+}
@@ -0,0 +1,104 @@
+/* ****************************************************************** **
+**    OpenSees - Open System for Earthquake Engineering Simulation    **
+**          Pacific Earthquake Engineering Research Center            **
+**                                                                    **
+**                                                                    **
+** (C) Copyright 1999, The Regents of the University of California    **
+** All Rights Reserved.                                               **
+**                                                                    **
+** Commercial use of this program without express permission of the   **
+** University of California, Berkeley, is strictly prohibited.  See   **
+** file 'COPYRIGHT'  in main directory for information on usage and   **
+** redistribution,  and for a DISCLAIMER OF ALL WARRANTIES.           **
+**                                                                    **
+** Developed by:                                                      **
+**   Frank McKenna (fmckenna@ce.berkeley.edu)                         **
+**   Gregory L. Fenves (fenves@ce.berkeley.edu)                       **
+**   Filip C. Filippou (filippou@ce.berkeley.edu)                     **
+**                                                                    **
+** ****************************************************************** */
+
+#ifndef NodalStatePool_h
+#define NodalStatePool_h
+
+// Description: This file contains the class definition for NodalStatePool.
+// A NodalStatePool holds the displacements, velocities, accelerations
+// and unbalanced loads of all the Nodes of a Domain in contiguous
+// blocks, one block for each quantity:
+//
+//   disp:  trial | committed | incremental | incremental delta
+//   vel:   trial | committed
+//   accel: trial | committed
+//   load:  unbalanced load
+//
+// each block being of size getSize(), the sum of the number of dof of
+// the nodes, with the dof of node i starting at getOffset(i). The nodes
+// keep working on their part of the blocks, so that the rest of the
+// program is not aware of the pool, while commit() and
+// revertToLastCommit() become copies of whole blocks and integrators
+// can update all the nodes with single loops over them.
+//
+// Nodes of other classes than Node are left out of the blocks; the
+// pool invokes the methods on them one by one.
+//
+// The setTrial methods copy the values of vectors indexed by equation
+// number straight into the trial blocks: loc[j] is the position in the
+// blocks of the dof with equation number eqn[j]. For setTrialDisp() the
+// dof are grouped by node, those of node[n] being from start[n] to
+// start[n+1]-1, so that the incremental displacements and the trial
+// stamps of the nodes can be kept up to date.
+
+#include <vector>
+
+class Node;
+class Vector;
+class Domain;
+
+class NodalStatePool
+{
+  public:
+    NodalStatePool();
+    ~NodalStatePool();
+
+    int setNodes(Domain &theDomain);
+    bool hasNodes(void) const;
+    void clear(void);
+    void removeNode(Node *theNode);
+    int getLayoutTag(void) const;
+
+    // methods invoked by the Domain in place of the node by node ones
+    int commit(void);
+    int revertToLastCommit(void);
+    void zeroUnbalancedLoad(void);
+
+    // scatter of vectors indexed by equation number into the blocks
+    void setTrialDisp(const Vector &U, int numNodes, Node *const *node,
+		      const int *start, const int *eqn, const int *loc);
+    void setTrialVel(const Vector &V, int numDOF,
+		     const int *eqn, const int *loc);
+    void setTrialAccel(const Vector &A, int numDOF,
+		       const int *eqn, const int *loc);
+
+    // access to the blocks
+    int getNumNodes(void) const;
+    Node *getNode(int i) const;
+    int getOffset(int i) const;
+    int getOffset(const Node *theNode) const;
+    int getSize(void) const;
+    double *getDisp(void);
+    double *getVel(void);
+    double *getAccel(void);
+    double *getUnbalancedLoad(void);
+
+  private:
+    std::vector<Node *> theNodes;     // the nodes in the blocks
+    std::vector<int> offsets;         // their first dof in the blocks
+    std::vector<Node *> otherNodes;   // the nodes that are not
+
+    bool nodesSet;                    // setNodes() invoked since clear()
+    int layoutTag;                    // changes whenever the blocks do
+    int size;
+    double *disp, *vel, *accel, *load;
+};
+
+#endif
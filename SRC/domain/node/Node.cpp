@@ -32,6 +32,7 @@
 // What: "@(#) Node.h, revA"
    
 #include <Node.h>
+#include <NodalStatePool.h>
 #include <stdlib.h>
 
 #include <Element.h>
@@ -64,6 +65,7 @@
 
 Matrix **Node::theMatrices = 0;
 int Node::numMatrices = 0;
+unsigned long Node::currentStamp = 1;
 
 int OPS_Node()
 {
@@ -216,9 +218,9 @@ Node::Node(int theClassTag)
  Crd(0), commitDisp(0), commitVel(0), commitAccel(0), 
  trialDisp(0), trialVel(0), trialAccel(0), unbalLoad(0), incrDisp(0), 
  incrDeltaDisp(0),
- disp(0), vel(0), accel(0), dbTag1(0), dbTag2(0), dbTag3(0), dbTag4(0),
+ disp(0), vel(0), accel(0), stateStride(0), thePool(0), dbTag1(0), dbTag2(0), dbTag3(0), dbTag4(0),
  R(0), mass(0), unbalLoadWithInertia(0), alphaM(0.0), theEigenvectors(0), 
- index(-1), reaction(0), displayLocation(0)
+ index(-1), reaction(0), displayLocation(0), trialStamp(currentStamp)
 #ifdef _CSS
 	, prevT(0), curT(0), theAccelSeries(0) , theVelocSeries(0) , kineticEnergy(0), dampEnergy(0), motionEnergy(0), lastCommitAccel(0), lastCommitVel(0), lastCommitDisp(0), theEleConnects(0), numEleConnects(0)
 #endif // _CSS
@@ -243,9 +245,9 @@ Node::Node(int tag, int theClassTag)
  Crd(0), commitDisp(0), commitVel(0), commitAccel(0), 
  trialDisp(0), trialVel(0), trialAccel(0), unbalLoad(0), incrDisp(0),
  incrDeltaDisp(0), 
- disp(0), vel(0), accel(0), dbTag1(0), dbTag2(0), dbTag3(0), dbTag4(0),
+ disp(0), vel(0), accel(0), stateStride(0), thePool(0), dbTag1(0), dbTag2(0), dbTag3(0), dbTag4(0),
   R(0), mass(0), unbalLoadWithInertia(0), alphaM(0.0), theEigenvectors(0), 
- index(-1), reaction(0), displayLocation(0)
+ index(-1), reaction(0), displayLocation(0), trialStamp(currentStamp)
 #ifdef _CSS
     , prevT(0), curT(0), theAccelSeries(0), theVelocSeries(0), kineticEnergy(0), dampEnergy(0), motionEnergy(0), lastCommitAccel(0), lastCommitVel(0), lastCommitDisp(0), theEleConnects(0), numEleConnects(0)
 #endif // _CSS
@@ -269,9 +271,9 @@ Node::Node(int tag, int ndof, double Crd1, Vector *dLoc)
  Crd(0), commitDisp(0), commitVel(0), commitAccel(0), 
  trialDisp(0), trialVel(0), trialAccel(0), unbalLoad(0), incrDisp(0),
  incrDeltaDisp(0), 
- disp(0), vel(0), accel(0), dbTag1(0), dbTag2(0), dbTag3(0), dbTag4(0),
+ disp(0), vel(0), accel(0), stateStride(0), thePool(0), dbTag1(0), dbTag2(0), dbTag3(0), dbTag4(0),
  R(0), mass(0), unbalLoadWithInertia(0), alphaM(0.0), theEigenvectors(0), 
- index(-1), reaction(0), displayLocation(0)
+ index(-1), reaction(0), displayLocation(0), trialStamp(currentStamp)
 #ifdef _CSS
     , prevT(0), curT(0), theAccelSeries(0), theVelocSeries(0), kineticEnergy(0), dampEnergy(0), motionEnergy(0), lastCommitAccel(0), lastCommitVel(0), lastCommitDisp(0), theEleConnects(0), numEleConnects(0)
 #endif // _CSS
@@ -303,9 +305,9 @@ Node::Node(int tag, int ndof, double Crd1, double Crd2, Vector *dLoc)
  Crd(0), commitDisp(0), commitVel(0), commitAccel(0), 
  trialDisp(0), trialVel(0), trialAccel(0), unbalLoad(0), incrDisp(0),
  incrDeltaDisp(0), 
- disp(0), vel(0), accel(0), dbTag1(0), dbTag2(0), dbTag3(0), dbTag4(0),
+ disp(0), vel(0), accel(0), stateStride(0), thePool(0), dbTag1(0), dbTag2(0), dbTag3(0), dbTag4(0),
  R(0), mass(0), unbalLoadWithInertia(0), alphaM(0.0), theEigenvectors(0),
- reaction(0), displayLocation(0)
+ reaction(0), displayLocation(0), trialStamp(currentStamp)
 #ifdef _CSS
     , prevT(0), curT(0), theAccelSeries(0), theVelocSeries(0), kineticEnergy(0), dampEnergy(0), motionEnergy(0), lastCommitAccel(0), lastCommitVel(0), lastCommitDisp(0), theEleConnects(0), numEleConnects(0)
 #endif // _CSS
@@ -340,9 +342,9 @@ Node::Node(int tag, int ndof, double Crd1, double Crd2, Vector *dLoc)
  Crd(0), commitDisp(0), commitVel(0), commitAccel(0), 
  trialDisp(0), trialVel(0), trialAccel(0), unbalLoad(0), incrDisp(0),
  incrDeltaDisp(0), 
- disp(0), vel(0), accel(0), dbTag1(0), dbTag2(0), dbTag3(0), dbTag4(0),
+ disp(0), vel(0), accel(0), stateStride(0), thePool(0), dbTag1(0), dbTag2(0), dbTag3(0), dbTag4(0),
  R(0), mass(0), unbalLoadWithInertia(0), alphaM(0.0), theEigenvectors(0),
- reaction(0), displayLocation(0)
+ reaction(0), displayLocation(0), trialStamp(currentStamp)
 #ifdef _CSS
      , prevT(0), curT(0), theAccelSeries(0), theVelocSeries(0), kineticEnergy(0), dampEnergy(0), motionEnergy(0), lastCommitAccel(0), lastCommitVel(0), lastCommitDisp(0), theEleConnects(0), numEleConnects(0)
 #endif // _CSS
@@ -378,9 +380,9 @@ Node::Node(const Node &otherNode, bool copyMass)
  Crd(0), commitDisp(0), commitVel(0), commitAccel(0), 
  trialDisp(0), trialVel(0), trialAccel(0), unbalLoad(0), incrDisp(0),
  incrDeltaDisp(0), 
- disp(0), vel(0), accel(0), dbTag1(0), dbTag2(0), dbTag3(0), dbTag4(0),
+ disp(0), vel(0), accel(0), stateStride(0), thePool(0), dbTag1(0), dbTag2(0), dbTag3(0), dbTag4(0),
  R(0), mass(0), unbalLoadWithInertia(0), alphaM(0.0), theEigenvectors(0),
-   reaction(0), displayLocation(0)
+   reaction(0), displayLocation(0), trialStamp(currentStamp)
 #ifdef _CSS
     , prevT(0), curT(0), theAccelSeries(0), theVelocSeries(0), kineticEnergy(0), dampEnergy(0), motionEnergy(0), lastCommitAccel(0), lastCommitVel(0), lastCommitDisp(0), theEleConnects(0), numEleConnects(0)
 #endif // _CSS
@@ -409,8 +411,9 @@ Node::Node(const Node &otherNode, bool copyMass)
       opserr << " FATAL Node::Node(node *) - ran out of memory for displacement\n";
       exit(-1);
     }
-    for (int i=0; i<4*numberDOF; i++)
-      disp[i] = otherNode.disp[i];
+    for (int k=0; k<4; k++)
+      for (int i=0; i<numberDOF; i++)
+	disp[i+k*numberDOF] = otherNode.disp[i+k*otherNode.stateStride];
   }    
   
   if (otherNode.commitVel != 0) {
@@ -418,8 +421,9 @@ Node::Node(const Node &otherNode, bool copyMass)
       opserr << " FATAL Node::Node(node *) - ran out of memory for velocity\n";
       exit(-1);
     }
-    for (int i=0; i<2*numberDOF; i++)
-      vel[i] = otherNode.vel[i];
+    for (int k=0; k<2; k++)
+      for (int i=0; i<numberDOF; i++)
+	vel[i+k*numberDOF] = otherNode.vel[i+k*otherNode.stateStride];
   }    
   
   if (otherNode.commitAccel != 0) {
@@ -427,8 +431,9 @@ Node::Node(const Node &otherNode, bool copyMass)
       opserr << " FATAL Node::Node(node *) - ran out of memory for acceleration\n";
       exit(-1);
     }
-    for (int i=0; i<2*numberDOF; i++)
-      accel[i] = otherNode.accel[i];
+    for (int k=0; k<2; k++)
+      for (int i=0; i<numberDOF; i++)
+	accel[i+k*numberDOF] = otherNode.accel[i+k*otherNode.stateStride];
   }    
   
   
@@ -512,14 +517,19 @@ Node::~Node()
     if (unbalLoad != 0)
 	delete unbalLoad;
     
-    if (disp != 0)
+    // the arrays of a node in a NodalStatePool are owned by the pool
+    if (thePool != 0)
+	thePool->removeNode(this);
+    else {
+      if (disp != 0)
 	delete [] disp;
 
-    if (vel != 0)
+      if (vel != 0)
 	delete [] vel;
 
-    if (accel != 0)
+      if (accel != 0)
 	delete [] accel;
+    }
 
     if (mass != 0)
 	delete mass;
@@ -738,8 +748,10 @@ Node::setTrialDisp(double value, int dof)
     // perform the assignment .. we dont't go through Vector interface
     // as we are sure of size and this way is quicker
     double tDisp = value;
-    disp[dof+2*numberDOF] = tDisp - disp[dof+numberDOF];
-    disp[dof+3*numberDOF] = tDisp - disp[dof];	
+    if (tDisp != disp[dof])
+      trialStamp = currentStamp;
+    disp[dof+2*stateStride] = tDisp - disp[dof+stateStride];
+    disp[dof+3*stateStride] = tDisp - disp[dof];	
     disp[dof] = tDisp;
 
     return 0;
@@ -769,8 +781,10 @@ Node::setTrialDisp(const Vector &newTrialDisp)
     // as we are sure of size and this way is quicker
     for (int i=0; i<numberDOF; i++) {
         double tDisp = newTrialDisp(i);
-	disp[i+2*numberDOF] = tDisp - disp[i+numberDOF];
-	disp[i+3*numberDOF] = tDisp - disp[i];	
+	if (tDisp != disp[i])
+	  trialStamp = currentStamp;
+	disp[i+2*stateStride] = tDisp - disp[i+stateStride];
+	disp[i+3*stateStride] = tDisp - disp[i];	
 	disp[i] = tDisp;
     }
 
@@ -842,11 +856,12 @@ Node::incrTrialDisp(const Vector &incrDispl)
 	    opserr << "FATAL Node::incrTrialDisp() - ran out of memory\n";
 	    exit(-1);
 	}    
+	trialStamp = currentStamp;
 	for (int i = 0; i<numberDOF; i++) {
 	  double incrDispI = incrDispl(i);
 	  disp[i] = incrDispI;
-	  disp[i+2*numberDOF] = incrDispI;
-	  disp[i+3*numberDOF] = incrDispI;
+	  disp[i+2*stateStride] = incrDispI;
+	  disp[i+3*stateStride] = incrDispI;
 	}
 	return 0;
     }
@@ -854,9 +869,11 @@ Node::incrTrialDisp(const Vector &incrDispl)
     // otherwise set trial = incr + trial
     for (int i = 0; i<numberDOF; i++) {
 	  double incrDispI = incrDispl(i);
+	  if (incrDispI != 0.0)
+	    trialStamp = currentStamp;
 	  disp[i] += incrDispI;
-	  disp[i+2*numberDOF] += incrDispI;
-	  disp[i+3*numberDOF] = incrDispI;
+	  disp[i+2*stateStride] += incrDispI;
+	  disp[i+3*stateStride] = incrDispI;
     }
 
     return 0;
@@ -1093,9 +1110,9 @@ Node::commitState()
     lastCommitDisp = *commitDisp;
 #endif // _CSS
       for (int i=0; i<numberDOF; i++) {
-	disp[i+numberDOF] = disp[i];  
-        disp[i+2*numberDOF] = 0.0;
-        disp[i+3*numberDOF] = 0.0;
+	disp[i+stateStride] = disp[i];  
+        disp[i+2*stateStride] = 0.0;
+        disp[i+3*stateStride] = 0.0;
       }
     }		    
     
@@ -1105,7 +1122,7 @@ Node::commitState()
 		lastCommitVel = *commitVel;
 #endif // _CSS
 		for (int i=0; i<numberDOF; i++)
-	vel[i+numberDOF] = vel[i];
+	vel[i+stateStride] = vel[i];
     }
     
     // check accel exists, if does set commit = trial        
@@ -1114,7 +1131,7 @@ Node::commitState()
 		lastCommitAccel = *commitAccel;
 #endif // _CSS
 		for (int i=0; i<numberDOF; i++)
-	accel[i+numberDOF] = accel[i];
+	accel[i+stateStride] = accel[i];
     }
 
 #ifdef _CSS
@@ -1138,22 +1155,24 @@ Node::revertToLastCommit()
     // check disp exists, if does set trial = last commit, incr = 0
     if (disp != 0) {
       for (int i=0 ; i<numberDOF; i++) {
-	disp[i] = disp[i+numberDOF];
-	disp[i+2*numberDOF] = 0.0;
-	disp[i+3*numberDOF] = 0.0;
+	if (disp[i] != disp[i+stateStride])
+	  trialStamp = currentStamp;
+	disp[i] = disp[i+stateStride];
+	disp[i+2*stateStride] = 0.0;
+	disp[i+3*stateStride] = 0.0;
       }
     }
     
     // check vel exists, if does set trial = last commit
     if (vel != 0) {
       for (int i=0 ; i<numberDOF; i++)
-	vel[i] = vel[numberDOF+i];
+	vel[i] = vel[stateStride+i];
     }
 
     // check accel exists, if does set trial = last commit
     if (accel != 0) {    
       for (int i=0 ; i<numberDOF; i++)
-	accel[i] = accel[numberDOF+i];
+	accel[i] = accel[stateStride+i];
     }
 
     // if we get here we are done
@@ -1165,21 +1184,25 @@ int
 Node::revertToStart()
 {
     // check disp exists, if does set all to zero
+    trialStamp = currentStamp;
     if (disp != 0) {
-      for (int i=0 ; i<4*numberDOF; i++)
-	disp[i] = 0.0;
+      for (int k=0; k<4; k++)
+	for (int i=0 ; i<numberDOF; i++)
+	  disp[i+k*stateStride] = 0.0;
     }
 
     // check vel exists, if does set all to zero
     if (vel != 0) {
-      for (int i=0 ; i<2*numberDOF; i++)
-	vel[i] = 0.0;
+      for (int k=0; k<2; k++)
+	for (int i=0 ; i<numberDOF; i++)
+	  vel[i+k*stateStride] = 0.0;
     }
 
     // check accel exists, if does set all to zero
     if (accel != 0) {    
-      for (int i=0 ; i<2*numberDOF; i++)
-	accel[i] = 0.0;
+      for (int k=0; k<2; k++)
+	for (int i=0 ; i<numberDOF; i++)
+	  accel[i+k*stateStride] = 0.0;
     }
     
     if (unbalLoad != 0) 
@@ -1580,6 +1603,7 @@ int
 Node::recvSelf(int cTag, Channel &theChannel, 
 	       FEM_ObjectBroker &theBroker)
 {
+    trialStamp = currentStamp;
     int res = 0;
     int dataTag = this->getDbTag();
 
@@ -1629,7 +1653,7 @@ Node::recvSelf(int cTag, Channel &theChannel,
 
       // set the trial quantities equal to committed
       for (int i=0; i<numberDOF; i++)
-	disp[i] = disp[i+numberDOF];  // set trial equal commited
+	disp[i] = disp[i+stateStride];  // set trial equal commited
 
     } else if (commitDisp != 0) {
       // if going back to initial we will just zero the vectors
@@ -1651,7 +1675,7 @@ Node::recvSelf(int cTag, Channel &theChannel,
 
       // set the trial quantity
       for (int i=0; i<numberDOF; i++)
-	vel[i] = vel[i+numberDOF];  // set trial equal commited
+	vel[i] = vel[i+stateStride];  // set trial equal commited
     }
 
     if (data(4) == 0) {
@@ -1667,7 +1691,7 @@ Node::recvSelf(int cTag, Channel &theChannel,
       
       // set the trial values
       for (int i=0; i<numberDOF; i++)
-	accel[i] = accel[i+numberDOF];  // set trial equal commited
+	accel[i] = accel[i+stateStride];  // set trial equal commited
     }
 
     if (data(5) == 0) {
@@ -1880,6 +1904,7 @@ Node::createDisp(void)
   }
   for (int i=0; i<4*numberDOF; i++)
     disp[i] = 0.0;
+  stateStride = numberDOF;
     
   commitDisp = new Vector(&disp[numberDOF], numberDOF); 
   trialDisp = new Vector(disp, numberDOF);
@@ -1907,6 +1932,7 @@ Node::createVel(void)
     }
     for (int i=0; i<2*numberDOF; i++)
       vel[i] = 0.0;
+    stateStride = numberDOF;
     
     commitVel = new Vector(&vel[numberDOF], numberDOF); 
     trialVel = new Vector(vel, numberDOF);
@@ -1931,6 +1957,7 @@ Node::createAccel(void)
     }
     for (int i=0; i<2*numberDOF; i++)
 	accel[i] = 0.0;
+    stateStride = numberDOF;
     
     commitAccel = new Vector(&accel[numberDOF], numberDOF);
     trialAccel = new Vector(accel, numberDOF);
@@ -2286,6 +2313,7 @@ Node::getResponse(NodeResponseType responseType)
 void
 Node::setCrds(double Crd1)
 {
+  trialStamp = currentStamp;
   if (Crd != 0 && Crd->Size() >= 1)
     (*Crd)(0) = Crd1;
 
@@ -2301,6 +2329,7 @@ Node::setCrds(double Crd1)
 void
 Node::setCrds(double Crd1, double Crd2)
 {
+  trialStamp = currentStamp;
   if (Crd != 0 && Crd->Size() >= 2) {
     (*Crd)(0) = Crd1;
     (*Crd)(1) = Crd2;
@@ -2318,6 +2347,7 @@ Node::setCrds(double Crd1, double Crd2)
 void
 Node::setCrds(double Crd1, double Crd2, double Crd3)
 {
+  trialStamp = currentStamp;
   if (Crd != 0 && Crd->Size() >= 3) {
     (*Crd)(0) = Crd1;
     (*Crd)(1) = Crd2;
@@ -2336,6 +2366,7 @@ Node::setCrds(double Crd1, double Crd2, double Crd3)
 void
 Node::setCrds(const Vector &newCrds) 
 {
+  trialStamp = currentStamp;
   if (Crd != 0 && Crd->Size() == newCrds.Size()) {
     (*Crd) = newCrds;
 
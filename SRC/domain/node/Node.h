@@ -48,6 +48,7 @@ class Channel;
 class Renderer;
 
 class DOF_Group;
+class NodalStatePool;
 class NodalThermalAction; //L.Jiang [ SIF ]
 
 #ifdef _CSS
@@ -56,6 +57,8 @@ class TimeSeries;
 
 class Node : public DomainComponent
 {
+  friend class NodalStatePool;
+
   public:
     // constructors
     Node(int classTag);
@@ -170,6 +173,12 @@ class Node : public DomainComponent
     virtual void setCrds(double Crd1, double Crd2, double Crd3);
     virtual void setCrds(const Vector &);
 
+    // stamp of the last change of the trial displacements or coordinates,
+    // compared by Domain::update() with the stamp of the last update of
+    // an element. newTrialStamp() ends the current stamp and returns it
+    unsigned long getTrialStamp(void) const {return trialStamp;};
+    static unsigned long newTrialStamp(void) {return currentStamp++;};
+
 #ifdef _CSS
 	double getKineticEnergy(TimeSeries** velocSeries);
 	double getMotionEnergy(TimeSeries** accelSeries);
@@ -228,6 +237,9 @@ class Node : public DomainComponent
 
     double *disp, *vel, *accel; // double arrays holding the displ, 
                                 // vel and accel values
+    int stateStride;            // distance between the trial, committed
+                                // and incremental values in these arrays
+    NodalStatePool *thePool;    // the pool owning them, if any
 
     int dbTag1, dbTag2, dbTag3, dbTag4; // needed for database
     Matrix *R;                          // nodal participation matrix
@@ -254,6 +266,9 @@ class Node : public DomainComponent
 
     Vector *reaction;
     Vector *displayLocation;
+
+    unsigned long trialStamp;
+    static unsigned long currentStamp;
 };
 
 #endif
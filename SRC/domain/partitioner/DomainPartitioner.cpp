@@ -78,7 +78,10 @@ public:
   NodeLocations(int tag);
   void Print(OPS_Stream &s, int flag =0);  
   int addPartition(int partition);
+  int removePartition(int partition);
+  bool inPartition(int partition) const;
   ID nodePartitions;
+  ID numConnections;   // number of elements (or constraints) holding the node in each partition
   int numPartitions;
 };
 
@@ -87,6 +90,7 @@ public:
 NodeLocations::NodeLocations(int tag)
 :TaggedObject(tag), 
  nodePartitions(0,1), 
+ numConnections(0,1),
  numPartitions(0)
 {
 
@@ -101,11 +105,46 @@ NodeLocations::Print(OPS_Stream &s, int flag)
 int
 NodeLocations::addPartition(int partition)
 {
-  if (nodePartitions.insert(partition) != 1)
+  int loc = nodePartitions.getLocationOrdered(partition);
+  if (loc < 0) {
+    nodePartitions.insert(partition);
     numPartitions++;
+    loc = nodePartitions.getLocationOrdered(partition);
+    for (int i=numPartitions-1; i>loc; i--)
+      numConnections[i] = numConnections[i-1];
+    numConnections[loc] = 0;
+  }
+  numConnections[loc] += 1;
   return 0;
 }
 
+// removes one connection to the partition, returning the number that remain
+int
+NodeLocations::removePartition(int partition)
+{
+  int loc = nodePartitions.getLocationOrdered(partition);
+  if (loc < 0)
+    return -1;
+
+  numConnections[loc] -= 1;
+  int remaining = numConnections(loc);
+  if (remaining <= 0) {
+    nodePartitions.removeValue(partition);
+    for (int i=loc; i<numPartitions-1; i++)
+      numConnections[i] = numConnections(i+1);
+    numPartitions--;
+    numConnections.resize(numPartitions);
+    remaining = 0;
+  }
+  return remaining;
+}
+
+bool
+NodeLocations::inPartition(int partition) const
+{
+  return (nodePartitions.getLocationOrdered(partition) >= 0);
+}
+
 
 //==================================================================================================
 // Some maps that help handling graphs
@@ -127,8 +166,8 @@ typedef MAP_ID::iterator     MAP_ID_ITERATOR;
 
 DomainPartitioner::DomainPartitioner(GraphPartitioner &theGraphPartitioner)
   :  myDomain(0), thePartitioner(theGraphPartitioner), theBalancer(0),
- theElementGraph(0), theBoundaryElements(0), 
- theNodeLocations(0),elementPlace(0), numPartitions(0), partitionFlag(false), usingMainDomain(false)
+ theElementGraph(0),
+ theNodeLocations(0), pinnedElements(0,16), numPartitions(0), partitionFlag(false), usingMainDomain(false)
 {
 
 }    
@@ -136,8 +175,8 @@ DomainPartitioner::DomainPartitioner(GraphPartitioner &theGraphPartitioner)
 DomainPartitioner::DomainPartitioner(GraphPartitioner &theGraphPartitioner,
 				     LoadBalancer &theLoadBalancer)
   :  myDomain(0), thePartitioner(theGraphPartitioner), theBalancer(&theLoadBalancer),
- theElementGraph(0), theBoundaryElements(0),
- theNodeLocations(0),elementPlace(0), numPartitions(0), partitionFlag(false), usingMainDomain(false)
+ theElementGraph(0),
+ theNodeLocations(0), pinnedElements(0,16), numPartitions(0), partitionFlag(false), usingMainDomain(false)
 {
     // set the links the loadBalancer needs
     theLoadBalancer.setLinks(*this);
@@ -146,12 +185,12 @@ DomainPartitioner::DomainPartitioner(GraphPartitioner &theGraphPartitioner,
 
 DomainPartitioner::~DomainPartitioner()
 {
-  if (theBoundaryElements != 0) {
-    for (int i=0; i<numPartitions; i++)
-      if (theBoundaryElements[i] != 0)
-	delete theBoundaryElements[i];
-    delete []theBoundaryElements;
-  }
+  // once partitioned the colored element graph is our own copy
+  if (partitionFlag == true && theElementGraph != 0)
+    delete theElementGraph;
+
+  if (theNodeLocations != 0)
+    delete theNodeLocations;
 }
 
 
@@ -171,6 +210,19 @@ DomainPartitioner::partition(int numParts, bool usingMain, int mainPartitionTag,
   usingMainDomain = usingMain;
   mainPartition = mainPartitionTag;
 
+  // clean up from any previous partitioning
+  if (partitionFlag == true) {
+    if (theElementGraph != 0)
+      delete theElementGraph;
+    theElementGraph = 0;
+    partitionFlag = false;
+  }
+  if (theNodeLocations != 0) {
+    delete theNodeLocations;
+    theNodeLocations = 0;
+  }
+  pinnedElements.resize(0);
+
   // first we ensure the partitioned domain has numpart subdomains
   // with tags 1 through numparts
   for (int i=1; i<=numParts; i++) {
@@ -243,34 +295,6 @@ DomainPartitioner::partition(int numParts, bool usingMain, int mainPartitionTag,
   }
   
       
-  // we create empty graphs for the numParts subdomains,
-  // in the graphs we place the vertices for the elements on the boundaries
-  
-  // we do not invoke the destructor on the individual graphs as 
-  // this would invoke the destructor on the individual vertices
-
-  if (theBoundaryElements != 0)
-    delete [] theBoundaryElements;
-  
-  theBoundaryElements = new Graph * [numParts];
-  if (theBoundaryElements == 0) {
-    opserr << "DomainPartitioner::partition(int numParts)";
-    opserr << " - ran out of memory\n";
-    numPartitions = 0;  
-    return -1;
-  }
-
-  for (int l=0; l<numParts; l++) {
-    theBoundaryElements[l] = new Graph(2048); // graphs can grow larger; just an estimate
-    
-    if (theBoundaryElements[l] == 0) {
-      opserr << "DomainPartitioner::partition(int numParts)";
-      opserr << " - ran out of memory\n";
-      numPartitions = 0;
-      return -1;
-    }
-  }
-  
   numPartitions = numParts;
 
   //  opserr << "DomainPartitioner::partition() - nodes \n";  
@@ -306,12 +330,49 @@ DomainPartitioner::partition(int numParts, bool usingMain, int mainPartitionTag,
   }
 
   //
-  // we now iterate through the vertices of the element graph
-  // to see if the vertex is a boundary vertex or not - if it is
-  // we add to the appropriate graph created above. We also set the
-  // value the color variable of each of the external nodes connected 
-  // to the element to a value which will indicate that that node will
-  // have to be added to the subdomain.
+  // determine the nodes that are constrained or loaded and the elements
+  // carrying elemental loads; elements attached to these are pinned
+  // to their partition, i.e. they are never moved by the load balancer.
+  //
+
+  ID pinnedNodes(0,64);
+
+  MP_ConstraintIter &thePinnedMPs = myDomain->getMPs();
+  MP_Constraint *pinnedMP;
+  while ((pinnedMP = thePinnedMPs()) != 0) {
+    pinnedNodes.insert(pinnedMP->getNodeRetained());
+    pinnedNodes.insert(pinnedMP->getNodeConstrained());
+  }
+
+  SP_ConstraintIter &thePinnedSPs = myDomain->getSPs();
+  SP_Constraint *pinnedSP;
+  while ((pinnedSP = thePinnedSPs()) != 0) 
+    pinnedNodes.insert(pinnedSP->getNodeTag());
+
+  LoadPatternIter &thePinnedPatterns = myDomain->getLoadPatterns();
+  LoadPattern *pinnedPattern;
+  while ((pinnedPattern = thePinnedPatterns()) != 0) {
+    NodalLoadIter &thePinnedNodalLoads = pinnedPattern->getNodalLoads();
+    NodalLoad *pinnedNodalLoad;
+    while ((pinnedNodalLoad = thePinnedNodalLoads()) != 0)
+      pinnedNodes.insert(pinnedNodalLoad->getNodeTag());
+
+    SP_ConstraintIter &thePatternSPs = pinnedPattern->getSPs();
+    while ((pinnedSP = thePatternSPs()) != 0) 
+      pinnedNodes.insert(pinnedSP->getNodeTag());
+
+    ElementalLoadIter &thePinnedEleLoads = pinnedPattern->getElementalLoads();
+    ElementalLoad *pinnedEleLoad;
+    while ((pinnedEleLoad = thePinnedEleLoads()) != 0)
+      pinnedElements.insert(pinnedEleLoad->getElementTag());
+  }
+
+  //
+  // we now iterate through the vertices of the element graph and
+  // add the partition of each element to the locations of all the
+  // nodes connected to the element; the number of elements connecting
+  // a node to a partition is also kept, so that the load balancer can
+  // determine when a node leaves a partition.
   //
   
   opserr << "     + Boundary Nodes.\n";
@@ -321,31 +382,18 @@ DomainPartitioner::partition(int numParts, bool usingMain, int mainPartitionTag,
     int eleTag = vertexPtr->getRef();
     int vertexColor = vertexPtr->getColor();
     
-    // For each element, transverse its neighboring element
-    const ID &adjacency = vertexPtr->getAdjacency();
-    int size = adjacency.Size();
-    for (int i=0; i<size; i++) {
-      Vertex *otherVertex = theElementGraph->getVertexPtr(adjacency(i));
-
-      //If a neighbor has a different color (partition)
-      if (otherVertex->getColor() != vertexColor) {
-
-        //Add it into the boundary elements graph
-	theBoundaryElements[vertexColor-1]->addVertex(vertexPtr,false);
-	i = size;
-      }
-    }
-    
-    //Also for each element, transverse its connected nodes
+    //For each element, transverse its connected nodes
     Element *elePtr = myDomain->getElement(eleTag);
     const ID &nodes = elePtr->getExternalNodes();
-    size = nodes.Size();
+    int size = nodes.Size();
     for (int j=0; j<size; j++) {
       int nodeTag = nodes(j);
+      if (pinnedNodes.getLocationOrdered(nodeTag) >= 0)
+	pinnedElements.insert(eleTag);
       TaggedObject *theTaggedObject = theNodeLocations->getComponentPtr(nodeTag);
       if (theTaggedObject == 0) {
 	opserr << "DomainPartitioner::partition(int numParts)";
-	opserr << " - failed to find NodeLocation in Map for Node: " << nodePtr->getTag() << " -- A BUG!!\n";
+	opserr << " - failed to find NodeLocation in Map for Node: " << nodeTag << " -- A BUG!!\n";
 	numPartitions = 0;
 	return -1;	
       }
@@ -691,7 +739,18 @@ DomainPartitioner::partition(int numParts, bool usingMain, int mainPartitionTag,
   // we invoke change on the PartitionedDomain
   myDomain->domainChange();
 
+  // keep a colored copy of the element graph for load balancing, the
+  // Graph copy constructor does not copy the colors so set them here
+  Graph *theColoredGraph = new Graph(*theElementGraph);
+  VertexIter &theColoredVertices = theElementGraph->getVertices();
+  while ((vertexPtr = theColoredVertices()) != 0) {
+    Vertex *theCopy = theColoredGraph->getVertexPtr(vertexPtr->getTag());
+    if (theCopy != 0)
+      theCopy->setColor(vertexPtr->getColor());
+  }
+
   myDomain->clearElementGraph();
+  theElementGraph = theColoredGraph;
     
   // we are done
   partitionFlag = true;
@@ -731,6 +790,11 @@ DomainPartitioner::balance(Graph &theWeightedPGraph)
 
     if (theBalancer != 0) {
 
+	// only rebalance when the measured costs are out of balance;
+	// this avoids a domainChange() at every commit
+	if (theBalancer->needsBalancing(theWeightedPGraph) == false)
+	  return 0;
+
 	// call on the LoadBalancer to partition		
 
     // timer.start();
@@ -795,24 +859,68 @@ DomainPartitioner::getColoredGraph(void)
       opserr << " - No domain has been set";
       exit(0);
     }
+
+    // once partitioned the element graph is held by the partitioner
+    if (partitionFlag == true && theElementGraph != 0)
+      return *theElementGraph;
     
     return myDomain->getElementGraph();
 }
 
 
+// method to determine the tags of the vertices of partition from that are
+// adjacent to a vertex of another partition; if to is not 0 only vertices
+// adjacent to a vertex in to are returned.
+
+int
+DomainPartitioner::getBoundaryVertices(int from, ID &theVertexTags, int to)
+{
+  theVertexTags.resize(0);
+  int numVertices = 0;
+
+  VertexIter &theVertices = theElementGraph->getVertices();
+  Vertex *vertexPtr;
+  while ((vertexPtr = theVertices()) != 0) {
+    if (vertexPtr->getColor() != from)
+      continue;
+
+    const ID &adjacency = vertexPtr->getAdjacency();
+    int size = adjacency.Size();
+    for (int i=0; i<size; i++) {
+      Vertex *otherVertex = theElementGraph->getVertexPtr(adjacency(i));
+      int otherColor = otherVertex->getColor();
+      if (otherColor != from && (to == 0 || otherColor == to)) {
+	theVertexTags[numVertices++] = vertexPtr->getTag();
+	i = size;
+      }
+    }
+  }
+
+  return numVertices;
+}
+
+
+// method to move the element given by vertexTag from subdomain from to 
+// subdomain to. the nodes of the element are moved with it, nodes that
+// become shared are made external to both subdomains and nodes no longer
+// needed by from are removed from it. returns 1 if the element was moved,
+// 0 if it could not be moved and a negative number on error.
+
 int 
 DomainPartitioner::swapVertex(int from, int to, int vertexTag,
 			      bool adjacentVertexNotInOther)
 {
-  opserr << "DomainPartitioner::swapVertex() " << from << " " << to << " " << vertexTag << endln;
-
-  /*
   // check that the object did the partitioning
   if (partitionFlag == false) {
-    opserr << "DomainPartitioner::balance(const Vector &load)";
+    opserr << "DomainPartitioner::swapVertex";
     opserr << " - not partitioned or DomainPartitioner did not partition\n";
     return -1;
   }
+
+  // elements of the main partition reside in the PartitionedDomain 
+  // itself and are not moved
+  if (from == to || from == mainPartition || to == mainPartition)
+    return 0;
   
   // check that the subdomain exist in partitioned domain
   Subdomain *fromSubdomain = myDomain->getSubdomainPtr(from);
@@ -827,694 +935,142 @@ DomainPartitioner::swapVertex(int from, int to, int vertexTag,
     opserr << to << " exists\n";
     return -3;
   }    
-  
-  // remove the vertex from the boundary if there
-  // if not there we have to get a pointer to it from the ele graph.
-  
-  //    Graph &theEleGraph = myDomain->getElementGraph();    
-  Graph *fromBoundary = theBoundaryElements[from-1];
-  Graph *toBoundary = theBoundaryElements[to-1];    
-  Vertex *vertexPtr;
-  
-  // get a pointer to the vertex in the element graph
-  if (adjacentVertexNotInOther  == false) {
-    vertexPtr = fromBoundary->removeVertex(vertexTag,false);    
-    if (vertexPtr == 0) 
-      vertexPtr = theElementGraph->getVertexPtr(vertexTag);
-
-    if (vertexPtr == 0)  // if still 0 no vertex given by tag exists
-      return -4;
-  } else { // get a pointer and check vertex not adjacent to another partition
-    vertexPtr = fromBoundary->getVertexPtr(vertexTag);    
-    if (vertexPtr == 0) 
-      vertexPtr = theElementGraph->getVertexPtr(vertexTag);
-    if (vertexPtr == 0)  // if still 0 no vertex given by tag exists
-      return -4;	
+
+  Vertex *vertexPtr = theElementGraph->getVertexPtr(vertexTag);
+  if (vertexPtr == 0 || vertexPtr->getColor() != from)
+    return -4;
+
+  // check vertex is adjacent to to and not adjacent to another partition
+  if (adjacentVertexNotInOther == true) {
     const ID &adjacent = vertexPtr->getAdjacency();
     bool inTo = false;
     bool inOther = false;
     int adjacentSize = adjacent.Size();
     for (int i=0; i<adjacentSize; i++) {
       Vertex *other = theElementGraph->getVertexPtr(adjacent(i));
-      if (other->getColor() == to) 
+      int otherColor = other->getColor();
+      if (otherColor == to) 
 	inTo = true;
-      else if (other->getColor() != from) {
+      else if (otherColor != from) {
 	inOther = true;
 	i = adjacentSize;
       }
     }
-    if (inTo != true || inOther == true) // we cannot remove the vertex
-      return -5;
-    // if can remove the vertex from the fromBoundary
-    Vertex *theVertex = fromBoundary->removeVertex(vertexTag,false);
+    if (inTo != true || inOther == true) // we cannot move the vertex
+      return 0;
   }
-  
-  int eleTag = vertexPtr->getRef();
-  
-  //
-  // in the FROM subdomain we:
-  //  1. remove the element
-  //  2. remove all nodes connected to the element divide color by prime
-  //  3. see if have to add nodes back as external
-  //  4. remove from the PartitionedDomain if node was external
-  //  5. add new elements to the boundary vertices for from
-  
-  //  1. remove the element from the fromSubdomain
-    //          this gives us a pointer to the element as well.
-
-    Element *elePtr = fromSubdomain->removeElement(eleTag);
-    if (elePtr == 0) // if ele not there we can just return but ERROR it should be
-  return -6;
-
-    //  2. remove all nodes connected to the element divide color by prime    
-    //  3. add back if still in subdomain
-    //  4. if node external remove from PartitionedDomains external nodes
-    int primeFrom = primes(from);
-    const ID  &nodes1 = elePtr->getExternalNodes(); // create a copy, need after send ele
-    ID  nodes(nodes1);
-
-    int nodesSize = nodes.Size();
-    Node **nodesArray = new Node *[nodesSize];
-    for (int i=0; i<nodesSize; i++) {
-  int nodeTag = nodes(i);
-
-  // remove the node
-  Node *nodePtr = fromSubdomain->removeNode(nodeTag);
-
-  (*nodePlace)(nodeTag) /= primeFrom;
-  nodesArray[i] = nodePtr;
-        // opserr << "DomainPartitioner::swapVertex -NODE " << *nodePtr;
-  // add back as external if still needed
-  if ((*nodePlace)(nodeTag)%primeFrom == 0)
-      fromSubdomain->addExternalNode(nodePtr);
-
-  // if it was external remove from PartitionedDomains external nodes
-  int partition = (*nodePlace)(nodeTag);
-  for (int j=1; j<=numPartitions; j++) 
-      if (j != from) {
-    int prime = primes(j);
-    if (partition%prime == 0) {
-        myDomain->removeExternalNode(nodeTag);
-        j = numPartitions+1;
-    }
-      }
-    }
 
-    // 5. add new elements to boundary vertices of from if connected to
-    //    vertex we just removed and of color of from and not already in boundary
-
-    const ID &eleAdjacent = vertexPtr->getAdjacency();
-    int eleAdjacentSize = eleAdjacent.Size();
+  int eleTag = vertexPtr->getRef();
+  if (pinnedElements.getLocationOrdered(eleTag) >= 0)
+    return 0;
 
-    for (int a=0; a<eleAdjacentSize; a++) {
-	int otherEleVertexTag = eleAdjacent(a);
-	Vertex *other = fromBoundary->getVertexPtr(otherEleVertexTag);
-	if (other == 0) {
-	    other = theElementGraph->getVertexPtr(otherEleVertexTag);
-	    if (other->getColor() == from)
-		fromBoundary->addVertex(other,false);
-	}
+  // remove the element from the fromSubdomain
+  Element *elePtr = fromSubdomain->removeElement(eleTag);
+  if (elePtr == 0) 
+    return -6;
+
+  ID nodes(elePtr->getExternalNodes()); // a copy, needed after ele is added to to
+  int numNodes = nodes.Size();
+
+  for (int i=0; i<numNodes; i++) {
+    int nodeTag = nodes(i);
+    NodeLocations *theLocation = 
+      (NodeLocations *)theNodeLocations->getComponentPtr(nodeTag);
+    if (theLocation == 0) {
+      opserr << "DomainPartitioner::swapVertex - no NodeLocation for node: ";
+      opserr << nodeTag << " -- A BUG!!\n";
+      return -7;
     }
 
+    bool wasInternal = (theLocation->numPartitions == 1);
+    bool wasInTo = theLocation->inPartition(to);
+    int remainingInFrom = theLocation->removePartition(from);
+    theLocation->addPartition(to);
+    bool isInternal = (theLocation->numPartitions == 1);
 
-    
-    // in the TO subdomain we:
-    //  1. remove all nodes connected to the element, may or may not be there
-    //     if there don't divide by primeTo. 
-    //  2. mark all connecting nodes of elements as belonging to To
-    //  3. add the nodes, checking if external or internal
-    //  3. add the element
-    //  4. change the vertex color to be to and add vertex to boundary
-    //     also see if we can reduce the size of boundary
-    //     of boundary of to vertices
-
-    //  1. remove all nodes connected to the element, may or may not be there
-    //      if there divide by primeTo, do this as may have been added as extnl
-    int primeTo = primes(to);
-    for (int l=0; l<nodesSize; l++) {    
-  int nodeTag = nodesArray[l]->getTag();
-  int nodeColor = (*nodePlace)(nodeTag);
-  if (nodeColor % primeTo == 0) {
-      Node *nodePtr;
-      nodePtr = toSubdomain->removeNode(nodes(l));
-  }
-    }
-
+    if (wasInternal == true) {
 
-    for (int m=0; m<nodesSize; m++) {
-  Node *nodePtr = nodesArray[m];
-  int nodeTag = nodePtr->getTag();
-  
-  //  2. mark all connecting nodes of elements as belonging to To      
-  (*nodePlace)(nodeTag) *= primeTo;
-
-  //  3. add the nodes, checking if external or internal  
-  int internal = 0;
-  for (int n=1; n<=numPartitions; n++) 
-      if (n != to) {
-    int prime = primes(n);
-    if ((*nodePlace)(nodeTag)%prime == 0) { // its external
-        internal = 1;
-        n = numPartitions+1;
-    }
+      // the node only existed in from, get it & its current state
+      Node *nodePtr = fromSubdomain->removeNode(nodeTag);
+      if (nodePtr == 0) {
+	opserr << "DomainPartitioner::swapVertex - node: " << nodeTag;
+	opserr << " not in Subdomain: " << from << endln;
+	return -8;
       }
-  
-  if (internal == 0)
-      toSubdomain->addNode(nodePtr);
-  else {
-      toSubdomain->addExternalNode(nodePtr);
-      myDomain->addNode(nodePtr);
-  }
-    }
-
-    delete [] nodesArray; // DELETE nodesArray here should not use nodePtrs
-                          // after here as node objects deleted if parallel    
-    
-    //  3. add the element
-    
-    toSubdomain->addElement(elePtr);
-    
-    //  4. change the vertex color to be to and add vertex to boundary
-    //     also see if we can reduce the size of to's boundary vertices
-
-
-    vertexPtr->setColor(to);
-    toBoundary->addVertex(vertexPtr,false);
-
-    for (int n=0; n<eleAdjacentSize; n++) {
-	int otherEleVertexTag = eleAdjacent(n);
-	Vertex *other = toBoundary->removeVertex(otherEleVertexTag,false);
-	if (other != 0) {
-	    const ID &othersAdjacency = other->getAdjacency();
-	    int otherSize = othersAdjacency.Size();
-	    for (int b=0; b<otherSize; b++) {
-		int anotherEleVertexTag = othersAdjacency(b);
-		Vertex *otherOther = theElementGraph->getVertexPtr(anotherEleVertexTag);
-		if (otherOther->getColor() != to) {
-		    toBoundary->addVertex(other,false);
-		    b=otherSize;
-		}
-	    }
-	}
-    }
 
-
-    // now remove any SP_Constraints that may have been external to 
-    // PartitionedDomain and are now internal to toSubdomain
-    SP_ConstraintIter &theSPs = myDomain->getSPs();
-    SP_Constraint *spPtr;
-    while ((spPtr = theSPs()) != 0) {
-  int nodeTag = spPtr->getNodeTag();
-  for (int i=0; i<nodesSize; i++) {
-      if (nodeTag == nodes(i)) {
-    int internal = 0;
-    for (int j=1; j<=numPartitions; j++) 
-        if (j != to) {
-      int prime = primes(j);
-      if ((*nodePlace)(nodeTag)%prime == 0) {
-          internal = 1;
-          j = numPartitions+1;
+      if (isInternal == true)
+	// node moves with the element
+	toSubdomain->addNode(nodePtr);
+      else {
+	// node is now on the interface of from and to
+	myDomain->addNode(nodePtr);
+	fromSubdomain->addExternalNode(nodePtr);
+	toSubdomain->addExternalNode(nodePtr);
       }
-        }
-    if (internal == 0) { // add to toSubdomain if inteernal
-        myDomain->removeSP_Constraint(spPtr->getTag());
-        toSubdomain->addSP_Constraint(spPtr);
-    }
-      }
-  }
-    }
-
-    
-    
-    // now remove any SP_Constraints that may have been internal to fromSubdomain
-    // and are now external to PartitionedDomain or internal to toSubdomain 
-    SP_ConstraintIter &theSPs2 = fromSubdomain->getSPs();
-    while ((spPtr = theSPs2()) != 0) {
-  int nodeTag = spPtr->getNodeTag();
-  for (int i=0; i<nodesSize; i++) {
-      if (nodeTag == nodes(i)) {
-    fromSubdomain->removeSP_Constraint(spPtr->getTag());
-    int internal = 0;
-    for (int j=1; j<=numPartitions; j++) 
-        if (j != to) {
-      int prime = primes(j);
-      if ((*nodePlace)(nodeTag)%prime == 0) {
-          internal = 1;
-          j = numPartitions+1;
-      }
-        }
-    if (internal == 0) 
-        toSubdomain->addSP_Constraint(spPtr);
-    else
-        myDomain->addSP_Constraint(spPtr);
-      }
-  }
-    }
-
 
+    } else {
 
-  */
-    /*
-    // now remove any NodalLoads that may have been external to 
-    // PartitionedDomain and are now internal to toSubdomain
-    NodalLoadIter &theNodalLoads = myDomain->getNodalLoads();
-    NodalLoad *loadPtr;
-    while ((loadPtr = theNodalLoads()) != 0) {
-  int nodeTag = loadPtr->getNodeTag();
-  for (int i=0; i<nodesSize; i++) {
-      if (nodeTag == nodes(i)) {
-    int internal = 0;
-    for (int j=1; j<=numPartitions; j++) 
-        if (j != to) {
-      int prime = primes(j);
-      if ((*nodePlace)(nodeTag)%prime == 0) {
-          internal = 1;
-          j = numPartitions+1;
+      // the node is on the interface, the PartitionedDomain holds it;
+      // a local Subdomain gives back that node, only the copies
+      // received from a ShadowSubdomain are to be deleted
+      Node *theNode = myDomain->getNode(nodeTag);
+      if (remainingInFrom == 0) {
+	Node *dummy = fromSubdomain->removeNode(nodeTag);
+	if (dummy != 0 && dummy != theNode)
+	  delete dummy;
       }
-        }
-    if (internal == 0) { // add to toSubdomain if inteernal
-        myDomain->removeNodalLoad(loadPtr->getTag());
-        toSubdomain->addNodalLoad(loadPtr);
-    }
-      }
-  }
-    }
 
-
-    // now remove any NodalLoads that may have been internal to fromSubdomain
-    // and are now external to PartitionedDomain or internal to toSubdomain 
-
-    NodalLoadIter &theNodalLoads2 = myDomain->getNodalLoads();
-    while ((loadPtr = theNodalLoads2()) != 0) {
-  int nodeTag = loadPtr->getNodeTag();
-  for (int i=0; i<nodesSize; i++) {
-      if (nodeTag == nodes(i)) {
-    fromSubdomain->removeNodalLoad(loadPtr->getTag());
-    int internal = 0;
-    for (int j=1; j<=numPartitions; j++) 
-        if (j != to) {
-      int prime = primes(j);
-      if ((*nodePlace)(nodeTag)%prime == 0) {
-          internal = 1;
-          j = numPartitions+1;
+      if (isInternal == true) {
+	// only to now holds the node, make it internal to to
+	if (wasInTo == true) {
+	  Node *dummy = toSubdomain->removeNode(nodeTag);
+	  if (dummy != 0 && dummy != theNode)
+	    delete dummy;
+	}
+	Node *nodePtr = myDomain->removeExternalNode(nodeTag);
+	if (nodePtr != 0)
+	  toSubdomain->addNode(nodePtr);
+      } else if (wasInTo == false) {
+	Node *nodePtr = myDomain->getNode(nodeTag);
+	if (nodePtr != 0)
+	  toSubdomain->addExternalNode(nodePtr);
       }
-        }
-    if (internal == 0) 
-        toSubdomain->addNodalLoad(loadPtr);
-    else
-        myDomain->addNodalLoad(loadPtr);
-      }  
-  }
     }
-    */
+  }
 
-    return 0;
+  // add the element & change the vertex color
+  toSubdomain->addElement(elePtr);
+  vertexPtr->setColor(to);
 
+  return 1;
 }
 
 
-
 // method to move from from to to, all elements on the interface of 
 // from that are adjacent with to.
 
 int 
 DomainPartitioner::swapBoundary(int from, int to, bool adjacentVertexNotInOther)
-          
 {
-  opserr << "DomainPartitioner::swapBoundary: from "  << from << " to " << to << endln;
-  /***********************************************************************************
-    opserr << "DomainPartitioner::swapBoundary from " << from << "  to " << to << endln;
-    Timer timer;
-    timer.start();
-
-    // check that the object did the partitioning
-    if (partitionFlag == false) {
-  opserr << "DomainPartitioner::balance(const Vector &load)";
-  opserr << " - not partitioned or DomainPartitioner did not partition\n";
-  return -1;
-    }
-
-    // check that the subdomains exist in partitioned domain
-    Subdomain *fromSubdomain = myDomain->getSubdomainPtr(from);
-    if (fromSubdomain == 0) {
-  opserr << "DomainPartitioner::swapBoundary - No from Subdomain: ";
-  opserr << from << " exists\n";
-  return -2;
-    }
-
-    Subdomain *toSubdomain = myDomain->getSubdomainPtr(to);
-    if (toSubdomain == 0) {
-  opserr << "DomainPartitioner::swapBoundary - No to Subdomain: ";
-  opserr << to << " exists\n";
-  return -3;
-    }    
-
-    // get the element graph
-    //    Graph &theEleGraph = myDomain->getElementGraph();    
-    Graph *fromBoundary = theBoundaryElements[from-1];
-    Graph *toBoundary = theBoundaryElements[to-1];
-
-    // into a new graph place the vertices that are to be swapped
-    Graph *swapVertices = new Graph(fromBoundary->getNumVertex());
-
-    VertexIter &swappableVertices = fromBoundary->getVertices();
-    Vertex *vertexPtr;
-
-    while ((vertexPtr = swappableVertices()) != 0) {
-	if (adjacentVertexNotInOther == false) {   
-	    const ID &adjacency=vertexPtr->getAdjacency();
-	    int size = adjacency.Size();
-	    for (int i=0; i<size; i++) {
-		int otherTag = adjacency(i);
-		Vertex *otherVertex = toBoundary->getVertexPtr(otherTag);
-		if (otherVertex != 0) {
-		    swapVertices->addVertex(vertexPtr,false);
-		    i = size;
-		}
-	    }
-	}
-	else {
-	    const ID &adjacent = vertexPtr->getAdjacency();
-	    bool inTo = false;
-	    bool inOther = false;
-	    int adjacentSize = adjacent.Size();
-	    for (int i=0; i<adjacentSize; i++) {
-		Vertex *other = theElementGraph->getVertexPtr(adjacent(i));
-		if (other->getColor() == to) 
-		    inTo = true;
-		else if (other->getColor() != from) {
-		    inOther = true;
-		    i = adjacentSize;
-		}
-	    }
-	    if (inTo == true && inOther == false) { // we remove the vertex
-		swapVertices->addVertex(vertexPtr,false);
-		vertexPtr->setColor(to);
-	    }
-	}
-    }
-
-    //
-    // in the FROM subdomain we:
-    //  1. remove the elements corresponding to the vertices
-    //  2. remove all nodes connected to the elements divide color by prime
-    //  3. see if have to add nodes back as external
-    //  4. remove from the PartitionedDomain if node was external
-    //  5. add new elements to the boundary vertices for from
-
-    // 1. first remove all the elements from from subdomain
-    VertexIter &verticesToSwap = swapVertices->getVertices();
-
-    int numEleToSwap = swapVertices->getNumVertex();
-    Element **elementsArray = new Element *[numEleToSwap];
-
-    int count =0; 
-    int numCannotRemove =0;
-    for (int i=0; i<numEleToSwap; i++) {
-      vertexPtr = verticesToSwap();
-  if (vertexPtr == 0) 
-      return -1;
-
-  int vertexTag = vertexPtr->getTag();
-  int eleTag = vertexPtr->getRef();
-
-  // remove the vertex from fromBoundary, set color to to
-  // and add to toBoundary
-  bool inFrom = true;
-  vertexPtr = fromBoundary->removeVertex(vertexTag,false);
-
-
-  if (inFrom == true) {
-      vertexPtr->setColor(to);
-      toBoundary->addVertex(vertexPtr,false);
-      Element *elePtr = fromSubdomain->removeElement(eleTag);
-      if (elePtr == 0) // if ele not there we can just return IT SHOULD BE
-    return -4;
-      elementsArray[count] = elePtr;
-      count++;
-  }
-  else  // we cannot remove the element
-      numCannotRemove++;
-    }
-    numEleToSwap -= numCannotRemove;
-
-    //  2. remove all nodes connected to the elements divide color by prime    
-    //     for each element and add back if still in subdomain
-    //  3. add back if still in subdomain
-    //  4. if node external remove from PartitionedDomains external nodes
-
-    // first determine which nodes to remove
-    int primeFrom = primes(from);
-    int primeTo = primes(to);
-    int numNodToSwap = 0;
-    ID nodesToRemove(0,128);
-    for (int j=0; j<numEleToSwap; j++) {
-  Element *elePtr = elementsArray[j];
-  const ID  &nodes = elePtr->getExternalNodes(); 
-  
-  int nodesSize = nodes.Size();
-
-  for (int k=0; k<nodesSize; k++) {
-      int nodeTag = nodes(k);
-      int loc = nodesToRemove.getLocation(nodeTag);
-      if (loc < 0) {
-    nodesToRemove[numNodToSwap] = nodeTag;
-    numNodToSwap++;
-      }
-      (*nodePlace)(nodeTag) /= primeFrom;    
-      (*nodePlace)(nodeTag) *= primeTo;        
-  }
-    }
-
-    // remove the nodes
-    Node **nodesArray = new Node *[numNodToSwap];  
-    for (int k=0; k<numNodToSwap; k++) {
-  int nodeTag = nodesToRemove(k); 
-  Node *nodePtr = fromSubdomain->removeNode(nodeTag);
-  nodesArray[k] = nodePtr;
-
-  // add the node back to from if still external
-  if ((*nodePlace)(nodeTag)%primeFrom == 0)
-      fromSubdomain->addExternalNode(nodePtr);
-
-  // if it was external remove from PartitionedDomains external nodes
-  int partition = (*nodePlace)(nodeTag);
-  for (int j=1; j<=numPartitions; j++) 
-      if (j != from) {
-    int prime = primes(j);
-    if (partition%prime == 0) {
-        myDomain->removeExternalNode(nodeTag);
-        j = numPartitions+1;
-    }
-      }
-    }
-
-    // 5. add new vertices to boundary vertices of from if connected to
-    //    vertex we just removed and of color of from and not already in boundary
-
-    VertexIter &verticesToSwap2 = swapVertices->getVertices();
-    while ((vertexPtr = verticesToSwap2()) != 0) {
-  const ID &vertexAdjacent = vertexPtr->getAdjacency();
-  int vertexAdjacentSize = vertexAdjacent.Size();
-
-	for (int a=0; a<vertexAdjacentSize; a++) {
-	    int otherEleVertexTag = vertexAdjacent(a);
-	    Vertex *other = fromBoundary->getVertexPtr(otherEleVertexTag);
-	    if (other == 0) {
-		other = theElementGraph->getVertexPtr(otherEleVertexTag);
-		if (other->getColor() == from)
-		    fromBoundary->addVertex(other,false);
-	    }
-	}	
-    }
-
-
-    // in the TO subdomain we:
-    //  1. remove all nodes connected to the element, may or may not be there
-    //     if there don't divide by primeTo. 
-    //  2. mark all connecting nodes of elements as belonging to To
-    //  3. add the nodes, checking if external or internal
-    //  3. add the element
-    //  4. change the vertex color to be to and add vertex to boundary
-    //     also see if we can reduce the size of boundary
-    //     of boundary of to vertices
-
-    //  1. remove all nodes connected to the element, may or may not be there
-    //      if there divide by primeTo, do this as may have been added as extnl
-
-    for (int l=0; l<numNodToSwap; l++) {    
-  int nodeTag = nodesArray[l]->getTag();
-  Node *nodePtr;
-  nodePtr = toSubdomain->removeNode(nodesToRemove(l));
-    }
-
-
-    for (int m=0; m<numNodToSwap; m++) {
-  Node *nodePtr = nodesArray[m];
-  int nodeTag = nodePtr->getTag();
-  
-  //  3. add the nodes, checking if external or internal  
-  int internal = 0;
-  for (int n=1; n<=numPartitions; n++) 
-      if (n != to) {
-    int prime = primes(n);
-    if ((*nodePlace)(nodeTag)%prime == 0) { // its external
-        internal = 1;
-        n = numPartitions+1;
-    }
-      }
-  
-  if (internal == 0)
-      toSubdomain->addNode(nodePtr);
-  else {
-      toSubdomain->addExternalNode(nodePtr);
-      myDomain->addNode(nodePtr);
-  }
-    }
-
-
-    delete [] nodesArray; // DELETE nodesArray here should not use nodePtrs
-                          // after here as node objects deleted if parallel    
-    
-    //  3. add the elements
-    for (int a=0; a<numEleToSwap; a++)
-  toSubdomain->addElement(elementsArray[a]);
-
-
-    //  4. change the vertex color to be to and add vertex to boundary
-    //     also see if we can reduce the size of to's boundary vertices
-
-    VertexIter &verticesToSwap3 = swapVertices->getVertices();
-    while ((vertexPtr = verticesToSwap3()) != 0) {
-	const ID &vertexAdjacent = vertexPtr->getAdjacency();
-	int vertexAdjacentSize = vertexAdjacent.Size();
-	for (int n=0; n<vertexAdjacentSize; n++) {
-	    int otherEleVertexTag = vertexAdjacent(n);
-	    Vertex *other = toBoundary->removeVertex(otherEleVertexTag,false);
-	    if (other != 0) {
-		const ID &othersAdjacency = other->getAdjacency();
-		int otherSize = othersAdjacency.Size();
-		for (int b=0; b<otherSize; b++) {
-		    int anotherEleVertexTag = othersAdjacency(b);
-		    Vertex *otherOther 
-			= theElementGraph->getVertexPtr(anotherEleVertexTag);
-		    if (otherOther->getColor() != to) {
-			toBoundary->addVertex(other,false);
-			b=otherSize;
-		    }
-		}
-	    }
-	}
-    }
-
-    // now remove any SP_Constraints that may have been external to 
-    // PartitionedDomain and are now internal to toSubdomain
-    SP_ConstraintIter &theSPs = myDomain->getSPs();
-    SP_Constraint *spPtr;
-    while ((spPtr = theSPs()) != 0) {
-  int nodeTag = spPtr->getNodeTag();
-  int loc = nodesToRemove.getLocation(nodeTag);
-  if (loc >= 0) {
-      int internal = 0;
-      for (int j=1; j<=numPartitions; j++) 
-    if (j != to) {
-        int prime = primes(j);
-        if ((*nodePlace)(nodeTag)%prime == 0) {
-      internal = 1;
-      j = numPartitions+1;
-        }
-    }
-      if (internal == 0) { // add to toSubdomain if inteernal
-    myDomain->removeSP_Constraint(spPtr->getTag());
-    toSubdomain->addSP_Constraint(spPtr);
-      }
+  // check that the object did the partitioning
+  if (partitionFlag == false) {
+    opserr << "DomainPartitioner::swapBoundary";
+    opserr << " - not partitioned or DomainPartitioner did not partition\n";
+    return -1;
   }
-    }
 
-    
-    // now remove any SP_Constraints that may have been internal to fromSubdomain
-    // and are now external to PartitionedDomain or internal to toSubdomain 
-    SP_ConstraintIter &theSPs2 = fromSubdomain->getSPs();
-    while ((spPtr = theSPs2()) != 0) {
-  int nodeTag = spPtr->getNodeTag();
-  int loc = nodesToRemove.getLocation(nodeTag);
-  if (loc >= 0) {
-      fromSubdomain->removeSP_Constraint(spPtr->getTag());
-      int internal = 0;
-      for (int j=1; j<=numPartitions; j++) 
-    if (j != to) {
-        int prime = primes(j);
-        if ((*nodePlace)(nodeTag)%prime == 0) {
-      internal = 1;
-      j = numPartitions+1;
-        }
-    }
-      if (internal == 0) 
-    toSubdomain->addSP_Constraint(spPtr);
-      else
-    myDomain->addSP_Constraint(spPtr);
-  }  
-    }
+  ID theVertexTags(0,256);
+  int numVertices = this->getBoundaryVertices(from, theVertexTags, to);
 
-    // now remove any NodalLoads that may have been external to 
-    // PartitionedDomain and are now internal to toSubdomain
-    NodalLoadIter &theNodalLoads = myDomain->getNodalLoads();
-    NodalLoad *loadPtr;
-    while ((loadPtr = theNodalLoads()) != 0) {
-  int nodeTag = loadPtr->getNodeTag();
-  int loc = nodesToRemove.getLocation(nodeTag);
-  if (loc >= 0) {
-
-      int internal = 0;
-      for (int j=1; j<=numPartitions; j++) 
-    if (j != to) {
-        int prime = primes(j);
-        if ((*nodePlace)(nodeTag)%prime == 0) {
-      internal = 1;
-      j = numPartitions+1;
-        }
-    }
-      if (internal == 0) { // add to toSubdomain if inteernal
-    myDomain->removeNodalLoad(loadPtr->getTag());
-    toSubdomain->addNodalLoad(loadPtr);
-      }
+  int numMoved = 0;
+  for (int i=0; i<numVertices; i++) {
+    int res = this->swapVertex(from, to, theVertexTags(i), adjacentVertexNotInOther);
+    if (res < 0)
+      return res;
+    numMoved += res;
   }
-    }
-
-
-    // now remove any NodalLoads that may have been internal to fromSubdomain
-    // and are now external to PartitionedDomain or internal to toSubdomain 
-
-    NodalLoadIter &theNodalLoads2 = myDomain->getNodalLoads();
-    while ((loadPtr = theNodalLoads2()) != 0) {
-  int nodeTag = loadPtr->getNodeTag();
-  int loc = nodesToRemove.getLocation(nodeTag);
-  if (loc >= 0) {
-      fromSubdomain->removeNodalLoad(loadPtr->getTag());
-      int internal = 0;
-      for (int j=1; j<=numPartitions; j++) 
-    if (j != to) {
-        int prime = primes(j);
-        if ((*nodePlace)(nodeTag)%prime == 0) {
-      internal = 1;
-      j = numPartitions+1;
-        }
-    }
-      if (internal == 0) 
-    toSubdomain->addNodalLoad(loadPtr);
-      else
-    myDomain->addNodalLoad(loadPtr);
-  }  
-    }
-
-
-    delete swapVertices;
 
-    timer.pause();
-    opserr << "DomainPartitioner::swapBoundary DONE" << timer.getReal() << endln;
-
-  ***************************************************************************/
-    return 0;
+  return numMoved;
 }
 
 
@@ -1528,28 +1084,13 @@ DomainPartitioner::releaseVertex(int from,
 {
   // check that the object did the partitioning
   if (partitionFlag == false) {
-    opserr << "DomainPartitioner::balance(const Vector &load)";
+    opserr << "DomainPartitioner::releaseVertex";
     opserr << " - not partitioned or DomainPartitioner did not partition\n";
     return -1;
   }
   
-  // we first check the vertex is on the fromBoundary
-  Subdomain *fromSubdomain = myDomain->getSubdomainPtr(from);
-  if (fromSubdomain == 0) {
-    opserr << "DomainPartitioner::swapVertex - No from Subdomain: ";
-    opserr << from << " exists\n";
-    return -1;
-  }
-
-  // get the vertex from the boundary vertices of from
-  // Graph &theEleGraph = myDomain->getElementGraph();    
-  Graph *fromBoundary = theBoundaryElements[from-1];
-    
-  Vertex *vertexPtr = fromBoundary->getVertexPtr(vertexTag);
-  if (vertexPtr == 0) 
-    vertexPtr = theElementGraph->getVertexPtr(vertexTag);
-  
-  if (vertexPtr == 0)  // if still 0 no vertex given by tag exists
+  Vertex *vertexPtr = theElementGraph->getVertexPtr(vertexTag);
+  if (vertexPtr == 0)  // no vertex given by tag exists
     return -3;
 
   ID attraction(numPartitions+1);
@@ -1567,34 +1108,36 @@ DomainPartitioner::releaseVertex(int from,
   }
   
   // determine the other partition the vertex is most attracted to
-  int partition = 1;
-  int maxAttraction = attraction(1);
-  for (int j=2; j<=numPartitions; j++)
+  int partition = 0;
+  int maxAttraction = 0;
+  for (int j=1; j<=numPartitions; j++)
     if (attraction(j) > maxAttraction) {
       partition = j;
       maxAttraction = attraction(j);
     }
 
+  // not on the boundary
+  if (partition == 0)
+    return 0;
+
   // swap the vertex
   if (mustReleaseToLighter == false)
     return swapVertex(from, partition, vertexTag, adjacentVertexNotInOther);
   
-  else { // check the other partition has a lighter load
-    Vertex *fromVertex = theWeightedPartitionGraph.getVertexPtr(from);
-    Vertex *toVertex = theWeightedPartitionGraph.getVertexPtr(partition);	    
+  // check the other partition has a lighter load
+  Vertex *fromVertex = theWeightedPartitionGraph.getVertexPtr(from);
+  Vertex *toVertex = theWeightedPartitionGraph.getVertexPtr(partition);	    
+  if (fromVertex == 0 || toVertex == 0)
+    return 0;
     
-    double fromWeight = fromVertex->getWeight();
-    double toWeight  = toVertex->getWeight();
+  double fromWeight = fromVertex->getWeight();
+  double toWeight  = toVertex->getWeight();
     
-    if (fromWeight == toWeight)
-      opserr << "DomainPartitioner::releaseVertex - TO CHANGE >= to >\n";
-
-    if (fromWeight >= toWeight) {
-      if (toWeight == 0.0) 
-	return swapVertex(from,partition,vertexTag,adjacentVertexNotInOther);	    
-      if (fromWeight/toWeight > factorGreater)        
-	return swapVertex(from,partition,vertexTag,adjacentVertexNotInOther);	    
-    }
+  if (fromWeight > toWeight) {
+    if (toWeight == 0.0) 
+      return swapVertex(from,partition,vertexTag,adjacentVertexNotInOther);	    
+    if (fromWeight/toWeight > factorGreater)        
+      return swapVertex(from,partition,vertexTag,adjacentVertexNotInOther);	    
   }
   
   return 0;
@@ -1611,47 +1154,66 @@ DomainPartitioner::releaseBoundary(int from,
 {
     // check that the object did the partitioning
     if (partitionFlag == false) {
-      opserr << "DomainPartitioner::balance(const Vector &load)";
+      opserr << "DomainPartitioner::releaseBoundary";
       opserr << " - not partitioned or DomainPartitioner did not partition\n";
       return -1;
     }
 
-    // we first get a pointer to fromSubdomain & the fromBoundary
+    // we first check the fromSubdomain exists
     Subdomain *fromSubdomain = myDomain->getSubdomainPtr(from);
     if (fromSubdomain == 0) {
-      opserr << "DomainPartitioner::swapVertex - No from Subdomain: ";
+      opserr << "DomainPartitioner::releaseBoundary - No from Subdomain: ";
       opserr << from << " exists\n";
       return -1;
     }
 
-    //    Graph &theEleGraph = myDomain->getElementGraph();    
-    Graph *fromBoundary = theBoundaryElements[from-1];
-
-    // into a new graph place the vertices on the fromBoundary
-    // we cannot use fromBoundary as this would empty all the nodes
-    // as fromBoundary changes in called methods
-
-    Graph *swapVertices = new Graph(fromBoundary->getNumVertex());
-
-    VertexIter &swappableVertices = fromBoundary->getVertices();
-    Vertex *vertexPtr;
+    // get the boundary vertices first, as the boundary changes
+    // as the vertices are released
+    ID theVertexTags(0,256);
+    int numVertices = this->getBoundaryVertices(from, theVertexTags);
+    if (numVertices == 0)
+      return 0;
 
-    while ((vertexPtr = swappableVertices()) != 0) 
-      swapVertices->addVertex(vertexPtr,false);
+    // the measured cost of from is shared evenly by its elements; as elements 
+    // are moved the weights are adjusted so that releasing stops once
+    // the partitions are balanced
+    Vertex *fromVertex = theWeightedPartitionGraph.getVertexPtr(from);
+    double eleCost = 0.0;
+    if (fromVertex != 0) {
+      int numFromElements = 0;
+      VertexIter &theVertices = theElementGraph->getVertices();
+      Vertex *vertexPtr;
+      while ((vertexPtr = theVertices()) != 0) 
+	if (vertexPtr->getColor() == from)
+	  numFromElements++;
+      if (numFromElements != 0)
+	eleCost = fromVertex->getWeight()/numFromElements;
+    }
 
-    // release all the vertices in the swapVertices
-    VertexIter &verticesToSwap = swapVertices->getVertices();
-    while ((vertexPtr = verticesToSwap()) != 0)
-      releaseVertex(from,
-		    vertexPtr->getTag(),
-		    theWeightedPartitionGraph,
-		    mustReleaseToLighter,
-		    factorGreater,
-		    adjacentVertexNotInOther);
-    
-    delete swapVertices;    
+    // release all the vertices 
+    int numMoved = 0;
+    for (int i=0; i<numVertices; i++) {
+      int vertexTag = theVertexTags(i);
+      int res = releaseVertex(from,
+			      vertexTag,
+			      theWeightedPartitionGraph,
+			      mustReleaseToLighter,
+			      factorGreater,
+			      adjacentVertexNotInOther);
+      if (res < 0)
+	return res;
+
+      if (res > 0) {
+	numMoved++;
+	Vertex *toVertex = theWeightedPartitionGraph.getVertexPtr(theElementGraph->getVertexPtr(vertexTag)->getColor());
+	if (fromVertex != 0 && toVertex != 0) {
+	  fromVertex->setWeight(fromVertex->getWeight() - eleCost);
+	  toVertex->setWeight(toVertex->getWeight() + eleCost);
+	}
+      }
+    }
 
-    return 0;
+    return numMoved;
 }
 
 
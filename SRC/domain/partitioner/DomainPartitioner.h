@@ -28,6 +28,10 @@
 //
 // Description: This file contains the class definition for DomainPartitioner.
 // A DomainPartitioner is an object used to partition a PartitionedDomain.
+// After partitioning it keeps a colored copy of the element graph so that
+// a LoadBalancer can later migrate elements between the Subdomains.
+// Elements connected to constrained or loaded nodes, or carrying elemental
+// loads, are pinned to their original partition.
 //
 // What: "@(#) DomainPartitioner.h, revA"
 
@@ -98,13 +102,13 @@ class DomainPartitioner
     GraphPartitioner  &thePartitioner;
     LoadBalancer      *theBalancer;    
 
+    int getBoundaryVertices(int from, ID &theVertexTags, int to = 0);
+
     Graph *theElementGraph;
-    Graph **theBoundaryElements; 
     
     TaggedObjectStorage *theNodeLocations;
-    ID *elementPlace;
+    ID pinnedElements;
     int numPartitions;
-    ID primes;
     bool partitionFlag;
     
     bool usingMainDomain;
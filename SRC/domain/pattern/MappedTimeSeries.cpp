@@ -0,0 +1,596 @@
+/* ****************************************************************** **
+**    OpenSees - Open System for Earthquake Engineering Simulation    **
+**          Pacific Earthquake Engineering Research Center            **
+**                                                                    **
+**                                                                    **
+** (C) Copyright 1999, The Regents of the University of California    **
+** All Rights Reserved.                                               **
+**                                                                    **
+** Commercial use of this program without express permission of the   **
+** University of California, Berkeley, is strictly prohibited.  See   **
+** file 'COPYRIGHT'  in main directory for information on usage and   **
+** redistribution,  and for a DISCLAIMER OF ALL WARRANTIES.           **
+**                                                                    **
+** Developed by:                                                      **
+**   Frank McKenna (fmckenna@ce.berkeley.edu)                         **
+**   Gregory L. Fenves (fenves@ce.berkeley.edu)                       **
+**   Filip C. Filippou (filippou@ce.berkeley.edu)                     **
+**                                                                    **
+** ****************************************************************** */
+
+// Purpose: This file contains the class implementation for MappedTimeSeries.
+// The record files are kept in a registry keyed by file name, so all
+// series built on the same file share one read-only mapping which is
+// released when the last of them is destroyed. The registry, the
+// reference counts and the peaks are guarded by theMappedFilesMutex.
+
+#include <MappedTimeSeries.h>
+#include <Vector.h>
+#include <Channel.h>
+#include <Message.h>
+#include <classTags.h>
+#include <elementAPI.h>
+
+#include <math.h>
+#include <string.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <algorithm>
+#include <map>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#ifdef _WIN32
+#include <fstream>
+#else
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+namespace {
+  struct MappedTimeSeriesHeader {
+    char magic[8];
+    int version;
+    int numComponents;
+    long long numPoints;
+    double dt;
+    double startTime;
+  };
+
+  const char mappedTimeSeriesMagic[8] = {'O','P','S','T','S','B','I','N'};
+  const int mappedTimeSeriesVersion = 1;
+}
+
+class MappedTimeSeriesFile
+{
+  public:
+    std::string fileName;
+    int refCount;
+    char *base;            // start of the mapping (or buffer)
+    size_t length;
+    int numComponents;
+    long numPoints;
+    double dt;             // > 0 for a constant time step
+    double startTime;
+    double endTime;
+    const double *times;   // 0 for a constant time step
+    const double *values;
+    std::vector<double> peaks;
+};
+
+static std::map<std::string, MappedTimeSeriesFile *> theMappedFiles;
+static std::mutex theMappedFilesMutex;
+
+static void
+unmapFile(char *base, size_t length)
+{
+#ifdef _WIN32
+  delete [] (double *)base;
+#else
+  munmap(base, length);
+#endif
+}
+
+static void
+releaseMappedFile(MappedTimeSeriesFile *theFile)
+{
+  if (theFile == 0)
+    return;
+
+  std::lock_guard<std::mutex> lock(theMappedFilesMutex);
+
+  theFile->refCount--;
+  if (theFile->refCount > 0)
+    return;
+
+  theMappedFiles.erase(theFile->fileName);
+  unmapFile(theFile->base, theFile->length);
+  delete theFile;
+}
+
+static MappedTimeSeriesFile *
+getMappedFile(const char *fileName)
+{
+  std::lock_guard<std::mutex> lock(theMappedFilesMutex);
+
+  std::map<std::string, MappedTimeSeriesFile *>::iterator it = theMappedFiles.find(fileName);
+  if (it != theMappedFiles.end()) {
+    it->second->refCount++;
+    return it->second;
+  }
+
+  char *base = 0;
+  size_t length = 0;
+
+#ifdef _WIN32
+  std::ifstream theFile(fileName, std::ios::in | std::ios::binary);
+  if (theFile.bad() || !theFile.is_open()) {
+    opserr << "WARNING - MappedTimeSeries - could not open file " << fileName << endln;
+    return 0;
+  }
+  theFile.seekg(0, std::ios::end);
+  length = (size_t)theFile.tellg();
+  theFile.seekg(0, std::ios::beg);
+  base = (char *)(new double[length/sizeof(double) + 1]);
+  theFile.read(base, length);
+  theFile.close();
+#else
+  int fd = open(fileName, O_RDONLY);
+  if (fd < 0) {
+    opserr << "WARNING - MappedTimeSeries - could not open file " << fileName << endln;
+    return 0;
+  }
+  struct stat theStat;
+  if (fstat(fd, &theStat) != 0 || theStat.st_size < (off_t)sizeof(MappedTimeSeriesHeader)) {
+    opserr << "WARNING - MappedTimeSeries - file " << fileName << " is not a binary time series\n";
+    close(fd);
+    return 0;
+  }
+  length = (size_t)theStat.st_size;
+  void *theMap = mmap(0, length, PROT_READ, MAP_SHARED, fd, 0);
+  close(fd);
+  if (theMap == MAP_FAILED) {
+    opserr << "WARNING - MappedTimeSeries - could not map file " << fileName << endln;
+    return 0;
+  }
+  base = (char *)theMap;
+#endif
+
+  // check the header and that the file holds all the data it promises
+  bool ok = length >= sizeof(MappedTimeSeriesHeader);
+  MappedTimeSeriesHeader header;
+  if (ok) {
+    memcpy(&header, base, sizeof(MappedTimeSeriesHeader));
+    ok = memcmp(header.magic, mappedTimeSeriesMagic, 8) == 0 &&
+      header.version == mappedTimeSeriesVersion &&
+      header.numComponents > 0 && header.numPoints > 0;
+  }
+  if (ok) {
+    long long numColumns = header.numComponents + ((header.dt > 0.0) ? 0 : 1);
+    ok = length >= sizeof(MappedTimeSeriesHeader) + numColumns*header.numPoints*sizeof(double);
+  }
+  if (ok == false) {
+    opserr << "WARNING - MappedTimeSeries - file " << fileName << " is not a valid binary time series\n";
+    unmapFile(base, length);
+    return 0;
+  }
+
+  MappedTimeSeriesFile *theMapped = new MappedTimeSeriesFile;
+  theMapped->fileName = fileName;
+  theMapped->refCount = 1;
+  theMapped->base = base;
+  theMapped->length = length;
+
+  theMapped->numComponents = header.numComponents;
+  theMapped->numPoints = (long)header.numPoints;
+  theMapped->dt = header.dt;
+
+  const double *data = (const double *)(base + sizeof(MappedTimeSeriesHeader));
+  if (header.dt > 0.0) {
+    theMapped->times = 0;
+    theMapped->values = data;
+    theMapped->startTime = header.startTime;
+    theMapped->endTime = header.startTime + header.dt*(theMapped->numPoints-1);
+  } else {
+    theMapped->times = data;
+    theMapped->values = data + theMapped->numPoints;
+    theMapped->startTime = data[0];
+    theMapped->endTime = data[theMapped->numPoints-1];
+  }
+  theMapped->peaks.assign(header.numComponents, -1.0);
+
+  theMappedFiles[theMapped->fileName] = theMapped;
+  return theMapped;
+}
+
+void *
+OPS_MappedTimeSeries(void)
+{
+  if (OPS_GetNumRemainingInputArgs() < 2) {
+    opserr << "WARNING insufficient args: timeSeries Mapped tag? fileName? <-component c?> <-factor f?> <-useLast>\n";
+    return 0;
+  }
+
+  int tag = 0;
+  int numData = 1;
+  if (OPS_GetIntInput(numData, &tag) != 0) {
+    opserr << "WARNING invalid tag for Mapped timeSeries\n";
+    return 0;
+  }
+
+  const char *fileName = OPS_GetString();
+  int component = 0;
+  double factor = 1.0;
+  bool useLast = false;
+
+  while (OPS_GetNumRemainingInputArgs() > 0) {
+    const char *opt = OPS_GetString();
+    if (strcmp(opt, "-component") == 0 && OPS_GetNumRemainingInputArgs() > 0) {
+      if (OPS_GetIntInput(numData, &component) != 0) {
+	opserr << "WARNING invalid component for Mapped timeSeries " << tag << endln;
+	return 0;
+      }
+    } else if (strcmp(opt, "-factor") == 0 && OPS_GetNumRemainingInputArgs() > 0) {
+      if (OPS_GetDoubleInput(numData, &factor) != 0) {
+	opserr << "WARNING invalid factor for Mapped timeSeries " << tag << endln;
+	return 0;
+      }
+    } else if (strcmp(opt, "-useLast") == 0) {
+      useLast = true;
+    } else {
+      opserr << "WARNING unknown option " << opt << " for Mapped timeSeries " << tag << endln;
+      return 0;
+    }
+  }
+
+  MappedTimeSeries *theSeries = new MappedTimeSeries(tag, fileName, component, factor, useLast);
+  if (theSeries->getNumDataPoints() == 0) {
+    delete theSeries;
+    return 0;
+  }
+
+  return theSeries;
+}
+
+MappedTimeSeries::MappedTimeSeries()
+  :TimeSeries(TSERIES_TAG_MappedTimeSeries),
+   theFile(0), theValues(0), component(0), currentTimeLoc(0),
+   cFactor(0.0), useLast(false)
+{
+  // does nothing
+}
+
+MappedTimeSeries::MappedTimeSeries(int tag,
+				   const char *fileName,
+				   int comp,
+				   double theFactor,
+				   bool last)
+  :TimeSeries(tag, TSERIES_TAG_MappedTimeSeries),
+   theFile(0), theValues(0), component(comp), currentTimeLoc(0),
+   cFactor(theFactor), useLast(last)
+{
+  this->openFile(fileName);
+}
+
+MappedTimeSeries::~MappedTimeSeries()
+{
+  releaseMappedFile(theFile);
+}
+
+TimeSeries *
+MappedTimeSeries::getCopy(void)
+{
+  if (theFile == 0)
+    return new MappedTimeSeries();
+
+  return new MappedTimeSeries(this->getTag(), theFile->fileName.c_str(),
+			      component, cFactor, useLast);
+}
+
+int
+MappedTimeSeries::openFile(const char *fileName)
+{
+  releaseMappedFile(theFile);
+  theFile = 0;
+  theValues = 0;
+  currentTimeLoc = 0;
+
+  theFile = getMappedFile(fileName);
+  if (theFile == 0)
+    return -1;
+
+  if (component < 0 || component >= theFile->numComponents) {
+    opserr << "WARNING - MappedTimeSeries::MappedTimeSeries() - component " << component;
+    opserr << " not in file " << fileName << " with " << theFile->numComponents << " components\n";
+    releaseMappedFile(theFile);
+    theFile = 0;
+    return -1;
+  }
+
+  theValues = theFile->values + (size_t)component*theFile->numPoints;
+  return 0;
+}
+
+double
+MappedTimeSeries::getFactor(double pseudoTime)
+{
+  // check for a quick return
+  if (theFile == 0)
+    return 0.0;
+
+  long numPoints = theFile->numPoints;
+  if (pseudoTime < theFile->startTime)
+    return 0.0;
+  if (pseudoTime >= theFile->endTime) {
+    if (pseudoTime == theFile->endTime || useLast == true)
+      return cFactor*theValues[numPoints-1];
+    return 0.0;
+  }
+
+  // constant time step, index directly
+  if (theFile->dt > 0.0) {
+    double x = (pseudoTime - theFile->startTime)/theFile->dt;
+    long loc = (long)x;
+    if (loc > numPoints-2)
+      loc = numPoints-2;
+    double value1 = theValues[loc];
+    double value2 = theValues[loc+1];
+    return cFactor*(value1 + (value2-value1)*(x-loc));
+  }
+
+  // explicit times, try the last interval and the one after it before bisecting
+  const double *times = theFile->times;
+  long loc = currentTimeLoc;
+  if (!(times[loc] <= pseudoTime && pseudoTime <= times[loc+1])) {
+    if (loc+2 < numPoints && times[loc+1] <= pseudoTime && pseudoTime <= times[loc+2])
+      loc++;
+    else {
+      loc = (long)(std::upper_bound(times, times+numPoints, pseudoTime) - times) - 1;
+      if (loc > numPoints-2)
+	loc = numPoints-2;
+    }
+    currentTimeLoc = loc;
+  }
+
+  double time1 = times[loc];
+  double time2 = times[loc+1];
+  double value1 = theValues[loc];
+  double value2 = theValues[loc+1];
+  if (time2 == time1)
+    return cFactor*value2;
+
+  return cFactor*(value1 + (value2-value1)*(pseudoTime-time1)/(time2 - time1));
+}
+
+double
+MappedTimeSeries::getDuration()
+{
+  if (theFile == 0)
+    return 0.0;
+
+  return theFile->endTime;
+}
+
+double
+MappedTimeSeries::getPeakFactor()
+{
+  if (theFile == 0)
+    return 0.0;
+
+  // computed once per component of a file, shared by all its series
+  std::lock_guard<std::mutex> lock(theMappedFilesMutex);
+  double &peak = theFile->peaks[component];
+  if (peak < 0.0) {
+    peak = 0.0;
+    for (long i = 0; i < theFile->numPoints; i++) {
+      double temp = fabs(theValues[i]);
+      if (temp > peak)
+	peak = temp;
+    }
+  }
+
+  return peak*cFactor;
+}
+
+int
+MappedTimeSeries::getNumDataPoints(void) const
+{
+  if (theFile == 0)
+    return 0;
+
+  return (int)theFile->numPoints;
+}
+
+double
+MappedTimeSeries::getTimeIncr(double pseudoTime)
+{
+  if (theFile == 0)
+    return 1.0;
+
+  if (theFile->dt > 0.0)
+    return theFile->dt;
+  if (theFile->numPoints < 2)
+    return 1.0;
+
+  this->getFactor(pseudoTime);
+  return theFile->times[currentTimeLoc+1] - theFile->times[currentTimeLoc];
+}
+
+int
+MappedTimeSeries::sendSelf(int commitTag, Channel &theChannel)
+{
+  // only the file name is sent, the receiving process maps the same file
+  int dbTag = this->getDbTag();
+  Vector data(4);
+  data(0) = cFactor;
+  data(1) = component;
+  data(2) = (useLast == true) ? 1 : 0;
+  data(3) = (theFile != 0) ? theFile->fileName.length() : 0;
+
+  int result = theChannel.sendVector(dbTag, commitTag, data);
+  if (result < 0) {
+    opserr << "MappedTimeSeries::sendSelf() - channel failed to send data\n";
+    return result;
+  }
+
+  if (theFile != 0) {
+    Message theMessage((char *)theFile->fileName.c_str(), theFile->fileName.length());
+    result = theChannel.sendMsg(dbTag, commitTag, theMessage);
+    if (result < 0) {
+      opserr << "MappedTimeSeries::sendSelf() - channel failed to send file name\n";
+      return result;
+    }
+  }
+
+  return 0;
+}
+
+int
+MappedTimeSeries::recvSelf(int commitTag, Channel &theChannel,
+			   FEM_ObjectBroker &theBroker)
+{
+  int dbTag = this->getDbTag();
+  Vector data(4);
+  int result = theChannel.recvVector(dbTag, commitTag, data);
+  if (result < 0) {
+    opserr << "MappedTimeSeries::recvSelf() - channel failed to receive data\n";
+    return result;
+  }
+
+  cFactor = data(0);
+  component = (int)data(1);
+  useLast = (data(2) == 1);
+  int length = (int)data(3);
+
+  if (length > 0) {
+    char *fileName = new char[length+1];
+    Message theMessage(fileName, length);
+    result = theChannel.recvMsg(dbTag, commitTag, theMessage);
+    fileName[length] = '\0';
+    if (result < 0) {
+      opserr << "MappedTimeSeries::recvSelf() - channel failed to receive file name\n";
+      delete [] fileName;
+      return result;
+    }
+    if (theFile == 0 || theFile->fileName != fileName)
+      result = this->openFile(fileName);
+    delete [] fileName;
+  }
+
+  return result;
+}
+
+void
+MappedTimeSeries::Print(OPS_Stream &s, int flag)
+{
+  s << "Mapped Time Series: constant factor: " << cFactor;
+  if (theFile != 0) {
+    s << " file: " << theFile->fileName.c_str() << " component: " << component;
+    s << " points: " << (int)theFile->numPoints;
+  }
+  s << endln;
+}
+
+int
+MappedTimeSeries::convertTextFile(const char *textFile, const char *binaryFile,
+				  double dt, double startTime)
+{
+  FILE *in = fopen(textFile, "rb");
+  if (in == 0) {
+    opserr << "WARNING - MappedTimeSeries::convertTextFile() - could not open file " << textFile << endln;
+    return -1;
+  }
+
+  // read the whole file and parse it in place, much faster than streams
+  fseek(in, 0, SEEK_END);
+  long size = ftell(in);
+  fseek(in, 0, SEEK_SET);
+  std::vector<char> buffer(size+1);
+  size_t numRead = fread(&buffer[0], 1, size, in);
+  fclose(in);
+  buffer[numRead] = '\0';
+
+  int numColumns = 0;
+  std::vector<double> data;
+  data.reserve(numRead/8);
+
+  char *current = &buffer[0];
+  bool firstRow = true;
+  while (*current != '\0') {
+    // skip separators, counting the columns on the first row
+    if (*current == ' ' || *current == '\t' || *current == ',' || *current == '\r') {
+      current++;
+      continue;
+    }
+    if (*current == '\n') {
+      if (data.empty() == false)
+	firstRow = false;
+      current++;
+      continue;
+    }
+    char *end = current;
+    double value = strtod(current, &end);
+    if (end == current) {
+      opserr << "WARNING - MappedTimeSeries::convertTextFile() - invalid data in file " << textFile << endln;
+      return -1;
+    }
+    data.push_back(value);
+    if (firstRow == true)
+      numColumns++;
+    current = end;
+  }
+
+  int numComponents = (dt > 0.0) ? numColumns : numColumns-1;
+  if (numComponents < 1 || data.size() % numColumns != 0) {
+    opserr << "WARNING - MappedTimeSeries::convertTextFile() - file " << textFile;
+    opserr << " does not hold rows of equal length";
+    if (dt <= 0.0)
+      opserr << " with a time and at least one value";
+    opserr << endln;
+    return -1;
+  }
+
+  long numPoints = (long)(data.size()/numColumns);
+  if (dt <= 0.0) {
+    for (long i = 1; i < numPoints; i++)
+      if (data[i*numColumns] < data[(i-1)*numColumns]) {
+	opserr << "WARNING - MappedTimeSeries::convertTextFile() - times in file " << textFile;
+	opserr << " are not increasing at row " << (int)i+1 << endln;
+	return -1;
+      }
+  }
+
+  MappedTimeSeriesHeader header;
+  memcpy(header.magic, mappedTimeSeriesMagic, 8);
+  header.version = mappedTimeSeriesVersion;
+  header.numComponents = numComponents;
+  header.numPoints = numPoints;
+  header.dt = (dt > 0.0) ? dt : 0.0;
+  header.startTime = (dt > 0.0) ? startTime : data[0];
+
+  FILE *out = fopen(binaryFile, "wb");
+  if (out == 0) {
+    opserr << "WARNING - MappedTimeSeries::convertTextFile() - could not open file " << binaryFile << endln;
+    return -1;
+  }
+  fwrite(&header, sizeof(MappedTimeSeriesHeader), 1, out);
+
+  // write column after column
+  std::vector<double> column(numPoints);
+  for (int j = 0; j < numColumns; j++) {
+    for (long i = 0; i < numPoints; i++)
+      column[i] = data[i*numColumns + j];
+    if (fwrite(&column[0], sizeof(double), numPoints, out) != (size_t)numPoints) {
+      opserr << "WARNING - MappedTimeSeries::convertTextFile() - failed writing file " << binaryFile << endln;
+      fclose(out);
+      return -1;
+    }
+  }
+  fclose(out);
+
+  return 0;
+}
@@ -0,0 +1,100 @@
+/* ****************************************************************** **
+**    OpenSees - Open System for Earthquake Engineering Simulation    **
+**          Pacific Earthquake Engineering Research Center            **
+**                                                                    **
+**                                                                    **
+** (C) Copyright 1999, The Regents of the University of California    **
+** All Rights Reserved.                                               **
+**                                                                    **
+** Commercial use of this program without express permission of the   **
+** University of California, Berkeley, is strictly prohibited.  See   **
+** file 'COPYRIGHT'  in main directory for information on usage and   **
+** redistribution,  and for a DISCLAIMER OF ALL WARRANTIES.           **
+**                                                                    **
+** Developed by:                                                      **
+**   Frank McKenna (fmckenna@ce.berkeley.edu)                         **
+**   Gregory L. Fenves (fenves@ce.berkeley.edu)                       **
+**   Filip C. Filippou (filippou@ce.berkeley.edu)                     **
+**                                                                    **
+** ****************************************************************** */
+
+#ifndef MappedTimeSeries_h
+#define MappedTimeSeries_h
+
+// Description: This file contains the class definition for MappedTimeSeries.
+// MappedTimeSeries is a TimeSeries class which linear interpolates the
+// load factor from one component of a binary record file. The file is
+// memory mapped and shared by every series (in every load pattern) that
+// refers to it, so very long or multi-component records are neither
+// parsed nor copied. Records with a constant time step are looked up
+// directly, records with explicit times by bisection.
+//
+// The file layout (native byte order) is a header
+//    char   magic[8]       "OPSTSBIN"
+//    int    version        1
+//    int    numComponents
+//    long long numPoints
+//    double dt             (<= 0 if explicit times follow)
+//    double startTime
+// followed by numPoints times if dt <= 0, and then numPoints values for
+// each component, component after component. convertTextFile() writes
+// such a file from a text file with one row per time point.
+//
+// The registry of mapped files is guarded by a mutex, so series may be
+// created, copied and destroyed from any thread.
+
+#include <TimeSeries.h>
+
+class MappedTimeSeriesFile;
+
+class MappedTimeSeries : public TimeSeries
+{
+  public:
+    // constructors
+    MappedTimeSeries(int tag,
+		     const char *fileName,
+		     int component = 0,
+		     double cfactor = 1.0,
+		     bool useLast = false);
+    MappedTimeSeries();
+
+    // destructor
+    ~MappedTimeSeries();
+
+    TimeSeries *getCopy(void);
+
+    // method to get factor
+    double getFactor(double pseudoTime);
+    double getDuration ();
+    double getPeakFactor ();
+    double getTimeIncr (double pseudoTime);
+
+    // methods for output
+    int sendSelf(int commitTag, Channel &theChannel);
+    int recvSelf(int commitTag, Channel &theChannel,
+		 FEM_ObjectBroker &theBroker);
+
+    void Print(OPS_Stream &s, int flag =0);
+
+    // 0 if the file could not be mapped
+    int getNumDataPoints(void) const;
+
+    // convert a text record (rows of values, or of time and values when
+    // dt <= 0) into the binary format read by this class
+    static int convertTextFile(const char *textFile, const char *binaryFile,
+			       double dt = 0.0, double startTime = 0.0);
+
+  protected:
+
+  private:
+    int openFile(const char *fileName);
+
+    MappedTimeSeriesFile *theFile; // shared mapping of the record file
+    const double *theValues;       // start of this component in the mapping
+    int component;        // component of the record used
+    long currentTimeLoc;  // current location in time
+    double cFactor;       // additional factor on the returned load factor
+    bool useLast;
+};
+
+#endif
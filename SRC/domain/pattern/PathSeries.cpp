@@ -205,6 +205,10 @@ void* OPS_PathSeries()
 	    }
 	}
 	theSeries = new PathTimeSeries(tag,timefile,valfile,factor);
+	if (((PathTimeSeries *)theSeries)->getNumDataPoints() == 0) {
+	    delete theSeries;
+	    return 0;
+	}
     }
 
     if(theSeries == 0) {
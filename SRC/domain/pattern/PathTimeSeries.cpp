@@ -322,7 +322,6 @@ PathTimeSeries::getFactor(double pseudoTime)
 
   int size = time->Size();
   int sizem1 = size - 1;
-  int sizem2 = size - 2;
   
   // check we are not at the end
   if (pseudoTime > time1 && currentTimeLoc == sizem1) {
@@ -332,31 +331,43 @@ PathTimeSeries::getFactor(double pseudoTime)
       return cFactor*(*thePath)[sizem1];
   }
 
-  // otherwise go find the current interval
-  double time2 = (*time)(currentTimeLoc+1);
-  if (pseudoTime > time2) {
-    while ((pseudoTime > time2) && (currentTimeLoc < sizem2)) {
-      currentTimeLoc++;
-      time1 = time2;
-      time2 = (*time)(currentTimeLoc+1);
-    }
-    // if pseudo time greater than ending time return 0
-    if (pseudoTime > time2) {
+  // otherwise go find the current interval; a short walk is cheapest when
+  // time advances one step, a bisection when it jumps (e.g. after a revert)
+  double time2 = (currentTimeLoc < sizem1) ? (*time)(currentTimeLoc+1) : time1;
+  if (pseudoTime > time2 || pseudoTime < time1) {
+
+    if (pseudoTime < (*time)(0))
+      return 0.0;
+
+    if (pseudoTime > (*time)(sizem1)) {
+      currentTimeLoc = sizem1;
       if (useLast == false)
         return 0.0;
       else
         return cFactor*(*thePath)[sizem1];
     }
 
-  } else if (pseudoTime < time1) {
-    while ((pseudoTime < time1) && (currentTimeLoc > 0)) {
-      currentTimeLoc--;
-      time2 = time1;	
-      time1 = (*time)(currentTimeLoc);
+    int loc = currentTimeLoc;
+    int numSteps = 0;
+    if (pseudoTime > time2) {
+      while (pseudoTime > (*time)(loc+1) && numSteps < 4) {
+        loc++;
+        numSteps++;
+      }
+      if (pseudoTime > (*time)(loc+1))
+        loc = this->locateTime(pseudoTime);
+    } else {
+      while (pseudoTime < (*time)(loc) && numSteps < 4) {
+        loc--;
+        numSteps++;
+      }
+      if (pseudoTime < (*time)(loc))
+        loc = this->locateTime(pseudoTime);
     }
-    // if starting time less than initial starting time return 0
-    if (pseudoTime < time1)
-      return 0.0;
+
+    currentTimeLoc = loc;
+    time1 = (*time)(loc);
+    time2 = (*time)(loc+1);
   }
 
   double value1 = (*thePath)[currentTimeLoc];
@@ -364,6 +375,22 @@ PathTimeSeries::getFactor(double pseudoTime)
   return cFactor*(value1 + (value2-value1)*(pseudoTime-time1)/(time2 - time1));
 }
 
+int
+PathTimeSeries::locateTime(double pseudoTime) const
+{
+  // bisection for loc with time(loc) <= pseudoTime <= time(loc+1)
+  int low = 0;
+  int high = time->Size() - 1;
+  while (high - low > 1) {
+    int mid = (low + high)/2;
+    if ((*time)(mid) <= pseudoTime)
+      low = mid;
+    else
+      high = mid;
+  }
+  return low;
+}
+
 double
 PathTimeSeries::getDuration()
 {
@@ -377,6 +404,15 @@ PathTimeSeries::getDuration()
   return ((*time)[lastIndex-1]);
 }
 
+int
+PathTimeSeries::getNumDataPoints(void) const
+{
+  if (thePath == 0)
+    return 0;
+
+  return thePath->Size();
+}
+
 double
 PathTimeSeries::getPeakFactor()
 {
@@ -82,10 +82,15 @@ class PathTimeSeries : public TimeSeries
 		 FEM_ObjectBroker &theBroker);
 
     void Print(OPS_Stream &s, int flag =0);    
+
+    // 0 if the data could not be read
+    int getNumDataPoints(void) const;
     
   protected:
     
   private:
+    int locateTime(double pseudoTime) const;
+
     Vector *thePath;      // vector containg the data points
     Vector *time;		  // vector containg the time values of data points
     int currentTimeLoc;   // current location in time
@@ -500,9 +500,21 @@ TclPatternCommand(ClientData clientData, Tcl_Interp *interp,
           return TCL_ERROR;
     }
 
+    // optional number of steps read ahead in the background, 0 to disable
+    int prefetch = H5DRM_PREFETCH_WINDOW;
+    if (argc > 6 && strcmp(argv[5], "-prefetch") == 0)
+    {
+        if (Tcl_GetInt(interp, argv[6], &prefetch) != TCL_OK)
+        {
+            opserr << "WARNING invalid -prefetch steps - want: pattern ";
+            opserr << "H5DRM " << patternID << " filename factor <-prefetch nSteps>\n";
+            return TCL_ERROR;
+        }
+    }
+
         opserr << "Creating H5DRM tag = " << tag << " filename = " << filename.c_str() << " factor = " << factor << endln;
 
-        thePattern = new H5DRM(tag, filename, factor);
+        thePattern = new H5DRM(tag, filename, factor, 1.0, 1e-3, prefetch);
 
         opserr << "Done! Creating H5DRM tag = " << tag << " filename = " << filename.c_str() << " factor = " << factor << endln;
 
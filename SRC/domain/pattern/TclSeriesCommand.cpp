@@ -74,6 +74,7 @@ extern void *OPS_TriangleSeries(void);
 extern void *OPS_TrigSeries(void);
 extern void *OPS_RectangularSeries(void);
 extern void *OPS_PulseSeries(void);
+extern void *OPS_MappedTimeSeries(void);
 extern void *OPS_PeerMotion(void);
 extern void *OPS_PeerNGAMotion(void);
 
@@ -140,6 +141,14 @@ TclTimeSeriesCommand(ClientData clientData,
       theSeries = (TimeSeries *)theResult;
 
   }
+
+  else if ((strcmp(argv[0],"Mapped") == 0) || (strcmp(argv[0],"MappedSeries") == 0))  {
+
+    void *theResult = OPS_MappedTimeSeries();
+    if (theResult != 0)
+      theSeries = (TimeSeries *)theResult;
+
+  }
   
   else if ((strcmp(argv[0],"Series") == 0) ||
 	   (strcmp(argv[0],"Path") == 0)) {
@@ -329,6 +338,10 @@ TclTimeSeriesCommand(ClientData clientData,
       //const char *pwd = getInterpPWD(interp);
       //      simulationInfo.addInputFile(argv[fileName], pwd);  
       theSeries = new PathTimeSeries(tag, argv[fileName], cFactor, useLast);
+      if (((PathTimeSeries *)theSeries)->getNumDataPoints() == 0) {
+	delete theSeries;
+	return 0;
+      }
 
     } else if (filePathName != 0 && fileTimeName != 0) {
       //      const char *pwd = getInterpPWD(interp);
@@ -336,6 +349,10 @@ TclTimeSeriesCommand(ClientData clientData,
       //      simulationInfo.addInputFile(argv[fileTimeName], pwd);  
       theSeries = new PathTimeSeries(tag, argv[filePathName], argv[fileTimeName],
                                      cFactor, useLast); 
+      if (((PathTimeSeries *)theSeries)->getNumDataPoints() == 0) {
+	delete theSeries;
+	return 0;
+      }
 
     } else if (dataPath != 0 && dataTime == 0 && timeIncr != 0.0) {
       theSeries = new PathSeries(tag, *dataPath, timeIncr, cFactor,
@@ -569,7 +586,7 @@ TclTimeSeriesCommand(ClientData clientData,
     opserr << endln;
     // type of load pattern type unknown
     opserr << "WARNING unknown Series type " << argv[0] << " - ";
-    opserr << " valid types: Linear, Rectangular, Path, Constant, Trig, Sine\n";
+    opserr << " valid types: Linear, Rectangular, Path, Mapped, Constant, Trig, Sine\n";
     return 0;
   }
 
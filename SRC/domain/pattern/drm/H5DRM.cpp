@@ -86,18 +86,18 @@ void* OPS_H5DRM()
 
     int num = 1;
     int tag = 0;
-    OPS_GetIntInput(&num, &tag);
+    OPS_GetIntInput(num, &tag);
 
     std::string filename = OPS_GetString();
 
     double factor = 1.0;
-    OPS_GetDoubleInput(&num, &factor);
+    OPS_GetDoubleInput(num, &factor);
 
     double crd_scale = 1.0;
 
     if (OPS_GetNumRemainingInputArgs() < 3)
     {
-        OPS_GetDoubleInput(&num, &crd_scale);
+        OPS_GetDoubleInput(num, &crd_scale);
         opserr << "crd_scale = " << crd_scale << endln;
     }
 
@@ -132,7 +132,9 @@ H5DRM::H5DRM()
       crd_scale(0),
       distance_tolerance(0),
       maxnodetag(0),
-      station_id2data_pos(100)
+      station_id2data_pos(100),
+      prefetch_window(H5DRM_PREFETCH_WINDOW),
+      displacement_prefetcher(0)
 {
     is_initialized = false;
     t1 =  t2 =  tend = 0;
@@ -155,7 +157,8 @@ H5DRM::H5DRM(
     std::string HDF5filename_,
     double cFactor_,
     double crd_scale_,
-    double distance_tolerance_)
+    double distance_tolerance_,
+    int prefetch_window_)
     : LoadPattern(tag, PATTERN_TAG_H5DRM),
       HDF5filename(HDF5filename_),
       DRMForces(100),
@@ -165,7 +168,9 @@ H5DRM::H5DRM(
       crd_scale(crd_scale_),
       distance_tolerance(distance_tolerance_),
       maxnodetag(0),
-      station_id2data_pos(100)
+      station_id2data_pos(100),
+      prefetch_window(prefetch_window_),
+      displacement_prefetcher(0)
 {
 
     id_velocity = id_displacement = id_acceleration = 0;
@@ -438,26 +443,29 @@ void H5DRM::intitialize()
     fprintf(fptr, "$EndElementData\n");
     fclose(fptr);
 
-    sprintf(mshfilename, "drmforces.%d.msh", myrank);
-    fptr = fopen(mshfilename, "w");
-    fprintf(fptr, "$MeshFormat\n");
-    fprintf(fptr, "2.2 0 8\n");
-    fprintf(fptr, "$EndMeshFormat\n");
-    fclose(fptr);
+    if (DEBUG_DRM_FORCES)
+    {
+        sprintf(mshfilename, "drmforces.%d.msh", myrank);
+        fptr = fopen(mshfilename, "w");
+        fprintf(fptr, "$MeshFormat\n");
+        fprintf(fptr, "2.2 0 8\n");
+        fprintf(fptr, "$EndMeshFormat\n");
+        fclose(fptr);
 
-    sprintf(mshfilename, "drmdisplacements.%d.msh", myrank);
-    fptr = fopen(mshfilename, "w");
-    fprintf(fptr, "$MeshFormat\n");
-    fprintf(fptr, "2.2 0 8\n");
-    fprintf(fptr, "$EndMeshFormat\n");
-    fclose(fptr);
+        sprintf(mshfilename, "drmdisplacements.%d.msh", myrank);
+        fptr = fopen(mshfilename, "w");
+        fprintf(fptr, "$MeshFormat\n");
+        fprintf(fptr, "2.2 0 8\n");
+        fprintf(fptr, "$EndMeshFormat\n");
+        fclose(fptr);
 
-    sprintf(mshfilename, "drmaccelerations.%d.msh", myrank);
-    fptr = fopen(mshfilename, "w");
-    fprintf(fptr, "$MeshFormat\n");
-    fprintf(fptr, "2.2 0 8\n");
-    fprintf(fptr, "$EndMeshFormat\n");
-    fclose(fptr);
+        sprintf(mshfilename, "drmaccelerations.%d.msh", myrank);
+        fptr = fopen(mshfilename, "w");
+        fprintf(fptr, "$MeshFormat\n");
+        fprintf(fptr, "2.2 0 8\n");
+        fprintf(fptr, "$EndMeshFormat\n");
+        fclose(fptr);
+    }
 
 
 
@@ -535,6 +543,39 @@ void H5DRM::intitialize()
 
     id_xfer_plist = H5Pcreate( H5P_DATASET_XFER);
 
+    //===========================================================================
+    // Set up reading of the motions, only for the stations of the nodes of
+    // the DRM elements of this process
+    //===========================================================================
+    if (id_displacement > 0)
+    {
+        local_pos2row.resize(Nodes.Size());
+        for (int i = 0; i < Nodes.Size(); ++i)
+            local_pos2row(i) = -1;
+
+        ID data_positions(0, Nodes.Size());
+        for (int e = 0; e < Elements.Size(); ++e)
+        {
+            Element* theElement = theDomain->getElement(Elements(e));
+            const ID& element_nodelist = theElement->getExternalNodes();
+            for (int k = 0; k < element_nodelist.Size(); ++k)
+            {
+                int nodeTag = element_nodelist(k);
+                int station_id = nodetag2station_id[nodeTag];
+                data_positions.insert(station_id2data_pos(station_id));
+            }
+        }
+
+        displacement_prefetcher = new H5DRMPrefetcher(id_displacement, id_xfer_plist, data_positions,
+                number_of_timesteps, prefetch_window, prefetch_window > 0);
+
+        for (int i = 0; i < Nodes.Size(); ++i)
+        {
+            int station_id = nodetag2station_id[Nodes(i)];
+            local_pos2row(nodetag2local_pos[Nodes(i)]) = displacement_prefetcher->getRow(station_id2data_pos(station_id));
+        }
+    }
+
 
 //===========================================================================
 // Set status to initialized and ready to compute loads
@@ -566,6 +607,10 @@ H5DRM::~H5DRM()
 
 void H5DRM::clean_all_data()
 {
+    // stop reading before the datasets are closed
+    if (displacement_prefetcher != 0)
+        delete displacement_prefetcher;
+    displacement_prefetcher = 0;
 
     nodetag2station_id.clear();
     nodetag2local_pos.clear();
@@ -694,48 +739,51 @@ H5DRM::applyLoad(double time)
         FILE* fptr_accel = 0;
 
         static int step = 0;
-        char mshfilename[100];
 
-        // drmforces
-        sprintf(mshfilename, "drmforces.%d.msh", myrank);
-        fptr_forces = fopen(mshfilename, "a");
-        // drmdisplacements
-        sprintf(mshfilename, "drmdisplacements.%d.msh", myrank);
-        fptr_displ = fopen(mshfilename, "a");
-        // drmaccelerations
-        sprintf(mshfilename, "drmaccelerations.%d.msh", myrank);
-        fptr_accel = fopen(mshfilename, "a");
+        if (DEBUG_DRM_FORCES)
+        {
+            char mshfilename[100];
+
+            // drmforces
+            sprintf(mshfilename, "drmforces.%d.msh", myrank);
+            fptr_forces = fopen(mshfilename, "a");
+            // drmdisplacements
+            sprintf(mshfilename, "drmdisplacements.%d.msh", myrank);
+            fptr_displ = fopen(mshfilename, "a");
+            // drmaccelerations
+            sprintf(mshfilename, "drmaccelerations.%d.msh", myrank);
+            fptr_accel = fopen(mshfilename, "a");
         
-        fprintf(fptr_forces, "$NodeData\n");
-        fprintf(fptr_forces, "    1\n");
-        fprintf(fptr_forces, "\"DRM Forces\"\n");
-        fprintf(fptr_forces, "1\n");
-        fprintf(fptr_forces, "%f\n", time);
-        fprintf(fptr_forces, "3\n");
-        fprintf(fptr_forces, "%d\n", step);
-        fprintf(fptr_forces, "3\n");
-        fprintf(fptr_forces, "%d\n", Nodes.Size());
-
-        fprintf(fptr_displ, "$NodeData\n");
-        fprintf(fptr_displ, "    1\n");
-        fprintf(fptr_displ, "\"DRM Displacements\"\n");
-        fprintf(fptr_displ, "1\n");
-        fprintf(fptr_displ, "%f\n", time);
-        fprintf(fptr_displ, "3\n");
-        fprintf(fptr_displ, "%d\n", step);
-        fprintf(fptr_displ, "3\n");
-        fprintf(fptr_displ, "%d\n", Nodes.Size());
-
-        fprintf(fptr_accel, "$NodeData\n");
-        fprintf(fptr_accel, "    1\n");
-        fprintf(fptr_accel, "\"DRM Acceleration\"\n");
-        fprintf(fptr_accel, "1\n");
-        fprintf(fptr_accel, "%f\n", time);
-        fprintf(fptr_accel, "3\n");
-        fprintf(fptr_accel, "%d\n", step);
-        fprintf(fptr_accel, "3\n");
-        fprintf(fptr_accel, "%d\n", Nodes.Size());
-
+            fprintf(fptr_forces, "$NodeData\n");
+            fprintf(fptr_forces, "    1\n");
+            fprintf(fptr_forces, "\"DRM Forces\"\n");
+            fprintf(fptr_forces, "1\n");
+            fprintf(fptr_forces, "%f\n", time);
+            fprintf(fptr_forces, "3\n");
+            fprintf(fptr_forces, "%d\n", step);
+            fprintf(fptr_forces, "3\n");
+            fprintf(fptr_forces, "%d\n", Nodes.Size());
+
+            fprintf(fptr_displ, "$NodeData\n");
+            fprintf(fptr_displ, "    1\n");
+            fprintf(fptr_displ, "\"DRM Displacements\"\n");
+            fprintf(fptr_displ, "1\n");
+            fprintf(fptr_displ, "%f\n", time);
+            fprintf(fptr_displ, "3\n");
+            fprintf(fptr_displ, "%d\n", step);
+            fprintf(fptr_displ, "3\n");
+            fprintf(fptr_displ, "%d\n", Nodes.Size());
+
+            fprintf(fptr_accel, "$NodeData\n");
+            fprintf(fptr_accel, "    1\n");
+            fprintf(fptr_accel, "\"DRM Acceleration\"\n");
+            fprintf(fptr_accel, "1\n");
+            fprintf(fptr_accel, "%f\n", time);
+            fprintf(fptr_accel, "3\n");
+            fprintf(fptr_accel, "%d\n", step);
+            fprintf(fptr_accel, "3\n");
+            fprintf(fptr_accel, "%d\n", Nodes.Size());
+        }
 
         ++step;
 
@@ -760,19 +808,25 @@ H5DRM::applyLoad(double time)
                 load(2) = DRMForces(3 * local_pos + 2);
             }
 
-            fprintf(fptr_forces, "%d %f %f %f\n", nodeTag, load(0), load(1), load(2));
-            fprintf(fptr_displ, "%d %f %f %f\n", nodeTag, DRMDisplacements(3 * local_pos + 0), DRMDisplacements(3 * local_pos + 1), DRMDisplacements(3 * local_pos + 2));
-            fprintf(fptr_accel, "%d %f %f %f\n", nodeTag, DRMAccelerations(3 * local_pos + 0), DRMAccelerations(3 * local_pos + 1), DRMAccelerations(3 * local_pos + 2));
+            if (DEBUG_DRM_FORCES)
+            {
+                fprintf(fptr_forces, "%d %f %f %f\n", nodeTag, load(0), load(1), load(2));
+                fprintf(fptr_displ, "%d %f %f %f\n", nodeTag, DRMDisplacements(3 * local_pos + 0), DRMDisplacements(3 * local_pos + 1), DRMDisplacements(3 * local_pos + 2));
+                fprintf(fptr_accel, "%d %f %f %f\n", nodeTag, DRMAccelerations(3 * local_pos + 0), DRMAccelerations(3 * local_pos + 1), DRMAccelerations(3 * local_pos + 2));
+            }
 
             //Add to current nodal unbalanced load
             theNode->addUnbalancedLoad(load);
         }
-        fprintf(fptr_forces, "$EndNodeData\n");
-        fclose(fptr_forces);
-        fprintf(fptr_displ, "$EndNodeData\n");
-        fclose(fptr_displ);
-        fprintf(fptr_accel, "$EndNodeData\n");
-        fclose(fptr_accel);
+        if (DEBUG_DRM_FORCES)
+        {
+            fprintf(fptr_forces, "$EndNodeData\n");
+            fclose(fptr_forces);
+            fprintf(fptr_displ, "$EndNodeData\n");
+            fclose(fptr_displ);
+            fprintf(fptr_accel, "$EndNodeData\n");
+            fclose(fptr_accel);
+        }
     }
 }
 
@@ -962,7 +1016,7 @@ bool H5DRM::drm_direct_read(double t)
 bool H5DRM::drm_differentiate_displacements(double t)
 {
 
-    if (Nodes.Size() == 0)
+    if (Nodes.Size() == 0 || displacement_prefetcher == 0)
         return false;
 
     DRMDisplacements.Zero();
@@ -980,27 +1034,36 @@ bool H5DRM::drm_differentiate_displacements(double t)
 
     double dtau = (t - t1)/(t2-t1);
 
-    id_displacement_dataspace = H5Dget_space(id_displacement);
-    hsize_t i_first = i1 - 1;
-    hsize_t i_last  = i1 + 2;
-
-    i_first = i_first < 0 ? 0 : i_first;
-    i_first = i_first > (hsize_t) number_of_timesteps-1 ? number_of_timesteps-1 : i_first;
-
-    i_last = i_last < 0 ? 0 : i_last;
-    i_last = i_last > (hsize_t) number_of_timesteps-1 ? number_of_timesteps-1 : i_last;
-
-    hsize_t i_len = (i_last - i_first) + 1; 
-    H5DRMout << "t = " << t 
-        << " dt = " << dt 
-        << " i1 = " << i1 
-        << " i2 = " << i2 
-        << " i_first = " << i_first
-        << " i_last = " << i_last
-        << " i_len = " << i_len
-        << " t1 = " << t1 
-        << " t2 = " << t2 
-        << " dtau = " << dtau << endln;
+    // steps i1-1 .. i1+2 are needed, clamped to the dataset
+    int i_step[H5DRM_STENCIL_STEPS];
+    for (int k = 0; k < H5DRM_STENCIL_STEPS; ++k)
+    {
+        int i = i1 - 1 + k;
+        i = i < 0 ? 0 : i;
+        i = i > number_of_timesteps-1 ? number_of_timesteps-1 : i;
+        i_step[k] = i;
+    }
+    int i_first = i_step[0];
+    int i_last  = i_step[H5DRM_STENCIL_STEPS-1];
+
+    if (DEBUG_DRM_INTEGRATION)
+        H5DRMout << "t = " << t 
+            << " dt = " << dt 
+            << " i1 = " << i1 
+            << " i2 = " << i2 
+            << " i_first = " << i_first
+            << " i_last = " << i_last
+            << " t1 = " << t1 
+            << " t2 = " << t2 
+            << " dtau = " << dtau << endln;
+
+    // the motion is taken as zero during the first steps
+    bool have_data = i1 > 2;
+    if (have_data && !displacement_prefetcher->fetch(i_first, i_last))
+    {
+        H5DRMerror << "Failed to read displacement array for steps " << i_first << " to " << i_last << "!!\n";
+        exit(-1);
+    }
 
     double umax = -std::numeric_limits<double>::infinity();
     double amax = -std::numeric_limits<double>::infinity();
@@ -1013,56 +1076,20 @@ bool H5DRM::drm_differentiate_displacements(double t)
     for (int n = 0; n < Nodes.Size(); ++n)
     {
         int nodeTag = Nodes(n);
-        int station_id = nodetag2station_id[nodeTag];
-        int data_pos = station_id2data_pos[station_id];
         int local_pos = nodetag2local_pos[nodeTag];
+        int row = local_pos2row(local_pos);
+
+        // not on a DRM element of this process
+        if (row < 0)
+            continue;
         
-        double d0[3][4];
+        double d0[3][H5DRM_STENCIL_STEPS];
         double d1[3], d2[3];
         double a1[3], a2[3];
 
-        d0[0][0] = d0[1][0] = d0[2][0] = 0.;
-        d0[0][1] = d0[1][1] = d0[2][1] = 0.;
-        d0[0][2] = d0[1][2] = d0[2][2] = 0.;
-        d0[0][3] = d0[1][3] = d0[2][3] = 0.;
-        d1[0] = d1[1] = d1[2] = 0.;
-        d2[0] = d2[1] = d2[2] = 0.;
-        a1[0] = a1[1] = a1[2] = 0.;
-        a2[0] = a2[1] = a2[2] = 0.;
-
-        hsize_t start[2]  = {(hsize_t) data_pos , (hsize_t) i_first};
-        hsize_t stride[2] = {1                  , 1};
-        hsize_t count[2]  = {3                  , i_len};
-        hsize_t block[2]  = {1                  , 1};
-
-        //Selection in dataspace
-        H5Sselect_hyperslab(
-            id_displacement_dataspace,
-            H5S_SELECT_SET, start, stride, count, block );
-
-        //Selection in memspace
-        hsize_t rank_two_array = 2;
-        hsize_t one_node_data_dims[2] = {3, i_len};
-        hsize_t one_node_data_maxdims[2] = {3, i_len};
-        hid_t memspace  = H5Screate_simple(rank_two_array, one_node_data_dims, one_node_data_maxdims);       // create dataspace of memory
-
-
-        hsize_t mem_start[2] = {0, 0};
-        hsize_t mem_stride[2] = {1, 1};
-        hsize_t mem_count[2] = {3, i_len};
-        hsize_t mem_block[2] = {1, 1};
-        H5Sselect_hyperslab(
-            memspace,
-            H5S_SELECT_SET, mem_start, mem_stride, mem_count, mem_block );
-
-        //Read data
-        herr_t errorflag1 = 0;
-        if (i1 > 2)
-        {
-            errorflag1 = H5Dread( id_displacement, H5T_NATIVE_DOUBLE, memspace,
-                                    id_displacement_dataspace, id_xfer_plist,  d0 );
-        }
-        
+        for (int dof = 0; dof < 3; ++dof)
+            for (int k = 0; k < H5DRM_STENCIL_STEPS; ++k)
+                d0[dof][k] = have_data ? displacement_prefetcher->getValue(row, dof, i_step[k]) : 0.;
 
         for (int dof = 0; dof < 3; ++dof)
         {
@@ -1072,9 +1099,6 @@ bool H5DRM::drm_differentiate_displacements(double t)
             a2[dof] = (d0[dof][1] -2*d0[dof][2] +d0[dof][3])/dt2;
         }
 
-
-        H5Sclose(memspace);
-
         bool nanfound = false;
         for (int i = 0; i < 3; ++i)
         {
@@ -1097,24 +1121,17 @@ bool H5DRM::drm_differentiate_displacements(double t)
         }
 
 
-        if (errorflag1 < 0 || 
-            // errorflag2 < 0 || errorflag3 < 0 || errorflag4 < 0 || 
-            nanfound)
+        if (nanfound)
         {
-            H5DRMerror << "Failed to read displacement or acceleration array!!\n" <<
+            int station_id = nodetag2station_id[nodeTag];
+            H5DRMerror << "NAN found in displacement array!!\n" <<
                        " n = " << n << endln <<
                        " nodeTag = " << nodeTag << endln <<
                        " station_id = " << station_id << endln <<
                        " i1 = " << i1 << endln <<
-                       " data_pos = " << data_pos << endln <<
+                       " data_pos = " << station_id2data_pos[station_id] << endln <<
                        " local_pos = " << local_pos << endln <<
-                       " Nt = " << 1 << endln <<
-                       " last_integration_time = " << last_integration_time << endln <<
-                       " start   = [" << start[0] << ", " << start[1] << "]" << endln <<
-                       " mem_start  = [" << mem_start[0] << ", " << mem_start[1] << "]" << endln <<
-                       " stride  = [" << stride[0] << ", " << stride[1] << "]" << endln <<
-                       " count   = [" << count[0] << ", " << count[1] << "]" << endln <<
-                       " block   = [" << block[0] << ", " << block[1] << "]" << endln;
+                       " last_integration_time = " << last_integration_time << endln;
             exit(-1);
         }
 
@@ -1133,11 +1150,13 @@ bool H5DRM::drm_differentiate_displacements(double t)
         DRMAccelerations(3 * local_pos + 2) = a1[2]*(1-dtau) + a2[2]*(dtau);
     }
 
-    H5DRMout << "t = " << t << " u = (" << umin << ", " << umax << ") a = (" << amin << ", " << amax << ")" << endln;
+    if (DEBUG_DRM_INTEGRATION)
+        H5DRMout << "t = " << t << " u = (" << umin << ", " << umax << ") a = (" << amin << ", " << amax << ")" << endln;
 
     return true;
 }
 
+
 bool H5DRM::drm_integrate_velocity(double next_integration_time)
 {
 
@@ -1614,10 +1633,11 @@ H5DRM::sendSelf(int commitTag, Channel & theChannel)
 
     H5DRMout << "sending filename: " << HDF5filename << endl;
 
-    static Vector data(3);
+    static Vector data(4);
     data(0) = cFactor;
     data(1) = crd_scale;
     data(2) = distance_tolerance;
+    data(3) = prefetch_window;
 
     char drmfilename[H5DRM_MAX_FILENAME];
     strcpy(drmfilename, HDF5filename.c_str());
@@ -1644,7 +1664,7 @@ H5DRM::recvSelf(int commitTag, Channel & theChannel,
                 FEM_ObjectBroker & theBroker)
 {
     H5DRMout << "receiving...\n";
-    static Vector data(3);
+    static Vector data(4);
     char drmfilename[H5DRM_MAX_FILENAME];
     Message filename_msg(drmfilename, H5DRM_MAX_FILENAME);
 
@@ -1664,6 +1684,7 @@ H5DRM::recvSelf(int commitTag, Channel & theChannel,
     cFactor = data(0);
     crd_scale = data(1);
     distance_tolerance = data(2);
+    prefetch_window = (int) data(3);
 
     HDF5filename = drmfilename;
     H5DRMout << "received filename is " <<  drmfilename << "\n";
@@ -1683,7 +1704,7 @@ H5DRM::Print(ostream & s, int flag)
 LoadPattern *
 H5DRM::getCopy(void)
 {
-    return new H5DRM(this->getTag(), HDF5filename);
+    return new H5DRM(this->getTag(), HDF5filename, cFactor, crd_scale, distance_tolerance, prefetch_window);
 }
 
 
@@ -2207,6 +2228,208 @@ void Plane::print(FILE * fptr) const
 
 
 
+H5DRMPrefetcher::H5DRMPrefetcher(hid_t id_dataset_, hid_t id_xfer_plist_, const ID & data_positions,
+                                 int number_of_timesteps_, int window, bool background) :
+    id_dataset(id_dataset_),
+    id_xfer_plist(id_xfer_plist_),
+    number_of_timesteps(number_of_timesteps_),
+    current(0),
+    pending(-1),
+    stop(false)
+{
+    id_dataspace = H5Dget_space(id_dataset);
+
+    // data_positions comes sorted and unique from ID::insert
+    rows.resize(data_positions.Size());
+    for (int i = 0; i < data_positions.Size(); ++i)
+        rows[i] = data_positions(i);
+
+    // align the windows with the chunks in time of the dataset
+    int chunk_length = 1;
+    hid_t id_create_plist = H5Dget_create_plist(id_dataset);
+    if (H5Pget_layout(id_create_plist) == H5D_CHUNKED)
+    {
+        hsize_t chunk_dims[2] = {1, 1};
+        if (H5Pget_chunk(id_create_plist, 2, chunk_dims) == 2)
+            chunk_length = (int) chunk_dims[1];
+    }
+    H5Pclose(id_create_plist);
+
+    if (window < 1)
+        window = H5DRM_PREFETCH_WINDOW;
+    window_length = ((window + chunk_length - 1) / chunk_length) * chunk_length;
+
+    for (int k = 0; k < 2; ++k)
+    {
+        windows[k].start = -1;
+        windows[k].length = 0;
+        windows[k].ready = false;
+    }
+
+#ifdef H5_HAVE_THREADSAFE
+    if (background)
+        worker = std::thread(&H5DRMPrefetcher::run, this);
+#endif
+}
+
+H5DRMPrefetcher::~H5DRMPrefetcher()
+{
+    if (worker.joinable())
+    {
+        {
+            std::lock_guard<std::mutex> guard(lock);
+            stop = true;
+        }
+        changed.notify_all();
+        worker.join();
+    }
+
+    if (id_dataspace > 0)
+        H5Sclose(id_dataspace);
+}
+
+int H5DRMPrefetcher::getRow(int data_pos) const
+{
+    std::vector<int>::const_iterator it = std::lower_bound(rows.begin(), rows.end(), data_pos);
+    if (it == rows.end() || *it != data_pos)
+        return -1;
+    return (int)(it - rows.begin());
+}
+
+bool H5DRMPrefetcher::fetch(int i_first, int i_last)
+{
+    int start = (i_first / window_length) * window_length;
+
+    std::unique_lock<std::mutex> guard(lock);
+
+    // use the window already read, or being read, if it covers the steps
+    int k = -1;
+    for (int j = 0; j < 2; ++j)
+        if (windows[j].start == start && (windows[j].ready || pending == j))
+            k = j;
+
+    if (k >= 0)
+    {
+        changed.wait(guard, [&] { return pending != k; });
+        const Window& w = windows[k];
+        if (!w.ready || w.start != start || w.start + w.length <= i_last)
+            k = -1;
+    }
+
+    if (k < 0)
+    {
+        // not prefetched, read it here once the worker is idle
+        changed.wait(guard, [&] { return pending < 0; });
+        k = 1 - current;
+        Window& w = windows[k];
+        w.ready = false;
+        w.start = -1;
+        guard.unlock();
+
+        int read_start = start;
+        int length = getLength(read_start);
+        bool ok = read(w.data, read_start, length);
+        if (ok && read_start + length <= i_last)
+        {
+            read_start = i_first;
+            length = getLength(read_start);
+            ok = read(w.data, read_start, length);
+        }
+
+        guard.lock();
+        w.length = length;
+        w.ready = ok;
+        if (!ok)
+            return false;
+        w.start = read_start;
+    }
+
+    current = k;
+
+    // start reading the following window
+    int next = start + window_length;
+    Window& other = windows[1 - k];
+    if (worker.joinable() && pending < 0 && next < number_of_timesteps && other.start != next)
+    {
+        other.ready = false;
+        other.start = next;
+        pending = 1 - k;
+        guard.unlock();
+        changed.notify_all();
+    }
+
+    return true;
+}
+
+int H5DRMPrefetcher::getLength(int start) const
+{
+    // the window overlaps the next one by a stencil so any step in it can be served
+    int length = window_length + H5DRM_STENCIL_STEPS - 1;
+    if (start + length > number_of_timesteps)
+        length = number_of_timesteps - start;
+    return length;
+}
+
+bool H5DRMPrefetcher::read(std::vector<double>& data, int start, int length)
+{
+    int num_rows = (int) rows.size();
+    if (num_rows == 0 || length <= 0)
+        return length > 0;
+
+    data.resize(3 * num_rows * length);
+
+    // select all stations at once, consecutive ones as a single hyperslab
+    H5Sselect_none(id_dataspace);
+    int first = 0;
+    while (first < num_rows)
+    {
+        int last = first;
+        while (last + 1 < num_rows && rows[last + 1] == rows[last] + 3)
+            ++last;
+
+        hsize_t start_[2] = {(hsize_t) rows[first], (hsize_t) start};
+        hsize_t count[2]  = {(hsize_t) (3 * (last - first + 1)), (hsize_t) length};
+        H5Sselect_hyperslab(id_dataspace, H5S_SELECT_OR, start_, NULL, count, NULL);
+
+        first = last + 1;
+    }
+
+    hsize_t mem_dims[2] = {(hsize_t) (3 * num_rows), (hsize_t) length};
+    hid_t memspace = H5Screate_simple(2, mem_dims, NULL);
+
+    herr_t errorflag = H5Dread(id_dataset, H5T_NATIVE_DOUBLE, memspace,
+                               id_dataspace, id_xfer_plist, &data[0]);
+    H5Sclose(memspace);
+
+    return errorflag >= 0;
+}
+
+void H5DRMPrefetcher::run()
+{
+    std::unique_lock<std::mutex> guard(lock);
+    while (true)
+    {
+        changed.wait(guard, [&] { return stop || pending >= 0; });
+        if (stop)
+            break;
+
+        Window& w = windows[pending];
+        int start = w.start;
+        guard.unlock();
+        int length = getLength(start);
+        bool ok = read(w.data, start, length);
+        guard.lock();
+
+        w.length = length;
+        w.ready = ok;
+        if (!ok)
+            w.start = -1;
+        pending = -1;
+        changed.notify_all();
+    }
+}
+
+
 void convert_h5drmcrd_to_ops_crd(Vector & v )
 {
     // static Vector v_tmp(3);
@@ -104,8 +104,13 @@
 #include <vector>
 #include <algorithm>  // For std::min and std::max functions
 #include <string>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
 
 #define H5DRM_NUM_OF_PRECOMPUTED_TIMESTEPS 50
+#define H5DRM_PREFETCH_WINDOW 256         // default time steps read at once
+#define H5DRM_STENCIL_STEPS 4             // steps needed around the current one
 #define H5DRM_MAX_RETURN_OPEN_OBJS 100
 #define H5DRM_MAX_FILENAME 200
 #define H5DRM_MAX_STRINGSIZE 80
@@ -145,11 +150,71 @@ private:
 
 
 
+// H5DRMPrefetcher serves windows of time steps of one DRM motion dataset
+// for the stations used by this process. Windows start on chunk boundaries
+// and all stations are read with one H5Dread (consecutive stations merged
+// into one hyperslab). While the solver works on one window the following
+// one is read by a background thread into the other buffer. HDF5 is then
+// called from two threads (and from other patterns and recorders at the
+// same time), so the background thread is only used with a thread-safe
+// HDF5 build (H5_HAVE_THREADSAFE); otherwise the windows are read
+// synchronously by fetch(). The fields of a Window other than its data
+// are only changed under the lock.
+class H5DRMPrefetcher
+{
+public:
+    H5DRMPrefetcher(hid_t id_dataset, hid_t id_xfer_plist, const ID& data_positions,
+                    int number_of_timesteps, int window, bool background);
+    ~H5DRMPrefetcher();
+
+    // make steps i_first..i_last available, false on a read error
+    bool fetch(int i_first, int i_last);
+
+    // row of the station stored at data_pos, -1 if it is not read
+    int getRow(int data_pos) const;
+
+    // value of the given dof of a station row at a step of the last fetch
+    double getValue(int row, int dof, int step) const
+    {
+        const Window& w = windows[current];
+        return w.data[(3 * row + dof) * w.length + step - w.start];
+    }
+
+private:
+    struct Window
+    {
+        int start;
+        int length;
+        bool ready;
+        std::vector<double> data;
+    };
+
+    int getLength(int start) const;
+    bool read(std::vector<double>& data, int start, int length);
+    void run();
+
+    hid_t id_dataset;
+    hid_t id_dataspace;
+    hid_t id_xfer_plist;
+    std::vector<int> rows;      // sorted data positions of the stations read
+    int number_of_timesteps;
+    int window_length;          // multiple of the chunk length in time
+
+    Window windows[2];
+    int current;
+    int pending;                // window being read in background, or -1
+    bool stop;
+    std::thread worker;
+    std::mutex lock;
+    std::condition_variable changed;
+};
+
 class H5DRM : public LoadPattern
 {
 public:
     H5DRM();
-    H5DRM(int tag, std::string HDF5filename_, double cFactor_ = 1.0, double crd_scale_ = 1, double distance_tolerance_ = 1e-3);
+    H5DRM(int tag, std::string HDF5filename_, double cFactor_ = 1.0, double crd_scale_ = 1, double distance_tolerance_ = 1e-3,
+          int prefetch_window_ = H5DRM_PREFETCH_WINDOW);
     ~H5DRM();
     void clean_all_data(); // Called by destructor and if domain changes
 
@@ -231,6 +296,10 @@ private:
 
     int myrank;         // MPI Process-id (rank) in the case of parallel processing
 
+    int prefetch_window;                        // steps per window, 0 reads without a background thread
+    H5DRMPrefetcher* displacement_prefetcher;   // reader of the displacement dataset
+    ID local_pos2row;                           // row in the prefetcher of each local DRM node
+
     std::vector<Plane*> planes;
 };
 
@@ -1443,15 +1443,13 @@ ShadowSubdomain::eigenAnalysis(int numMode, bool generalized, bool findSmallest)
 double
 ShadowSubdomain::getCost(void)    
 {
-  /*
+    // the ActorSubdomain returns the measured cost in a Vector of size 4
     msgData(0) = ShadowActorSubdomain_getCost;
     
     this->sendID(msgData);
-    Vector cost(2);
+    static Vector cost(4);
     this->recvVector(cost);
     return cost(0);
-  */
-  return 0.0;
 }
 
 
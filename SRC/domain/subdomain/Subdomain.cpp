@@ -360,13 +360,31 @@ Subdomain::revertToStart(void)
 int
 Subdomain::update(void)
 {
-  return this->Domain::update();
+  theTimer.start();
+
+  int res = this->Domain::update();
+
+  theTimer.pause();
+  realCost += theTimer.getReal();
+  cpuCost += theTimer.getCPU();
+  pageCost += theTimer.getNumPageFaults();
+
+  return res;
 }
 
 int
 Subdomain::update(double newTime, double dT)
 {
-    return this->Domain::update(newTime, dT);
+  theTimer.start();
+
+  int res = this->Domain::update(newTime, dT);
+
+  theTimer.pause();
+  realCost += theTimer.getReal();
+  cpuCost += theTimer.getCPU();
+  pageCost += theTimer.getNumPageFaults();
+
+  return res;
 }
 
 void
@@ -683,10 +701,15 @@ int
 Subdomain::computeTang(void)
 {   
   if (theAnalysis != 0) {
-    //    theTimer.start();
+    theTimer.start();
     
     int res =0;
     res = theAnalysis->formTangent();
+
+    theTimer.pause();
+    realCost += theTimer.getReal();
+    cpuCost += theTimer.getCPU();
+    pageCost += theTimer.getNumPageFaults();
     
     return res;
     
@@ -703,15 +726,15 @@ int
 Subdomain::computeResidual(void)
 {
   if (theAnalysis != 0) {
-    //    theTimer.start();
+    theTimer.start();
     
     int res =0;
     res = theAnalysis->formResidual();
     
-    //theTimer.pause();
-    //    realCost += theTimer.getReal();
-    //    cpuCost += theTimer.getCPU();
-    //    pageCost += theTimer.getNumPageFaults();
+    theTimer.pause();
+    realCost += theTimer.getReal();
+    cpuCost += theTimer.getCPU();
+    pageCost += theTimer.getNumPageFaults();
     
     return res;
     
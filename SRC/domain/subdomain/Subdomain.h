@@ -40,6 +40,7 @@
 
 #include <Domain.h>
 #include <Element.h>
+#include <Timer.h>
 
 class Node;
 class ID;
@@ -175,6 +176,8 @@ class Subdomain: public Element, public Domain
     DomainDecompositionAnalysis *getDDAnalysis(void);
 
   private:
+    // measured cost of element state determination since the last getCost()
+    Timer theTimer;
     double realCost;
     double cpuCost;
     int pageCost;
@@ -50,6 +50,10 @@ Matrix **Element::theMatrices;
 Vector **Element::theVectors1; 
 Vector **Element::theVectors2; 
 int  Element::numMatrices(0);
+unsigned long Element::firstValidStamp(0);
+#ifdef _CSS
+int Element::energyTrackingTag(0);
+#endif // _CSS
 
 // Element(int tag, int noExtNodes);
 // 	constructor that takes the element's unique tag and the number
@@ -59,9 +63,9 @@ Element::Element(int tag, int cTag)
   :DomainComponent(tag, cTag), alphaM(0.0), 
   betaK(0.0), betaK0(0.0), betaKc(0.0), 
       Kc(0), previousK(0), numPreviousK(0), index(-1), nodeIndex(-1),
-      is_this_element_active(true)
-#ifdef _CSS
-    , dampingEnergy(0), prevDampingForces(0), hystereticEnergy(0), prevResistingForces(0)
+      is_this_element_active(true), updateStamp(0)
+#ifdef _CSS
+    , numEnergyRequests(0), dampingEnergy(0), hystereticEnergy(0)
 #endif // _CSS
 {
   // does nothing
@@ -85,9 +89,6 @@ Element::commitState(void)
 {
   if (Kc != 0)
     *Kc = this->getTangentStiff();
-#ifdef _CSS
-  computeEnergies();
-#endif // _CSS
   return 0;
 }
 
@@ -413,6 +414,19 @@ Element::isSubdomain(void)
     return false;
 }
 
+bool
+Element::hasPathIndependentState(void)
+{
+    return false;
+}
+
+void
+Element::resetUpdateStamps(void)
+{
+    // the stamps of all the elements are older than the next one
+    firstValidStamp = Node::newTrialStamp() + 1;
+}
+
 Response*
 Element::setResponse(const char **argv, int argc, OPS_Stream &output)
 {
@@ -474,11 +488,15 @@ Element::setResponse(const char **argv, int argc, OPS_Stream &output)
 #ifdef _CSS
   else if (strcmp(argv[0], "dampingEnergy") == 0 || strcmp(argv[0], "DampingEnergy") == 0) {
       output.tag("ResponseType", "dampingEnergy");
-      theResponse = new ElementResponse(this, 555555, 0.0);
+      ElementResponse *theEnergyResponse = new ElementResponse(this, 555555, 0.0);
+      theEnergyResponse->trackEnergy();
+      theResponse = theEnergyResponse;
   }
   else if (strcmp(argv[0], "energy") == 0 || strcmp(argv[0], "Energy") == 0) {
       output.tag("ResponseType", "hystereticEnergy");
-      theResponse = new ElementResponse(this, 666666, 0.0);
+      ElementResponse *theEnergyResponse = new ElementResponse(this, 666666, 0.0);
+      theEnergyResponse->trackEnergy();
+      theResponse = theEnergyResponse;
   }
 
 #endif // _CSS
@@ -797,6 +815,7 @@ void Element::activate()
 {
     // opserr << "Activating element # " << this->getTag() << endln;
     is_this_element_active = true;
+    updateStamp = 0;
     this->onActivate();
 }
 
@@ -804,6 +823,7 @@ void Element::deactivate()
 {
     // opserr << "Deactivating element # " << this->getTag() << endln;
     is_this_element_active = false;
+    updateStamp = 0;
     this->onDeactivate();
 }
 
@@ -851,30 +871,42 @@ double Element::getHystereticEnergy()
 {
     return hystereticEnergy;
 }
-void Element::computeEnergies()
+void Element::setEnergyTracking(bool on)
 {
-    const Vector& thisDampF = getRayleighDampingForces();
+    bool wasTracked = numEnergyRequests > 0;
+    if (on == true)
+        numEnergyRequests++;
+    else if (numEnergyRequests > 0)
+        numEnergyRequests--;
+    if (wasTracked != (numEnergyRequests > 0))
+        energyTrackingTag++;
+}
+int Element::getEnergyForces(double* dampF, double* resF, int size)
+{
+    // copies the committed damping and resisting forces, the energies
+    // themselves are integrated by Domain::computeEnergies()
     const Vector& thisResF = getResistingForce();
-    int numDof = thisDampF.Size();
-    if (prevDampingForces.Size() == 0)
-    {
-        prevDampingForces = Vector(numDof);
-        prevResistingForces = Vector(numDof);
+    if (thisResF.Size() != size)
+        return -1;
+    for (int i = 0; i < size; i++)
+        resF[i] = thisResF(i);
+
+    if (alphaM == 0.0 && betaK == 0.0 && betaK0 == 0.0 && betaKc == 0.0) {
+        for (int i = 0; i < size; i++)
+            dampF[i] = 0.0;
+        return 0;
     }
-    Node** theNodes = this->getNodePtrs();
-    int numNodes = this->getNumExternalNodes();
-    int loc = 0;
-    for (int i = 0; i < numNodes; i++) {
-        const Vector& prevDisp = theNodes[i]->getLastCommitDisp();
-        const Vector& thisDisp = theNodes[i]->getDisp();
-        for (int j = 0; j < prevDisp.Size(); j++) {
-            dampingEnergy += 0.5 * (prevDampingForces(loc) + thisDampF(loc)) * (thisDisp[j] - prevDisp[j]);
-            hystereticEnergy += 0.5 * (prevResistingForces(loc) + thisResF(loc)) * (thisDisp[j] - prevDisp[j]);
-            //opserr <<loc << " " << dampingEnergy << " " << prevDampingForces(loc) << " " << thisDampF(loc) << " " << thisDisp[j] << " " << prevDisp[j] << "\n";
-            loc++;
-        }
-    }
-    prevDampingForces = thisDampF;
-    prevResistingForces = thisResF;
+
+    const Vector& thisDampF = getRayleighDampingForces();
+    if (thisDampF.Size() != size)
+        return -1;
+    for (int i = 0; i < size; i++)
+        dampF[i] = thisDampF(i);
+    return 0;
+}
+void Element::addEnergies(double damping, double hysteretic)
+{
+    dampingEnergy += damping;
+    hystereticEnergy += hysteretic;
 }
 #endif
\ No newline at end of file
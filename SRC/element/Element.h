@@ -66,6 +66,18 @@ class Element : public DomainComponent
     virtual int revertToStart(void);                
     virtual int update(void);
     virtual bool isSubdomain(void);
+
+    // elements whose state after update() depends only on the current
+    // trial displacements of their nodes return true; Domain::update()
+    // then skips them when none of their nodes has changed since their
+    // last update, keeping the stamp of that update here. stamps older
+    // than getFirstValidStamp() are out of date; resetUpdateStamps() is
+    // invoked when a parameter changes so that all elements are updated
+    virtual bool hasPathIndependentState(void);
+    unsigned long getUpdateStamp(void) const {return updateStamp;};
+    void setUpdateStamp(unsigned long stamp) {updateStamp = stamp;};
+    static unsigned long getFirstValidStamp(void) {return firstValidStamp;};
+    static void resetUpdateStamps(void);
     
     // methods to return the current linearized stiffness,
     // damping and mass matrices
@@ -124,6 +136,17 @@ class Element : public DomainComponent
 #ifdef _CSS
     void resetDampingEnergy() { dampingEnergy = 0; }
     void resetHystereticEnergy() { hystereticEnergy = 0; }
+    double getDampingEnergy();
+    double getHystereticEnergy();
+
+    // methods for the energy pass done by the Domain after a commit, the
+    // energies are tracked while any request made with setEnergyTracking(true)
+    // has not been released with setEnergyTracking(false)
+    void setEnergyTracking(bool on);
+    bool isEnergyTracked(void) const {return numEnergyRequests > 0;};
+    static int getEnergyTrackingTag(void) {return energyTrackingTag;};
+    int getEnergyForces(double *dampF, double *resF, int size);
+    void addEnergies(double damping, double hysteretic);
 #endif // _CSS
 #if _DLL
 	const Vector& getRayleighDampingForces(void);
@@ -145,18 +168,15 @@ protected:
     static Vector ** theVectors1; 
     static Vector ** theVectors2; 
     static int numMatrices;
-#ifdef _CSS
-	double getDampingEnergy();
-	void computeEnergies();
-	double getHystereticEnergy();
-#endif
    bool is_this_element_active;
   private:
+    unsigned long updateStamp;
+    static unsigned long firstValidStamp;
 #ifdef _CSS
-	  Vector prevDampingForces;
-	  Vector prevResistingForces;
+	  int numEnergyRequests;
 	  double dampingEnergy;
 	  double hystereticEnergy;
+	  static int energyTrackingTag; // changes when any element's tracking does
 #endif // _CSS
 
 };
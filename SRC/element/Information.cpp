@@ -35,28 +35,32 @@
 
 Information::Information() 
   :theType(UnknownType),
-   theID(0), theVector(0), theMatrix(0), theString(0)
+   theID(0), theVector(0), theMatrix(0), theString(0),
+   theOutput(0), outputSize(0), outputDone(false)
 {
     // does nothing
 }
 
 Information::Information(int val) 
   :theType(IntType), theInt(val),
-  theID(0), theVector(0), theMatrix(0), theString(0)
+  theID(0), theVector(0), theMatrix(0), theString(0),
+   theOutput(0), outputSize(0), outputDone(false)
 {
     // does nothing
 }
 
 Information::Information(double val) 
   :theType(DoubleType), theDouble(val),
-  theID(0), theVector(0), theMatrix(0), theString(0)
+  theID(0), theVector(0), theMatrix(0), theString(0),
+   theOutput(0), outputSize(0), outputDone(false)
 {
   // does nothing
 }
 
 Information::Information(const ID &val) 
   :theType(IdType),
-  theID(0), theVector(0), theMatrix(0), theString(0)
+  theID(0), theVector(0), theMatrix(0), theString(0),
+   theOutput(0), outputSize(0), outputDone(false)
 {
   // Make a copy
   theID = new ID(val);
@@ -67,7 +71,8 @@ Information::Information(const ID &val)
 
 Information::Information(const Vector &val) 
   :theType(VectorType),
-  theID(0), theVector(0), theMatrix(0), theString(0)
+  theID(0), theVector(0), theMatrix(0), theString(0),
+   theOutput(0), outputSize(0), outputDone(false)
 {
   // Make a copy
   theVector = new Vector(val);
@@ -78,7 +83,8 @@ Information::Information(const Vector &val)
 
 Information::Information(const Matrix &val) 
   :theType(MatrixType),
-   theID(0), theVector(0), theMatrix(0), theString(0)
+   theID(0), theVector(0), theMatrix(0), theString(0),
+   theOutput(0), outputSize(0), outputDone(false)
 {
   // Make a copy
   theMatrix = new Matrix(val);
@@ -89,7 +95,8 @@ Information::Information(const Matrix &val)
 
 Information::Information(const ID &val1, const Vector &val2) 
   :theType(IdType),
-   theID(0), theVector(0), theMatrix(0), theString(0)
+   theID(0), theVector(0), theMatrix(0), theString(0),
+   theOutput(0), outputSize(0), outputDone(false)
 {
   // Make a copy
   theID = new ID(val1);
@@ -117,6 +124,10 @@ int
 Information::setInt(int newInt)
 {
   theInt = newInt;
+
+  outputDone = (theOutput != 0 && outputSize == 1);
+  if (outputDone)
+    theOutput[0] = newInt;
   
   return 0;
 }
@@ -125,6 +136,10 @@ int
 Information::setDouble(double newDouble)
 {
   theDouble = newDouble;
+
+  outputDone = (theOutput != 0 && outputSize == 1);
+  if (outputDone)
+    theOutput[0] = newDouble;
   
   return 0;
 }
@@ -132,6 +147,14 @@ Information::setDouble(double newDouble)
 int 
 Information::setID(const ID &newID)
 {
+  int size = newID.Size();
+  outputDone = (theOutput != 0 && outputSize == size);
+  if (outputDone) {
+    for (int i=0; i<size; i++)
+      theOutput[i] = newID(i);
+    return 0;
+  }
+
   if (theID != 0) {
     *theID = newID;
   } else {
@@ -143,6 +166,14 @@ Information::setID(const ID &newID)
 int 
 Information::setVector(const Vector &newVector)
 {
+  int size = newVector.Size();
+  outputDone = (theOutput != 0 && outputSize == size);
+  if (outputDone) {
+    for (int i=0; i<size; i++)
+      theOutput[i] = newVector(i);
+    return 0;
+  }
+
   if (theVector != 0) {
     *theVector = newVector;
   } else {
@@ -155,6 +186,18 @@ Information::setVector(const Vector &newVector)
 int 
 Information::setMatrix(const Matrix &newMatrix)
 {
+  int noRows = newMatrix.noRows();
+  int noCols = newMatrix.noCols();
+  outputDone = (theOutput != 0 && outputSize == noRows*noCols);
+  if (outputDone) {
+    // same order as getData()
+    int count = 0;
+    for (int i=0; i<noRows; i++)
+      for (int j=0; j<noCols; j++)
+	theOutput[count++] = newMatrix(i,j);
+    return 0;
+  }
+
   if (theMatrix != 0) {
     *theMatrix = newMatrix;
   } else {
@@ -235,9 +278,29 @@ Information::Print(ofstream &s, int flag)
   return;
 }
 
+int
+Information::setOutput(double *data, int size)
+{
+  theOutput = data;
+  outputSize = (data != 0) ? size : 0;
+  outputDone = false;
+
+  return 0;
+}
+
 const Vector &
 Information::getData(void) 
 {
+  if (outputDone == true) {
+    if (theVector == 0) 
+      theVector = new Vector(outputSize);
+    else if (theVector->Size() != outputSize)
+      theVector->resize(outputSize);
+    for (int i=0; i<outputSize; i++)
+      (*theVector)(i) = theOutput[i];
+    return *theVector;
+  }
+
   if (theType == IntType) {
     if (theVector == 0) 
       theVector = new Vector(1);
@@ -75,6 +75,10 @@ class Information
     virtual void Print(ofstream &s, int flag = 0);
     virtual const Vector &getData(void);
 
+    // let the setX() methods write the data straight into an array of
+    // size values owned by the caller, e.g. the columns of a recorder
+    int setOutput(double *data, int size);
+
     // data that is stored in the information object
     InfoType	theType;   // information about data type
     int		theInt;    // an integer value
@@ -84,6 +88,10 @@ class Information
     Matrix	*theMatrix;// pointer to a Matrix object, created elsewhere
     char        *theString;// pointer to string
 
+    double      *theOutput;  // array set by setOutput(), created elsewhere
+    int         outputSize;  // size of theOutput
+    bool        outputDone;  // true if the last setX() wrote into theOutput
+
   protected:
     
   private:        
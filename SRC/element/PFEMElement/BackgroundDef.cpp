@@ -199,3 +199,32 @@ const VInt& operator/=(VInt& v1, int val) {
     }
     return v1;
 }
+
+BIndexKey packBIndex(const VInt& index) {
+    BIndexKey key = 0;
+    for (int i = 0; i < 3; ++i) {
+        int val = i < (int)index.size() ? index[i] : 0;
+        key = (key << 21) | (BIndexKey)(val + BINDEX_LIMIT);
+    }
+    return key;
+}
+
+void unpackBIndex(BIndexKey key, int ndm, VInt& index) {
+    index.resize(ndm);
+    for (int i = 2; i >= 0; --i) {
+        if (i < ndm) {
+            index[i] = (int)(key & 0x1FFFFF) - BINDEX_LIMIT;
+        }
+        key >>= 21;
+    }
+}
+
+bool validBIndex(const VInt& index) {
+    if (index.size() > 3) return false;
+    for (int i = 0; i < (int)index.size(); ++i) {
+        if (index[i] < -BINDEX_LIMIT || index[i] >= BINDEX_LIMIT) {
+            return false;
+        }
+    }
+    return true;
+}
@@ -33,9 +33,12 @@
 #include <vector>
 #include <set>
 #include <map>
+#include <unordered_map>
+#include <utility>
 #include <Vector.h>
 #include <math.h>
 #include <iostream>
+#include <algorithm>
 
 class Particle;
 class ParticleGroup;
@@ -71,6 +74,64 @@ double normVDouble(const VDouble& v);
 double dotVDouble(const VDouble& v1, const VDouble& v2);
 void crossVDouble(const VDouble& v1, const VDouble& v2, VDouble& res);
 
+// packed key of a background grid index, each of the (at most 3)
+// components is offset by BINDEX_LIMIT and given 21 bits with the first
+// component in the highest bits, so the order of the keys is the
+// lexicographic order of the indices
+typedef long long BIndexKey;
+const int BINDEX_LIMIT = 1 << 20;
+BIndexKey packBIndex(const VInt& index);
+void unpackBIndex(BIndexKey key, int ndm, VInt& index);
+bool validBIndex(const VInt& index);
+
+struct BIndexHash {
+    std::size_t operator()(BIndexKey key) const {
+        unsigned long long x = (unsigned long long)key;
+        x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ULL;
+        x = (x ^ (x >> 27)) * 0x94d049bb133111ebULL;
+        return (std::size_t)(x ^ (x >> 31));
+    }
+};
+
+// hashed storage of background cells or nodes keyed by grid index,
+// only the occupied part of the grid is stored. The items are node
+// based, so references to them stay valid while items are added.
+// sorted() returns the items in index order for traversals whose
+// result depends on the order (e.g. node and element tags).
+template <class T>
+class BIndexMap {
+   public:
+    typedef std::unordered_map<BIndexKey, T, BIndexHash> Map;
+    typedef typename Map::iterator iterator;
+    typedef std::vector<std::pair<BIndexKey, T*> > Items;
+
+    T& operator[](const VInt& index) { return items[packBIndex(index)]; }
+    iterator find(const VInt& index) {
+        return items.find(packBIndex(index));
+    }
+    iterator begin() { return items.begin(); }
+    iterator end() { return items.end(); }
+    std::size_t size() const { return items.size(); }
+    bool empty() const { return items.empty(); }
+    void clear() { items.clear(); }
+
+    void sorted(Items& res) {
+        res.clear();
+        res.reserve(items.size());
+        for (iterator it = items.begin(); it != items.end(); ++it) {
+            res.push_back(std::make_pair(it->first, &(it->second)));
+        }
+        std::sort(res.begin(), res.end(),
+                  [](const std::pair<BIndexKey, T*>& a,
+                     const std::pair<BIndexKey, T*>& b) {
+                      return a.first < b.first;
+                  });
+    }
+
+   private:
+    Map items;
+};
+
 enum BackgroundType {
     BACKGROUND_FLUID,
     BACKGROUND_STRUCTURE,
@@ -408,7 +408,7 @@ void BackgroundMesh::gatherParticles(const VInt& minind,
             index[0] = i;
             for (int j = minind[1]; j < maxind[1]; ++j) {
                 index[1] = j;
-                std::map<VInt, BCell>::iterator it = bcells.find(index);
+                BIndexMap<BCell>::iterator it = bcells.find(index);
                 if (it != bcells.end()) {
                     BCell& cell = it->second;
                     if (checkfsi && cell.getType() == BACKGROUND_FLUID) {
@@ -426,7 +426,7 @@ void BackgroundMesh::gatherParticles(const VInt& minind,
                 index[1] = j;
                 for (int k = minind[2]; k < maxind[2]; ++k) {
                     index[2] = k;
-                    std::map<VInt, BCell>::iterator it =
+                    BIndexMap<BCell>::iterator it =
                         bcells.find(index);
                     if (it != bcells.end()) {
                         BCell& cell = it->second;
@@ -688,7 +688,7 @@ void BackgroundMesh::clearGrid() {
     if (domain == 0) return;
 
     // remove cells
-    for (std::map<VInt, BNode>::iterator it = bnodes.begin();
+    for (BIndexMap<BNode>::iterator it = bnodes.begin();
          it != bnodes.end(); ++it) {
         BNode& bnode = it->second;
         const VInt& tags = bnode.getTags();
@@ -759,6 +759,17 @@ int BackgroundMesh::remesh(bool init) {
         return -1;
     }
 
+    // grid indices must fit in the packed cell keys
+    VInt lmargin = lower, umargin = upper;
+    lmargin -= 2;
+    umargin += 2;
+    if (!validBIndex(lmargin) || !validBIndex(umargin)) {
+        opserr << "WARNING: background mesh range has more than "
+               << BINDEX_LIMIT << " cells from the origin -- "
+               << "BgMesh::remesh\n";
+        return -1;
+    }
+
 #ifdef _LINUX
     Timer timer;
     timer.start();
@@ -1098,13 +1109,9 @@ int BackgroundMesh::gridNodes() {
     Domain* domain = OPS_GetDomain();
     if (domain == 0) return 0;
 
-    // vector of iterators
-    std::vector<std::map<VInt, BNode>::iterator> iters;
-    iters.reserve(bnodes.size());
-    for (std::map<VInt, BNode>::iterator it = bnodes.begin();
-         it != bnodes.end(); ++it) {
-        iters.push_back(it);
-    }
+    // bnodes in index order
+    BIndexMap<BNode>::Items iters;
+    bnodes.sorted(iters);
 
     // vector of new objects
     int ndtag = Mesh::nextNodeTag();
@@ -1116,12 +1123,10 @@ int BackgroundMesh::gridNodes() {
 
 #pragma omp parallel for
     for (int j = 0; j < (int)iters.size(); ++j) {
-        // get iterator
-        std::map<VInt, BNode>::iterator it = iters[j];
-
         // get cell
-        const VInt& index = it->first;
-        BNode& bnode = it->second;
+        VInt index;
+        unpackBIndex(iters[j].first, ndm, index);
+        BNode& bnode = *(iters[j].second);
         if (bnode.getType() == BACKGROUND_FIXED) {
             continue;
         }
@@ -1331,12 +1336,14 @@ int BackgroundMesh::gridNodes() {
 int BackgroundMesh::moveFixedParticles() {
     int ndm = OPS_GetNDM();
 
-    // check each cell
-    for (std::map<VInt, BCell>::iterator it = bcells.begin();
-         it != bcells.end(); ++it) {
+    // check each cell, cells added below are empty and not checked
+    BIndexMap<BCell>::Items items;
+    bcells.sorted(items);
+    for (int c = 0; c < (int)items.size(); ++c) {
         // get cell
-        const VInt& index = it->first;
-        BCell& cell = it->second;
+        VInt index;
+        unpackBIndex(items[c].first, ndm, index);
+        BCell& cell = *(items[c].second);
 
         // empty cell
         if (cell.getPts().empty()) {
@@ -1357,7 +1364,7 @@ int BackgroundMesh::moveFixedParticles() {
         // give each cell a score
         VInt scores(indices.size());
         for (int i = 0; i < (int)indices.size(); ++i) {
-            std::map<VInt, BCell>::iterator cellit =
+            BIndexMap<BCell>::iterator cellit =
                 bcells.find(indices[i]);
             if (cellit == bcells.end()) {
                 // empty cell
@@ -1586,12 +1593,13 @@ int BackgroundMesh::gridFluid() {
     // store cells in a vector
     std::vector<BCell*> cells;
     VVInt indices;
-    cells.reserve(bcells.size());
-    indices.reserve(bcells.size());
-    for (std::map<VInt, BCell>::iterator it = bcells.begin();
-         it != bcells.end(); ++it) {
-        indices.push_back(it->first);
-        cells.push_back(&(it->second));
+    BIndexMap<BCell>::Items items;
+    bcells.sorted(items);
+    cells.reserve(items.size());
+    indices.resize(items.size());
+    for (int j = 0; j < (int)items.size(); ++j) {
+        unpackBIndex(items[j].first, ndm, indices[j]);
+        cells.push_back(items[j].second);
     }
 
     // create elements in each cell
@@ -1729,10 +1737,12 @@ int BackgroundMesh::gridFSInoDT() {
 
     // store cells in a vector
     std::vector<BCell*> cells;
-    for (auto& item : bcells) {
-        auto& cell = item.second;
-        if (cell.getType() == BACKGROUND_STRUCTURE) {
-            cells.push_back(&cell);
+    BIndexMap<BCell>::Items items;
+    bcells.sorted(items);
+    for (int j = 0; j < (int)items.size(); ++j) {
+        BCell* cell = items[j].second;
+        if (cell->getType() == BACKGROUND_STRUCTURE) {
+            cells.push_back(cell);
         }
     }
 
@@ -2160,8 +2170,8 @@ int BackgroundMesh::gridFSI() {
     TetMeshGenerator tetgen;
 
     // gather bnodes
-    std::map<VInt, BNode*> fsibnodes;
-    for (std::map<VInt, BCell>::iterator it = bcells.begin();
+    std::map<BIndexKey, BNode*> fsibnodes;
+    for (BIndexMap<BCell>::iterator it = bcells.begin();
          it != bcells.end(); ++it) {
         // only for structural cells
         BCell& bcell = it->second;
@@ -2177,7 +2187,7 @@ int BackgroundMesh::gridFSI() {
                 opserr << "WARNING: failed to get bnode -- gridFSI\n";
                 return -1;
             }
-            fsibnodes[bindex] = bnode;
+            fsibnodes[packBIndex(bindex)] = bnode;
         }
     }
 
@@ -2185,9 +2195,10 @@ int BackgroundMesh::gridFSI() {
     VInt ndtags, ndtypes, ndsids;
     VVInt ndindex;
     VDouble min, max;
-    for (std::map<VInt, BNode*>::iterator it = fsibnodes.begin();
+    for (std::map<BIndexKey, BNode*>::iterator it = fsibnodes.begin();
          it != fsibnodes.end(); ++it) {
-        VInt bindex = it->first;
+        VInt bindex;
+        unpackBIndex(it->first, ndm, bindex);
         BNode* bnode = it->second;
 
         const VInt& tags = bnode->getTags();
@@ -2358,7 +2369,7 @@ int BackgroundMesh::gridFSI() {
                     for (int k = minind[1]; k < maxind[1]; ++k) {
                         currind[0] = j;
                         currind[1] = k;
-                        std::map<VInt, BCell>::iterator it =
+                        BIndexMap<BCell>::iterator it =
                             bcells.find(currind);
                         if (it == bcells.end()) {
                             outside = true;
@@ -2379,7 +2390,7 @@ int BackgroundMesh::gridFSI() {
                             currind[0] = j;
                             currind[1] = k;
                             currind[2] = l;
-                            std::map<VInt, BCell>::iterator it =
+                            BIndexMap<BCell>::iterator it =
                                 bcells.find(currind);
                             if (it == bcells.end()) {
                                 outside = true;
@@ -2420,7 +2431,7 @@ int BackgroundMesh::gridFSI() {
             VVInt indices;
             getCorners(ind, 1, indices);
             for (int k = 0; k < (int)indices.size(); ++k) {
-                std::map<VInt, BCell>::iterator cellit =
+                BIndexMap<BCell>::iterator cellit =
                     bcells.find(indices[k]);
                 if (cellit == bcells.end()) continue;
                 if (cellit->second.getType() == BACKGROUND_STRUCTURE)
@@ -2656,7 +2667,7 @@ int BackgroundMesh::record(bool init) {
             getCrds(indices[k], crds);
 
             // check bnode
-            std::map<VInt, BNode>::iterator bit = bnodes.find(indices[k]);
+            BIndexMap<BNode>::iterator bit = bnodes.find(indices[k]);
             if (bit == bnodes.end()) continue;
 
             // get bnode
@@ -2746,7 +2757,7 @@ int BackgroundMesh::moveParticles() {
     double dt = domain->getCurrentTime() - currentTime;
 
     // get current disp and velocity
-    for (std::map<VInt, BNode>::iterator it = bnodes.begin();
+    for (BIndexMap<BNode>::iterator it = bnodes.begin();
          it != bnodes.end(); ++it) {
         BNode& bnode = it->second;
         VInt& tags = bnode.getTags();
@@ -2778,12 +2789,13 @@ int BackgroundMesh::moveParticles() {
     // store cells in a vector
     std::vector<BCell*> cells;
     VVInt indices;
-    cells.reserve(bcells.size());
-    indices.reserve(bcells.size());
-    for (std::map<VInt, BCell>::iterator it = bcells.begin();
-         it != bcells.end(); ++it) {
-        indices.push_back(it->first);
-        cells.push_back(&(it->second));
+    BIndexMap<BCell>::Items items;
+    bcells.sorted(items);
+    cells.reserve(items.size());
+    indices.resize(items.size());
+    for (int j = 0; j < (int)items.size(); ++j) {
+        unpackBIndex(items[j].first, ndm, indices[j]);
+        cells.push_back(items[j].second);
     }
 
     // move particles in each cell
@@ -147,8 +147,8 @@ class BackgroundMesh {
 
    private:
     VInt lower, upper;
-    std::map<VInt, BCell> bcells;
-    std::map<VInt, BNode> bnodes;
+    BIndexMap<BCell> bcells;
+    BIndexMap<BNode> bnodes;
     double tol;
     double bsize;
     int numave, numsub;
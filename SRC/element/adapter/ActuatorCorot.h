@@ -60,7 +60,7 @@ public:
     // constructors
     ActuatorCorot(int tag, int dim, int Nd1, int Nd2,
         double EA, int ipPort, int ssl = 0, int udp = 0,
-        int addRayleigh = 0, double rho = 0.0);
+        int addRayleigh = 0, double rho = 0.0, int shm = 0);
     ActuatorCorot();
     
     // destructor
@@ -119,6 +119,7 @@ private:
     int ipPort;         // ipPort
     int ssl;            // secure socket layer flag
     int udp;            // udp socket flag
+    int shm;            // shared memory flag (2: busy polling)
     int addRayleigh;    // flag to add Rayleigh damping
     double rho;         // rho: mass per unit length
     double L;           // undeformed actuator length
@@ -273,6 +273,16 @@ int  Brick::revertToStart( )
   return success ;
 }
 
+//state depends only on the nodal displacements if the materials do
+bool  Brick::hasPathIndependentState( ) 
+{
+  for ( int i=0; i<8; i++ )
+    if ( materialPointers[i]->hasPathIndependentState( ) == false )
+      return false ;
+
+  return true ;
+}
+
 //print out element data
 void  Brick::Print(OPS_Stream &s, int flag)
 {
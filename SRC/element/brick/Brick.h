@@ -92,6 +92,7 @@ class Brick : public Element {
 
     // update
     int update(void);
+    bool hasPathIndependentState(void);
 
     //print out element data
     void Print( OPS_Stream &s, int flag ) ;
@@ -40,6 +40,7 @@
 #include <FEM_ObjectBroker.h>
 
 #include <CrdTransf.h>
+#include <classTags.h>
 #include <SectionForceDeformation.h>
 #include <Information.h>
 #include <Parameter.h>
@@ -561,6 +562,17 @@ ElasticBeam2d::update(void)
   return theCoordTransf->update();
 }
 
+bool
+ElasticBeam2d::hasPathIndependentState(void)
+{
+  // the linear and P-Delta transformations and the corotational one
+  // depend only on the trial displacements of the nodes
+  int tag = theCoordTransf->getClassTag();
+  return (tag == CRDTR_TAG_LinearCrdTransf2d ||
+	  tag == CRDTR_TAG_PDeltaCrdTransf2d ||
+	  tag == CRDTR_TAG_CorotCrdTransf2d);
+}
+
 const Matrix &
 ElasticBeam2d::getTangentStiff(void)
 {
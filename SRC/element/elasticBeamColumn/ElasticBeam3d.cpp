@@ -38,6 +38,7 @@
 #include <FEM_ObjectBroker.h>
 
 #include <CrdTransf.h>
+#include <classTags.h>
 #include <Information.h>
 #include <Parameter.h>
 #include <ElementResponse.h>
@@ -416,6 +417,16 @@ ElasticBeam3d::update(void)
   return theCoordTransf->update();
 }
 
+bool
+ElasticBeam3d::hasPathIndependentState(void)
+{
+  // the linear and P-Delta transformations depend only
+  // on the trial displacements of the nodes
+  int tag = theCoordTransf->getClassTag();
+  return (tag == CRDTR_TAG_LinearCrdTransf3d ||
+	  tag == CRDTR_TAG_PDeltaCrdTransf3d);
+}
+
 const Matrix &
 ElasticBeam3d::getTangentStiff(void)
 {
@@ -74,6 +74,7 @@ class ElasticBeam3d : public Element
     int revertToStart(void);
     
     int update(void);
+    bool hasPathIndependentState(void);
     const Matrix &getTangentStiff(void);
     const Matrix &getInitialStiff(void);
     const Matrix &getMass(void);    
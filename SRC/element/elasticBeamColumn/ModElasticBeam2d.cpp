@@ -41,6 +41,7 @@
 #include <FEM_ObjectBroker.h>
 
 #include <CrdTransf.h>
+#include <classTags.h>
 #include <Information.h>
 #include <Parameter.h>
 #include <ElementResponse.h>
@@ -328,6 +329,17 @@ ModElasticBeam2d::update(void)
   return theCoordTransf->update();
 }
 
+bool
+ModElasticBeam2d::hasPathIndependentState(void)
+{
+  // the linear and P-Delta transformations and the corotational one
+  // depend only on the trial displacements of the nodes
+  int tag = theCoordTransf->getClassTag();
+  return (tag == CRDTR_TAG_LinearCrdTransf2d ||
+	  tag == CRDTR_TAG_PDeltaCrdTransf2d ||
+	  tag == CRDTR_TAG_CorotCrdTransf2d);
+}
+
 const Matrix &
 ModElasticBeam2d::getTangentStiff(void)
 {
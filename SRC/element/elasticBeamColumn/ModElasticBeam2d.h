@@ -68,6 +68,7 @@ class ModElasticBeam2d : public Element
     int revertToStart(void);
     
     int update(void);
+    bool hasPathIndependentState(void);
     const Matrix &getTangentStiff(void);
     const Matrix &getInitialStiff(void);
     const Matrix &getMass(void);    
@@ -111,7 +111,7 @@ void* OPS_ForceBeamColumn2d()
 	}
 
 	// options
-	double mass = 0.0, tol = 1e-12;
+	double mass = 0.0, tol = 1e-12, elasticFraction = 0.0;
 	int maxIter = 10;
 	numData = 1;
 	while (OPS_GetNumRemainingInputArgs() > 0) {
@@ -136,6 +136,14 @@ void* OPS_ForceBeamColumn2d()
 				}
 			}
 		}
+		else if (strcmp(type, "-elastic") == 0) {
+			if (OPS_GetNumRemainingInputArgs() > 0) {
+				if (OPS_GetDoubleInput(numData, &elasticFraction) < 0) {
+					opserr << "WARNING invalid elastic fraction\n";
+					return 0;
+				}
+			}
+		}
 	}
 
 	// check transf
@@ -170,7 +178,7 @@ void* OPS_ForceBeamColumn2d()
 	}
 
 	Element* theEle = new ForceBeamColumn2d(iData[0], iData[1], iData[2], secTags.Size(), sections,
-		*bi, *theTransf, mass, maxIter, tol);
+		*bi, *theTransf, mass, maxIter, tol, elasticFraction);
 	delete[] sections;
 	return theEle;
 }
@@ -180,7 +188,7 @@ void* OPS_ForceBeamColumn2d(const ID& info)
 	// data
 	int iData[5];
 	int numData;
-	double mass = 0.0, tol = 1e-12;
+	double mass = 0.0, tol = 1e-12, elasticFraction = 0.0;
 	int maxIter = 10;
 
 	// regular element, not in a mesh, get tags
@@ -242,6 +250,14 @@ void* OPS_ForceBeamColumn2d(const ID& info)
 					}
 				}
 			}
+			else if (strcmp(type, "-elastic") == 0) {
+				if (OPS_GetNumRemainingInputArgs() > 0) {
+					if (OPS_GetDoubleInput(numData, &elasticFraction) < 0) {
+						opserr << "WARNING invalid elastic fraction\n";
+						return 0;
+					}
+				}
+			}
 		}
 	}
 
@@ -255,12 +271,13 @@ void* OPS_ForceBeamColumn2d(const ID& info)
 
 		// save the data for a mesh
 		Vector& mdata = meshdata[info(1)];
-		mdata.resize(5);
+		mdata.resize(6);
 		mdata(0) = iData[3];
 		mdata(1) = iData[4];
 		mdata(2) = mass;
 		mdata(3) = tol;
 		mdata(4) = maxIter;
+		mdata(5) = elasticFraction;
 		return &meshdata;
 
 	}
@@ -272,7 +289,7 @@ void* OPS_ForceBeamColumn2d(const ID& info)
 
 		// get the data for a mesh
 		Vector& mdata = meshdata[info(1)];
-		if (mdata.Size() < 5) return 0;
+		if (mdata.Size() < 6) return 0;
 
 		iData[0] = info(2);
 		iData[1] = info(3);
@@ -282,6 +299,7 @@ void* OPS_ForceBeamColumn2d(const ID& info)
 		mass = mdata(2);
 		tol = mdata(3);
 		maxIter = mdata(4);
+		elasticFraction = mdata(5);
 	}
 
 	// check transf
@@ -316,7 +334,7 @@ void* OPS_ForceBeamColumn2d(const ID& info)
 	}
 
 	Element* theEle = new ForceBeamColumn2d(iData[0], iData[1], iData[2], secTags.Size(), sections,
-		*bi, *theTransf, mass, maxIter, tol);
+		*bi, *theTransf, mass, maxIter, tol, elasticFraction);
 	delete[] sections;
 	return theEle;
 }
@@ -334,7 +352,7 @@ int OPS_ForceBeamColumn2d(Domain& theDomain, const ID& elenodes, ID& eletags)
 	if (OPS_GetIntInput(numData, &iData[0]) < 0) return -1;
 
 	// options
-	double mass = 0.0, tol = 1e-12;
+	double mass = 0.0, tol = 1e-12, elasticFraction = 0.0;
 	int maxIter = 10;
 	numData = 1;
 	while (OPS_GetNumRemainingInputArgs() > 0) {
@@ -350,6 +368,11 @@ int OPS_ForceBeamColumn2d(Domain& theDomain, const ID& elenodes, ID& eletags)
 				if (OPS_GetDoubleInput(numData, &mass) < 0) return -1;
 			}
 		}
+		else if (strcmp(type, "-elastic") == 0) {
+			if (OPS_GetNumRemainingInputArgs() > 0) {
+				if (OPS_GetDoubleInput(numData, &elasticFraction) < 0) return -1;
+			}
+		}
 	}
 
 	// check transf
@@ -393,7 +416,7 @@ int OPS_ForceBeamColumn2d(Domain& theDomain, const ID& elenodes, ID& eletags)
 	eletags.resize(elenodes.Size() / 2);
 	for (int i = 0; i < elenodes.Size() / 2; i++) {
 		theEle = new ForceBeamColumn2d(--currTag, elenodes(2 * i), elenodes(2 * i + 1), secTags.Size(),
-			sections, *bi, *theTransf, mass, maxIter, tol);
+			sections, *bi, *theTransf, mass, maxIter, tol, elasticFraction);
 		if (theEle == 0) {
 			opserr << "WARNING: run out of memory for creating element\n";
 			return -1;
@@ -416,9 +439,9 @@ ForceBeamColumn2d::ForceBeamColumn2d() :
 	Element(0, ELE_TAG_ForceBeamColumn2d), connectedExternalNodes(2),
 	beamIntegr(0), numSections(0), sections(0), crdTransf(0),
 	rho(0.0), maxIters(0), tol(0.0),
-	initialFlag(0),
+	initialFlag(0), elasticFraction(0.0), stillElastic(false), elasticFormed(false),
 	kv(NEBD, NEBD), Se(NEBD),
-	kvcommit(NEBD, NEBD), Secommit(NEBD),
+	kvcommit(NEBD, NEBD), Secommit(NEBD), kve(NEBD, NEBD),
 	fs(0), vs(0), Ssr(0), vscommit(0),
 	numEleLoads(0), sizeEleLoads(0), eleLoads(0), eleLoadFactors(0), load(6),
 	Ki(0), parameterID(0)
@@ -436,13 +459,13 @@ ForceBeamColumn2d::ForceBeamColumn2d(int tag, int nodeI, int nodeJ,
 	int numSec, SectionForceDeformation** sec,
 	BeamIntegration& bi,
 	CrdTransf& coordTransf, double massDensPerUnitLength,
-	int maxNumIters, double tolerance) :
+	int maxNumIters, double tolerance, double elasticFrac) :
 	Element(tag, ELE_TAG_ForceBeamColumn2d), connectedExternalNodes(2),
 	beamIntegr(0), numSections(0), sections(0), crdTransf(0),
 	rho(massDensPerUnitLength), maxIters(maxNumIters), tol(tolerance),
-	initialFlag(0),
+	initialFlag(0), elasticFraction(elasticFrac), stillElastic(elasticFrac > 0.0), elasticFormed(false),
 	kv(NEBD, NEBD), Se(NEBD),
-	kvcommit(NEBD, NEBD), Secommit(NEBD),
+	kvcommit(NEBD, NEBD), Secommit(NEBD), kve(NEBD, NEBD),
 	fs(0), vs(0), Ssr(0), vscommit(0),
 	numEleLoads(0), sizeEleLoads(0), eleLoads(0), eleLoadFactors(0), load(6),
 	Ki(0), parameterID(0)
@@ -605,6 +628,10 @@ ForceBeamColumn2d::commitState()
 	int i = 0;
 
 	do {
+		// sections on the linear path are set once per step, here
+		if (stillElastic)
+			sections[i]->setTrialSectionDeformation(vs[i]);
+
 		vscommit[i] = vs[i];
 		err = sections[i++]->commitState();
 
@@ -662,6 +689,7 @@ int ForceBeamColumn2d::revertToLastCommit()
 	kv = kvcommit;
 
 	initialFlag = 0;
+	elasticFormed = false;
 	// this->update();
 
 	return err;
@@ -696,6 +724,8 @@ int ForceBeamColumn2d::revertToStart()
 	kv.Zero();
 
 	initialFlag = 0;
+	stillElastic = (elasticFraction > 0.0);
+	elasticFormed = false;
 	// this->update();
 	return err;
 }
@@ -917,6 +947,18 @@ ForceBeamColumn2d::update()
 	if (initialFlag != 0 && dv.Norm() <= DBL_EPSILON && numEleLoads == 0)
 		return 0;
 
+	// while the sections stay elastic the forces follow from v directly
+	if (stillElastic) {
+		int res = this->updateElastic(v);
+		if (res < 0)
+			return -1;
+		if (res > 0) {
+			initialFlag = 1;
+			return 0;
+		}
+		this->leaveElastic();
+	}
+
 	static Vector vin(NEBD);
 	vin = v;
 	vin -= dv;
@@ -1284,6 +1326,177 @@ ForceBeamColumn2d::update()
 	return 0;
 }
 
+// Linear response of an element whose sections have not left the
+// elastic range: with the initial section flexibilities the element
+// forces follow from the basic displacements without iterations,
+//   Se = ke * (v - vp)
+// where ke is the initial stiffness and vp are the basic displacements
+// due to the element loads. Only the section deformations are checked
+// against elasticFraction of yield, the sections are set at commit.
+// A section with a material that is not linear up to yield, such as
+// concrete, is never elastic here, so the forces are exact.
+// Returns 1 if all sections remain elastic, 0 if any does not, and a
+// negative number if the initial stiffness could not be formed.
+int
+ForceBeamColumn2d::updateElastic(const Vector& v)
+{
+	double L = crdTransf->getInitialLength();
+	double oneOverL = 1.0 / L;
+
+	int i, ii;
+
+	if (elasticFormed == false) {
+		static Matrix f(NEBD, NEBD);
+		static Matrix I(NEBD, NEBD);
+
+		I.Zero();
+		for (i = 0; i < NEBD; i++)
+			I(i, i) = 1.0;
+
+		this->getInitialFlexibility(f);
+		if (f.Solve(I, kve) < 0) {
+			opserr << "ForceBeamColumn2d::updateElastic() -- could not invert initial flexibility for element with tag: " << this->getTag() << endln;
+			return -1;
+		}
+
+		for (i = 0; i < numSections; i++)
+			fs[i] = sections[i]->getInitialFlexibility();
+
+		elasticFormed = true;
+	}
+
+	double xi[maxNumSections];
+	beamIntegr->getSectionLocations(numSections, L, xi);
+
+	static Vector Ss;
+
+	// vp = v0 + (b^ fs0 * sp) * wtL
+	static Vector vp(NEBD);
+	vp.Zero();
+
+	if (numEleLoads > 0) {
+		double v0[3];
+		v0[0] = 0.0; v0[1] = 0.0; v0[2] = 0.0;
+
+		for (int ie = 0; ie < numEleLoads; ie++)
+			beamIntegr->addElasticDeformations(eleLoads[ie], eleLoadFactors[ie], L, v0);
+
+		vp(0) += v0[0];
+		vp(1) += v0[1];
+		vp(2) += v0[2];
+
+		double wt[maxNumSections];
+		beamIntegr->getSectionWeights(numSections, L, wt);
+
+		for (i = 0; i < numSections; i++) {
+
+			int order = sections[i]->getOrder();
+			const ID& code = sections[i]->getType();
+
+			double xL = xi[i];
+			double xL1 = xL - 1.0;
+			double wtL = wt[i] * L;
+
+			static Vector es;
+			Ss.setData(workArea, order);
+			es.setData(&workArea[order], order);
+
+			Ss.Zero();
+			this->computeSectionForces(Ss, i);
+			es.addMatrixVector(0.0, fs[i], Ss, 1.0);
+
+			double dei, tmp;
+			for (ii = 0; ii < order; ii++) {
+				dei = es(ii) * wtL;
+				switch (code(ii)) {
+				case SECTION_RESPONSE_P:
+					vp(0) += dei;
+					break;
+				case SECTION_RESPONSE_MZ:
+					vp(1) += xL1 * dei; vp(2) += xL * dei;
+					break;
+				case SECTION_RESPONSE_VY:
+					tmp = oneOverL * dei;
+					vp(1) += tmp; vp(2) += tmp;
+					break;
+				default:
+					break;
+				}
+			}
+		}
+	}
+
+	static Vector SeTrial(NEBD);
+	vp.addVector(-1.0, v, 1.0);
+	SeTrial.addMatrixVector(0.0, kve, vp, 1.0);
+
+	for (i = 0; i < numSections; i++) {
+
+		int order = sections[i]->getOrder();
+		const ID& code = sections[i]->getType();
+
+		double xL = xi[i];
+		double xL1 = xL - 1.0;
+
+		// Ss = b*Se + sp
+		Ss.setData(workArea, order);
+		for (ii = 0; ii < order; ii++) {
+			switch (code(ii)) {
+				case SECTION_RESPONSE_P:
+					Ss(ii) = SeTrial(0);
+					break;
+				case SECTION_RESPONSE_MZ:
+					Ss(ii) = xL1 * SeTrial(1) + xL * SeTrial(2);
+					break;
+				case SECTION_RESPONSE_VY:
+					Ss(ii) = oneOverL * (SeTrial(1) + SeTrial(2));
+					break;
+				default:
+					Ss(ii) = 0.0;
+					break;
+			}
+		}
+
+		if (numEleLoads > 0)
+			this->computeSectionForces(Ss, i);
+
+		SsrSubdivide[i] = Ss;
+		vsSubdivide[i] = vs[i];
+		vsSubdivide[i].addMatrixVector(0.0, fs[i], Ss, 1.0);
+
+		if (sections[i]->isElastic(vsSubdivide[i], elasticFraction) == false)
+			return 0;
+	}
+
+	Se = SeTrial;
+	kv = kve;
+
+	for (i = 0; i < numSections; i++) {
+		vs[i] = vsSubdivide[i];
+		Ssr[i] = SsrSubdivide[i];
+	}
+
+	return 1;
+}
+
+// Sets the sections to the deformations of the linear response and
+// goes on with the full integration for the rest of the analysis
+void
+ForceBeamColumn2d::leaveElastic(void)
+{
+	if (stillElastic == false)
+		return;
+
+	stillElastic = false;
+	elasticFormed = false;
+
+	for (int i = 0; i < numSections; i++) {
+		sections[i]->setTrialSectionDeformation(vs[i]);
+		Ssr[i] = sections[i]->getStressResultant();
+		fs[i] = sections[i]->getSectionFlexibility();
+	}
+}
+
 void ForceBeamColumn2d::getForceInterpolatMatrix(double xi, Matrix& b, const ID& code)
 {
 	b.Zero();
@@ -1814,7 +2027,7 @@ ForceBeamColumn2d::sendSelf(int commitTag, Channel& theChannel)
 		secDefSize += size;
 	}
 
-	Vector dData(1 + 1 + NEBD + NEBD * NEBD + secDefSize + 4);
+	Vector dData(1 + 1 + NEBD + NEBD * NEBD + secDefSize + 4 + 2);
 	loc = 0;
 
 	// place double variables into Vector
@@ -1845,6 +2058,10 @@ ForceBeamColumn2d::sendSelf(int commitTag, Channel& theChannel)
 	dData(loc++) = betaK0;
 	dData(loc++) = betaKc;
 
+	// send the elastic range data
+	dData(loc++) = elasticFraction;
+	dData(loc++) = (stillElastic) ? 1.0 : 0.0;
+
 	if (theChannel.sendVector(dbTag, commitTag, dData) < 0) {
 		opserr << "ForceBeamColumn2d::sendSelf() - failed to send Vector data\n";
 		return -1;
@@ -2079,7 +2296,7 @@ ForceBeamColumn2d::recvSelf(int commitTag, Channel& theChannel, FEM_ObjectBroker
 		secDefSize += size;
 	}
 
-	Vector dData(1 + 1 + NEBD + NEBD * NEBD + secDefSize + 4);
+	Vector dData(1 + 1 + NEBD + NEBD * NEBD + secDefSize + 4 + 2);
 
 	if (theChannel.recvVector(dbTag, commitTag, dData) < 0) {
 		opserr << "ForceBeamColumn2d::sendSelf() - failed to send Vector data\n";
@@ -2123,6 +2340,11 @@ ForceBeamColumn2d::recvSelf(int commitTag, Channel& theChannel, FEM_ObjectBroker
 	betaK0 = dData(loc++);
 	betaKc = dData(loc++);
 
+	// set the elastic range data
+	elasticFraction = dData(loc++);
+	stillElastic = (dData(loc++) == 1.0);
+	elasticFormed = false;
+
 	initialFlag = 2;
 
 	return 0;
@@ -3202,6 +3424,9 @@ ForceBeamColumn2d::setParameter(const char** argv, int argc, Parameter& param)
 		return param.addObject(1, this);
 	}
 
+	// parameters of the sections change their elastic response
+	this->leaveElastic();
+
 	// section response -
 	if (strstr(argv[0], "sectionX") != 0) {
 		if (argc > 2) {
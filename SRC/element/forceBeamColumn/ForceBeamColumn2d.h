@@ -81,7 +81,8 @@ class ForceBeamColumn2d: public Element
 		    int numSections, SectionForceDeformation **sec,
 		    BeamIntegration &beamIntegr,
 		    CrdTransf &coordTransf, double rho = 0.0, 
-		    int maxNumIters = 10, double tolerance = 1.0e-12);
+		    int maxNumIters = 10, double tolerance = 1.0e-12,
+		    double elasticFraction = 0.0);
   
   ~ForceBeamColumn2d();
   
@@ -155,6 +156,10 @@ class ForceBeamColumn2d: public Element
   // Section forces due to element loads
   void computeSectionForces(Vector &sp, int isec);
 
+  // Linear response while the sections remain elastic
+  int updateElastic(const Vector &v);
+  void leaveElastic(void);
+
   // internal data
   ID     connectedExternalNodes; // tags of the end nodes
 
@@ -171,6 +176,10 @@ class ForceBeamColumn2d: public Element
   double tol;	                   // tolerance for relative energy norm for local iterations
   
   int    initialFlag;            // indicates if the element has been initialized
+
+  double elasticFraction;        // fraction of yield strain the sections are elastic to, 0 for none
+  bool   stillElastic;           // no section has left the elastic range yet
+  bool   elasticFormed;          // kve and fs hold the initial stiffness and flexibilities
   
   Node *theNodes[2];   // pointers to the nodes
   
@@ -179,6 +188,8 @@ class ForceBeamColumn2d: public Element
   
   Matrix kvcommit;               // committed stiffness matrix in the basic system
   Vector Secommit;               // committed element end forces in the basic system
+
+  Matrix kve;                    // initial stiffness matrix in the basic system
   
   Matrix *fs;                    // array of section flexibility matrices
   Vector *vs;                    // array of section deformation vectors
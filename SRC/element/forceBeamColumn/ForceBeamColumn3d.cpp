@@ -115,7 +115,7 @@ void* OPS_ForceBeamColumn3d()
 	}
 
 	// options
-	double mass = 0.0, tol = 1e-12;
+	double mass = 0.0, tol = 1e-12, elasticFraction = 0.0;
 	int maxIter = 10;
 	numData = 1;
 	while (OPS_GetNumRemainingInputArgs() > 0) {
@@ -140,6 +140,14 @@ void* OPS_ForceBeamColumn3d()
 				}
 			}
 		}
+		else if (strcmp(type, "-elastic") == 0) {
+			if (OPS_GetNumRemainingInputArgs() > 0) {
+				if (OPS_GetDoubleInput(numData, &elasticFraction) < 0) {
+					opserr << "WARNING invalid elastic fraction\n";
+					return 0;
+				}
+			}
+		}
 	}
 
 	// check transf
@@ -173,7 +181,7 @@ void* OPS_ForceBeamColumn3d()
 	}
 
 	Element* theEle = new ForceBeamColumn3d(iData[0], iData[1], iData[2], secTags.Size(), sections,
-		*bi, *theTransf, mass, maxIter, tol);
+		*bi, *theTransf, mass, maxIter, tol, elasticFraction);
 	delete[] sections;
 	return theEle;
 }
@@ -185,9 +193,9 @@ ForceBeamColumn3d::ForceBeamColumn3d() :
 	Element(0, ELE_TAG_ForceBeamColumn3d), connectedExternalNodes(2),
 	beamIntegr(0), numSections(0), sections(0), crdTransf(0),
 	rho(0.0), maxIters(0), tol(0.0),
-	initialFlag(0),
+	initialFlag(0), elasticFraction(0.0), stillElastic(false), elasticFormed(false),
 	kv(NEBD, NEBD), Se(NEBD),
-	kvcommit(NEBD, NEBD), Secommit(NEBD),
+	kvcommit(NEBD, NEBD), Secommit(NEBD), kve(NEBD, NEBD),
 	fs(0), vs(0), Ssr(0), vscommit(0),
 	numEleLoads(0), sizeEleLoads(0), eleLoads(0), eleLoadFactors(0), load(12),
 	Ki(0), isTorsion(false), parameterID(0)
@@ -205,13 +213,13 @@ ForceBeamColumn3d::ForceBeamColumn3d(int tag, int nodeI, int nodeJ,
 	int numSec, SectionForceDeformation** sec,
 	BeamIntegration& bi,
 	CrdTransf& coordTransf, double massDensPerUnitLength,
-	int maxNumIters, double tolerance) :
+	int maxNumIters, double tolerance, double elasticFrac) :
 	Element(tag, ELE_TAG_ForceBeamColumn3d), connectedExternalNodes(2),
 	beamIntegr(0), numSections(0), sections(0), crdTransf(0),
 	rho(massDensPerUnitLength), maxIters(maxNumIters), tol(tolerance),
-	initialFlag(0),
+	initialFlag(0), elasticFraction(elasticFrac), stillElastic(elasticFrac > 0.0), elasticFormed(false),
 	kv(NEBD, NEBD), Se(NEBD),
-	kvcommit(NEBD, NEBD), Secommit(NEBD),
+	kvcommit(NEBD, NEBD), Secommit(NEBD), kve(NEBD, NEBD),
 	fs(0), vs(0), Ssr(0), vscommit(0),
 	numEleLoads(0), sizeEleLoads(0), eleLoads(0), eleLoadFactors(0), load(12),
 	Ki(0), isTorsion(false), parameterID(0)
@@ -374,6 +382,10 @@ ForceBeamColumn3d::commitState()
 	int i = 0;
 
 	do {
+		// sections on the linear path are set once per step, here
+		if (stillElastic)
+			sections[i]->setTrialSectionDeformation(vs[i]);
+
 		vscommit[i] = vs[i];
 		err = sections[i++]->commitState();
 
@@ -430,6 +442,7 @@ int ForceBeamColumn3d::revertToLastCommit()
 	kv = kvcommit;
 
 	initialFlag = 0;
+	elasticFormed = false;
 	// this->update();
 
 	return err;
@@ -464,6 +477,8 @@ int ForceBeamColumn3d::revertToStart()
 	kv.Zero();
 
 	initialFlag = 0;
+	stillElastic = (elasticFraction > 0.0);
+	elasticFormed = false;
 	// this->update();
 	return err;
 }
@@ -693,6 +708,18 @@ ForceBeamColumn3d::update()
 	if (initialFlag != 0 && dv.Norm() <= DBL_EPSILON && numEleLoads == 0)
 		return 0;
 
+	// while the sections stay elastic the forces follow from v directly
+	if (stillElastic) {
+		int res = this->updateElastic(v);
+		if (res < 0)
+			return -1;
+		if (res > 0) {
+			initialFlag = 1;
+			return 0;
+		}
+		this->leaveElastic();
+	}
+
 	static Vector vin(NEBD);
 	vin = v;
 	vin -= dv;
@@ -1151,6 +1178,195 @@ ForceBeamColumn3d::update()
 	return 0;
 }
 
+// Linear response of an element whose sections have not left the
+// elastic range: with the initial section flexibilities the element
+// forces follow from the basic displacements without iterations,
+//   Se = ke * (v - vp)
+// where ke is the initial stiffness and vp are the basic displacements
+// due to the element loads. Only the section deformations are checked
+// against elasticFraction of yield, the sections are set at commit.
+// A section with a material that is not linear up to yield, such as
+// concrete, is never elastic here, so the forces are exact.
+// Returns 1 if all sections remain elastic, 0 if any does not, and a
+// negative number if the initial stiffness could not be formed.
+int
+ForceBeamColumn3d::updateElastic(const Vector& v)
+{
+	double L = crdTransf->getInitialLength();
+	double oneOverL = 1.0 / L;
+
+	int i, ii;
+
+	if (elasticFormed == false) {
+		static Matrix f(NEBD, NEBD);
+		static Matrix I(NEBD, NEBD);
+
+		I.Zero();
+		for (i = 0; i < NEBD; i++)
+			I(i, i) = 1.0;
+
+		this->getInitialFlexibility(f);
+		if (f.Solve(I, kve) < 0) {
+			opserr << "ForceBeamColumn3d::updateElastic() -- could not invert initial flexibility for element with tag: " << this->getTag() << endln;
+			return -1;
+		}
+
+		for (i = 0; i < numSections; i++)
+			fs[i] = sections[i]->getInitialFlexibility();
+
+		elasticFormed = true;
+	}
+
+	double xi[maxNumSections];
+	beamIntegr->getSectionLocations(numSections, L, xi);
+
+	static Vector Ss;
+
+	// vp = v0 + (b^ fs0 * sp) * wtL
+	static Vector vp(NEBD);
+	vp.Zero();
+
+	if (numEleLoads > 0) {
+		double v0[5];
+		v0[0] = v0[1] = v0[2] = v0[3] = v0[4] = 0.0;
+
+		for (int ie = 0; ie < numEleLoads; ie++)
+			beamIntegr->addElasticDeformations(eleLoads[ie], eleLoadFactors[ie], L, v0);
+
+		vp(0) += v0[0];
+		vp(1) += v0[1];
+		vp(2) += v0[2];
+		vp(3) += v0[3];
+		vp(4) += v0[4];
+
+		double wt[maxNumSections];
+		beamIntegr->getSectionWeights(numSections, L, wt);
+
+		for (i = 0; i < numSections; i++) {
+
+			int order = sections[i]->getOrder();
+			const ID& code = sections[i]->getType();
+
+			double xL = xi[i];
+			double xL1 = xL - 1.0;
+			double wtL = wt[i] * L;
+
+			static Vector es;
+			Ss.setData(workArea, order);
+			es.setData(&workArea[order], order);
+
+			Ss.Zero();
+			this->computeSectionForces(Ss, i);
+			es.addMatrixVector(0.0, fs[i], Ss, 1.0);
+
+			double dei, tmp;
+			for (ii = 0; ii < order; ii++) {
+				dei = es(ii) * wtL;
+				switch (code(ii)) {
+				case SECTION_RESPONSE_P:
+					vp(0) += dei;
+					break;
+				case SECTION_RESPONSE_MZ:
+					vp(1) += xL1 * dei; vp(2) += xL * dei;
+					break;
+				case SECTION_RESPONSE_VY:
+					tmp = oneOverL * dei;
+					vp(1) += tmp; vp(2) += tmp;
+					break;
+				case SECTION_RESPONSE_MY:
+					vp(3) += xL1 * dei; vp(4) += xL * dei;
+					break;
+				case SECTION_RESPONSE_VZ:
+					tmp = oneOverL * dei;
+					vp(3) += tmp; vp(4) += tmp;
+					break;
+				default:
+					break;
+				}
+			}
+		}
+	}
+
+	static Vector SeTrial(NEBD);
+	vp.addVector(-1.0, v, 1.0);
+	SeTrial.addMatrixVector(0.0, kve, vp, 1.0);
+
+	for (i = 0; i < numSections; i++) {
+
+		int order = sections[i]->getOrder();
+		const ID& code = sections[i]->getType();
+
+		double xL = xi[i];
+		double xL1 = xL - 1.0;
+
+		// Ss = b*Se + sp
+		Ss.setData(workArea, order);
+		for (ii = 0; ii < order; ii++) {
+			switch (code(ii)) {
+				case SECTION_RESPONSE_P:
+					Ss(ii) = SeTrial(0);
+					break;
+				case SECTION_RESPONSE_MZ:
+					Ss(ii) = xL1 * SeTrial(1) + xL * SeTrial(2);
+					break;
+				case SECTION_RESPONSE_VY:
+					Ss(ii) = oneOverL * (SeTrial(1) + SeTrial(2));
+					break;
+				case SECTION_RESPONSE_MY:
+					Ss(ii) = xL1 * SeTrial(3) + xL * SeTrial(4);
+					break;
+				case SECTION_RESPONSE_VZ:
+					Ss(ii) = oneOverL * (SeTrial(3) + SeTrial(4));
+					break;
+				case SECTION_RESPONSE_T:
+					Ss(ii) = SeTrial(5);
+					break;
+				default:
+					Ss(ii) = 0.0;
+					break;
+			}
+		}
+
+		if (numEleLoads > 0)
+			this->computeSectionForces(Ss, i);
+
+		SsrSubdivide[i] = Ss;
+		vsSubdivide[i] = vs[i];
+		vsSubdivide[i].addMatrixVector(0.0, fs[i], Ss, 1.0);
+
+		if (sections[i]->isElastic(vsSubdivide[i], elasticFraction) == false)
+			return 0;
+	}
+
+	Se = SeTrial;
+	kv = kve;
+
+	for (i = 0; i < numSections; i++) {
+		vs[i] = vsSubdivide[i];
+		Ssr[i] = SsrSubdivide[i];
+	}
+
+	return 1;
+}
+
+// Sets the sections to the deformations of the linear response and
+// goes on with the full integration for the rest of the analysis
+void
+ForceBeamColumn3d::leaveElastic(void)
+{
+	if (stillElastic == false)
+		return;
+
+	stillElastic = false;
+	elasticFormed = false;
+
+	for (int i = 0; i < numSections; i++) {
+		sections[i]->setTrialSectionDeformation(vs[i]);
+		Ssr[i] = sections[i]->getStressResultant();
+		fs[i] = sections[i]->getSectionFlexibility();
+	}
+}
+
 void ForceBeamColumn3d::getForceInterpolatMatrix(double xi, Matrix& b, const ID& code)
 {
 	b.Zero();
@@ -1773,7 +1989,7 @@ ForceBeamColumn3d::sendSelf(int commitTag, Channel& theChannel)
 		secDefSize += size;
 	}
 
-	Vector dData(1 + 1 + NEBD + NEBD * NEBD + secDefSize + 4);
+	Vector dData(1 + 1 + NEBD + NEBD * NEBD + secDefSize + 4 + 2);
 	loc = 0;
 
 	// place double variables into Vector
@@ -1804,6 +2020,10 @@ ForceBeamColumn3d::sendSelf(int commitTag, Channel& theChannel)
 	dData(loc++) = betaK0;
 	dData(loc++) = betaKc;
 
+	// send the elastic range data
+	dData(loc++) = elasticFraction;
+	dData(loc++) = (stillElastic) ? 1.0 : 0.0;
+
 	if (theChannel.sendVector(dbTag, commitTag, dData) < 0) {
 		opserr << "ForceBeamColumn3d::sendSelf() - failed to send Vector data\n";
 
@@ -2039,7 +2259,7 @@ ForceBeamColumn3d::recvSelf(int commitTag, Channel& theChannel, FEM_ObjectBroker
 		secDefSize += size;
 	}
 
-	Vector dData(1 + 1 + NEBD + NEBD * NEBD + secDefSize + 4);
+	Vector dData(1 + 1 + NEBD + NEBD * NEBD + secDefSize + 4 + 2);
 
 	if (theChannel.recvVector(dbTag, commitTag, dData) < 0) {
 		opserr << "ForceBeamColumn3d::recvSelf() - failed to send Vector data\n";
@@ -2083,6 +2303,11 @@ ForceBeamColumn3d::recvSelf(int commitTag, Channel& theChannel, FEM_ObjectBroker
 	betaK0 = dData(loc++);
 	betaKc = dData(loc++);
 
+	// set the elastic range data
+	elasticFraction = dData(loc++);
+	stillElastic = (dData(loc++) == 1.0);
+	elasticFormed = false;
+
 	initialFlag = 2;
 	return 0;
 }
@@ -3493,6 +3718,9 @@ ForceBeamColumn3d::setParameter(const char** argv, int argc, Parameter& param)
 		return param.addObject(1, this);
 	}
 
+	// parameters of the sections change their elastic response
+	this->leaveElastic();
+
 	// section response -
 	if (strstr(argv[0], "sectionX") != 0) {
 		if (argc > 2) {
@@ -268,6 +268,7 @@ TclModelBuilder_addForceBeamColumn(ClientData clientData, Tcl_Interp *interp,
     int numIter = 10;
     double tol = 1.0e-12;
     double mass = 0.0;
+    double elasticFraction = 0.0;
     int cMass = 0;
     BeamIntegration *beamIntegr = 0;
 
@@ -301,6 +302,18 @@ TclModelBuilder_addForceBeamColumn(ClientData clientData, Tcl_Interp *interp,
 	  return TCL_ERROR;
 	}
 	argi += 2;
+      } else if (strcmp(argv[argi],"-elastic") == 0) {
+	if (argc < argi+2) {
+	  opserr << "WARNING not enough -elastic args need -elastic fraction?\n";
+	  opserr << argv[1] << " element: " << eleTag << endln;
+	  return TCL_ERROR;
+	}
+	if (Tcl_GetDouble(interp, argv[argi+1], &elasticFraction) != TCL_OK) {
+	  opserr << "WARNING invalid elastic fraction\n";
+	  opserr << argv[1] << " element: " << eleTag << endln;
+	  return TCL_ERROR;
+	}
+	argi += 2;
       } else if ((strcmp(argv[argi],"-lMass") == 0) || (strcmp(argv[argi],"lMass") == 0)) {
           cMass = 0;
           argi++;
@@ -389,7 +402,7 @@ TclModelBuilder_addForceBeamColumn(ClientData clientData, Tcl_Interp *interp,
       else if (strcmp(argv[1],"dispBeamColumnWithSensitivity") == 0)
 	theElement = new DispBeamColumn2dWithSensitivity(eleTag, iNode, jNode, nIP, sections, *beamIntegr, *theTransf2d, mass);
       else
-	theElement = new ForceBeamColumn2d(eleTag, iNode, jNode, nIP, sections, *beamIntegr, *theTransf2d, mass, numIter, tol);
+	theElement = new ForceBeamColumn2d(eleTag, iNode, jNode, nIP, sections, *beamIntegr, *theTransf2d, mass, numIter, tol, elasticFraction);
     }
     else {
       if (strcmp(argv[1],"elasticForceBeamColumn") == 0)
@@ -401,7 +414,7 @@ TclModelBuilder_addForceBeamColumn(ClientData clientData, Tcl_Interp *interp,
       else if (strcmp(argv[1],"dispBeamColumnWithSensitivity") == 0)
 	theElement = new DispBeamColumn3dWithSensitivity(eleTag, iNode, jNode, nIP, sections, *beamIntegr, *theTransf3d, mass);
       else
-	theElement = new ForceBeamColumn3d(eleTag, iNode, jNode, nIP, sections, *beamIntegr, *theTransf3d, mass, numIter, tol);
+	theElement = new ForceBeamColumn3d(eleTag, iNode, jNode, nIP, sections, *beamIntegr, *theTransf3d, mass, numIter, tol, elasticFraction);
     }
 
     delete beamIntegr;
@@ -1286,6 +1299,7 @@ TclModelBuilder_addForceBeamColumn(ClientData clientData, Tcl_Interp *interp,
   double mass = 0.0;
   int cMass = 0;
   int numIter = 10;
+  double elasticFraction = 0.0;
   double tol = 1.0e-12;
 
   while (argi < argc) {
@@ -1318,6 +1332,18 @@ TclModelBuilder_addForceBeamColumn(ClientData clientData, Tcl_Interp *interp,
 	return TCL_ERROR;
       }
       argi += 1;
+    } else if (strcmp(argv[argi],"-elastic") == 0) {
+      if (argc < argi+2) {
+	opserr << "WARNING not enough -elastic args need -elastic fraction?\n";
+	opserr << argv[1] << " element: " << eleTag << endln;
+	return TCL_ERROR;
+      }
+      if (Tcl_GetDouble(interp, argv[argi+1], &elasticFraction) != TCL_OK) {
+	opserr << "WARNING invalid elastic fraction\n";
+	opserr << argv[1] << " element: " << eleTag << endln;
+	return TCL_ERROR;
+      }
+      argi += 1;
     } else if ((strcmp(argv[argi],"-lMass") == 0 || strcmp(argv[argi],"lMass") == 0)) {
       cMass = 0;
     } else if ((strcmp(argv[argi],"-cMass") == 0 || strcmp(argv[argi],"cMass") == 0)) {
@@ -1344,7 +1370,7 @@ TclModelBuilder_addForceBeamColumn(ClientData clientData, Tcl_Interp *interp,
     else if (strcmp(argv[1],"elasticForceBeamColumnWarping") == 0)
       theElement = new ElasticForceBeamColumnWarping2d(eleTag, iNode, jNode, numSections, sections, *beamIntegr, *theTransf2d);
     else 
-      theElement = new ForceBeamColumn2d(eleTag, iNode, jNode, numSections, sections, *beamIntegr, *theTransf2d, mass, numIter, tol);
+      theElement = new ForceBeamColumn2d(eleTag, iNode, jNode, numSections, sections, *beamIntegr, *theTransf2d, mass, numIter, tol, elasticFraction);
   }
   else {
     if (strcmp(argv[1],"elasticForceBeamColumn") == 0)
@@ -1352,7 +1378,7 @@ TclModelBuilder_addForceBeamColumn(ClientData clientData, Tcl_Interp *interp,
     else if (strcmp(argv[1],"dispBeamColumn") == 0)
       theElement = new DispBeamColumn3d(eleTag, iNode, jNode, numSections, sections, *beamIntegr, *theTransf3d, mass, cMass);
     else
-      theElement = new ForceBeamColumn3d(eleTag, iNode, jNode, numSections, sections, *beamIntegr, *theTransf3d, mass, numIter, tol);
+      theElement = new ForceBeamColumn3d(eleTag, iNode, jNode, numSections, sections, *beamIntegr, *theTransf3d, mass, numIter, tol, elasticFraction);
   }
 
   if (beamIntegr != 0)
@@ -343,6 +343,17 @@ FourNodeQuad::revertToStart()
     return retVal;
 }
 
+bool
+FourNodeQuad::hasPathIndependentState()
+{
+    // the state depends only on the nodal displacements if the materials do
+    for (int i = 0; i < 4; i++)
+		if (theMaterial[i]->hasPathIndependentState() == false)
+			return false;
+
+    return true;
+}
+
 
 int
 FourNodeQuad::update()
@@ -69,6 +69,7 @@ class FourNodeQuad : public Element
     int revertToLastCommit(void);
     int revertToStart(void);
     int update(void);
+    bool hasPathIndependentState(void);
 
     // public methods to obtain stiffness, mass, damping and residual information    
     const Matrix &getTangentStiff(void);
@@ -36,6 +36,7 @@
 #include <ElementResponse.h>
 #include <TCP_Socket.h>
 #include <UDP_Socket.h>
+#include <SharedMemoryChannel.h>
 #ifdef SSL
     #include <TCP_SocketSSL.h>
 #endif
@@ -51,7 +52,7 @@ void* OPS_GenericClient()
     int ndf = OPS_GetNDF();
     if (OPS_GetNumRemainingInputArgs() < 7) {
         opserr << "WARNING insufficient arguments\n";
-        opserr << "Want: element genericClient eleTag -node Ndi Ndj ... -dof dofNdi -dof dofNdj ... -server ipPort <ipAddr> <-ssl> <-udp> <-dataSize size> <-noRayleigh>\n";
+        opserr << "Want: element genericClient eleTag -node Ndi Ndj ... -dof dofNdi -dof dofNdj ... -server ipPort <ipAddr> <-ssl> <-udp> <-shm> <-shmBusyPoll> <-dataSize size> <-noRayleigh>\n";
         return 0;
     }
     
@@ -128,7 +129,7 @@ void* OPS_GenericClient()
     // options
     char* ipAddr = new char[10];
     strcpy(ipAddr, "127.0.0.1");
-    int ssl = 0, udp = 0;
+    int ssl = 0, udp = 0, shm = 0;
     int dataSize = 256;
     int doRayleigh = 1;
     
@@ -136,6 +137,8 @@ void* OPS_GenericClient()
         type = OPS_GetString();
         if (strcmp(type, "-ssl") != 0 &&
             strcmp(type, "-udp") != 0 &&
+            strcmp(type, "-shm") != 0 &&
+            strcmp(type, "-shmBusyPoll") != 0 &&
             strcmp(type, "-dataSize") != 0 &&
             strcmp(type, "-noRayleigh") != 0 &&
             strcmp(type, "-doRayleigh") != 0) {
@@ -144,10 +147,16 @@ void* OPS_GenericClient()
             strcpy(ipAddr, type);
         }
         else if (strcmp(type, "-ssl") == 0) {
-            ssl = 1; udp = 0;
+            ssl = 1; udp = 0; shm = 0;
         }
         else if (strcmp(type, "-udp") == 0) {
-            udp = 1; ssl = 0;
+            udp = 1; ssl = 0; shm = 0;
+        }
+        else if (strcmp(type, "-shm") == 0) {
+            shm = 1; ssl = 0; udp = 0;
+        }
+        else if (strcmp(type, "-shmBusyPoll") == 0) {
+            shm = 2; ssl = 0; udp = 0;
         }
         else if (strcmp(type, "-dataSize") == 0) {
             if (OPS_GetNumRemainingInputArgs() < 1) {
@@ -170,7 +179,7 @@ void* OPS_GenericClient()
     
     // create object
     Element *theEle = new GenericClient(tag, nodes, dofs, ipPort,
-        ipAddr, ssl, udp, dataSize, doRayleigh);
+        ipAddr, ssl, udp, dataSize, doRayleigh, shm);
     
     // cleanup dynamic memory
     if (dofs != 0)
@@ -184,11 +193,12 @@ void* OPS_GenericClient()
 // responsible for allocating the necessary space needed
 // by each object and storing the tags of the end nodes.
 GenericClient::GenericClient(int tag, ID nodes, ID *dof, int _port,
-    char *machineinetaddr, int _ssl, int _udp, int datasize, int addRay)
+    char *machineinetaddr, int _ssl, int _udp, int datasize, int addRay,
+    int _shm)
     : Element(tag, ELE_TAG_GenericClient),
     connectedExternalNodes(nodes), basicDOF(1), numExternalNodes(0),
     numDOF(0), numBasicDOF(0), port(_port), machineInetAddr(0), ssl(_ssl),
-    udp(_udp), dataSize(datasize), addRayleigh(addRay), theMatrix(1,1),
+    udp(_udp), shm(_shm), dataSize(datasize), addRayleigh(addRay), theMatrix(1,1),
     theVector(1), theLoad(1), theInitStiff(1,1), theMass(1,1),
     theChannel(0), sData(0), sendData(0), rData(0), recvData(0),
     db(0), vb(0), ab(0), t(0), qDaq(0), rMatrix(0),
@@ -244,7 +254,7 @@ GenericClient::GenericClient()
     : Element(0, ELE_TAG_GenericClient),
     connectedExternalNodes(1), basicDOF(1), numExternalNodes(0),
     numDOF(0), numBasicDOF(0), port(0), machineInetAddr(0), ssl(0),
-    udp(0), dataSize(0), addRayleigh(0), theMatrix(1,1),
+    udp(0), shm(0), dataSize(0), addRayleigh(0), theMatrix(1,1),
     theVector(1), theLoad(1), theInitStiff(1,1), theMass(1,1),
     theChannel(0), sData(0), sendData(0), rData(0), recvData(0),
     db(0), vb(0), ab(0), t(0), qDaq(0), rMatrix(0),
@@ -676,7 +686,7 @@ const Vector& GenericClient::getBasicAccel()
 int GenericClient::sendSelf(int commitTag, Channel &sChannel)
 {
     // send element parameters
-    static Vector data(12);
+    static Vector data(13);
     data(0) = this->getTag();
     data(1) = numExternalNodes;
     data(2) = port;
@@ -689,6 +699,7 @@ int GenericClient::sendSelf(int commitTag, Channel &sChannel)
     data(9) = betaK;
     data(10) = betaK0;
     data(11) = betaKc;
+    data(12) = shm;
     sChannel.sendVector(0, commitTag, data);
     
     // send the end nodes and dofs
@@ -716,7 +727,7 @@ int GenericClient::recvSelf(int commitTag, Channel &rChannel,
         delete[] machineInetAddr;
     
     // receive element parameters
-    static Vector data(12);
+    static Vector data(13);
     rChannel.recvVector(0, commitTag, data);
     this->setTag((int)data(0));
     numExternalNodes = (int)data(1);
@@ -724,6 +735,7 @@ int GenericClient::recvSelf(int commitTag, Channel &rChannel,
     machineInetAddr = new char[int(data(3) + 1)];
     ssl = (int)data(4);
     udp = (int)data(5);
+    shm = (int)data(12);
     dataSize = (int)data(6);
     addRayleigh = (int)data(7);
     alphaM = data(8);
@@ -1008,7 +1020,10 @@ int GenericClient::getResponse(int responseID, Information &eleInfo)
 int GenericClient::setupConnection()
 {
     // setup the connection
-    if (udp)  {
+    if (shm)  {
+        theChannel = new SharedMemoryChannel(port, false, shm == 2);
+    }
+    else if (udp)  {
         if (machineInetAddr == 0)
             theChannel = new UDP_Socket(port, "127.0.0.1");
         else
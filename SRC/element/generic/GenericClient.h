@@ -60,7 +60,7 @@ public:
     GenericClient(int tag, ID nodes, ID *dof,
           int port, char *machineInetAddr = 0,
           int ssl = 0, int udp = 0, int dataSize = 256,
-          int addRayleigh = 1);
+          int addRayleigh = 1, int shm = 0);
     GenericClient();
     
     // destructor
@@ -129,6 +129,7 @@ private:
     char *machineInetAddr;      // ipAddress
     int ssl;                    // secure socket layer flag
     int udp;                    // udp socket flag
+    int shm;                    // shared memory flag (2: busy polling)
     int dataSize;               // data size of send/recv vectors
     int addRayleigh;            // flag to add Rayleigh damping
     
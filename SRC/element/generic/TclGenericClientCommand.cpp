@@ -54,7 +54,7 @@ int TclModelBuilder_addGenericClient(ClientData clientData, Tcl_Interp *interp,
     if ((argc-eleArgStart) < 8)  {
         opserr << "WARNING insufficient arguments\n";
         printCommand(argc, argv);
-        opserr << "Want: element genericClient eleTag -node Ndi Ndj ... -dof dofNdi -dof dofNdj ... -server ipPort <ipAddr> <-ssl> <-udp> <-dataSize size> <-noRayleigh>\n";
+        opserr << "Want: element genericClient eleTag -node Ndi Ndj ... -dof dofNdi -dof dofNdj ... -server ipPort <ipAddr> <-ssl> <-udp> <-shm> <-shmBusyPoll> <-dataSize size> <-noRayleigh>\n";
         return TCL_ERROR;
     }
     
@@ -65,7 +65,7 @@ int TclModelBuilder_addGenericClient(ClientData clientData, Tcl_Interp *interp,
     int tag, node, dof, ipPort, argi, i, j;
     int numNodes = 0, numDOFj = 0, numDOF = 0;
     char *ipAddr = 0;
-    int ssl = 0, udp = 0;
+    int ssl = 0, udp = 0, shm = 0;
     int dataSize = 256;
     int doRayleigh = 1;
     
@@ -153,7 +153,9 @@ int TclModelBuilder_addGenericClient(ClientData clientData, Tcl_Interp *interp,
             strcmp(argv[argi], "-noRayleigh") != 0 &&
             strcmp(argv[argi], "-dataSize") != 0 &&
             strcmp(argv[argi], "-ssl") != 0 &&
-            strcmp(argv[argi], "-udp") != 0)  {
+            strcmp(argv[argi], "-udp") != 0 &&
+            strcmp(argv[argi], "-shm") != 0 &&
+            strcmp(argv[argi], "-shmBusyPoll") != 0)  {
                 ipAddr = new char [strlen(argv[argi])+1];
                 strcpy(ipAddr,argv[argi]);
                 argi++;
@@ -164,10 +166,16 @@ int TclModelBuilder_addGenericClient(ClientData clientData, Tcl_Interp *interp,
         }
         for (i = argi; i < argc; i++)  {
             if (strcmp(argv[i], "-ssl") == 0)  {
-                ssl = 1; udp = 0;
+                ssl = 1; udp = 0; shm = 0;
             }
             else if (strcmp(argv[i], "-udp") == 0)  {
-                udp = 1; ssl = 0;
+                udp = 1; ssl = 0; shm = 0;
+            }
+            else if (strcmp(argv[i], "-shm") == 0)  {
+                shm = 1; ssl = 0; udp = 0;
+            }
+            else if (strcmp(argv[i], "-shmBusyPoll") == 0)  {
+                shm = 2; ssl = 0; udp = 0;
             }
             else if (strcmp(argv[i], "-dataSize") == 0)  {
                 if (Tcl_GetInt(interp, argv[i+1], &dataSize) != TCL_OK)  {
@@ -194,7 +202,7 @@ int TclModelBuilder_addGenericClient(ClientData clientData, Tcl_Interp *interp,
     
     // now create the GenericClient
     theElement = new GenericClient(tag, nodes, dofs, ipPort, ipAddr,
-        ssl, udp, dataSize, doRayleigh);
+        ssl, udp, dataSize, doRayleigh, shm);
     
     // cleanup dynamic memory
     if (dofs != 0)
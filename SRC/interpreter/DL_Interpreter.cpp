@@ -78,6 +78,18 @@ DL_Interpreter::getDouble(double *, int numArgs)
     return -1;
 }
 
+int 
+DL_Interpreter::getIntList(int* size, ID* data)
+{
+    return -1;
+}
+
+int 
+DL_Interpreter::getDoubleList(int* size, Vector* data)
+{
+    return -1;
+}
+
 const char*
 DL_Interpreter::getString()
 {
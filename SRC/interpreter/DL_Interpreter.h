@@ -45,6 +45,8 @@ UPDATES, ENHANCEMENTS, OR MODIFICATIONS.
 #define DL_Interpreter_h
 
 class Command;
+class ID;
+class Vector;
 
 class DL_Interpreter
 {
@@ -63,6 +65,8 @@ class DL_Interpreter
     virtual int getNumRemainingInputArgs(void);
     virtual int getInt(int *, int numArgs);
     virtual int getDouble(double *, int numArgs);
+    virtual int getIntList(int* size, ID* data);
+    virtual int getDoubleList(int* size, Vector* data);
     virtual const char* getString();
     virtual const char* getStringFromAll(char* buffer, int len);
     virtual int getStringCopy(char **stringPtr);
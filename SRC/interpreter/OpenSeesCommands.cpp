@@ -98,6 +98,7 @@ UPDATES, ENHANCEMENTS, OR MODIFICATIONS.
 #include <RegulaFalsiLineSearch.h>
 #include <NewtonLineSearch.h>
 #include <FileDatastore.h>
+#include <BinaryFileDatastore.h>
 #include <Mesh.h>
 #ifdef _MUMPS
 #include <MumpsSolver.h>
@@ -960,6 +961,16 @@ OpenSeesCommands::setFileDatabase(const char* filename)
     }
 }
 
+void
+OpenSeesCommands::setBinaryFileDatabase(const char* filename)
+{
+    if (theDatabase != 0) delete theDatabase;
+    theDatabase = new BinaryFileDatastore(filename, *theDomain, theBroker);
+    if (theDatabase == 0) {
+	opserr << "WARNING ran out of memory - database Binary " << filename << endln;
+    }
+}
+
 /////////////////////////////
 //// OpenSees APIs  /// /////
 /////////////////////////////
@@ -993,6 +1004,22 @@ int OPS_GetDoubleInput(int numData, double *data)
     return interp->getDouble(data, numData);
 }
 
+int OPS_GetIntListInput(int* size, ID* data)
+{
+    if (cmds == 0) return 0;
+    DL_Interpreter* interp = cmds->getInterpreter();
+    if (size == 0 || data == 0) return -1;
+    return interp->getIntList(size, data);
+}
+
+int OPS_GetDoubleListInput(int* size, Vector* data)
+{
+    if (cmds == 0) return 0;
+    DL_Interpreter* interp = cmds->getInterpreter();
+    if (size == 0 || data == 0) return -1;
+    return interp->getDoubleList(size, data);
+}
+
 int OPS_SetDoubleOutput(int numData, double *data, bool scalar)
 {
     if (cmds == 0) return 0;
@@ -1194,6 +1221,9 @@ int OPS_System()
 	// Diagonal SOE & SOLVER
 	theSOE = (LinearSOE*)OPS_DiagonalDirectSolver();
 
+    } else if (strcmp(type,"ElementByElement") == 0 || strcmp(type,"MatrixFree") == 0) {
+	// MATRIX FREE SOE & KRYLOV SOLVER
+	theSOE = (LinearSOE*)OPS_ElementByElementSolver();
 
     } else if (strcmp(type,"MPIDiagonal") == 0) {
 #ifdef _PARALLEL_INTERPRETERS
@@ -1258,6 +1288,11 @@ int OPS_System()
 	// SPARSE GENERAL SOE * SOLVER
 	theSOE = (LinearSOE*)OPS_SuperLUSolver();
 
+    } else if (strcmp(type,"Krylov") == 0) {
+
+	// SPARSE GENERAL SOE * PRECONDITIONED KRYLOV SOLVER
+	theSOE = (LinearSOE*)OPS_KrylovSolver();
+
 
     } else if ((strcmp(type,"SparseSPD") == 0) || (strcmp(type,"SparseSYM") == 0)) {
 	// now must determine the type of solver to create from rest of args
@@ -2558,7 +2593,7 @@ int OPS_Database()
     if (cmds == 0) return 0;
     // make sure at least one other argument to contain integrator
     if (OPS_GetNumRemainingInputArgs() < 1) {
-	opserr << "WARNING need to specify a Database type; valid type File, MySQL, BerkeleyDB \n";
+	opserr << "WARNING need to specify a Database type; valid type File, Binary, MySQL, BerkeleyDB \n";
 	return -1;
     }
 
@@ -2580,8 +2615,19 @@ int OPS_Database()
 
 	return 0;
     }
+    if (strcmp(type,"Binary") == 0) {
+	if (OPS_GetNumRemainingInputArgs() < 1) {
+	    opserr << "WARNING database Binary fileName? ";
+	    return -1;
+	}
+
+	const char* filename = OPS_GetString();
+	cmds->setBinaryFileDatabase(filename);
+
+	return 0;
+    }
     opserr << "WARNING No database type exists ";
-    opserr << "for database of type:" << type << "valid database type File\n";
+    opserr << "for database of type:" << type << "valid database type File, Binary\n";
 
     return -1;
 }
@@ -124,6 +124,7 @@ public:
     EigenSOE* getEigenSOE() {return theEigenSOE;}
 
     void setFileDatabase(const char* filename);
+    void setBinaryFileDatabase(const char* filename);
     FE_Datastore* getDatabase() {return theDatabase;}
 
     Timer* getTimer() {return &theTimer;}
@@ -239,6 +240,7 @@ int OPS_nodeDisp();
 int OPS_nodeReaction();
 int OPS_nodeEigenvector();
 int OPS_getTime();
+int OPS_memoryStats();
 int OPS_eleResponse();
 int OPS_getLoadFactor();
 int OPS_printModelGID();
@@ -316,6 +318,7 @@ int OPS_setElementRayleighDampingFactors();
 int OPS_MeshRegion();
 int OPS_peerNGA();
 int OPS_domainChange();
+int OPS_nodalStatePool();
 int OPS_record();
 int OPS_stripOpenSeesXML();
 int OPS_convertBinaryToText();
@@ -434,14 +437,21 @@ int OPS_HomogeneousBC_Z();
 int OPS_ShallowFoundationGen();
 int OPS_Pressure_Constraint();
 
+/* Defined in modelbuilder/BulkModelCommands.cpp */
+int OPS_Nodes();
+int OPS_Elements();
+int OPS_HomogeneousBCs();
+
 void* OPS_TimeSeriesIntegrator();
 
 void* OPS_BandGenLinLapack();
 void* OPS_BandSPDLinLapack();
 void* OPS_SuperLUSolver();
+void* OPS_KrylovSolver();
 void* OPS_ProfileSPDLinDirectSolver();
 void* OPS_UmfpackGenLinSolver();
 void* OPS_DiagonalDirectSolver();
+void* OPS_ElementByElementSolver();
 void* OPS_SProfileSPDLinSolver();
 void* OPS_PFEMSolver();
 void* OPS_PFEMCompressibleSolver();
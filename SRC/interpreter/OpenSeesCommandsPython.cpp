@@ -6,6 +6,8 @@
 #include <string.h>
 #include <string>
 #include <ID.h>
+#include <Vector.h>
+#include <limits.h>
 
 #include <StandardStream.h>
 StandardStream sserr;
@@ -916,6 +918,81 @@ int OPS_GetDoubleInput(int *numData, double *data)
   return -1;
 }
 
+// a list or tuple argument
+int OPS_GetIntListInput(int *size, ID *data)
+{
+  if (currentArg >= numberArgs || size == 0 || data == 0)
+    return -1;
+
+  PyObject *o = PyTuple_GetItem(currentArgs,currentArg);
+  PyObject *seq = PySequence_Fast(o, "list of integers expected");
+  if (seq == 0) {
+    PyErr_Clear();
+    return -1;
+  }
+  currentArg++;
+
+  int n = (int)PySequence_Fast_GET_SIZE(seq);
+  if (data->resize(n) < 0) {
+    Py_DECREF(seq);
+    return -1;
+  }
+  for (int i=0; i<n; i++) {
+    // integers only, floats are not truncated
+    PyObject *item = PyNumber_Index(PySequence_Fast_GET_ITEM(seq, i));
+    if (item == 0) {
+      PyErr_Clear();
+      Py_DECREF(seq);
+      return -1;
+    }
+    long value = PyLong_AsLong(item);
+    Py_DECREF(item);
+    if ((value == -1 && PyErr_Occurred()) || value > INT_MAX || value < INT_MIN) {
+      PyErr_Clear();
+      Py_DECREF(seq);
+      return -1;
+    }
+    (*data)(i) = (int)value;
+  }
+  Py_DECREF(seq);
+  *size = n;
+
+  return 0;
+}
+
+int OPS_GetDoubleListInput(int *size, Vector *data)
+{
+  if (currentArg >= numberArgs || size == 0 || data == 0)
+    return -1;
+
+  PyObject *o = PyTuple_GetItem(currentArgs,currentArg);
+  PyObject *seq = PySequence_Fast(o, "list of numbers expected");
+  if (seq == 0) {
+    PyErr_Clear();
+    return -1;
+  }
+  currentArg++;
+
+  int n = (int)PySequence_Fast_GET_SIZE(seq);
+  if (data->resize(n) < 0) {
+    Py_DECREF(seq);
+    return -1;
+  }
+  for (int i=0; i<n; i++) {
+    double value = PyFloat_AsDouble(PySequence_Fast_GET_ITEM(seq, i));
+    if (value == -1.0 && PyErr_Occurred()) {
+      PyErr_Clear();
+      Py_DECREF(seq);
+      return -1;
+    }
+    (*data)(i) = value;
+  }
+  Py_DECREF(seq);
+  *size = n;
+
+  return 0;
+}
+
 extern "C" 
 const char *OPS_GetString(void)
 {
@@ -1026,6 +1026,26 @@ int OPS_domainChange()
     return 0;
 }
 
+int OPS_nodalStatePool()
+{
+    Domain* theDomain = OPS_GetDomain();
+    if (theDomain == 0) return -1;
+
+    if (OPS_GetNumRemainingInputArgs() < 1) {
+	opserr << "WARNING want - nodalStatePool on|off\n";
+	return -1;
+    }
+
+    std::string opt = OPS_GetString();
+    if (opt == "on" || opt == "1")
+	return theDomain->setNodalStatePool(true);
+    else if (opt == "off" || opt == "0")
+	return theDomain->setNodalStatePool(false);
+
+    opserr << "WARNING nodalStatePool " << opt.c_str() << " - want on or off\n";
+    return -1;
+}
+
 int OPS_record()
 {
     Domain* theDomain = OPS_GetDomain();
@@ -48,6 +48,7 @@ UPDATES, ENHANCEMENTS, OR MODIFICATIONS.
 #include <LoadPattern.h>
 #include <LoadPatternIter.h>
 #include <FileStream.h>
+#include <MemoryStats.h>
 #include <ID.h>
 #include <NodalLoad.h>
 #include <NodalLoadIter.h>
@@ -394,6 +395,44 @@ int OPS_getTime()
 	 return 0;
 }
 
+int OPS_memoryStats()
+{
+	 // print the report, to a file if one is given
+	 if (OPS_GetNumRemainingInputArgs() > 0) {
+		  const char* filename = OPS_GetString();
+
+		  // memoryStats -on/-off switches the counting, which is off by default
+		  if (strcmp(filename, "-on") == 0 || strcmp(filename, "-off") == 0) {
+				MemoryStats::setEnabled(strcmp(filename, "-on") == 0);
+				return 0;
+		  }
+
+		  FileStream outputFile;
+		  if (outputFile.setFile(filename, OVERWRITE) < 0) {
+				opserr << "WARNING memoryStats " << filename << " failed to set the file\n";
+				return -1;
+		  }
+		  MemoryStats::Print(outputFile);
+	 } else {
+		  MemoryStats::Print(opserr);
+	 }
+
+	 // live and peak heap, then the bytes of each subsystem
+	 double data[2 + MemoryStats::NumSubsystems];
+	 data[0] = (double)MemoryStats::getLiveBytes();
+	 data[1] = (double)MemoryStats::getPeakBytes();
+	 for (int i = 0; i < MemoryStats::NumSubsystems; i++)
+		  data[2 + i] = (double)MemoryStats::getBytes(i);
+
+	 int numdata = 2 + MemoryStats::NumSubsystems;
+	 if (OPS_SetDoubleOutput(numdata, data, false) < 0) {
+		  opserr << "WARNING memoryStats - failed to set double output\n";
+		  return -1;
+	 }
+
+	 return 0;
+}
+
 int OPS_eleResponse()
 {
 	 Domain* theDomain = OPS_GetDomain();
@@ -76,6 +76,7 @@ UPDATES, ENHANCEMENTS, OR MODIFICATIONS.
 #include <NatafProbabilityTransformation.h>
 
 #include <CStdLibRandGenerator.h>
+#include <PhiloxRandGenerator.h>
 
 #include <StandardReliabilityConvergenceCheck.h>
 #include <OptimalityConditionReliabilityConvergenceCheck.h>
@@ -1184,15 +1185,29 @@ int OPS_randomNumberGenerator() {
 
   // Get the type of generator
   const char *type = OPS_GetString();
-  if (strcmp(type, "CStdLib") != 0) {
+  RandomNumberGenerator *theGenerator = 0;
+  if (strcmp(type, "CStdLib") == 0) {
+    theGenerator = new CStdLibRandGenerator();
+  } else if (strcmp(type, "Philox") == 0) {
+    // optional seed, 0 seeds from the clock
+    int seed = 0;
+    if (OPS_GetNumRemainingInputArgs() > 0) {
+      int numData = 1;
+      if (OPS_GetIntInput(numData, &seed) < 0) {
+        opserr << "ERROR: invalid seed for Philox "
+                  "randomNumberGenerator"
+               << endln;
+        return -1;
+      }
+    }
+    theGenerator = new PhiloxRandGenerator(seed);
+  } else {
     opserr
         << "ERROR: unrecognized type of RandomNumberGenerator "
         << type << endln;
     return -1;
   }
 
-  RandomNumberGenerator *theGenerator =
-      new CStdLibRandGenerator();
   if (theGenerator == 0) {
     opserr << "ERROR: could not create randomNumberGenerator"
            << endln;
@@ -2356,6 +2371,7 @@ variable positioner list." << endln; return TCL_ERROR;
   // Mean findDesignPoint              StepSearch -maxNumIter 30
   // -printDesignPointX CalRel_manual_1_output/1_designX.out
   // randomNumberGenerator        CStdLib
+  // randomNumberGenerator        Philox <seed>
 
   return 0;
 }
@@ -2588,6 +2604,12 @@ int OPS_runImportanceSamplingAnalysis() {
   //     default -print 1   (print to screen) -print 2   (print
   //     to restart file)
   //
+  //     -numWorkers 1  ....................... this is the
+  //     default, more run the samples in worker processes
+  //
+  //     -seed 1  ............................. this is the
+  //     default
+  //
 
   // Declaration of input parameters
   long int numberOfSimulations = 1000;
@@ -2595,6 +2617,8 @@ int OPS_runImportanceSamplingAnalysis() {
   double samplingVariance = 1.0;
   int printFlag = 0;
   int analysisTypeTag = 1;
+  int numWorkers = 1;
+  int seed = 1;
 
   while (OPS_GetNumRemainingInputArgs() > 1) {
     const char *type = OPS_GetString();
@@ -2661,6 +2685,20 @@ int OPS_runImportanceSamplingAnalysis() {
         return -1;
       }
 
+    } else if (strcmp(type, "-numWorkers") == 0) {
+      int numdata = 1;
+      if (OPS_GetIntInput(numdata, &numWorkers) < 0) {
+        opserr << "ERROR: invalid input: numWorkers \n";
+        return -1;
+      }
+
+    } else if (strcmp(type, "-seed") == 0) {
+      int numdata = 1;
+      if (OPS_GetIntInput(numdata, &seed) < 0) {
+        opserr << "ERROR: invalid input: seed \n";
+        return -1;
+      }
+
     } else {
       opserr << "ERROR: invalid input to sampling analysis. \n";
       return -1;
@@ -2675,6 +2713,11 @@ int OPS_runImportanceSamplingAnalysis() {
               "option. \n";
     return -1;
   }
+  if (numWorkers > 1 && !SamplingWorkers::available()) {
+    opserr << "WARNING: worker processes are not available in "
+              "this build, the samples are run serially\n";
+    numWorkers = 1;
+  }
 
   ImportanceSamplingAnalysis *theImportanceSamplingAnalysis =
       new ImportanceSamplingAnalysis(
@@ -2682,7 +2725,7 @@ int OPS_runImportanceSamplingAnalysis() {
           theProbabilityTransformation, theFunctionEvaluator,
           theRandomNumberGenerator, 0, numberOfSimulations,
           targetCOV, samplingVariance, printFlag, filename,
-          analysisTypeTag);
+          analysisTypeTag, numWorkers, seed);
 
   if (theImportanceSamplingAnalysis == 0) {
     opserr << "ERROR: could not create "
@@ -57,6 +57,7 @@ UPDATES, ENHANCEMENTS, OR MODIFICATIONS.
 #include <FunctionEvaluator.h>
 #include <GradientEvaluator.h>
 #include <ImportanceSamplingAnalysis.h>
+#include <SamplingWorkers.h>
 #include <Integrator.h>
 #include <MeritFunctionCheck.h>
 #include <PolakHeSearchDirectionAndMeritFunction.h>
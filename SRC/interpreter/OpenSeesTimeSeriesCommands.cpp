@@ -54,6 +54,7 @@ void* OPS_TriangleSeries();
 void* OPS_TrigSeries();
 void* OPS_RectangularSeries();
 void* OPS_PulseSeries();
+void* OPS_MappedTimeSeries();
 
 namespace {
     
@@ -223,6 +224,8 @@ namespace {
 	functionMap.insert(std::make_pair("TriangleSeries", &OPS_TriangleSeries));
 	functionMap.insert(std::make_pair("Path", &OPS_PathSeries));
 	functionMap.insert(std::make_pair("Series", &OPS_PathSeries));
+	functionMap.insert(std::make_pair("Mapped", &OPS_MappedTimeSeries));
+	functionMap.insert(std::make_pair("MappedSeries", &OPS_MappedTimeSeries));
       
 	return 0;
     }
@@ -44,8 +44,12 @@ UPDATES, ENHANCEMENTS, OR MODIFICATIONS.
 #include "PythonModule.h"
 #include "PythonStream.h"
 #include <OPS_Globals.h>
+#include <ID.h>
+#include <Vector.h>
 #include <cstring>
 #include <cctype>
+#include <climits>
+#include <limits>
 
 // define opserr
 static PythonStream sserr;
@@ -133,6 +137,27 @@ PythonModule::getNumRemainingInputArgs(void) {
     return wrapper.getNumberArgs() - wrapper.getCurrentArg();
 }
 
+// an integer argument: ints, bools and objects with __index__, but not
+// floats, and only values that fit in an int
+static int toInt(PyObject *o, int &value) {
+    PyObject *index = PyNumber_Index(o);
+    if (index == 0) {
+        PyErr_Clear();
+        return -1;
+    }
+    long res = PyLong_AsLong(index);
+    Py_DECREF(index);
+    if (res == -1 && PyErr_Occurred()) {
+        PyErr_Clear();
+        return -1;
+    }
+    if (res > INT_MAX || res < INT_MIN) {
+        return -1;
+    }
+    value = (int)res;
+    return 0;
+}
+
 int
 PythonModule::getInt(int *data, int numArgs) {
     if ((wrapper.getNumberArgs() - wrapper.getCurrentArg()) < numArgs) {
@@ -141,16 +166,10 @@ PythonModule::getInt(int *data, int numArgs) {
 
     for (int i = 0; i < numArgs; i++) {
         PyObject *o = PyTuple_GetItem(wrapper.getCurrentArgv(), wrapper.getCurrentArg());
-        if (PyLong_Check(o) || PyFloat_Check(o) || PyBool_Check(o)) {
-            PyErr_Clear();
-            data[i] = PyLong_AsLong(o);
-            if (PyErr_Occurred()) {
-                return -1;
-            }
-            wrapper.incrCurrentArg();
-        } else {
+        if (toInt(o, data[i]) < 0) {
             return -1;
         }
+        wrapper.incrCurrentArg();
     }
 
     return 0;
@@ -179,6 +198,184 @@ PythonModule::getDouble(double *data, int numArgs) {
     return 0;
 }
 
+// copy n items of type S from a buffer, integers that do not fit in T
+// are an error rather than narrowed
+template<class S, class T>
+static int copyBufferItems(const char *buf, T *data, int n) {
+    const S *items = (const S *)buf;
+    for (int i = 0; i < n; i++) {
+        if (std::numeric_limits<T>::is_integer &&
+            ((double)items[i] > (double)std::numeric_limits<T>::max() ||
+             (double)items[i] < (double)std::numeric_limits<T>::min())) {
+            return -1;
+        }
+        data[i] = (T)items[i];
+    }
+    return 0;
+}
+
+// convert the items of a contiguous buffer (NumPy arrays, array.array,
+// memoryview) without going through python objects; the type is taken
+// from the kind of the format character and the item size
+template<class T>
+static int convertBuffer(const Py_buffer &view, T *data, int n, bool allowFloat) {
+    const char *fmt = view.format != 0 ? view.format : "B";
+    if (fmt[0] == '@' || fmt[0] == '=') {
+        fmt++;
+    } else if (fmt[0] == '<' || fmt[0] == '>' || fmt[0] == '!') {
+        const int one = 1;
+        bool little = *(const char *)&one == 1;
+        if ((fmt[0] == '<') != little) {
+            return -1;
+        }
+        fmt++;
+    }
+    if (fmt[0] == '\0' || fmt[1] != '\0') {
+        return -1;
+    }
+
+    const char *buf = (const char *)view.buf;
+    Py_ssize_t size = view.itemsize;
+    if (strchr("bhilqn", fmt[0]) != 0) {
+        if (size == 1) return copyBufferItems<signed char>(buf, data, n);
+        else if (size == 2) return copyBufferItems<short>(buf, data, n);
+        else if (size == 4) return copyBufferItems<int>(buf, data, n);
+        else if (size == 8) return copyBufferItems<long long>(buf, data, n);
+        else return -1;
+    } else if (strchr("BHILQN?", fmt[0]) != 0) {
+        if (size == 1) return copyBufferItems<unsigned char>(buf, data, n);
+        else if (size == 2) return copyBufferItems<unsigned short>(buf, data, n);
+        else if (size == 4) return copyBufferItems<unsigned int>(buf, data, n);
+        else if (size == 8) return copyBufferItems<unsigned long long>(buf, data, n);
+        else return -1;
+    } else if (allowFloat && strchr("fd", fmt[0]) != 0) {
+        if (size == 4) return copyBufferItems<float>(buf, data, n);
+        else if (size == 8) return copyBufferItems<double>(buf, data, n);
+        else return -1;
+    }
+
+    return -1;
+}
+
+int
+PythonModule::getIntList(int *size, ID *data) {
+    if (wrapper.getCurrentArg() >= wrapper.getNumberArgs()) {
+        return -1;
+    }
+
+    PyObject *o = PyTuple_GetItem(wrapper.getCurrentArgv(), wrapper.getCurrentArg());
+    wrapper.incrCurrentArg();
+
+    // a list or tuple of numbers
+    if (PyList_Check(o) || PyTuple_Check(o)) {
+        PyObject *seq = PySequence_Fast(o, "");
+        if (seq == 0) {
+            PyErr_Clear();
+            return -1;
+        }
+        int n = (int)PySequence_Fast_GET_SIZE(seq);
+        PyObject **items = PySequence_Fast_ITEMS(seq);
+        if (data->resize(n) < 0) {
+            Py_DECREF(seq);
+            return -1;
+        }
+        for (int i = 0; i < n; i++) {
+            if (toInt(items[i], (*data)(i)) < 0) {
+                Py_DECREF(seq);
+                return -1;
+            }
+        }
+        Py_DECREF(seq);
+        *size = n;
+        return 0;
+    }
+
+    // an array exporting the buffer protocol
+    if (PyObject_CheckBuffer(o)) {
+        Py_buffer view;
+        if (PyObject_GetBuffer(o, &view, PyBUF_C_CONTIGUOUS | PyBUF_FORMAT) != 0) {
+            PyErr_Clear();
+            return -1;
+        }
+        int n = view.itemsize > 0 ? (int)(view.len / view.itemsize) : 0;
+        int res = data->resize(n);
+        if (res == 0 && n > 0) {
+            res = convertBuffer(view, &(*data)(0), n, false);
+        }
+        PyBuffer_Release(&view);
+        if (res < 0) {
+            return -1;
+        }
+        *size = n;
+        return 0;
+    }
+
+    return -1;
+}
+
+int
+PythonModule::getDoubleList(int *size, Vector *data) {
+    if (wrapper.getCurrentArg() >= wrapper.getNumberArgs()) {
+        return -1;
+    }
+
+    PyObject *o = PyTuple_GetItem(wrapper.getCurrentArgv(), wrapper.getCurrentArg());
+    wrapper.incrCurrentArg();
+
+    // a list or tuple of numbers
+    if (PyList_Check(o) || PyTuple_Check(o)) {
+        PyObject *seq = PySequence_Fast(o, "");
+        if (seq == 0) {
+            PyErr_Clear();
+            return -1;
+        }
+        int n = (int)PySequence_Fast_GET_SIZE(seq);
+        PyObject **items = PySequence_Fast_ITEMS(seq);
+        if (data->resize(n) < 0) {
+            Py_DECREF(seq);
+            return -1;
+        }
+        for (int i = 0; i < n; i++) {
+            PyObject *item = items[i];
+            if (!PyLong_Check(item) && !PyFloat_Check(item) && !PyBool_Check(item)) {
+                Py_DECREF(seq);
+                return -1;
+            }
+            PyErr_Clear();
+            (*data)(i) = PyFloat_AsDouble(item);
+            if (PyErr_Occurred()) {
+                Py_DECREF(seq);
+                return -1;
+            }
+        }
+        Py_DECREF(seq);
+        *size = n;
+        return 0;
+    }
+
+    // an array exporting the buffer protocol
+    if (PyObject_CheckBuffer(o)) {
+        Py_buffer view;
+        if (PyObject_GetBuffer(o, &view, PyBUF_C_CONTIGUOUS | PyBUF_FORMAT) != 0) {
+            PyErr_Clear();
+            return -1;
+        }
+        int n = view.itemsize > 0 ? (int)(view.len / view.itemsize) : 0;
+        int res = data->resize(n);
+        if (res == 0 && n > 0) {
+            res = convertBuffer(view, &(*data)(0), n, true);
+        }
+        PyBuffer_Release(&view);
+        if (res < 0) {
+            return -1;
+        }
+        *size = n;
+        return 0;
+    }
+
+    return -1;
+}
+
 const char *
 PythonModule::getString() {
     if (wrapper.getCurrentArg() >= wrapper.getNumberArgs()) {
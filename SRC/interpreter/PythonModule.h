@@ -73,6 +73,8 @@ class PythonModule: public DL_Interpreter
     virtual int getNumRemainingInputArgs(void);
     virtual int getInt(int *, int numArgs);
     virtual int getDouble(double *, int numArgs);
+    virtual int getIntList(int* size, ID* data);
+    virtual int getDoubleList(int* size, Vector* data);
     virtual const char* getString();
     virtual const char* getStringFromAll(char* buffer, int len);
     virtual int getStringCopy(char **stringPtr);
@@ -324,6 +324,42 @@ static PyObject* Py_ops_element(PyObject* self, PyObject* args)
 	return wrapper->getResults();
 }
 
+static PyObject* Py_ops_nodes(PyObject* self, PyObject* args)
+{
+	wrapper->resetCommandLine(PyTuple_Size(args), 1, args);
+
+	if (OPS_Nodes() < 0) {
+		opserr << (void*)0;
+		return NULL;
+	}
+
+	return wrapper->getResults();
+}
+
+static PyObject* Py_ops_fixes(PyObject* self, PyObject* args)
+{
+	wrapper->resetCommandLine(PyTuple_Size(args), 1, args);
+
+	if (OPS_HomogeneousBCs() < 0) {
+		opserr << (void*)0;
+		return NULL;
+	}
+
+	return wrapper->getResults();
+}
+
+static PyObject* Py_ops_elements(PyObject* self, PyObject* args)
+{
+	wrapper->resetCommandLine(PyTuple_Size(args), 1, args);
+
+	if (OPS_Elements() < 0) {
+		opserr << (void*)0;
+		return NULL;
+	}
+
+	return wrapper->getResults();
+}
+
 static PyObject* Py_ops_timeSeries(PyObject* self, PyObject* args)
 {
 	wrapper->resetCommandLine(PyTuple_Size(args), 1, args);
@@ -736,6 +772,18 @@ static PyObject* Py_ops_getTime(PyObject* self, PyObject* args)
 	return wrapper->getResults();
 }
 
+static PyObject* Py_ops_memoryStats(PyObject* self, PyObject* args)
+{
+	wrapper->resetCommandLine(PyTuple_Size(args), 1, args);
+
+	if (OPS_memoryStats() < 0) {
+		opserr << (void*)0;
+		return NULL;
+	}
+
+	return wrapper->getResults();
+}
+
 static PyObject* Py_ops_setCreep(PyObject* self, PyObject* args)
 {
 	wrapper->resetCommandLine(PyTuple_Size(args), 1, args);
@@ -1348,6 +1396,18 @@ static PyObject* Py_ops_domainChange(PyObject* self, PyObject* args)
 	return wrapper->getResults();
 }
 
+static PyObject* Py_ops_nodalStatePool(PyObject* self, PyObject* args)
+{
+	wrapper->resetCommandLine(PyTuple_Size(args), 1, args);
+
+	if (OPS_nodalStatePool() < 0) {
+		opserr << (void*)0;
+		return NULL;
+	}
+
+	return wrapper->getResults();
+}
+
 static PyObject* Py_ops_record(PyObject* self, PyObject* args)
 {
 	wrapper->resetCommandLine(PyTuple_Size(args), 1, args);
@@ -2621,6 +2681,9 @@ PythonWrapper::addOpenSeesCommands()
 	addCommand("node", &Py_ops_node);
 	addCommand("fix", &Py_ops_fix);
 	addCommand("element", &Py_ops_element);
+	addCommand("nodes", &Py_ops_nodes);
+	addCommand("fixes", &Py_ops_fixes);
+	addCommand("elements", &Py_ops_elements);
 	addCommand("timeSeries", &Py_ops_timeSeries);
 	addCommand("pattern", &Py_ops_pattern);
 	addCommand("load", &Py_ops_nodalLoad);
@@ -2656,6 +2719,7 @@ PythonWrapper::addOpenSeesCommands()
 	addCommand("equalDOF", &Py_ops_equalDOF);
 	addCommand("nodeEigenvector", &Py_ops_nodeEigenvector);
 	addCommand("getTime", &Py_ops_getTime);
+	addCommand("memoryStats", &Py_ops_memoryStats);
 	addCommand("setCreep", &Py_ops_setCreep);
 	addCommand("eleResponse", &Py_ops_eleResponse);
 	addCommand("sp", &Py_ops_SP);
@@ -2707,6 +2771,7 @@ PythonWrapper::addOpenSeesCommands()
 	addCommand("setPrecision", &Py_ops_setPrecision);
 	addCommand("searchPeerNGA", &Py_ops_searchPeerNGA);
 	addCommand("domainChange", &Py_ops_domainChange);
+	addCommand("nodalStatePool", &Py_ops_nodalStatePool);
 	addCommand("record", &Py_ops_record);
 	addCommand("metaData", &Py_ops_metaData);
 	addCommand("defaultUnits", &Py_ops_defaultUnits);
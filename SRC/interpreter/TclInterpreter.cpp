@@ -63,6 +63,8 @@ terms specified in this license.
 ** ****************************************************************** */
 
 #include "TclInterpreter.h"
+#include <ID.h>
+#include <Vector.h>
 #include <string.h>
 #include <StandardStream.h>
 
@@ -541,6 +543,70 @@ TclInterpreter::getDouble(double *data, int numArgs) {
     return 0;
 }
 
+int 
+TclInterpreter::getIntList(int* size, ID* data) {
+
+    if (wrapper.getCurrentArg() >= wrapper.getNumberArgs()) {
+	return -1;
+    }
+
+    // the argument is a tcl list
+    int n = 0;
+    TCL_Char **items = 0;
+    if (Tcl_SplitList(interp, wrapper.getCurrentArgv()[wrapper.getCurrentArg()], &n, &items) != TCL_OK) {
+	wrapper.incrCurrentArg();
+	return -1;
+    }
+    wrapper.incrCurrentArg();
+
+    if (data->resize(n) < 0) {
+	Tcl_Free((char *) items);
+	return -1;
+    }
+    for (int i=0; i<n; i++) {
+	if (Tcl_GetInt(interp, items[i], &(*data)(i)) != TCL_OK) {
+	    Tcl_Free((char *) items);
+	    return -1;
+	}
+    }
+    Tcl_Free((char *) items);
+    *size = n;
+
+    return 0;
+}
+
+int 
+TclInterpreter::getDoubleList(int* size, Vector* data) {
+
+    if (wrapper.getCurrentArg() >= wrapper.getNumberArgs()) {
+	return -1;
+    }
+
+    // the argument is a tcl list
+    int n = 0;
+    TCL_Char **items = 0;
+    if (Tcl_SplitList(interp, wrapper.getCurrentArgv()[wrapper.getCurrentArg()], &n, &items) != TCL_OK) {
+	wrapper.incrCurrentArg();
+	return -1;
+    }
+    wrapper.incrCurrentArg();
+
+    if (data->resize(n) < 0) {
+	Tcl_Free((char *) items);
+	return -1;
+    }
+    for (int i=0; i<n; i++) {
+	if (Tcl_GetDouble(interp, items[i], &(*data)(i)) != TCL_OK) {
+	    Tcl_Free((char *) items);
+	    return -1;
+	}
+    }
+    Tcl_Free((char *) items);
+    *size = n;
+
+    return 0;
+}
+
 const char*
 TclInterpreter::getString() {
 
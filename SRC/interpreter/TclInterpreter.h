@@ -61,6 +61,8 @@ class TclInterpreter: public DL_Interpreter
     virtual int getNumRemainingInputArgs(void);
     virtual int getInt(int *, int numArgs);
     virtual int getDouble(double *, int numArgs);
+    virtual int getIntList(int* size, ID* data);
+    virtual int getDoubleList(int* size, Vector* data);
     virtual const char* getString();
     virtual int getStringCopy(char **stringPtr);
     virtual void resetInput(int cArg);
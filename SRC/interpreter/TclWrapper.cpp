@@ -197,6 +197,30 @@ static int Tcl_ops_element(ClientData clientData, Tcl_Interp *interp, int argc,
     return TCL_OK;
 }
 
+static int Tcl_ops_nodes(ClientData clientData, Tcl_Interp *interp, int argc,   TCL_Char **argv) {
+    wrapper->resetCommandLine(argc, 1, argv);
+
+    if (OPS_Nodes() < 0) return TCL_ERROR;
+
+    return TCL_OK;
+}
+
+static int Tcl_ops_fixes(ClientData clientData, Tcl_Interp *interp, int argc,   TCL_Char **argv) {
+    wrapper->resetCommandLine(argc, 1, argv);
+
+    if (OPS_HomogeneousBCs() < 0) return TCL_ERROR;
+
+    return TCL_OK;
+}
+
+static int Tcl_ops_elements(ClientData clientData, Tcl_Interp *interp, int argc,   TCL_Char **argv) {
+    wrapper->resetCommandLine(argc, 1, argv);
+
+    if (OPS_Elements() < 0) return TCL_ERROR;
+
+    return TCL_OK;
+}
+
 static int Tcl_ops_timeSeries(ClientData clientData, Tcl_Interp *interp, int argc,   TCL_Char **argv) {
     wrapper->resetCommandLine(argc, 1, argv);
 
@@ -469,6 +493,14 @@ static int Tcl_ops_getTime(ClientData clientData, Tcl_Interp *interp, int argc,
     return TCL_OK;
 }
 
+static int Tcl_ops_memoryStats(ClientData clientData, Tcl_Interp *interp, int argc,   TCL_Char **argv) {
+    wrapper->resetCommandLine(argc, 1, argv);
+
+    if (OPS_memoryStats() < 0) return TCL_ERROR;
+
+    return TCL_OK;
+}
+
 static int Tcl_ops_setCreep(ClientData clientData, Tcl_Interp *interp, int argc,   TCL_Char **argv) {
     wrapper->resetCommandLine(argc, 1, argv);
 
@@ -853,6 +885,14 @@ static int Tcl_ops_domainChange(ClientData clientData, Tcl_Interp *interp, int a
     return TCL_OK;
 }
 
+static int Tcl_ops_nodalStatePool(ClientData clientData, Tcl_Interp *interp, int argc,   TCL_Char **argv) {
+    wrapper->resetCommandLine(argc, 1, argv);
+
+    if (OPS_nodalStatePool() < 0) return TCL_ERROR;
+
+    return TCL_OK;
+}
+
 static int Tcl_ops_metaData(ClientData clientData, Tcl_Interp *interp, int argc,   TCL_Char **argv) {
     wrapper->resetCommandLine(argc, 1, argv);
 
@@ -1685,6 +1725,9 @@ TclWrapper::addOpenSeesCommands(Tcl_Interp* interp)
     addCommand(interp,"node", &Tcl_ops_node);
     addCommand(interp,"fix", &Tcl_ops_fix);
     addCommand(interp,"element", &Tcl_ops_element);
+    addCommand(interp,"nodes", &Tcl_ops_nodes);
+    addCommand(interp,"fixes", &Tcl_ops_fixes);
+    addCommand(interp,"elements", &Tcl_ops_elements);
     addCommand(interp,"timeSeries", &Tcl_ops_timeSeries);
     addCommand(interp,"pattern", &Tcl_ops_pattern);
     addCommand(interp,"load", &Tcl_ops_nodalLoad);
@@ -1718,6 +1761,7 @@ TclWrapper::addOpenSeesCommands(Tcl_Interp* interp)
     addCommand(interp,"equalDOF", &Tcl_ops_equalDOF);
     addCommand(interp,"nodeEigenvector", &Tcl_ops_nodeEigenvector);
     addCommand(interp,"getTime", &Tcl_ops_getTime);
+    addCommand(interp,"memoryStats", &Tcl_ops_memoryStats);
     addCommand(interp,"setCreep", &Tcl_ops_setCreep);
     addCommand(interp,"eleResponse", &Tcl_ops_eleResponse);
     addCommand(interp,"sp", &Tcl_ops_SP);
@@ -1765,6 +1809,7 @@ TclWrapper::addOpenSeesCommands(Tcl_Interp* interp)
     addCommand(interp,"setPrecision", &Tcl_ops_setPrecision);
     addCommand(interp,"searchPeerNGA", &Tcl_ops_searchPeerNGA);
     addCommand(interp,"domainChange", &Tcl_ops_domainChange);
+    addCommand(interp,"nodalStatePool", &Tcl_ops_nodalStatePool);
     addCommand(interp,"record", &Tcl_ops_record);
     addCommand(interp,"metaData", &Tcl_ops_metaData);
     addCommand(interp,"defaultUnits", &Tcl_ops_defaultUnits);
@@ -65,6 +65,7 @@ class ElasticIsotropic3DThermal : public ElasticIsotropicMaterialThermal
     int commitState (void);
     int revertToLastCommit (void);
     int revertToStart (void);
+    bool hasPathIndependentState(void) {return false;};
     
     NDMaterial *getCopy (void);
     const char *getType (void) const;
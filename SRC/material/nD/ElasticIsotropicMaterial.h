@@ -73,6 +73,7 @@ class ElasticIsotropicMaterial : public NDMaterial
     virtual int commitState (void);
     virtual int revertToLastCommit (void);
     virtual int revertToStart (void);
+    virtual bool hasPathIndependentState(void) {return true;};
     
     // Create a copy of material parameters AND state variables
     // Called by GenericSectionXD
@@ -68,6 +68,7 @@ class ElasticOrthotropicMaterial : public NDMaterial
     virtual int commitState (void);
     virtual int revertToLastCommit (void);
     virtual int revertToStart (void);
+    virtual bool hasPathIndependentState(void) {return true;};
     
     // Create a copy of material parameters AND state variables
     // Called by GenericSectionXD
@@ -60,6 +60,7 @@ class IncrementalElasticIsotropicThreeDimensional : public ElasticIsotropicMater
     int commitState (void);
     int revertToLastCommit (void);
     int revertToStart (void);
+    bool hasPathIndependentState(void) {return false;};
     
     NDMaterial *getCopy (void);
     virtual NDMaterial *getCopy (const char *type);
@@ -48,6 +48,7 @@
 #include <string.h>
 #include <TaggedObject.h>
 #include <MapOfTaggedObjects.h>
+#include <MemoryStats.h>
 
 Matrix NDMaterial::errMatrix(1,1);
 Vector NDMaterial::errVector(1);
@@ -63,21 +64,22 @@ void OPSDLL_SetNDMaterialEventHandlers(ModelBuilder_AddNDMaterial add, ModelBuil
 #endif
 bool OPS_addNDMaterial(NDMaterial *newComponent)
 {
-#if _DLL
 	bool ret = theNDMaterialObjects.addComponent(newComponent);
+#if _DLL
 	if (ret && modelBuilderNDMaterialEventHandler._ModelBuilder_AddNDMaterial != 0) {
 		modelBuilderNDMaterialEventHandler._ModelBuilder_AddNDMaterial(newComponent);
 	}
-	return ret;
-#else
-	return theNDMaterialObjects.addComponent(newComponent);
 #endif
+	if (ret == true)
+		MemoryStats::charge(MemoryStats::Domain, newComponent->getClassTag(), newComponent->getClassType());
+	return ret;
 }
 
 bool OPS_removeNDMaterial(int tag)
 {
     TaggedObject* obj = theNDMaterialObjects.removeComponent(tag);
     if (obj != 0) {
+	MemoryStats::uncharge(MemoryStats::Domain, ((NDMaterial *)obj)->getClassTag(), ((NDMaterial *)obj)->getClassType());
 	delete obj;
 #if _DLL
 	if (modelBuilderNDMaterialEventHandler._ModelBuilder_RemoveNDMaterial != 0) {
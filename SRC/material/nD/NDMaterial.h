@@ -78,6 +78,10 @@ class NDMaterial : public Material
     virtual int revertToLastCommit(void) = 0;
     virtual int revertToStart(void) = 0;
 
+    // true if the stress and tangent depend only on the trial strain,
+    // so that an element need not repeat setTrialStrain() with it
+    virtual bool hasPathIndependentState(void) {return false;};
+
     virtual NDMaterial *getCopy(void) = 0;
     virtual NDMaterial *getCopy(const char *code);
 
@@ -62,6 +62,7 @@ class PressureDependentElastic3D : public ElasticIsotropicMaterial
     int commitState (void);
     int revertToLastCommit (void);
     int revertToStart (void);
+    bool hasPathIndependentState(void) {return false;};
 
     NDMaterial *getCopy (void);
     NDMaterial *getCopy(const char *type);
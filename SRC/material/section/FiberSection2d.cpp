@@ -1445,4 +1445,37 @@ double FiberSection2d::getMaxDuctility(const char* matType) const
 }
 
 
+bool FiberSection2d::isElastic(const Vector &deforms, double yieldFraction)
+{
+	double d0 = deforms(0);
+	double d1 = deforms(1);
+
+	static double fiberLocs[10000];
+
+	if (sectionIntegr != 0) {
+		sectionIntegr->getFiberLocations(numFibers, fiberLocs);
+	}
+	else {
+		for (int i = 0; i < numFibers; i++) {
+			fiberLocs[i] = matData[2 * i];
+		}
+	}
+	for (int i = 0; i < numFibers; i++) {
+		double y = fiberLocs[i] - yBar;
+
+		// only materials linear up to their yield strains are taken as
+		// elastic, each fiber is checked against the limit for its sign
+		UniaxialMaterial *theMat = theMaterials[i];
+		if (theMat->isLinearBelowYield() == false)
+			return false;
+		double strain = d0 - y * d1;
+		double sYield = (strain > 0.0) ? theMat->getInitTensileYieldStrain() :
+			theMat->getInitCompressiveYieldStrain();
+		if (fabs(strain) > yieldFraction * fabs(sYield))
+			return false;
+	}
+	return true;
+}
+
+
 #endif // _CSS
@@ -95,6 +95,7 @@ class FiberSection2d : public SectionForceDeformation
 	//by SAJalali
 	double getDmax();
    virtual double getMaxDuctility(const char* matType = 0) const;
+   bool isElastic(const Vector &e, double yieldFraction);
 
 #endif // _CSS
 
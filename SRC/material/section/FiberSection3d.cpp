@@ -1643,5 +1643,51 @@ double FiberSection3d::getMaxDuctility(const char* matType) const
 	}
 	return muMax;
 }
+
+bool FiberSection3d::isElastic(const Vector &deforms, double yieldFraction)
+{
+	double d0 = deforms(0);
+	double d1 = deforms(1);
+	double d2 = deforms(2);
+
+	static double fiberLocsy[10000];
+	static double fiberLocsz[10000];
+
+	if (sectionIntegr != 0) {
+		sectionIntegr->getFiberLocations(numFibers, fiberLocsy, fiberLocsz);
+	}
+	else {
+		for (int i = 0; i < numFibers; i++) {
+			fiberLocsy[i] = matData[3 * i];
+			fiberLocsz[i] = matData[3 * i + 1];
+		}
+	}
+	for (int i = 0; i < numFibers; i++) {
+		double y = fiberLocsy[i] - yBar;
+		double z = fiberLocsz[i] - zBar;
+
+		// only materials linear up to their yield strains are taken as
+		// elastic, each fiber is checked against the limit for its sign
+		UniaxialMaterial *theMat = theMaterials[i];
+		if (theMat->isLinearBelowYield() == false)
+			return false;
+		double strain = d0 - y * d1 + z * d2;
+		double sYield = (strain > 0.0) ? theMat->getInitTensileYieldStrain() :
+			theMat->getInitCompressiveYieldStrain();
+		if (fabs(strain) > yieldFraction * fabs(sYield))
+			return false;
+	}
+
+	if (theTorsion != 0) {
+		if (theTorsion->isLinearBelowYield() == false)
+			return false;
+		double strain = deforms(3);
+		double sYield = (strain > 0.0) ? theTorsion->getInitTensileYieldStrain() :
+			theTorsion->getInitCompressiveYieldStrain();
+		if (fabs(strain) > yieldFraction * fabs(sYield))
+			return false;
+	}
+	return true;
+}
 #endif // _CSS
 
@@ -97,6 +97,7 @@ class FiberSection3d : public SectionForceDeformation
 	//by SAJalali
 	double getDmax();
    virtual double getMaxDuctility(const char* matType = "") const;
+   bool isElastic(const Vector &e, double yieldFraction);
 #endif // _CSS
 
 
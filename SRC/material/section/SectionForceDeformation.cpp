@@ -42,6 +42,7 @@
 #include <TaggedObject.h>
 #include <MapOfTaggedObjects.h>
 #include <MapOfTaggedObjectsIter.h>
+#include <MemoryStats.h>
 
 static MapOfTaggedObjects theSectionForceDeformationObjects;
 #if _DLL
@@ -53,21 +54,22 @@ void OPSDLL_SetSectionEventHandlers(ModelBuilder_AddSection add, ModelBuilder_Re
 }
 #endif
 bool OPS_addSectionForceDeformation(SectionForceDeformation *newComponent) {
-#if _DLL
 	bool ret = theSectionForceDeformationObjects.addComponent(newComponent);
+#if _DLL
 	if (ret && modelBuilderSectionEventHandler._ModelBuilder_AddSection != 0) {
 		modelBuilderSectionEventHandler._ModelBuilder_AddSection(newComponent);
 	}
-	return ret;
-#else
-	return theSectionForceDeformationObjects.addComponent(newComponent);
 #endif
+	if (ret == true)
+		MemoryStats::charge(MemoryStats::Domain, newComponent->getClassTag(), newComponent->getClassType());
+	return ret;
 }
 
 bool OPS_removeSectionForceDeformation(int tag)
 {
     TaggedObject* obj = theSectionForceDeformationObjects.removeComponent(tag);
     if (obj != 0) {
+	MemoryStats::uncharge(MemoryStats::Domain, ((SectionForceDeformation *)obj)->getClassTag(), ((SectionForceDeformation *)obj)->getClassType());
 	delete obj;
 #if _DLL
 	if (modelBuilderSectionEventHandler._ModelBuilder_RemoveSection != 0) {
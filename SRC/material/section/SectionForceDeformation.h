@@ -129,6 +129,12 @@ class SectionForceDeformation : public Material
 #ifdef _CSS
   virtual double getMaxDuctility(const char* matType = 0) const { return 0; };		//by SAJalali
 #endif // _CSS
+
+  // true if all of the section's material points are linear up to yield
+  // and the section deformations e keep them within yieldFraction of
+  // their initial yield strain in tension or compression, so that the
+  // section responds exactly with its initial flexibility
+  virtual bool isElastic(const Vector &e, double yieldFraction) { return false; }
 
  protected:
   Matrix *fDefault;	// Default flexibility matrix
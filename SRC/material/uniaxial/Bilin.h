@@ -79,6 +79,7 @@ class Bilin : public UniaxialMaterial
   double energy;
   virtual double getEnergy(void) { return energy; } //by SAJalali
   virtual double getInitYieldStrain() { return My_pos / Ke0; }
+  virtual double getInitCompressiveYieldStrain() { return fabs(My_neg / Ke0); }
   virtual void resetEnergy(void) { energy = 0; }
 #endif // _CSS
 
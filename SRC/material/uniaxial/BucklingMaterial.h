@@ -37,6 +37,7 @@
 #define BucklingMaterial_h
 
 #include <UniaxialMaterial.h>
+#include <math.h>
 
 
 class BucklingMaterial : public UniaxialMaterial
@@ -84,6 +85,7 @@ class BucklingMaterial : public UniaxialMaterial
   double getEnergy() { return CenergyD; }
 #ifdef _CSS
   double getInitYieldStrain() { return rot1p; }//by SAJalali
+  double getInitCompressiveYieldStrain() { return fabs(rot1n); }
 #endif // _CSS
 
  protected:
@@ -83,6 +83,8 @@ class Concrete01 : public UniaxialMaterial
 #ifdef _CSS
   //by SAJalali
   double getInitYieldStrain() { return fabs(epsc0/2); }
+  // no tensile strength, any tension is past cracking
+  double getInitTensileYieldStrain() { return 0.0; }
   virtual void resetEnergy(void) { EnergyP = 0; }
 #endif // _CSS
 
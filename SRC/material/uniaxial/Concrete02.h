@@ -79,6 +79,8 @@ class Concrete02 : public UniaxialMaterial
     double EnergyP;
     double getEnergy() { return EnergyP; }
     double getInitYieldStrain() { return fabs(epsc0/2); }
+    // the cracking strain, ft over the initial tangent 2*fc/epsc0
+    double getInitTensileYieldStrain() { return fabs(ft*epsc0/(2.0*fc)); }
     virtual void resetEnergy(void) { EnergyP = 0; }
 #endif // _CSS
 
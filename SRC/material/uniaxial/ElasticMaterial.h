@@ -37,6 +37,7 @@
 
 
 #include <UniaxialMaterial.h>
+#include <float.h>
 
 class ElasticMaterial : public UniaxialMaterial
 {
@@ -85,6 +86,13 @@ class ElasticMaterial : public UniaxialMaterial
         double energy = 0.5 * trialStrain * s;
         return energy; 
     }
+    // a linear material never yields
+    virtual double getInitYieldStrain(void) {
+        return (Epos == Eneg && eta == 0.0) ? DBL_MAX : 0.0;
+    }
+    virtual bool isLinearBelowYield(void) {
+        return (Epos == Eneg && eta == 0.0);
+    }
 #endif
   protected:
     
@@ -27,6 +27,7 @@
 
 
 #include <UniaxialMaterial.h>
+#include <math.h>
 
 class ElasticPPLagMaterial : public UniaxialMaterial
 {
@@ -63,6 +64,7 @@ class ElasticPPLagMaterial : public UniaxialMaterial
 	virtual double getEnergy() { return EnergyP; };
 #ifdef _CSS
 	virtual double getInitYieldStrain() { return fyp / E; }//by SAJalali
+	virtual double getInitCompressiveYieldStrain() { return fabs(fyn / E); }
 #endif // _CSS
 
   protected:
@@ -36,6 +36,7 @@
 // What: "@(#) ElasticPPMaterial.h, revA"
 
 #include <UniaxialMaterial.h>
+#include <math.h>
 
 class ElasticPPMaterial : public UniaxialMaterial
 {
@@ -73,6 +74,8 @@ class ElasticPPMaterial : public UniaxialMaterial
 	virtual double getEnergy() { return EnergyP; };
 #ifdef _CSS
 	virtual double getInitYieldStrain() { return fyp / E; }//by SAJalali
+	virtual double getInitCompressiveYieldStrain() { return fabs(fyn / E); }
+	virtual bool isLinearBelowYield() { return ezero == 0.0; }
 #endif // _CSS
 
   protected:
@@ -91,6 +91,8 @@ class FatigueMaterial : public UniaxialMaterial
 #ifdef _CSS
   //by SAJalali
   virtual double getInitYieldStrain() { return theMaterial->getInitYieldStrain(); }
+  virtual double getInitTensileYieldStrain() { return theMaterial->getInitTensileYieldStrain(); }
+  virtual double getInitCompressiveYieldStrain() { return theMaterial->getInitCompressiveYieldStrain(); }
   virtual void resetEnergy(void) { energy = 0; }
 #endif // _CSS
 
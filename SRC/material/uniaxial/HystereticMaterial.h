@@ -84,6 +84,8 @@ class HystereticMaterial : public UniaxialMaterial
   double getEnergy() { return CenergyD; }
 #ifdef _CSS
   double getInitYieldStrain() { return rot1p; }//by SAJalali
+  double getInitCompressiveYieldStrain() { return fabs(rot1n); }
+  bool isLinearBelowYield() { return true; }
 #endif // _CSS
 
  protected:
@@ -33,6 +33,7 @@
 #define MinMaxMaterial_h
 
 #include <UniaxialMaterial.h>
+#include <math.h>
 
 class MinMaxMaterial : public UniaxialMaterial
 {
@@ -77,6 +78,16 @@ class MinMaxMaterial : public UniaxialMaterial
     int    commitSensitivity        (double strainGradient, int gradIndex, int numGrads);
     // AddingSensitivity:END ///////////////////////////////////////////
     virtual double getInitYieldStrain() { return theMaterial->getInitYieldStrain(); } //SAJalali
+    // the strain limits end the linear range if they come first
+    virtual double getInitTensileYieldStrain() {
+        double e = fabs(theMaterial->getInitTensileYieldStrain());
+        return (maxStrain < e) ? maxStrain : e;
+    }
+    virtual double getInitCompressiveYieldStrain() {
+        double e = fabs(theMaterial->getInitCompressiveYieldStrain());
+        return (-minStrain < e) ? -minStrain : e;
+    }
+    virtual bool isLinearBelowYield() { return theMaterial->isLinearBelowYield(); }
     virtual void resetEnergy(void) { theMaterial->resetEnergy(); }
     virtual double getEnergy() { return theMaterial->getEnergy(); }
 
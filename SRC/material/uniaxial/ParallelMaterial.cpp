@@ -628,6 +628,37 @@ double ParallelMaterial::getInitYieldStrain()
 
     return res;
 }
+double ParallelMaterial::getInitTensileYieldStrain()
+{
+    // the first material to crack or yield in tension sets the limit
+    double res = 0;
+    for (int i = 0; i < numMaterials; i++) {
+        double d = fabs(theModels[i]->getInitTensileYieldStrain());
+        if (i == 0 || d < res)
+            res = d;
+    }
+
+    return res;
+}
+double ParallelMaterial::getInitCompressiveYieldStrain()
+{
+    double res = 0;
+    for (int i = 0; i < numMaterials; i++) {
+        double d = fabs(theModels[i]->getInitCompressiveYieldStrain());
+        if (i == 0 || d < res)
+            res = d;
+    }
+
+    return res;
+}
+bool ParallelMaterial::isLinearBelowYield()
+{
+    for (int i = 0; i < numMaterials; i++)
+        if (theModels[i]->isLinearBelowYield() == false)
+            return false;
+
+    return true;
+}
 double ParallelMaterial::getEnergy()
 {
     return energy;
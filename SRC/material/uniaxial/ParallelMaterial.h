@@ -73,6 +73,9 @@ class ParallelMaterial : public UniaxialMaterial
     int getResponse(int responseID, Information &matInformation);
 #ifdef _CSS
     virtual double getInitYieldStrain();
+    virtual double getInitTensileYieldStrain();
+    virtual double getInitCompressiveYieldStrain();
+    virtual bool isLinearBelowYield();
     virtual double getEnergy();
     virtual void resetEnergy(void);
 #endif // _CSS
@@ -89,6 +89,7 @@ class Steel01 : public UniaxialMaterial
 #ifdef _CSS
 	//by SAJalali
 	double getInitYieldStrain() { return fy / E0; }
+	bool isLinearBelowYield() { return true; }
    virtual void resetEnergy(void) { Energy = 0; }
 #endif // _CSS
 
@@ -42,6 +42,7 @@
 
 #include <TaggedObject.h>
 #include <MapOfTaggedObjects.h>
+#include <MemoryStats.h>
 
 static MapOfTaggedObjects theUniaxialMaterialObjects;
 
@@ -54,21 +55,22 @@ void OPSDLL_SetUniaxialMaterialEventHandlers(ModelBuilder_AddUniaxialMaterial ad
 }
 #endif
 bool OPS_addUniaxialMaterial(UniaxialMaterial* newComponent) {
-#if _DLL
 	bool ret = theUniaxialMaterialObjects.addComponent(newComponent);
+#if _DLL
 	if (ret && modelBuilderUniaxialMaterialEventHandler._ModelBuilder_AddUniaxialMaterial != 0) {
 		modelBuilderUniaxialMaterialEventHandler._ModelBuilder_AddUniaxialMaterial(newComponent);
 	}
-	return ret;
-#else
-	return theUniaxialMaterialObjects.addComponent(newComponent);
 #endif
+	if (ret == true)
+		MemoryStats::charge(MemoryStats::Domain, newComponent->getClassTag(), newComponent->getClassType());
+	return ret;
 }
 
 bool OPS_removeUniaxialMaterial(int tag)
 {
 	TaggedObject* obj = theUniaxialMaterialObjects.removeComponent(tag);
 	if (obj != 0) {
+		MemoryStats::uncharge(MemoryStats::Domain, ((UniaxialMaterial *)obj)->getClassTag(), ((UniaxialMaterial *)obj)->getClassType());
 		delete obj;
 #if _DLL
 		if (modelBuilderUniaxialMaterialEventHandler._ModelBuilder_RemoveUniaxialMaterial != 0) {
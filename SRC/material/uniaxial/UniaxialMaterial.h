@@ -106,6 +106,12 @@ class UniaxialMaterial : public Material
 #ifdef _CSS
 	//by SAJalali
 	virtual double getInitYieldStrain() { return 0; }
+	// the initial yield strains in tension and in compression, for
+	// materials that differ between the two
+	virtual double getInitTensileYieldStrain() { return this->getInitYieldStrain(); }
+	virtual double getInitCompressiveYieldStrain() { return this->getInitYieldStrain(); }
+	// true if the response is linear from zero strain up to these limits
+	virtual bool isLinearBelowYield() { return false; }
 	virtual double getDuctility(void);
 #endif // _CSS
 protected:
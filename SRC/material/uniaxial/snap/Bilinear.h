@@ -43,6 +43,7 @@
 #include <UniaxialMaterial.h>
 #include <Vector.h>
 #include <stdio.h>
+#include <math.h>
 #include <DamageModel.h>
 #include <MaterialResponse.h>
 
@@ -93,6 +94,7 @@ class Bilinear : public UniaxialMaterial
 #ifdef _CSS
 	double getEnergy();
 	double getInitYieldStrain() { return fyieldPos / elstk; }
+	double getInitCompressiveYieldStrain() { return fabs(fyieldNeg / elstk); }
 #endif // _CSS
 
  protected:
@@ -43,6 +43,7 @@
 #include <UniaxialMaterial.h>
 #include <Vector.h>
 #include <stdio.h>
+#include <math.h>
 
 class Clough : public UniaxialMaterial
 {
@@ -83,6 +84,7 @@ class Clough : public UniaxialMaterial
   //by SAJalali
   double getEnergy()  {return Energy;}
   double getInitYieldStrain() { return fyieldPos / elstk; } //SAJalali
+  double getInitCompressiveYieldStrain() { return fabs(fyieldNeg / elstk); }
   virtual void resetEnergy(void) { Energy = 0; }
 #endif // _CSS
 
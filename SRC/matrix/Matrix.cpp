@@ -37,6 +37,7 @@
 
 #include <stdlib.h>
 #include <iostream>
+#include <utility>
 using std::nothrow;
 
 #define MATRIX_WORK_AREA 400
@@ -197,18 +198,35 @@ Matrix::Matrix(const Matrix &other)
     }
 }
 
-// Move ctor
-#ifdef USE_CXX11
-Matrix::Matrix(Matrix &&other)
-:numRows(other.numRows), numCols(other.numCols), dataSize(other.dataSize), data(other.data), fromFree(other.fromFree)
+// Move ctor, takes over the array of other if it owns one; data owned
+// elsewhere is copied as by the copy constructor.
+Matrix::Matrix(Matrix &&other) noexcept
+:
+#ifdef _CSS
+ IsDiagonal(other.isDiagonal()),
+#endif // _CSS
+ numRows(other.numRows), numCols(other.numCols), dataSize(other.dataSize), data(other.data), fromFree(0)
 {
-  other.numRows = 0;
-  other.numCols = 0;
-  other.dataSize = 0;
-  other.data = 0;
-  other.fromFree = 1;
+  if (other.fromFree == 0) {
+    other.numRows = 0;
+    other.numCols = 0;
+    other.dataSize = 0;
+    other.data = 0;
+  } else {
+    data = 0;
+    if (dataSize != 0) {
+      data = new (nothrow) double[dataSize];
+      if (data == 0) {
+	opserr << "WARNING:Matrix::Matrix(Matrix &&): ";
+	opserr << "Ran out of memory on init of size " << dataSize << endln; 
+	numRows = 0; numCols =0; dataSize = 0;
+      } else {
+	for (int i=0; i<dataSize; i++)
+	  data[i] = other.data[i];
+      }
+    }
+  }
 }
-#endif
 
 //
 // DESTRUCTOR
@@ -1282,14 +1300,15 @@ Matrix::operator=(const Matrix &other)
       opserr << "Matrix::operator=() - matrix dimensions do not match\n";
 #endif
 
-      if (this->data != 0)
+      if (this->data != 0 && fromFree == 0)
       {
 	  delete [] this->data;
-          this->data = 0;
       }
+      this->data = 0;
       
       int theSize = other.numCols*other.numRows;
       
+      fromFree = 0;
       data = new (nothrow) double[theSize];
       
       this->dataSize = theSize;
@@ -1309,35 +1328,41 @@ Matrix::operator=(const Matrix &other)
 
 
 // Move assignment
-//
-#ifdef USE_CXX11
+//	the array of other is taken over only where the copy would have
+//	allocated a new one anyway, i.e. for differing dimensions; otherwise
+//	the data is copied, so that a Matrix set up on an external array
+//	keeps writing into it.
 Matrix &
-Matrix::operator=( Matrix &&other)
+Matrix::operator=( Matrix &&other) noexcept
 {
   // first check we are not trying other = other
   if (this == &other) 
     return *this;
 
+  if (other.fromFree != 0 || other.data == 0 ||
+      (numCols == other.numCols && numRows == other.numRows))
+    return *this = static_cast<const Matrix &>(other);
+
+#ifdef _CSS
+  IsDiagonal = other.IsDiagonal;
+#endif // _CSS
 
   if (this->data != 0 && fromFree == 0){
     delete [] this->data;
-    this->data = 0;
   }
         
   this->data = other.data;
-  this->dataSize = other.numCols*other.numRows;
+  this->dataSize = other.dataSize;
   this->numCols = other.numCols;
   this->numRows = other.numRows;
-  this->fromFree = other.fromFree;
+  this->fromFree = 0;
   other.data = 0;
   other.dataSize = 0;
   other.numCols = 0;
   other.numRows = 0;
-  other.fromFree = 1;
 
   return *this;
 }
-#endif
 
 
 // virtual Matrix &operator+=(double fact);
@@ -1923,6 +1948,55 @@ Matrix operator*(double a, const Matrix &V)
 }
 
 
+// operators on a temporary Matrix: the result is computed in place
+
+Matrix operator+(Matrix &&A, double fact)
+{
+  A += fact;
+  return std::move(A);
+}
+
+Matrix operator-(Matrix &&A, double fact)
+{
+  A -= fact;
+  return std::move(A);
+}
+
+Matrix operator*(Matrix &&A, double fact)
+{
+  A *= fact;
+  return std::move(A);
+}
+
+Matrix operator/(Matrix &&A, double fact)
+{
+  if (fact == 0.0) {
+    opserr << "Matrix::operator/(const double &fact): ERROR divide-by-zero\n";
+    exit(0);
+  }
+  A /= fact;
+  return std::move(A);
+}
+
+Matrix operator+(Matrix &&A, const Matrix &B)
+{
+  A.addMatrix(1.0,B,1.0);
+  return std::move(A);
+}
+
+Matrix operator-(Matrix &&A, const Matrix &B)
+{
+  A.addMatrix(1.0,B,-1.0);
+  return std::move(A);
+}
+
+Matrix operator*(double fact, Matrix &&A)
+{
+  A *= fact;
+  return std::move(A);
+}
+
+
 
 
 int
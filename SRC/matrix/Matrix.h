@@ -53,9 +53,7 @@ class Matrix
     Matrix(int nrows, int ncols);
     Matrix(double *data, int nrows, int ncols);    
     Matrix(const Matrix &M);    
-#ifdef USE_CXX11
-    Matrix( Matrix &&M);    
-#endif
+    Matrix( Matrix &&M) noexcept;    
     ~Matrix();
 
     // utility methods
@@ -114,10 +112,7 @@ class Matrix
     Matrix operator()(const ID &rows, const ID & cols) const;
     
     Matrix &operator=(const Matrix &M);
-
-#ifdef USE_CXX11
-    Matrix &operator=(Matrix &&M);
-#endif
+    Matrix &operator=(Matrix &&M) noexcept;
     
     // matrix operations which will preserve the derived type and
     // which can be implemented efficiently without many constructor calls.
@@ -168,6 +163,15 @@ class Matrix
     friend OPS_Stream &operator<<(OPS_Stream &s, const Matrix &M);
     //    friend istream &operator>>(istream &s, Matrix &M);    
     friend Matrix operator*(double a, const Matrix &M);
+
+    // a temporary on the left is reused for the result
+    friend Matrix operator+(Matrix &&A, double fact);
+    friend Matrix operator-(Matrix &&A, double fact);
+    friend Matrix operator*(Matrix &&A, double fact);
+    friend Matrix operator/(Matrix &&A, double fact);
+    friend Matrix operator+(Matrix &&A, const Matrix &B);
+    friend Matrix operator-(Matrix &&A, const Matrix &B);
+    friend Matrix operator*(double fact, Matrix &&A);
     
     
     friend class Vector;    
@@ -177,6 +181,7 @@ class Matrix
     friend class TCP_SocketSSL;
     friend class TCP_SocketNoDelay;
     friend class MPI_Channel;
+    friend class SharedMemoryChannel;
     friend class MySqlDatastore;
     friend class BerkeleyDbDatastore;
 
@@ -35,6 +35,7 @@
 #include "Matrix.h"
 #include "ID.h"
 #include <iostream>
+#include <utility>
 using std::nothrow;
 
 #include <math.h>
@@ -66,12 +67,8 @@ Vector::Vector(int size)
   // get some space for the vector
   //  theData = (double *)malloc(size*sizeof(double));
   if (size > 0) {
-    theData = new (nothrow) double [size];
-
-    if (theData == 0) {
+    if (this->allocate(size) < 0) 
       opserr << "Vector::Vector(int) - out of memory creating vector of size " << size << endln;
-      sz = 0; // set this should fatal error handler not kill process!!
-    }
     
     // zero the components
     for (int i=0; i<sz; i++)
@@ -103,11 +100,8 @@ Vector::Vector(const std::vector<double>& other)
 : sz(other.size()),theData(0),fromFree(0)
 {
   if (sz != 0) {
-    theData = new (nothrow) double [sz];    
-    
-    if (theData == 0) {
-      opserr << "Vector::Vector(std::vector) - out of memory creating vector of size " << sz << endln;
-    }
+    if (this->allocate(sz) < 0) 
+      opserr << "Vector::Vector(std::vector) - out of memory creating vector of size " << other.size() << endln;
   }
   // copy the component data
   for (int i=0; i<sz; i++)
@@ -119,11 +113,8 @@ Vector::Vector(const Vector &other)
 : sz(other.sz),theData(0),fromFree(0)
 {
   if (sz != 0) {
-    theData = new (nothrow) double [other.sz];    
-    
-    if (theData == 0) {
-      opserr << "Vector::Vector(int) - out of memory creating vector of size " << sz << endln;
-    }
+    if (this->allocate(other.sz) < 0) 
+      opserr << "Vector::Vector(int) - out of memory creating vector of size " << other.sz << endln;
   }
   // copy the component data
   for (int i=0; i<sz; i++)
@@ -132,17 +123,67 @@ Vector::Vector(const Vector &other)
 
 
 
-// Vector(const Vector&):
-//  Move constructor
-#ifdef USE_CXX11   
-Vector::Vector(Vector &&other)
-: sz(other.sz),theData(other.theData),fromFree(0)
+// Vector(Vector&&):
+//  Move constructor, takes over the array of other if it owns one,
+//  inline data and data owned elsewhere are copied.
+
+Vector::Vector(Vector &&other) noexcept
+: sz(0),theData(0),fromFree(0)
 {
-  //opserr << "move ctor!\n";
-  other.theData = 0;
-  other.sz = 0;
+  if (other.fromFree == 0) {
+    sz = other.sz;
+    theData = other.theData;
+    other.theData = 0;
+    other.sz = 0;
+  } else if (other.sz != 0) {
+    if (this->allocate(other.sz) < 0) 
+      opserr << "Vector::Vector(Vector&&) - out of memory creating vector of size " << other.sz << endln;
+    for (int i=0; i<sz; i++)
+      theData[i] = other.theData[i];
+  }
 } 
-#endif
+
+
+// allocate(int size):
+//  sets theData to space for size values, in the object for small
+//  vectors, assumes any old space has been released.
+
+int
+Vector::allocate(int size)
+{
+  if (size <= 0) {
+    sz = 0;
+    theData = 0;
+    fromFree = 0;
+  } else if (size <= VECTOR_INLINE_SIZE) {
+    sz = size;
+    theData = inlineData;
+    fromFree = 2;
+  } else {
+    fromFree = 0;
+    theData = new (nothrow) double [size];
+    if (theData == 0) {
+      sz = 0; // set this should fatal error handler not kill process!!
+      return -1;
+    }
+    sz = size;
+  }
+
+  return 0;
+}
+
+
+// release():
+//  frees the space if it was obtained by allocate() from the heap.
+
+void
+Vector::release(void)
+{
+  if (theData != 0 && fromFree == 0) 
+    delete [] theData;
+  theData = 0;
+  fromFree = 0;
+}
 
 
 
@@ -190,23 +231,23 @@ Vector::resize(int newSize){
   // otherwise if newSize is gretaer than oldSize free old space and get new space
   else if (newSize > sz) {
 
+    // still fits in the object
+    if (fromFree == 2 && newSize <= VECTOR_INLINE_SIZE) {
+      sz = newSize;
+      return 0;
+    }
+
     // delete the old array
-    if (theData != 0 && fromFree == 0) {
-	delete [] theData;
-  theData = 0;
-}
+    this->release();
     sz = 0;
-    fromFree = 0;
     
     // create new memory
     // theData = (double *)malloc(newSize*sizeof(double));    
-    theData = new (nothrow) double[newSize];
-    if (theData == 0) {
+    if (this->allocate(newSize) < 0) {
       opserr << "Vector::resize() - out of memory for size " << newSize << endln;
       sz = 0;
       return -2;
     }
-    sz = newSize;
   }  
 
   // just set the size to be newSize .. penalty of holding onto additional
@@ -666,18 +707,19 @@ Vector::operator[](int x)
 #endif
   
   if (x >= sz) {
-    double *dataNew = new (nothrow) double[x+1];
-    for (int i=0; i<sz; i++)
-      dataNew[i] = theData[i];
-    for (int j=sz; j<x; j++)
-      dataNew[j] = 0.0;
+    if (fromFree == 2 && x < VECTOR_INLINE_SIZE) {
+      for (int j=sz; j<x; j++)
+	theData[j] = 0.0;
+    } else {
+      double *dataNew = new (nothrow) double[x+1];
+      for (int i=0; i<sz; i++)
+	dataNew[i] = theData[i];
+      for (int j=sz; j<x; j++)
+	dataNew[j] = 0.0;
     
-    if (fromFree == 0)
-      if (theData != 0){
-	delete [] theData;
-  theData = 0;
-}
-    theData = dataNew;
+      this->release();
+      theData = dataNew;
+    }
     sz = x+1;
   }
 
@@ -755,14 +797,10 @@ Vector::operator=(const Vector &V)
 #endif
 
 	  // Check that we are not deleting an empty Vector
-	  if (this->theData != 0){
-      delete [] this->theData;
-      this->theData = 0;
-    }
-	  this->sz = V.sz;
+	  this->release();
 	  
 	  // Check that we are not creating an empty Vector
-	  theData = (sz != 0) ? new (nothrow) double[sz] : 0;
+	  this->allocate(V.sz);
       }
 
 
@@ -774,26 +812,27 @@ Vector::operator=(const Vector &V)
   return *this;
 }
 
-// Move assignment operator.  
-#ifdef USE_CXX11   
+// Move assignment operator. The array of V is taken over only where the
+// copy would have allocated a new one anyway, i.e. for differing sizes; for
+// equal sizes the data is copied so that this keeps its own storage, which
+// may be shared through Vector(double *, int) or setData().
+
 Vector &
-Vector::operator=(Vector &&V) 
+Vector::operator=(Vector &&V) noexcept
 {
   // first check we are not trying v = v
   if (this != &V) {
-    // opserr << "move assign!\n";
-    if (this->theData != 0){ 
-      delete [] this->theData;
-      this->theData = 0;
-    }
-    theData = V.theData;
-    this->sz = V.sz;
-    V.theData = 0;
-    V.sz = 0;
+    if (V.fromFree == 0 && V.theData != 0 && sz != V.sz) {
+      this->release();
+      theData = V.theData;
+      this->sz = V.sz;
+      V.theData = 0;
+      V.sz = 0;
+    } else
+      *this = static_cast<const Vector &>(V);
   }
   return *this;
 }
-#endif
 
 
 
@@ -1166,6 +1205,53 @@ Vector operator*(double a, const Vector &V)
 }
 
 
+// operators on a temporary Vector: the result is computed in place
+
+Vector operator+(Vector &&a, double fact)
+{
+  a += fact;
+  return std::move(a);
+}
+
+Vector operator-(Vector &&a, double fact)
+{
+  a -= fact;
+  return std::move(a);
+}
+
+Vector operator*(Vector &&a, double fact)
+{
+  a *= fact;
+  return std::move(a);
+}
+
+Vector operator/(Vector &&a, double fact)
+{
+  if (fact == 0.0) 
+    opserr << "Vector::operator/(double fact) - divide-by-zero error coming\n";
+  a /= fact;
+  return std::move(a);
+}
+
+Vector operator+(Vector &&a, const Vector &b)
+{
+  a += b;
+  return std::move(a);
+}
+
+Vector operator-(Vector &&a, const Vector &b)
+{
+  a -= b;
+  return std::move(a);
+}
+
+Vector operator*(double fact, Vector &&a)
+{
+  a *= fact;
+  return std::move(a);
+}
+
+
 int
 Vector::Assemble(const Vector &V, int init_pos, double fact) 
 {
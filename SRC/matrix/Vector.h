@@ -38,6 +38,10 @@
 
 #define VECTOR_VERY_LARGE_VALUE 1.0e200
 
+// vectors up to this size keep their data inside the object, so that the
+// small temporaries of element and material code do not go to the heap
+#define VECTOR_INLINE_SIZE 6
+
 class Matrix; 
 class Message;
 class SystemOfEqn;
@@ -50,9 +54,7 @@ class Vector
     Vector();
     Vector(int);
     Vector(const Vector &);    
-#ifdef USE_CXX11   
-    Vector(Vector &&);    
-#endif
+    Vector(Vector &&) noexcept;    
 
     Vector(double *data, int size);
 #ifdef _CSS
@@ -101,9 +103,7 @@ class Vector
     double &operator[](int x);
     Vector operator()(const ID &rows) const;
     Vector &operator=(const Vector  &V);
-#ifdef USE_CXX11   
-    Vector &operator=(Vector  &&V);
-#endif
+    Vector &operator=(Vector  &&V) noexcept;
     Vector &operator+=(double fact);
     Vector &operator-=(double fact);
     Vector &operator*=(double fact);
@@ -137,6 +137,16 @@ class Vector
     friend OPS_Stream &operator<<(OPS_Stream &s, const Vector &V);
     // friend istream &operator>>(istream &s, Vector &V);    
     friend Vector operator*(double a, const Vector &V);
+
+    // a temporary on the left is reused for the result, so that in
+    // a + b + c or a*x + b*y only the first term allocates
+    friend Vector operator+(Vector &&a, double fact);
+    friend Vector operator-(Vector &&a, double fact);
+    friend Vector operator*(Vector &&a, double fact);
+    friend Vector operator/(Vector &&a, double fact);
+    friend Vector operator+(Vector &&a, const Vector &b);
+    friend Vector operator-(Vector &&a, const Vector &b);
+    friend Vector operator*(double fact, Vector &&a);
     
     friend class Message;
     friend class SystemOfEqn;
@@ -146,14 +156,20 @@ class Vector
     friend class TCP_SocketSSL;
     friend class TCP_SocketNoDelay;    
     friend class MPI_Channel;
+    friend class SharedMemoryChannel;
     friend class MySqlDatastore;
     friend class BerkeleyDbDatastore;
+    friend class BinaryFileDatastore;
     
   private:
+    int allocate(int size);
+    void release(void);
+
     static double VECTOR_NOT_VALID_ENTRY;
     int sz;
     double *theData;
-    int fromFree;
+    int fromFree;    // 0: theData from new, 1: from elsewhere, 2: inlineData
+    double inlineData[VECTOR_INLINE_SIZE];
 };
 
 
@@ -0,0 +1,512 @@
+/* ****************************************************************** **
+**    OpenSees - Open System for Earthquake Engineering Simulation    **
+**          Pacific Earthquake Engineering Research Center            **
+**                                                                    **
+**                                                                    **
+** (C) Copyright 1999, The Regents of the University of California    **
+** All Rights Reserved.                                               **
+**                                                                    **
+** Commercial use of this program without express permission of the   **
+** University of California, Berkeley, is strictly prohibited.  See   **
+** file 'COPYRIGHT'  in main directory for information on usage and   **
+** redistribution,  and for a DISCLAIMER OF ALL WARRANTIES.           **
+**                                                                    **
+** Developed by:                                                      **
+**   Frank McKenna (fmckenna@ce.berkeley.edu)                         **
+**   Gregory L. Fenves (fenves@ce.berkeley.edu)                       **
+**   Filip C. Filippou (filippou@ce.berkeley.edu)                     **
+**                                                                    **
+** ****************************************************************** */
+
+// Description: commands to define many nodes, elements and fixities
+// with one command. The data is given as arrays (a tcl list, a python
+// list or a NumPy array) or read from a binary file, it is validated
+// as a whole before anything is added to the domain, and the
+// components are then created and added in order of their tags. If one
+// of them cannot be added, the ones already added are removed again, so
+// a command adds either all of its components or none.
+//
+//   nodes tags crds <-ndf ndf> <-mass mass>
+//   elements eleType tags eleNodes eleArgs...
+//   fixes tags flags
+//
+// with -file fileName in place of the two arrays. The binary file holds,
+// in native byte order, the int32 number of items n and the int32 width
+// w, then n int32 tags and n*w values: float64 coordinates for nodes,
+// int32 element nodes or fixity flags otherwise.
+//
+// The element types are those whose arguments can be read once and
+// shared by all the elements, as for the mesh command.
+
+#include <elementAPI.h>
+#include <Domain.h>
+#include <Node.h>
+#include <Element.h>
+#include <SP_Constraint.h>
+#include <ID.h>
+#include <Vector.h>
+#include <Matrix.h>
+#include <stdio.h>
+#include <string.h>
+#include <vector>
+#include <algorithm>
+
+void *OPS_ElasticBeam2d(const ID &info);
+void *OPS_ForceBeamColumn2d(const ID &info);
+void *OPS_DispBeamColumn2d(const ID &info);
+void *OPS_Tri31(const ID &info);
+void *OPS_FourNodeTetrahedron(const ID &info);
+void *OPS_ShellMITC4(const ID &info);
+void *OPS_ShellNLDKGQ(const ID &info);
+void *OPS_CorotTrussElement(const ID &info);
+
+// key under which the element parsers save the shared arguments,
+// mesh tags are positive
+static const int bulkArgsKey = -1;
+
+struct BulkElementType {
+    const char *name;
+    int ndm;        // 0 for any
+    int numNodes;
+    void *(*parse)(const ID &info);
+};
+
+static const BulkElementType bulkElementTypes[] = {
+    {"elasticBeamColumn", 2, 2, OPS_ElasticBeam2d},
+    {"forceBeamColumn", 2, 2, OPS_ForceBeamColumn2d},
+    {"dispBeamColumn", 2, 2, OPS_DispBeamColumn2d},
+    {"tri31", 0, 3, OPS_Tri31},
+    {"FourNodeTetrahedron", 3, 4, OPS_FourNodeTetrahedron},
+    {"ShellMITC4", 3, 4, OPS_ShellMITC4},
+    {"ShellNLDKGQ", 3, 4, OPS_ShellNLDKGQ},
+    {"corotTruss", 0, 2, OPS_CorotTrussElement},
+    {0, 0, 0, 0}
+};
+
+static int
+readBulkFile(const char *fileName, int &width, ID &tags, ID *ivals, Vector *dvals)
+{
+    FILE *fp = fopen(fileName, "rb");
+    if (fp == 0) {
+	opserr << "WARNING: failed to open file " << fileName << "\n";
+	return -1;
+    }
+
+    int header[2];
+    if (fread(header, sizeof(int), 2, fp) != 2 || header[0] < 0 || header[1] < 1) {
+	opserr << "WARNING: invalid header in file " << fileName << "\n";
+	fclose(fp);
+	return -1;
+    }
+    int num = header[0];
+    width = header[1];
+    size_t numVals = (size_t)num * width;
+
+    bool ok = tags.resize(num) == 0;
+    if (ok && num > 0)
+	ok = fread(&tags(0), sizeof(int), num, fp) == (size_t)num;
+    if (ok && ivals != 0) {
+	ok = ivals->resize((int)numVals) == 0;
+	if (ok && numVals > 0)
+	    ok = fread(&(*ivals)(0), sizeof(int), numVals, fp) == numVals;
+    }
+    if (ok && dvals != 0) {
+	ok = dvals->resize((int)numVals) == 0;
+	if (ok && numVals > 0)
+	    ok = fread(&(*dvals)(0), sizeof(double), numVals, fp) == numVals;
+    }
+    fclose(fp);
+
+    if (!ok) {
+	opserr << "WARNING: failed to read " << num << " items from file " << fileName << "\n";
+	return -1;
+    }
+
+    return 0;
+}
+
+// the positions of the tags in increasing order of the tags,
+// fails if a tag is given twice
+static int
+sortTags(const ID &tags, std::vector<int> &order, const char *type)
+{
+    int num = tags.Size();
+    order.resize(num);
+    for (int i = 0; i < num; i++)
+	order[i] = i;
+    std::sort(order.begin(), order.end(),
+	      [&tags](int a, int b) {return tags(a) < tags(b);});
+
+    for (int i = 1; i < num; i++) {
+	if (tags(order[i]) == tags(order[i-1])) {
+	    opserr << "WARNING: " << type << " " << tags(order[i]) << " is given more than once\n";
+	    return -1;
+	}
+    }
+
+    return 0;
+}
+
+// the nodes refered to by the values, each one looked up once
+static int
+checkNodes(Domain *theDomain, const ID &nodeTags)
+{
+    std::vector<int> unique(nodeTags.Size());
+    for (int i = 0; i < nodeTags.Size(); i++)
+	unique[i] = nodeTags(i);
+    std::sort(unique.begin(), unique.end());
+    unique.erase(std::unique(unique.begin(), unique.end()), unique.end());
+
+    for (size_t i = 0; i < unique.size(); i++) {
+	if (theDomain->getNode(unique[i]) == 0) {
+	    opserr << "WARNING: node " << unique[i] << " is not defined\n";
+	    return -1;
+	}
+    }
+
+    return 0;
+}
+
+int OPS_Nodes()
+{
+    Domain *theDomain = OPS_GetDomain();
+    int ndm = OPS_GetNDM();
+    int ndf = OPS_GetNDF();
+
+    if (theDomain == 0) {
+	opserr << "WARNING: domain is not defined\n";
+	return -1;
+    }
+    if (ndm <= 0 || ndf <= 0) {
+	opserr << "WARNING: system ndm and ndf are zero\n";
+	return -1;
+    }
+    if (OPS_GetNumRemainingInputArgs() < 2) {
+	opserr << "WARNING insufficient args: nodes tags? crds? <-ndf ndf?> <-mass mass?>\n";
+	return -1;
+    }
+
+    // tags and coordinates
+    ID tags;
+    Vector crds;
+    int num = 0;
+    const char *opt = OPS_GetString();
+    if (strcmp(opt, "-file") == 0) {
+	int width = 0;
+	if (readBulkFile(OPS_GetString(), width, tags, 0, &crds) < 0)
+	    return -1;
+	if (width != ndm) {
+	    opserr << "WARNING: nodes file has " << width << " coordinates per node, ndm is " << ndm << "\n";
+	    return -1;
+	}
+	num = tags.Size();
+    } else {
+	OPS_ResetCurrentInputArg(-1);
+	int numCrds = 0;
+	if (OPS_GetIntListInput(&num, &tags) < 0) {
+	    opserr << "WARNING: invalid node tags\n";
+	    return -1;
+	}
+	if (OPS_GetDoubleListInput(&numCrds, &crds) < 0) {
+	    opserr << "WARNING: invalid node coordinates\n";
+	    return -1;
+	}
+	if (numCrds != num * ndm) {
+	    opserr << "WARNING: " << numCrds << " coordinates given for " << num << " nodes, want " << num * ndm << "\n";
+	    return -1;
+	}
+    }
+
+    // options
+    Vector mass;
+    while (OPS_GetNumRemainingInputArgs() > 0) {
+	const char *type = OPS_GetString();
+	if (strcmp(type, "-ndf") == 0) {
+	    int numdata = 1;
+	    if (OPS_GetIntInput(numdata, &ndf) < 0 || ndf <= 0) {
+		opserr << "WARNING: failed to read ndf\n";
+		return -1;
+	    }
+	} else if (strcmp(type, "-mass") == 0) {
+	    int numMass = 0;
+	    if (OPS_GetDoubleListInput(&numMass, &mass) < 0) {
+		opserr << "WARNING: failed to read mass\n";
+		return -1;
+	    }
+	} else {
+	    opserr << "WARNING: unknown option " << type << " for nodes\n";
+	    return -1;
+	}
+    }
+
+    // mass for every node or the same for all
+    bool massEach = false;
+    if (mass.Size() > 0) {
+	if (mass.Size() == num * ndf && num > 1)
+	    massEach = true;
+	else if (mass.Size() != ndf) {
+	    opserr << "WARNING: want " << ndf << " or " << num * ndf << " mass terms\n";
+	    return -1;
+	}
+    }
+
+    // validate all tags before adding anything
+    std::vector<int> order;
+    if (sortTags(tags, order, "node") < 0)
+	return -1;
+    for (int i = 0; i < num; i++) {
+	if (theDomain->getNode(tags(i)) != 0) {
+	    opserr << "WARNING: node " << tags(i) << " already exists\n";
+	    return -1;
+	}
+    }
+
+    // create all the nodes
+    Matrix ndmass;
+    if (mass.Size() > 0)
+	ndmass.resize(ndf, ndf);
+
+    std::vector<Node *> theNodes(num, (Node *)0);
+    for (int k = 0; k < num; k++) {
+	int i = order[k];
+	const double *x = &crds(i * ndm);
+
+	Node *theNode = 0;
+	if (ndm == 1)
+	    theNode = new Node(tags(i), ndf, x[0]);
+	else if (ndm == 2)
+	    theNode = new Node(tags(i), ndf, x[0], x[1]);
+	else
+	    theNode = new Node(tags(i), ndf, x[0], x[1], x[2]);
+
+	if (theNode == 0) {
+	    opserr << "WARNING: run out of memory for node " << tags(i) << "\n";
+	    for (int j = 0; j < k; j++)
+		delete theNodes[j];
+	    return -1;
+	}
+
+	if (mass.Size() > 0) {
+	    const double *m = massEach ? &mass(i * ndf) : &mass(0);
+	    ndmass.Zero();
+	    for (int j = 0; j < ndf; j++)
+		ndmass(j, j) = m[j];
+	    theNode->setMass(ndmass);
+	}
+	theNode->commitState();
+	theNodes[k] = theNode;
+    }
+
+    // and add them
+    for (int k = 0; k < num; k++) {
+	if (theDomain->addNode(theNodes[k]) == false) {
+	    opserr << "WARNING: failed to add node " << theNodes[k]->getTag() << " to domain\n";
+	    for (int j = 0; j < k; j++)
+		delete theDomain->removeNode(theNodes[j]->getTag());
+	    for (int j = k; j < num; j++)
+		delete theNodes[j];
+	    return -1;
+	}
+    }
+
+    return 0;
+}
+
+int OPS_Elements()
+{
+    Domain *theDomain = OPS_GetDomain();
+    if (theDomain == 0) {
+	opserr << "WARNING: domain is not defined\n";
+	return -1;
+    }
+    if (OPS_GetNumRemainingInputArgs() < 3) {
+	opserr << "WARNING insufficient args: elements eleType? tags? eleNodes? eleArgs?\n";
+	return -1;
+    }
+
+    // element type
+    const char *type = OPS_GetString();
+    int ndm = OPS_GetNDM();
+    const BulkElementType *eleType = 0;
+    for (const BulkElementType *t = bulkElementTypes; t->name != 0; t++) {
+	if (strcmp(type, t->name) == 0 && (t->ndm == 0 || t->ndm == ndm)) {
+	    eleType = t;
+	    break;
+	}
+    }
+    if (eleType == 0) {
+	opserr << "WARNING: element type " << type << " is not supported by elements for ndm = "
+	       << ndm << ", use element\n";
+	return -1;
+    }
+    int numNodes = eleType->numNodes;
+
+    // tags and element nodes
+    ID tags, eleNodes;
+    int num = 0;
+    const char *opt = OPS_GetString();
+    if (strcmp(opt, "-file") == 0) {
+	int width = 0;
+	if (readBulkFile(OPS_GetString(), width, tags, &eleNodes, 0) < 0)
+	    return -1;
+	if (width != numNodes) {
+	    opserr << "WARNING: elements file has " << width << " nodes per element, "
+		   << type << " has " << numNodes << "\n";
+	    return -1;
+	}
+	num = tags.Size();
+    } else {
+	OPS_ResetCurrentInputArg(-1);
+	int numEleNodes = 0;
+	if (OPS_GetIntListInput(&num, &tags) < 0) {
+	    opserr << "WARNING: invalid element tags\n";
+	    return -1;
+	}
+	if (OPS_GetIntListInput(&numEleNodes, &eleNodes) < 0) {
+	    opserr << "WARNING: invalid element nodes\n";
+	    return -1;
+	}
+	if (numEleNodes != num * numNodes) {
+	    opserr << "WARNING: " << numEleNodes << " nodes given for " << num << " elements, want "
+		   << num * numNodes << "\n";
+	    return -1;
+	}
+    }
+
+    // validate all tags and nodes before adding anything
+    std::vector<int> order;
+    if (sortTags(tags, order, "element") < 0)
+	return -1;
+    for (int i = 0; i < num; i++) {
+	if (theDomain->getElement(tags(i)) != 0) {
+	    opserr << "WARNING: element " << tags(i) << " already exists\n";
+	    return -1;
+	}
+    }
+    if (checkNodes(theDomain, eleNodes) < 0)
+	return -1;
+
+    // the element arguments are read once
+    ID info(2);
+    info(0) = 1;
+    info(1) = bulkArgsKey;
+    if (eleType->parse(info) == 0) {
+	opserr << "WARNING: failed to read element arguments for " << type << "\n";
+	return -1;
+    }
+
+    // create all the elements
+    std::vector<Element *> theElements(num, (Element *)0);
+    info.resize(3 + numNodes);
+    info(0) = 2;
+    info(1) = bulkArgsKey;
+    for (int k = 0; k < num; k++) {
+	int i = order[k];
+	info(2) = tags(i);
+	for (int j = 0; j < numNodes; j++)
+	    info(3 + j) = eleNodes(i * numNodes + j);
+
+	theElements[k] = (Element *) eleType->parse(info);
+	if (theElements[k] == 0) {
+	    opserr << "WARNING: failed to create element " << tags(i) << "\n";
+	    for (int j = 0; j < k; j++)
+		delete theElements[j];
+	    return -1;
+	}
+    }
+
+    // and add them
+    for (int k = 0; k < num; k++) {
+	if (theDomain->addElement(theElements[k]) == false) {
+	    opserr << "WARNING: failed to add element " << theElements[k]->getTag() << " to domain\n";
+	    for (int j = 0; j < k; j++)
+		delete theDomain->removeElement(theElements[j]->getTag());
+	    for (int j = k; j < num; j++)
+		delete theElements[j];
+	    return -1;
+	}
+    }
+
+    return 0;
+}
+
+int OPS_HomogeneousBCs()
+{
+    Domain *theDomain = OPS_GetDomain();
+    if (theDomain == 0) {
+	opserr << "WARNING: domain is not defined\n";
+	return -1;
+    }
+    if (OPS_GetNumRemainingInputArgs() < 2) {
+	opserr << "WARNING insufficient args: fixes tags? flags?\n";
+	return -1;
+    }
+
+    // node tags and flags
+    ID tags, flags;
+    int num = 0;
+    int width = 0;
+    const char *opt = OPS_GetString();
+    if (strcmp(opt, "-file") == 0) {
+	if (readBulkFile(OPS_GetString(), width, tags, &flags, 0) < 0)
+	    return -1;
+	num = tags.Size();
+    } else {
+	OPS_ResetCurrentInputArg(-1);
+	int numFlags = 0;
+	if (OPS_GetIntListInput(&num, &tags) < 0) {
+	    opserr << "WARNING: invalid node tags\n";
+	    return -1;
+	}
+	if (OPS_GetIntListInput(&numFlags, &flags) < 0) {
+	    opserr << "WARNING: invalid constraint flags\n";
+	    return -1;
+	}
+	if (num > 0)
+	    width = numFlags / num;
+	if (num == 0 || width == 0 || numFlags != num * width) {
+	    opserr << "WARNING: " << numFlags << " constraint flags given for " << num << " nodes\n";
+	    return -1;
+	}
+    }
+
+    // validate all nodes before adding anything
+    std::vector<int> order;
+    if (sortTags(tags, order, "node") < 0)
+	return -1;
+    std::vector<Node *> theNodes(num);
+    for (int i = 0; i < num; i++) {
+	theNodes[i] = theDomain->getNode(tags(i));
+	if (theNodes[i] == 0) {
+	    opserr << "ERROR node " << tags(i) << " is not defined\n";
+	    return -1;
+	}
+	if (theNodes[i]->getNumberDOF() > width) {
+	    opserr << "WARNING: invalid # of constraint values for node " << tags(i) << "\n";
+	    return -1;
+	}
+    }
+
+    // create and add the constraints, the tags of those added are kept
+    // to remove them again if one fails
+    std::vector<int> added;
+    for (int k = 0; k < num; k++) {
+	int i = order[k];
+	int ndf = theNodes[i]->getNumberDOF();
+	for (int j = 0; j < ndf; j++) {
+	    if (flags(i * width + j) == 0) continue;
+	    SP_Constraint *theSP = new SP_Constraint(tags(i), j, 0.0, true);
+	    if (theSP == 0 || theDomain->addSP_Constraint(theSP) == false) {
+		opserr << "WARNING: failed to add SP to domain for node " << tags(i) << "\n";
+		if (theSP != 0)
+		    delete theSP;
+		for (size_t n = 0; n < added.size(); n++)
+		    delete theDomain->removeSP_Constraint(added[n]);
+		return -1;
+	    }
+	    added.push_back(theSP->getTag());
+	}
+    }
+
+    return 0;
+}
@@ -178,6 +178,18 @@ int
 TclCommand_addElement(ClientData clientData, Tcl_Interp *interp,  int argc, 
 		      TCL_Char **argv);
 
+int
+TclCommand_addNodes(ClientData clientData, Tcl_Interp *interp, int argc, 
+		    TCL_Char **argv);
+
+int
+TclCommand_addElements(ClientData clientData, Tcl_Interp *interp, int argc, 
+		       TCL_Char **argv);
+
+int
+TclCommand_addHomogeneousBCs(ClientData clientData, Tcl_Interp *interp, int argc, 
+			     TCL_Char **argv);
+
 int
 TclCommand_mesh(ClientData clientData, Tcl_Interp *interp,  int argc, 
 		TCL_Char **argv);
@@ -477,6 +489,15 @@ TclModelBuilder::TclModelBuilder(Domain &theDomain, Tcl_Interp *interp, int NDM,
   Tcl_CreateCommand(interp, "element", TclCommand_addElement,
 		    (ClientData)NULL, NULL);
 
+  Tcl_CreateCommand(interp, "nodes", TclCommand_addNodes,
+		    (ClientData)NULL, NULL);
+
+  Tcl_CreateCommand(interp, "elements", TclCommand_addElements,
+		    (ClientData)NULL, NULL);
+
+  Tcl_CreateCommand(interp, "fixes", TclCommand_addHomogeneousBCs,
+		    (ClientData)NULL, NULL);
+
   Tcl_CreateCommand(interp, "mesh", TclCommand_mesh,
 		    (ClientData)NULL, NULL);
   Tcl_CreateCommand(interp, "remesh", TclCommand_remesh,
@@ -713,6 +734,9 @@ TclModelBuilder::~TclModelBuilder()
   Tcl_DeleteCommand(theInterp, "updateParameter");
   Tcl_DeleteCommand(theInterp, "node");
   Tcl_DeleteCommand(theInterp, "element");
+  Tcl_DeleteCommand(theInterp, "nodes");
+  Tcl_DeleteCommand(theInterp, "elements");
+  Tcl_DeleteCommand(theInterp, "fixes");
   Tcl_DeleteCommand(theInterp, "mesh");
   Tcl_DeleteCommand(theInterp, "remesh");
   Tcl_DeleteCommand(theInterp, "background");
@@ -1419,6 +1443,58 @@ TclCommand_backgroundMesh(ClientData clientData, Tcl_Interp *interp, int argc, T
 }
 #endif // _OPS_Element_PFEM
 
+extern int OPS_Nodes();
+extern int OPS_Elements();
+extern int OPS_HomogeneousBCs();
+
+int
+TclCommand_addNodes(ClientData clientData, Tcl_Interp *interp, int argc, 
+		    TCL_Char **argv)
+{
+  // ensure the destructor has not been called - 
+  if (theTclBuilder == 0) {
+    opserr << "WARNING builder has been destroyed" << endln;
+    return TCL_ERROR;
+  }
+
+  OPS_ResetInput(clientData, interp, 1, argc, argv, theTclDomain, theTclBuilder);
+
+  if (OPS_Nodes() < 0) return TCL_ERROR;
+  return TCL_OK;
+}
+
+int
+TclCommand_addElements(ClientData clientData, Tcl_Interp *interp, int argc, 
+		       TCL_Char **argv)
+{
+  // ensure the destructor has not been called - 
+  if (theTclBuilder == 0) {
+    opserr << "WARNING builder has been destroyed" << endln;
+    return TCL_ERROR;
+  }
+
+  OPS_ResetInput(clientData, interp, 1, argc, argv, theTclDomain, theTclBuilder);
+
+  if (OPS_Elements() < 0) return TCL_ERROR;
+  return TCL_OK;
+}
+
+int
+TclCommand_addHomogeneousBCs(ClientData clientData, Tcl_Interp *interp, int argc, 
+			     TCL_Char **argv)
+{
+  // ensure the destructor has not been called - 
+  if (theTclBuilder == 0) {
+    opserr << "WARNING builder has been destroyed" << endln;
+    return TCL_ERROR;
+  }
+
+  OPS_ResetInput(clientData, interp, 1, argc, argv, theTclDomain, theTclBuilder);
+
+  if (OPS_HomogeneousBCs() < 0) return TCL_ERROR;
+  return TCL_OK;
+}
+
 extern void* OPS_LobattoBeamIntegration(int& integrationTag, ID& secTags);
 extern void* OPS_LegendreBeamIntegration(int& integrationTag, ID& secTags);
 extern void* OPS_NewtonCotesBeamIntegration(int& integrationTag, ID& secTags);
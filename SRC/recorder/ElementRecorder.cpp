@@ -286,10 +286,18 @@ ElementRecorder::record(int commitTag, double timeStamp)
 						  result += res;
 					 else {
 						  Information& eleInfo = theResponses[i]->getInformation();
+						  if (numDOF == 0 && eleInfo.outputDone == true) {
+								// already written into data by the response
+								loc += eleInfo.outputSize;
+								continue;
+						  }
 						  const Vector& eleData = eleInfo.getData();
 						  if (numDOF == 0) {
-								for (int j = 0; j < eleData.Size(); j++)
-									 (*data)(loc++) = eleData(j);
+								int dataSize = eleData.Size();
+								if (eleInfo.theOutput != 0)
+									 dataSize = eleInfo.outputSize;
+								for (int j = 0; j < dataSize; j++)
+									 (*data)(loc++) = (j < eleData.Size()) ? eleData(j) : 0.0;
 						  }
 						  else {
 #ifdef _CSS
@@ -891,6 +899,31 @@ ElementRecorder::initialize(void)
 		  return -1;
 	 }
 
+	 //
+	 // when all the columns of a response are recorded, let the response write
+	 // straight into its columns of data so that record() does not copy them
+	 //
+
+	 bool directOutput = (numDOF == 0);
+#ifdef _CSS
+	 if (procDataMethod != 0)
+		  directOutput = false;
+#endif // _CSS
+	 if (directOutput == true) {
+		  int loc = (echoTimeFlag == true) ? 1 : 0;
+		  for (i = 0; i < numEle; i++) {
+				if (theResponses[i] == 0)
+					 continue;
+				Information& eleInfo = theResponses[i]->getInformation();
+				int dataSize = eleInfo.getData().Size();
+				if (loc + dataSize > numDbColumns)
+					 break;
+				if (dataSize > 0)
+					 eleInfo.setOutput(&(*data)(loc), dataSize);
+				loc += dataSize;
+		  }
+	 }
+
 	 if (theOutputHandler != 0)
 		  theOutputHandler->tag("Data");
 	 initializationDone = true;
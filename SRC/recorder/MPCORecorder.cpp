@@ -33,6 +33,17 @@ NDMaterial in setResponse gives unknownStress for stress components if type == P
 todo: add auto-component naming in case of duplicated components!
 in STKO components are assumed all different!
 
+note 6:
+storage of the results written at each recorded step (the layout of the file does not change):
+-compress level   gzip compression (1-9) of the step datasets
+-szip             szip compression of the step datasets (instead of gzip)
+-shuffle          shuffle filter before compression
+-chunk kB         chunk size of the step datasets (default 1 MB when filters are used)
+-async MB         write the step datasets on a dedicated thread, with at most MB megabytes
+                  of results waiting to be written (needs a thread-safe hdf5 library,
+                  otherwise the step datasets are written synchronously)
+-flushEvery n     flush the file every n recorded steps (default 1)
+
 **************************************************************************************/
 
 // some definitions
@@ -88,6 +99,10 @@ while opensees is writing data. Warning: this is a new feature in hdf5 version 1
 // include hdf5 headers
 #include "hdf5.h"
 #include "hdf5_hl.h"
+/* the asynchronous writer calls hdf5 from its own thread */
+#if defined(H5_HAVE_THREADSAFE)
+#define MPCO_ASYNC_WRITER
+#endif // H5_HAVE_THREADSAFE
 #else
 // include system headers for dynamic loading of libraries
 #if defined(_WIN32)
@@ -114,6 +129,10 @@ while opensees is writing data. Warning: this is a new feature in hdf5 version 1
 #include <algorithm>
 #include <limits>
 #include <stdint.h>
+#include <deque>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
 
 /*************************************************************************************
 
@@ -164,6 +183,8 @@ typedef unsigned long long 	hsize_t;
 typedef int H5T_str_t; // enum (int) in hdf5
 typedef int H5F_libver_t; // enum (int) in hdf5
 typedef int H5F_scope_t; // enum (int) in hdf5
+typedef int H5Z_filter_t;
+typedef int htri_t;
 
 /*
 HDF5 version info
@@ -378,6 +399,11 @@ private:
 		MPCO_LIBLOADER_LOAD_SYM(H5Pclose);
 		MPCO_LIBLOADER_LOAD_SYM(H5Pset_link_creation_order);
 		MPCO_LIBLOADER_LOAD_SYM(H5Pset_libver_bounds);
+		MPCO_LIBLOADER_LOAD_SYM(H5Pset_chunk);
+		MPCO_LIBLOADER_LOAD_SYM(H5Pset_deflate);
+		MPCO_LIBLOADER_LOAD_SYM(H5Pset_shuffle);
+		MPCO_LIBLOADER_LOAD_SYM(H5Pset_szip);
+		MPCO_LIBLOADER_LOAD_SYM(H5Zfilter_avail);
 		MPCO_LIBLOADER_LOAD_SYM(H5Fcreate);
 		MPCO_LIBLOADER_LOAD_SYM(H5Fflush);
 		MPCO_LIBLOADER_LOAD_SYM(H5Fclose);
@@ -394,6 +420,7 @@ private:
 		MPCO_LIBLOADER_LOAD_SYM(H5P_CLS_FILE_CREATE_ID_g);
 		MPCO_LIBLOADER_LOAD_SYM(H5P_CLS_FILE_ACCESS_ID_g);
 		MPCO_LIBLOADER_LOAD_SYM(H5P_CLS_GROUP_CREATE_ID_g);
+		MPCO_LIBLOADER_LOAD_SYM(H5P_CLS_DATASET_CREATE_ID_g);
 	}
 	~LibraryLoader() {
 		if (loaded) {
@@ -436,6 +463,11 @@ public:
 	herr_t (*ptr_H5Pclose)(hid_t plist_id);
 	herr_t (*ptr_H5Pset_link_creation_order)(hid_t plist_id, unsigned crt_order_flags);
 	herr_t (*ptr_H5Pset_libver_bounds)(hid_t plist_id, H5F_libver_t low, H5F_libver_t high);
+	herr_t (*ptr_H5Pset_chunk)(hid_t plist_id, int ndims, const hsize_t dim[]);
+	herr_t (*ptr_H5Pset_deflate)(hid_t plist_id, unsigned level);
+	herr_t (*ptr_H5Pset_shuffle)(hid_t plist_id);
+	herr_t (*ptr_H5Pset_szip)(hid_t plist_id, unsigned options_mask, unsigned pixels_per_block);
+	htri_t (*ptr_H5Zfilter_avail)(H5Z_filter_t id);
 	hid_t  (*ptr_H5Fcreate)(const char *filename, unsigned flags, hid_t create_plist, hid_t access_plist);
 	herr_t (*ptr_H5Fflush)(hid_t object_id, H5F_scope_t scope);
 	herr_t (*ptr_H5Fclose)(hid_t file_id);
@@ -452,6 +484,7 @@ public:
 	hid_t *ptr_H5P_CLS_FILE_CREATE_ID_g;
 	hid_t *ptr_H5P_CLS_FILE_ACCESS_ID_g;
 	hid_t *ptr_H5P_CLS_GROUP_CREATE_ID_g;
+	hid_t *ptr_H5P_CLS_DATASET_CREATE_ID_g;
 };
 
 /*
@@ -490,6 +523,12 @@ macros for loaded HDF5 functions
 #define H5Pclose (*LibraryLoader::instance().ptr_H5Pclose)
 #define H5Pset_link_creation_order (*LibraryLoader::instance().ptr_H5Pset_link_creation_order)
 #define H5Pset_libver_bounds (*LibraryLoader::instance().ptr_H5Pset_libver_bounds)
+#define H5Pset_chunk (*LibraryLoader::instance().ptr_H5Pset_chunk)
+#define H5Pset_deflate (*LibraryLoader::instance().ptr_H5Pset_deflate)
+#define H5Pset_shuffle (*LibraryLoader::instance().ptr_H5Pset_shuffle)
+#define H5Pset_szip (*LibraryLoader::instance().ptr_H5Pset_szip)
+
+#define H5Zfilter_avail (*LibraryLoader::instance().ptr_H5Zfilter_avail)
 
 #define H5Fcreate (*LibraryLoader::instance().ptr_H5Fcreate)
 #define H5Fflush (*LibraryLoader::instance().ptr_H5Fflush)
@@ -518,6 +557,8 @@ macros for loaded HDF5 global variables
 #define H5P_FILE_ACCESS (H5OPEN H5P_CLS_FILE_ACCESS_ID_g)
 #define H5P_CLS_GROUP_CREATE_ID_g (*LibraryLoader::instance().ptr_H5P_CLS_GROUP_CREATE_ID_g)
 #define H5P_GROUP_CREATE (H5OPEN H5P_CLS_GROUP_CREATE_ID_g)
+#define H5P_CLS_DATASET_CREATE_ID_g (*LibraryLoader::instance().ptr_H5P_CLS_DATASET_CREATE_ID_g)
+#define H5P_DATASET_CREATE (H5OPEN H5P_CLS_DATASET_CREATE_ID_g)
 
 /*
 some other useful things defined in HDF5 headers
@@ -541,6 +582,11 @@ some other useful things defined in HDF5 headers
 // this is an enum in hdf5: H5F_scope_t
 #define H5F_SCOPE_LOCAL 0
 
+// filter identifiers (H5Z_filter_t) and szip options
+#define H5Z_FILTER_DEFLATE 1
+#define H5Z_FILTER_SZIP 4
+#define H5_SZIP_NN_OPTION_MASK 32
+
 #endif // MPCO_HDF5_LOADED_AT_RUNTIME
 
 #define HID_INVALID -1
@@ -1040,7 +1086,7 @@ namespace h5 {
 			status = H5Sclose(space);
 			return dset;
 		}
-		hid_t createAndWrited2(hid_t obj, const char *name, const double *data, hsize_t rows, hsize_t cols)
+		hid_t createAndWrited2(hid_t obj, const char *name, const double *data, hsize_t rows, hsize_t cols, hid_t dcpl = H5P_DEFAULT)
 		{
 			// error flags
 			herr_t status;
@@ -1048,7 +1094,7 @@ namespace h5 {
 			hsize_t dim[2] = { rows, cols };
 			hid_t space = H5Screate_simple(2, dim, NULL);
 			// create the dataset and write data to it.
-			hid_t dset = H5Dcreate(obj, name, H5T_IEEE_F64LE, space, H5P_DEFAULT, H5P_DEFAULT, H5P_DEFAULT);
+			hid_t dset = H5Dcreate(obj, name, H5T_IEEE_F64LE, space, H5P_DEFAULT, dcpl, H5P_DEFAULT);
 			status = H5Dwrite(dset, H5T_NATIVE_DOUBLE, H5S_ALL, H5S_ALL, H5P_DEFAULT, data);
 			// close and release resources
 			status = H5Sclose(space);
@@ -1113,10 +1159,10 @@ namespace h5 {
 			}
 			return HID_INVALID;
 		}
-		hid_t createAndWrite(hid_t obj, const char *name, const std::vector<double> &data, size_t rows, size_t cols)
+		hid_t createAndWrite(hid_t obj, const char *name, const std::vector<double> &data, size_t rows, size_t cols, hid_t dcpl = H5P_DEFAULT)
 		{
 			if (data.size() > 0 && data.size() == rows*cols) {
-				return createAndWrited2(obj, name, &data[0], rows, cols);
+				return createAndWrited2(obj, name, &data[0], rows, cols, dcpl);
 			}
 			return HID_INVALID;
 		}
@@ -1194,7 +1240,8 @@ namespace h5 {
 		enum CreateOptions {
 			FileCreate,
 			FileAccess,
-			GroupCreate
+			GroupCreate,
+			DatasetCreate
 		};
 
 		// low level functions for c interface
@@ -1211,6 +1258,8 @@ namespace h5 {
 				return H5Pcreate(H5P_FILE_ACCESS);
 			case GroupCreate:
 				return H5Pcreate(H5P_GROUP_CREATE);
+			case DatasetCreate:
+				return H5Pcreate(H5P_DATASET_CREATE);
 			default:
 				return HID_INVALID;
 			}
@@ -1221,6 +1270,47 @@ namespace h5 {
 		herr_t setLibVerBounds(hid_t plist_id, unsigned int minor, unsigned int major) {
 			return H5Pset_libver_bounds(plist_id, (H5F_libver_t)minor, (H5F_libver_t)major);
 		}
+		bool isFilterAvailable(int filter_id) {
+			return H5Zfilter_avail((H5Z_filter_t)filter_id) > 0;
+		}
+
+		// higher level c++ utils
+
+		/*
+		creates the dataset creation property list for a 2D dataset of rows x cols items.
+		when filters are requested the dataset is chunked by whole rows, with as many rows per chunk
+		as fit in chunk_kb kilobytes (1 MB, the size of the default chunk cache, if chunk_kb < 1).
+		returns H5P_DEFAULT (contiguous layout) when neither chunking nor filters are requested.
+		*/
+		hid_t createChunked2(hsize_t rows, hsize_t cols, size_t type_size, int chunk_kb, int compression, bool shuffle, bool szip)
+		{
+			bool has_filters = compression > 0 || shuffle || szip;
+			if (rows == 0 || cols == 0 || (chunk_kb < 1 && !has_filters))
+				return H5P_DEFAULT;
+			hsize_t chunk_bytes = static_cast<hsize_t>(chunk_kb > 0 ? chunk_kb : 1024) * 1024;
+			hsize_t chunk_rows = std::max<hsize_t>(1, chunk_bytes / (cols * type_size));
+			chunk_rows = std::min(chunk_rows, rows);
+			hid_t dcpl = crate(DatasetCreate);
+			hsize_t chunk_dim[2] = { chunk_rows, cols };
+			herr_t status = H5Pset_chunk(dcpl, 2, chunk_dim);
+			if (shuffle)
+				status = H5Pset_shuffle(dcpl);
+			if (szip) {
+				// pixels per block must be even and not larger than the chunk
+				hsize_t chunk_size = chunk_rows * cols;
+				unsigned int pixels_per_block = static_cast<unsigned int>(std::min<hsize_t>(16, chunk_size - chunk_size % 2));
+				if (pixels_per_block >= 2)
+					status = H5Pset_szip(dcpl, H5_SZIP_NN_OPTION_MASK, pixels_per_block);
+			}
+			else if (compression > 0) {
+				status = H5Pset_deflate(dcpl, static_cast<unsigned int>(std::min(compression, 9)));
+			}
+			if (status < 0) {
+				close(dcpl);
+				return H5P_DEFAULT;
+			}
+			return dcpl;
+		}
 	}
 
 }
@@ -1403,6 +1493,176 @@ namespace mpco {
 		clock_t m_t1;
 	};
 
+	/*
+	holds the storage options for the datasets written at each recorded step
+	*/
+	struct StorageOptions {
+		int compression; // gzip level (0 = no compression)
+		bool shuffle; // shuffle filter (before compression)
+		bool szip; // szip compression (instead of gzip)
+		int chunk_kb; // target chunk size in kB (< 1 = automatic)
+		int async_mb; // size limit in MB of the queue of the asynchronous writer (< 1 = synchronous writing)
+		int flush_every; // flush the file every n recorded steps
+
+		StorageOptions() : compression(0), shuffle(false), szip(false), chunk_kb(0), async_mb(0), flush_every(1) {}
+	};
+
+	/*
+	creates the dataset of a recorded step, with its STEP and TIME attributes
+	*/
+	herr_t writeStepDataset(hid_t file_id, const std::string &name, const std::vector<double> &data,
+		size_t rows, size_t cols, int step_id, double step, const StorageOptions &options)
+	{
+		herr_t status = 0;
+		hid_t h_dcpl = h5::plist::createChunked2(rows, cols, sizeof(double),
+			options.chunk_kb, options.compression, options.shuffle, options.szip);
+		hid_t h_dset_data = h5::dataset::createAndWrite(file_id, name.c_str(), data, rows, cols, h_dcpl);
+		if (h_dcpl != H5P_DEFAULT)
+			status = h5::plist::close(h_dcpl);
+		if (h_dset_data == HID_INVALID || h_dset_data < 0)
+			return -1;
+		status = h5::attribute::write(h_dset_data, "STEP", step_id);
+		status = h5::attribute::write(h_dset_data, "TIME", step);
+		status = h5::dataset::close(h_dset_data);
+		return status;
+	}
+
+	/*
+	writes the step datasets on a dedicated thread, so that the analysis does not wait
+	for compression and disk I/O.
+	datasets are written in the order they are queued. the size of the queued buffers is bounded,
+	when the limit is reached push() waits for the writer. the buffers written are handed back
+	to push() through a free list, so that the buffers of the steps are not reallocated.
+	HDF5 is called at the same time by this thread, the analysis and other recorders or
+	load patterns, so the writer is only used with a thread-safe HDF5 library (MPCO_ASYNC_WRITER).
+	the recorder calls wait() before calling HDF5 by itself, to keep the order of the writes.
+	*/
+	class StepWriter
+	{
+	private:
+		struct Job {
+			Job() : rows(0), cols(0), step_id(0), step(0.0), flush(false) {}
+			std::string name;
+			std::vector<double> data;
+			size_t rows;
+			size_t cols;
+			int step_id;
+			double step;
+			bool flush;
+		};
+
+	public:
+		StepWriter(hid_t file_id, const StorageOptions &options)
+			: m_file_id(file_id)
+			, m_options(options)
+			, m_max_bytes(static_cast<size_t>(std::max(options.async_mb, 1)) * 1024 * 1024)
+			, m_queued_bytes(0)
+			, m_busy(false)
+			, m_stop(false)
+			, m_num_errors(0)
+		{
+			m_thread = std::thread(&StepWriter::run, this);
+		}
+		~StepWriter() {
+			{
+				std::unique_lock<std::mutex> lock(m_mutex);
+				m_stop = true;
+			}
+			m_cv_work.notify_all();
+			m_thread.join();
+		}
+
+		// queues a step dataset. data is moved into the queue and replaced by a drained buffer
+		void push(const std::string &name, std::vector<double> &data, size_t rows, size_t cols, int step_id, double step) {
+			size_t bytes = data.size() * sizeof(double);
+			std::unique_lock<std::mutex> lock(m_mutex);
+			// wait for room, but always accept a single job larger than the limit
+			m_cv_done.wait(lock, [&] { return m_jobs.empty() || m_queued_bytes + bytes <= m_max_bytes; });
+			m_jobs.push_back(Job());
+			Job &job = m_jobs.back();
+			job.name = name;
+			job.data.swap(data);
+			if (!m_free.empty()) {
+				data.swap(m_free.back());
+				m_free.pop_back();
+			}
+			job.rows = rows;
+			job.cols = cols;
+			job.step_id = step_id;
+			job.step = step;
+			m_queued_bytes += bytes;
+			m_cv_work.notify_one();
+		}
+		// queues a flush of the file after the datasets queued so far
+		void pushFlush() {
+			std::unique_lock<std::mutex> lock(m_mutex);
+			m_jobs.push_back(Job());
+			m_jobs.back().flush = true;
+			m_cv_work.notify_one();
+		}
+		// waits for all queued jobs. returns the number of failed jobs since the last call
+		int wait() {
+			std::unique_lock<std::mutex> lock(m_mutex);
+			m_cv_done.wait(lock, [&] { return m_jobs.empty() && !m_busy; });
+			int num_errors = m_num_errors;
+			m_num_errors = 0;
+			return num_errors;
+		}
+
+	private:
+		void run() {
+			Job job;
+			while (true) {
+				{
+					std::unique_lock<std::mutex> lock(m_mutex);
+					m_cv_work.wait(lock, [&] { return m_stop || !m_jobs.empty(); });
+					if (m_jobs.empty())
+						return; // stop requested and nothing left to write
+					job.name.swap(m_jobs.front().name);
+					job.data.swap(m_jobs.front().data);
+					job.rows = m_jobs.front().rows;
+					job.cols = m_jobs.front().cols;
+					job.step_id = m_jobs.front().step_id;
+					job.step = m_jobs.front().step;
+					job.flush = m_jobs.front().flush;
+					m_jobs.pop_front();
+					m_busy = true;
+				}
+				herr_t status = job.flush ?
+					h5::file::flush(m_file_id) :
+					writeStepDataset(m_file_id, job.name, job.data, job.rows, job.cols, job.step_id, job.step, m_options);
+				{
+					std::unique_lock<std::mutex> lock(m_mutex);
+					if (status < 0)
+						m_num_errors++;
+					m_queued_bytes -= job.data.size() * sizeof(double);
+					if (m_free.size() < MAX_FREE_BUFFERS) {
+						m_free.push_back(std::vector<double>());
+						m_free.back().swap(job.data);
+					}
+					m_busy = false;
+				}
+				m_cv_done.notify_all();
+			}
+		}
+
+	private:
+		hid_t m_file_id;
+		StorageOptions m_options;
+		size_t m_max_bytes;
+		size_t m_queued_bytes;
+		bool m_busy;
+		bool m_stop;
+		int m_num_errors;
+		std::deque<Job> m_jobs;
+		std::vector<std::vector<double> > m_free;
+		static const size_t MAX_FREE_BUFFERS = 64;
+		std::mutex m_mutex;
+		std::condition_variable m_cv_work;
+		std::condition_variable m_cv_done;
+		std::thread m_thread;
+	};
+
 	/*
 	holds current informations
 	*/
@@ -1421,6 +1681,9 @@ namespace mpco {
 			, h_file_acc_proplist(HID_INVALID)
 #endif // MPCO_USE_SWMR
 			, h_group_proplist(HID_INVALID)
+			// step datasets
+			, storage()
+			, writer(0)
 			// time step info
 			, current_time_step_id(0)
 			, current_time_step(0.0)
@@ -1442,6 +1705,9 @@ namespace mpco {
 		hid_t h_file_acc_proplist;
 #endif // MPCO_USE_SWMR
 		hid_t h_group_proplist;
+		// step datasets
+		StorageOptions storage;
+		StepWriter *writer;
 		// time step info
 		int current_time_step_id;
 		double current_time_step;
@@ -1450,6 +1716,28 @@ namespace mpco {
 		bool record_eigen_on_this_step;
 		double eigen_last_time_set;
 		Vector eigen_last_values;
+		// buffer of the step datasets
+		std::vector<double> step_buffer;
+	public:
+		// buffer for the dataset of the current step, reused from step to step
+		std::vector<double> &stepBuffer(size_t size) {
+			step_buffer.assign(size, 0.0);
+			return step_buffer;
+		}
+		// writes the dataset of the current step, or queues it to the asynchronous writer
+		herr_t writeStep(const std::string &name, std::vector<double> &data, size_t rows, size_t cols) const {
+			if (writer) {
+				writer->push(name, data, rows, cols, current_time_step_id, current_time_step);
+				return 0;
+			}
+			return writeStepDataset(h_file_id, name, data, rows, cols, current_time_step_id, current_time_step, storage);
+		}
+		// waits for the asynchronous writer before calling HDF5 directly
+		int syncWriter() const {
+			if (writer)
+				return writer->wait();
+			return 0;
+		}
 	};
 
 }
@@ -1495,6 +1783,7 @@ namespace mpco {
 					/*
 					create result group
 					*/
+					info.syncWriter();
 					hid_t h_gp_result = h5::group::createResultGroup(info.h_file_id, info.h_group_proplist,
 						m_result_name, m_result_display_name,
 						m_components_name, m_num_components, m_dimension, m_description,
@@ -1521,15 +1810,14 @@ namespace mpco {
 				/*
 				create the dataset for this timestep
 				*/
-				std::vector<double> buffer_data(nodes.size() * m_num_components);
+				std::vector<double> &buffer_data = info.stepBuffer(nodes.size() * m_num_components);
 				bufferResponse(info, nodes, buffer_data);
 				std::stringstream ss_dset_name;
 				ss_dset_name << m_result_name << "/DATA/STEP_" << info.current_time_step_id;
 				std::string dset_name = ss_dset_name.str();
-				hid_t h_dset_data = h5::dataset::createAndWrite(info.h_file_id, dset_name.c_str(), buffer_data, nodes.size(), m_num_components);
-				status = h5::attribute::write(h_dset_data, "STEP", info.current_time_step_id);
-				status = h5::attribute::write(h_dset_data, "TIME", info.current_time_step);
-				status = h5::dataset::close(h_dset_data);
+				status = info.writeStep(dset_name, buffer_data, nodes.size(), m_num_components);
+				if (status < 0)
+					retval = -1;
 				/*
 				return
 				*/
@@ -1985,6 +2273,7 @@ namespace mpco {
 					/*
 					create result group
 					*/
+					info.syncWriter();
 					hid_t h_gp_result = h5::group::createResultGroup(info.h_file_id, info.h_group_proplist,
 						m_result_name, m_result_display_name,
 						m_components_name, m_num_components, m_dimension, m_description,
@@ -2011,6 +2300,7 @@ namespace mpco {
 				/*
 				create the timestep group
 				*/
+				info.syncWriter();
 				std::stringstream ss_gp_step_name;
 				ss_gp_step_name << m_result_name << "/DATA/STEP_" << info.current_time_step_id;
 				std::string gp_step_name = ss_gp_step_name.str();
@@ -4211,6 +4501,7 @@ public:
 		, first_domain_changed_done(false)
 		, info()
 		, output_freq()
+		, num_records_since_flush(0)
 		, has_region(false)
 		, node_set()
 		, elem_set()
@@ -4239,6 +4530,7 @@ public:
 
 	// output frequency
 	mpco::OutputFrequency output_freq;
+	int num_records_since_flush;
 
 	// nodes and elements
 	bool has_region;
@@ -4290,6 +4582,15 @@ MPCORecorder::~MPCORecorder()
 		*/
 		herr_t status;
 		/*
+		write the queued steps and stop the asynchronous writer
+		*/
+		if (m_data->info.writer) {
+			if (m_data->info.writer->wait() > 0)
+				opserr << "MPCORecorder Error: cannot write some results on destructor\n";
+			delete m_data->info.writer;
+			m_data->info.writer = 0;
+		}
+		/*
 		close file
 		*/
 		status = h5::file::close(m_data->info.h_file_id);
@@ -4382,6 +4683,7 @@ int MPCORecorder::record(int commitTag, double timeStamp)
 		}
 	}
 	if (rebuild_model) {
+		m_data->info.syncWriter();
 		retval = writeModel();
 		if (retval) {
 			opserr << "MPCRecorder Error: cannot write model\n";
@@ -4405,13 +4707,22 @@ int MPCORecorder::record(int commitTag, double timeStamp)
 		return retval;
 	}
 	/*
-	flush file
+	flush file (the asynchronous writer flushes it after writing the queued steps)
 	*/ 
-	status = h5::file::flush(m_data->info.h_file_id);
-	if (status < 0) {
-		opserr << "MPCORecorder Error: cannot flush file on record()\n";
-		retval = -1;
-		return retval;
+	m_data->num_records_since_flush++;
+	if (m_data->num_records_since_flush >= m_data->info.storage.flush_every) {
+		m_data->num_records_since_flush = 0;
+		if (m_data->info.writer) {
+			m_data->info.writer->pushFlush();
+		}
+		else {
+			status = h5::file::flush(m_data->info.h_file_id);
+			if (status < 0) {
+				opserr << "MPCORecorder Error: cannot flush file on record()\n";
+				retval = -1;
+				return retval;
+			}
+		}
 	}
 	return retval;
 }
@@ -4478,6 +4789,13 @@ int MPCORecorder::sendSelf(int commitTag, Channel &theChannel)
 		<< m_data->output_freq.type
 		<< m_data->output_freq.dt
 		<< m_data->output_freq.nsteps
+		// storage options
+		<< m_data->info.storage.compression
+		<< m_data->info.storage.shuffle
+		<< m_data->info.storage.szip
+		<< m_data->info.storage.chunk_kb
+		<< m_data->info.storage.async_mb
+		<< m_data->info.storage.flush_every
 		// node result requests
 		<< m_data->nodal_results_requests
 		// node result requests (sens grad indices)
@@ -4569,6 +4887,13 @@ int MPCORecorder::recvSelf(int commitTag, Channel &theChannel, FEM_ObjectBroker
 		>> m_data->output_freq.type
 		>> m_data->output_freq.dt
 		>> m_data->output_freq.nsteps
+		// storage options
+		>> m_data->info.storage.compression
+		>> m_data->info.storage.shuffle
+		>> m_data->info.storage.szip
+		>> m_data->info.storage.chunk_kb
+		>> m_data->info.storage.async_mb
+		>> m_data->info.storage.flush_every
 		// node result requests
 		>> m_data->nodal_results_requests
 		// node result requests (sens grad indices)
@@ -4689,6 +5014,16 @@ int MPCORecorder::initialize()
 	status = h5::dataset::close(h_dset_dim);
 	status = h5::group::close(h_gp_info);	
 	/*
+	start the asynchronous writer
+	*/
+	if (m_data->info.storage.async_mb > 0) {
+#ifdef MPCO_ASYNC_WRITER
+		m_data->info.writer = new mpco::StepWriter(m_data->info.h_file_id, m_data->info.storage);
+#else
+		opserr << "MPCORecorder Warning: -async needs a thread-safe HDF5 library, the step datasets are written synchronously\n";
+#endif // MPCO_ASYNC_WRITER
+	}
+	/*
 	mark as initialized and return
 	*/
 	m_data->initialized = true;
@@ -6245,6 +6580,7 @@ int MPCORecorder::recordResultsOnElements()
 			/*
 			\todo all attributes are temporary, we need a user-defined metadata for elemental results...
 			*/
+			m_data->info.syncWriter();
 			hid_t h_gp_result = h5::group::createResultGroup(m_data->info.h_file_id, m_data->info.h_group_proplist,
 				result_name, result_display_name, "", 0, "", "",
 				(int)mpco::ResultType::Generic, (int)mpco::ResultDataType::Scalar);
@@ -6290,6 +6626,7 @@ int MPCORecorder::recordResultsOnElements()
 							/*
 							create the header group
 							*/
+							m_data->info.syncWriter();
 							hid_t h_gp_header = h5::group::create(m_data->info.h_file_id, header_dir_name.c_str(), H5P_DEFAULT, m_data->info.h_group_proplist, H5P_DEFAULT);
 							status = h5::attribute::write(h_gp_header, "NUM_COLUMNS", header.num_columns);
 							/*
@@ -6344,7 +6681,7 @@ int MPCORecorder::recordResultsOnElements()
 						std::stringstream ss_dset_name;
 						ss_dset_name << header_dir_name << "/DATA/STEP_" << m_data->info.current_time_step_id;
 						std::string dset_name = ss_dset_name.str();
-						std::vector<double> buffer_data(num_rows * header.num_columns);
+						std::vector<double> &buffer_data = m_data->info.stepBuffer(num_rows * header.num_columns);
 						for (size_t i = 0; i < num_rows; i++) {
 							mpco::element::OutputResponse &current_response = eo_by_header.items[i];
 							current_response.response->getResponse();
@@ -6357,10 +6694,9 @@ int MPCORecorder::recordResultsOnElements()
 							for (size_t j = 0; j < header.num_columns; j++)
 								buffer_data[offset + j] = current_data[(int)j];
 						}
-						hid_t h_dset_data = h5::dataset::createAndWrite(m_data->info.h_file_id, dset_name.c_str(), buffer_data, num_rows, header.num_columns);
-						status = h5::attribute::write(h_dset_data, "STEP", m_data->info.current_time_step_id);
-						status = h5::attribute::write(h_dset_data, "TIME", m_data->info.current_time_step);
-						status = h5::dataset::close(h_dset_data);
+						status = m_data->info.writeStep(dset_name, buffer_data, num_rows, header.num_columns);
+						if (status < 0)
+							retval = -1;
 					}
 				}
 			}
@@ -6430,6 +6766,7 @@ void* OPS_MPCORecorder()
 	std::vector<std::vector<std::string> > elemental_results_requests;
 	std::vector<std::string> tokens;
 	mpco::OutputFrequency output_freq;
+	mpco::StorageOptions storage;
 	bool has_region = false;
 	std::set<int> node_set;
 	std::set<int> elem_set;
@@ -6479,6 +6816,38 @@ void* OPS_MPCORecorder()
 			}
 			has_region = true;
 		}
+		else if (strcmp(data, "-compress") == 0 || strcmp(data, "-chunk") == 0 ||
+			strcmp(data, "-async") == 0 || strcmp(data, "-flushEvery") == 0) {
+			curr_opt = utils::parsing::opt_none;
+			int value = 0;
+			if (numdata < 1 || OPS_GetInt(1, &value) != 0) {
+				opserr << "MPCORecorder error: option " << data << " requires an extra parameter (int)\n";
+				return 0;
+			}
+			numdata--;
+			if (strcmp(data, "-compress") == 0) {
+				storage.compression = std::max(0, std::min(value, 9));
+				storage.szip = false;
+			}
+			else if (strcmp(data, "-chunk") == 0) {
+				storage.chunk_kb = std::max(0, value);
+			}
+			else if (strcmp(data, "-async") == 0) {
+				storage.async_mb = std::max(0, value);
+			}
+			else {
+				storage.flush_every = std::max(1, value);
+			}
+		}
+		else if (strcmp(data, "-shuffle") == 0) {
+			curr_opt = utils::parsing::opt_none;
+			storage.shuffle = true;
+		}
+		else if (strcmp(data, "-szip") == 0) {
+			curr_opt = utils::parsing::opt_none;
+			storage.szip = true;
+			storage.compression = 0;
+		}
 		else {
 			switch (curr_opt)
 			{
@@ -6606,10 +6975,21 @@ void* OPS_MPCORecorder()
 		}
 	}
 
+	// check that the requested filters are available in this HDF5 library
+	if (storage.compression > 0 && !h5::plist::isFilterAvailable(H5Z_FILTER_DEFLATE)) {
+		opserr << "MPCORecorder warning: gzip compression is not available in the HDF5 library, -compress will be ignored\n";
+		storage.compression = 0;
+	}
+	if (storage.szip && !h5::plist::isFilterAvailable(H5Z_FILTER_SZIP)) {
+		opserr << "MPCORecorder warning: szip compression is not available in the HDF5 library, -szip will be ignored\n";
+		storage.szip = false;
+	}
+
 	// create recorder
 	MPCORecorder *new_recorder = new MPCORecorder();
 	new_recorder->m_data->filename = filename;
 	new_recorder->m_data->output_freq = output_freq;
+	new_recorder->m_data->info.storage = storage;
 	new_recorder->m_data->nodal_results_requests.swap(nodal_results_requests);
 	new_recorder->m_data->sens_grad_indices.swap(sens_grad_indices);
 	new_recorder->m_data->elemental_results_requests.swap(elemental_results_requests);
@@ -76,9 +76,21 @@ ElementResponse::~ElementResponse()
 {
 #ifdef _CSS
     theElement->resetDampingEnergy();
+    if (energyTracked == true)
+        theElement->setEnergyTracking(false);
 #endif // _CSS
 }
 
+#ifdef _CSS
+void
+ElementResponse::trackEnergy(void)
+{
+    if (energyTracked == false)
+        theElement->setEnergyTracking(true);
+    energyTracked = true;
+}
+#endif // _CSS
+
 int
 ElementResponse::getResponse(void)
 {
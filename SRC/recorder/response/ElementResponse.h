@@ -54,10 +54,17 @@ public:
 
 	int getResponse(void);
 	int getResponseSensitivity(int gradNumber);
+#ifdef _CSS
+	// keeps the energies of the element tracked while this response lives
+	void trackEnergy(void);
+#endif // _CSS
 
 private:
 	Element *theElement;
 	int responseID;
+#ifdef _CSS
+	bool energyTracked = false;
+#endif // _CSS
 };
 
 #endif
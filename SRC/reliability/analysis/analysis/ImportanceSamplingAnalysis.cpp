@@ -43,6 +43,11 @@
 #include <Vector.h>
 #include <Matrix.h>
 #include <MatrixOperations.h>
+#include <SamplingWorkers.h>
+#include <Domain.h>
+#include <LoadPattern.h>
+#include <LoadPatternIter.h>
+#include <classTags.h>
 
 #include <math.h>
 #include <stdlib.h>
@@ -50,6 +55,7 @@
 #include <fstream>
 #include <iomanip>
 #include <iostream>
+#include <vector>
 using std::ifstream;
 using std::ios;
 using std::setw;
@@ -66,7 +72,8 @@ ImportanceSamplingAnalysis::ImportanceSamplingAnalysis(ReliabilityDomain *passed
 							long int passedNumberOfSimulations,
                             double passedTargetCOV, double passedSamplingStdv,
 							int passedPrintFlag, TCL_Char *passedFileName,
-							int passedAnalysisTypeTag)
+							int passedAnalysisTypeTag,
+							int passedNumWorkers, int passedSeed)
 :ReliabilityAnalysis(), theReliabilityDomain(passedReliabilityDomain), 
 theOpenSeesDomain(passedOpenSeesDomain)
 {
@@ -80,6 +87,8 @@ theOpenSeesDomain(passedOpenSeesDomain)
 	printFlag = passedPrintFlag;
 	strcpy(fileName,passedFileName);
 	analysisTypeTag = passedAnalysisTypeTag;
+	numWorkers = passedNumWorkers;
+	seed = passedSeed;
 }
 
 
@@ -92,6 +101,96 @@ ImportanceSamplingAnalysis::~ImportanceSamplingAnalysis()
 
 
 
+// Runs the analysis of one sample around startPointY. The random numbers
+// are drawn with the given seed, or continue the current stream if it is
+// 0. On return res holds the g-function values (-1 if the FE analysis
+// failed), u^u and the scaled squared distance of u from startPointY.
+int
+ImportanceSamplingAnalysis::evaluateSample(const Vector &startPointY, int sampleSeed, double *res)
+{
+	int numRV = theReliabilityDomain->getNumberOfRandomVariables();
+	int numLsf = theReliabilityDomain->getNumberOfLimitStateFunctions();
+
+	Vector x(numRV);
+	Vector u(numRV);
+
+	// Create array of standard normal random numbers
+	int result = theRandomNumberGenerator->generate_nIndependentStdNormalNumbers(numRV,sampleSeed);
+	if (result < 0) {
+		opserr << "ImportanceSamplingAnalysis::analyze() - could not generate" << endln
+			<< " random numbers for simulation." << endln;
+		return -1;
+	}
+	const Vector &randomArray = theRandomNumberGenerator->getGeneratedNumbers();
+
+	// Compute the point in standard normal space
+	//u = startPointY + chol_covariance * randomArray;
+	u = startPointY;
+	u.addVector(1.0, randomArray, samplingStdv);
+
+	// Transform into original space
+	result = theProbabilityTransformation->transform_u_to_x(u, x);
+	if (result < 0) {
+	  opserr << "ImportanceSamplingAnalysis::analyze() - could not transform u to x. " << endln;
+	  return -1;
+	}
+        
+	// update domain with new x values
+	for (int j = 0; j < numRV; j++) {
+		int param_indx = theReliabilityDomain->getParameterIndexFromRandomVariableIndex(j);
+		Parameter *theParam = theOpenSeesDomain->getParameterFromIndex(param_indx);
+            
+		// now we should update the parameter value
+		theParam->update( x(j) );
+	}
+		
+	// set values in the variable namespace
+	if (theGFunEvaluator->setVariables() < 0) {
+		opserr << "ImportanceSamplingAnalysis::analyze() - " << endln
+			<< " could not set variables in namespace. " << endln;
+		return -1;
+	}
+        
+	// Evaluate limit-state function
+	bool FEconvergence = true;
+	if (theGFunEvaluator -> runAnalysis() < 0) {
+		// In this case a failure happened during the analysis
+		// Hence, register this as failure
+		opserr << "ERROR ImportanceSamplingAnalysis -- error running analysis" << endln;
+		FEconvergence = false;
+	}
+
+	// Loop over number of limit-state functions
+	for (int lsf = 0; lsf < numLsf; lsf++ ) {
+		LimitStateFunction *theLimitStateFunction = theReliabilityDomain->getLimitStateFunctionPtrFromIndex(lsf);
+		int lsfTag = theLimitStateFunction->getTag();
+
+		// Set tag of "active" limit-state function
+		theReliabilityDomain->setTagOfActiveLimitStateFunction(lsfTag);
+
+		// set and evaluate LSF
+		const char *lsfExpression = theLimitStateFunction->getExpression();
+		theGFunEvaluator->setExpression(lsfExpression);
+            
+		res[lsf] = theGFunEvaluator->evaluateExpression();
+		if (!FEconvergence) {
+			res[lsf] = -1.0;
+		}
+	}
+
+	// Distances for the values of the joint distributions at the u-point
+	double temp2 = 0.0;
+	for (int i = 0; i < numRV; i++) {
+	  double uy = u(i)-startPointY(i);
+	  temp2 += uy*uy;
+	}
+	res[numLsf] = u ^ u;
+	res[numLsf+1] = temp2 / (samplingStdv*samplingStdv);
+
+	return 0;
+}
+
+
 int 
 ImportanceSamplingAnalysis::analyze(void)
 {
@@ -101,7 +200,9 @@ ImportanceSamplingAnalysis::analyze(void)
 
 	// Declaration of some of the data used in the algorithm
 	double gFunctionValue;
-	int result, I, seed = 1;
+	int result, I;
+	int seed = this->seed;
+	bool restarted = false;
     long int k = 1;
 	double det_covariance, phi, h, q;
 	int numRV = theReliabilityDomain->getNumberOfRandomVariables();
@@ -109,9 +210,6 @@ ImportanceSamplingAnalysis::analyze(void)
 	int numLsf = theReliabilityDomain->getNumberOfLimitStateFunctions();
     
 	Vector x(numRV);
-	Vector z(numRV);
-	Vector u(numRV);
-	Vector randomArray(numRV);
 	static NormalRV aStdNormRV(1,0.0,1.0);
 	bool failureHasOccured = false;
 
@@ -139,7 +237,14 @@ ImportanceSamplingAnalysis::analyze(void)
 		if (printFlag == 2) {
 			ifstream inputFile( restartFileName, ios::in );
 			inputFile >> k;
-			inputFile >> seed;
+			// the generator continues from where the last run stopped
+			if (theRandomNumberGenerator->readState(inputFile) < 0) {
+				opserr << "ImportanceSamplingAnalysis::analyze() - could not read" << endln
+				       << " the random number generator from the restart file." << endln;
+				return -1;
+			}
+			seed = theRandomNumberGenerator->getSeed();
+			restarted = true;
 			if (k == 1 && seed == 1) {
 			}
 			else { 
@@ -205,8 +310,52 @@ ImportanceSamplingAnalysis::analyze(void)
 	Vector cov(numLsf);
 	double govCov = 999.0;
 	//Vector temp1;
-	double temp2, denumerator;
-	bool FEconvergence;
+	double denumerator;
+
+
+	// Start the worker processes, each one runs the analyses of the
+	// samples it is given in its own copy of the model, with the
+	// random number stream of the sample number
+	int numResults = numLsf + 2;
+	Vector sampleResults(numResults);
+	SamplingWorkers theWorkers(numWorkers, numResults);
+	bool parallel = numWorkers > 1;
+	std::vector<double> batchResults;
+	std::vector<int> batchStatus;
+	long batchFirst = 0;
+	long batchCount = 0;
+	if (parallel) {
+		// the workers inherit the open recorders, which would all write
+		// to the same files, and a forked worker keeps only the forking
+		// thread, so the mutexes held by the threads of the MPCO writer
+		// or the H5DRM prefetcher would stay locked forever
+		if (theOpenSeesDomain->getNumRecorders() > 0) {
+			opserr << "ImportanceSamplingAnalysis::analyze() - the worker processes " << endln
+			       << " cannot be used while recorders are defined, remove them first. " << endln;
+			return -1;
+		}
+		LoadPatternIter &thePatterns = theOpenSeesDomain->getLoadPatterns();
+		LoadPattern *thePattern;
+		while ((thePattern = thePatterns()) != 0) {
+			if (thePattern->getClassTag() == PATTERN_TAG_H5DRM) {
+				opserr << "ImportanceSamplingAnalysis::analyze() - the worker processes " << endln
+				       << " cannot be used with H5DRM load patterns. " << endln;
+				return -1;
+			}
+		}
+
+		int baseSeed = seed;
+		SamplingWorkers::Evaluator eval = [this, &startPointY, baseSeed](long sample, double *res) {
+			if (theRandomNumberGenerator->setStream(baseSeed, sample) < 0)
+				return -1;
+			return this->evaluateSample(startPointY, 0, res);
+		};
+		if (theWorkers.start(eval) < 0) {
+			opserr << "ImportanceSamplingAnalysis::analyze() - could not start " << endln
+			       << " the worker processes. " << endln;
+			return -1;
+		}
+	}
 
 
 	// Prepare output file
@@ -223,61 +372,36 @@ ImportanceSamplingAnalysis::analyze(void)
 		}
 
 		
-		// Create array of standard normal random numbers
-		if (isFirstSimulation) {
-			result = theRandomNumberGenerator->generate_nIndependentStdNormalNumbers(numRV,seed);
+		if (parallel) {
+			// Evaluate the next batch of samples in the workers
+			if (k >= batchFirst + batchCount) {
+				batchFirst = k;
+				batchCount = 4*theWorkers.getNumWorkers();
+				if (numberOfSimulations - k + 1 < batchCount)
+					batchCount = numberOfSimulations - k + 1;
+				if (batchCount < 1)
+					batchCount = 1;
+				batchResults.resize(batchCount*numResults);
+				batchStatus.resize(batchCount);
+				if (theWorkers.evaluate(batchFirst, batchCount, &batchResults[0], &batchStatus[0]) < 0) {
+					opserr << "ImportanceSamplingAnalysis::analyze() - the worker " << endln
+					       << " processes failed. " << endln;
+					return -1;
+				}
+			}
+			if (batchStatus[k-batchFirst] < 0)
+				return -1;
+			for (int i = 0; i < numResults; i++)
+				sampleResults(i) = batchResults[(k-batchFirst)*numResults+i];
 		}
 		else {
-			result = theRandomNumberGenerator->generate_nIndependentStdNormalNumbers(numRV);
-		}
-		seed = theRandomNumberGenerator->getSeed();
-		if (result < 0) {
-			opserr << "ImportanceSamplingAnalysis::analyze() - could not generate" << endln
-				<< " random numbers for simulation." << endln;
-			return -1;
-		}
-		randomArray = theRandomNumberGenerator->getGeneratedNumbers();
-
-		// Compute the point in standard normal space
-		//u = startPointY + chol_covariance * randomArray;
-        u = startPointY;
-		u.addVector(1.0, randomArray, samplingStdv);
-
-		// Transform into original space
-		result = theProbabilityTransformation->transform_u_to_x(u, x);
-		if (result < 0) {
-		  opserr << "ImportanceSamplingAnalysis::analyze() - could not transform u to x. " << endln;
-		  return -1;
-		}
-        
-        // update domain with new x values
-        for (int j = 0; j < numRV; j++) {
-            RandomVariable *theRV = theReliabilityDomain->getRandomVariablePtrFromIndex(j);
-            int param_indx = theReliabilityDomain->getParameterIndexFromRandomVariableIndex(j);
-            Parameter *theParam = theOpenSeesDomain->getParameterFromIndex(param_indx);
-            
-            // now we should update the parameter value
-            theParam->update( x(j) );
-        }
-		
-        
-        // set values in the variable namespace
-        if (theGFunEvaluator->setVariables() < 0) {
-            opserr << "ImportanceSamplingAnalysis::analyze() - " << endln
-                << " could not set variables in namespace. " << endln;
-            return -1;
-        }
-        
-		// Evaluate limit-state function
-		FEconvergence = true;
-		if (theGFunEvaluator -> runAnalysis() < 0) {
-			// In this case a failure happened during the analysis
-			// Hence, register this as failure
-            opserr << "ERROR ImportanceSamplingAnalysis -- error running analysis" << endln;
-			FEconvergence = false;
+			// Run the analysis of the sample
+			result = this->evaluateSample(startPointY, isFirstSimulation && !restarted ? seed : 0, &sampleResults(0));
+			seed = theRandomNumberGenerator->getSeed();
+			if (result < 0)
+				return -1;
 		}
 
-
 		LimitStateFunctionIter &lsfIter = theReliabilityDomain->getLimitStateFunctions();
 		LimitStateFunction *theLimitStateFunction;
 		// Loop over number of limit-state functions
@@ -293,10 +417,7 @@ ImportanceSamplingAnalysis::analyze(void)
             const char *lsfExpression = theLimitStateFunction->getExpression();
             theGFunEvaluator->setExpression(lsfExpression);
             
-            gFunctionValue = theGFunEvaluator->evaluateExpression();
-            if (!FEconvergence) {
-				gFunctionValue = -1.0;
-			}
+            gFunctionValue = sampleResults(lsf);
 
 			
 			// ESTIMATION OF FAILURE PROBABILITY
@@ -313,16 +434,8 @@ ImportanceSamplingAnalysis::analyze(void)
 
 
 				// Compute values of joint distributions at the u-point
-				phi = factor1 * exp( -0.5 * (u ^ u) );
-				//temp1 = inv_covariance ^ (u-startPointY);
-				//temp2 = temp1 ^ (u-startPointY);
-				temp2 = 0.0;
-				for (int i = 0; i < numRV; i++) {
-				  double uy = u(i)-startPointY(i);
-				  temp2 += uy*uy;
-				}
-				temp2 /= samplingStdv*samplingStdv;
-				h   = factor2 * exp( -0.5 * temp2 );
+				phi = factor1 * exp( -0.5 * sampleResults(numLsf) );
+				h   = factor2 * exp( -0.5 * sampleResults(numLsf+1) );
 
 
 				// Update sums
@@ -457,7 +570,12 @@ ImportanceSamplingAnalysis::analyze(void)
 		if (printFlag == 2) {
 			ofstream outputFile( restartFileName, ios::out );
 			outputFile << k << endln;
-			outputFile << seed << endln;
+			// the workers draw sample k from the stream k of the seed
+			if (parallel)
+				outputFile << seed;
+			else
+				theRandomNumberGenerator->writeState(outputFile);
+			outputFile << endln;
 			for (int lsf=0; lsf<numLsf; lsf++ ) {
 				sprintf(myString,"%15.10f  %15.10f",q_bar(lsf),cov_of_q_bar(lsf));
 				outputFile << myString << " " << endln;
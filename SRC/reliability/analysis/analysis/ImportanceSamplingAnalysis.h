@@ -59,7 +59,9 @@ public:
 				   double samplingStdv,
 				   int printFlag,
 				   TCL_Char *fileName,
-				   int analysisTypeTag);
+				   int analysisTypeTag,
+				   int numWorkers = 1,
+				   int seed = 1);
 	
 	~ImportanceSamplingAnalysis();
 	
@@ -68,6 +70,9 @@ public:
 protected:
 	
 private:
+	int evaluateSample(const Vector &startPointY, int seed, double *res);
+
+
 	ReliabilityDomain *theReliabilityDomain;
     Domain *theOpenSeesDomain;
 	ProbabilityTransformation *theProbabilityTransformation;
@@ -80,6 +85,8 @@ private:
 	int printFlag;
 	char fileName[256];
 	int analysisTypeTag;
+	int numWorkers;
+	int seed;
 };
 
 #endif
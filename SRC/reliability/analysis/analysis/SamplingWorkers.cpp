@@ -0,0 +1,288 @@
+/* ****************************************************************** **
+**    OpenSees - Open System for Earthquake Engineering Simulation    **
+**          Pacific Earthquake Engineering Research Center            **
+**                                                                    **
+**                                                                    **
+** (C) Copyright 2001, The Regents of the University of California    **
+** All Rights Reserved.                                               **
+**                                                                    **
+** Commercial use of this program without express permission of the   **
+** University of California, Berkeley, is strictly prohibited.  See   **
+** file 'COPYRIGHT'  in main directory for information on usage and   **
+** redistribution,  and for a DISCLAIMER OF ALL WARRANTIES.           **
+**                                                                    **
+** Developed by:                                                      **
+**   Frank McKenna (fmckenna@ce.berkeley.edu)                         **
+**   Gregory L. Fenves (fenves@ce.berkeley.edu)                       **
+**   Filip C. Filippou (filippou@ce.berkeley.edu)                     **
+**                                                                    **
+** Reliability module developed by:                                   **
+**   Terje Haukaas (haukaas@ce.berkeley.edu)                          **
+**   Armen Der Kiureghian (adk@ce.berkeley.edu)                       **
+**                                                                    **
+** ****************************************************************** */
+
+#include <SamplingWorkers.h>
+#include <OPS_Globals.h>
+
+#include <stdio.h>
+#include <iostream>
+
+#if !defined(_WIN32) && !defined(_PARALLEL_PROCESSING) && !defined(_PARALLEL_INTERPRETERS)
+#define _SAMPLING_WORKERS
+#include <unistd.h>
+#include <errno.h>
+#include <poll.h>
+#include <signal.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+#endif
+
+#ifdef _SAMPLING_WORKERS
+static int
+readAll(int fd, void *data, size_t size)
+{
+    char *ptr = (char *)data;
+    while (size > 0) {
+	ssize_t n = read(fd, ptr, size);
+	if (n < 0 && errno == EINTR)
+	    continue;
+	if (n <= 0)
+	    return -1;
+	ptr += n;
+	size -= n;
+    }
+    return 0;
+}
+
+static int
+writeAll(int fd, const void *data, size_t size)
+{
+    const char *ptr = (const char *)data;
+    while (size > 0) {
+	ssize_t n = write(fd, ptr, size);
+	if (n < 0 && errno == EINTR)
+	    continue;
+	if (n <= 0)
+	    return -1;
+	ptr += n;
+	size -= n;
+    }
+    return 0;
+}
+#endif
+
+SamplingWorkers::SamplingWorkers(int num, int size)
+  :numWorkers(num), resultSize(size), oldPipeHandler(0), pipeIgnored(false)
+{
+    if (numWorkers < 1)
+	numWorkers = 1;
+}
+
+SamplingWorkers::~SamplingWorkers()
+{
+    this->stop();
+}
+
+bool
+SamplingWorkers::available(void)
+{
+#ifdef _SAMPLING_WORKERS
+    return true;
+#else
+    return false;
+#endif
+}
+
+int
+SamplingWorkers::start(Evaluator eval)
+{
+#ifdef _SAMPLING_WORKERS
+    if (!pids.empty()) {
+	opserr << "WARNING SamplingWorkers::start() - workers already started\n";
+	return -1;
+    }
+
+    theEvaluator = eval;
+
+    // a dead worker is detected by read/write, not by SIGPIPE
+    oldPipeHandler = signal(SIGPIPE, SIG_IGN);
+    if (oldPipeHandler == SIG_ERR)
+	oldPipeHandler = SIG_DFL;
+    pipeIgnored = true;
+
+    // buffered output would otherwise be written by every worker
+    fflush(0);
+    std::cout.flush();
+    std::cerr.flush();
+
+    for (int i = 0; i < numWorkers; i++) {
+	int down[2], up[2];
+	if (pipe(down) != 0) {
+	    opserr << "WARNING SamplingWorkers::start() - failed to create pipe\n";
+	    this->stop();
+	    return -1;
+	}
+	if (pipe(up) != 0) {
+	    close(down[0]);
+	    close(down[1]);
+	    opserr << "WARNING SamplingWorkers::start() - failed to create pipe\n";
+	    this->stop();
+	    return -1;
+	}
+
+	pid_t pid = fork();
+	if (pid < 0) {
+	    close(down[0]); close(down[1]);
+	    close(up[0]); close(up[1]);
+	    opserr << "WARNING SamplingWorkers::start() - failed to fork worker " << i << endln;
+	    this->stop();
+	    return -1;
+	}
+
+	if (pid == 0) {
+	    // worker: keep only its own ends of its own pipes
+	    for (int j = 0; j < (int)toWorker.size(); j++) {
+		close(toWorker[j]);
+		close(fromWorker[j]);
+	    }
+	    close(down[1]);
+	    close(up[0]);
+	    signal(SIGPIPE, oldPipeHandler);
+	    this->workerLoop(down[0], up[1]);
+	    close(down[0]);
+	    close(up[1]);
+	    fflush(0);
+	    _exit(0);
+	}
+
+	close(down[0]);
+	close(up[1]);
+	pids.push_back(pid);
+	toWorker.push_back(down[1]);
+	fromWorker.push_back(up[0]);
+    }
+
+    return 0;
+#else
+    opserr << "WARNING SamplingWorkers::start() - worker processes are not available in this build\n";
+    return -1;
+#endif
+}
+
+void
+SamplingWorkers::workerLoop(int in, int out)
+{
+#ifdef _SAMPLING_WORKERS
+    std::vector<double> res(resultSize);
+    long k;
+    while (readAll(in, &k, sizeof(k)) == 0 && k >= 0) {
+	for (int i = 0; i < resultSize; i++)
+	    res[i] = 0.0;
+	int status = theEvaluator(k, resultSize > 0 ? &res[0] : 0);
+	if (writeAll(out, &k, sizeof(k)) != 0 ||
+	    writeAll(out, &status, sizeof(status)) != 0 ||
+	    writeAll(out, res.data(), resultSize*sizeof(double)) != 0)
+	    break;
+	fflush(0);
+    }
+#endif
+}
+
+int
+SamplingWorkers::evaluate(long first, long count, double *results, int *status)
+{
+#ifdef _SAMPLING_WORKERS
+    int num = (int)pids.size();
+    if (num == 0) {
+	opserr << "WARNING SamplingWorkers::evaluate() - workers not started\n";
+	return -1;
+    }
+
+    long next = first;
+    long last = first + count;
+    int busy = 0;
+    std::vector<struct pollfd> fds(num);
+
+    // one sample to each worker to begin with
+    for (int i = 0; i < num; i++) {
+	fds[i].fd = fromWorker[i];
+	fds[i].events = POLLIN;
+	fds[i].revents = 0;
+	if (next < last) {
+	    if (writeAll(toWorker[i], &next, sizeof(next)) != 0) {
+		opserr << "WARNING SamplingWorkers::evaluate() - lost worker " << i << endln;
+		return -1;
+	    }
+	    next++;
+	    busy++;
+	}
+    }
+
+    // then the next sample to whichever worker is done
+    while (busy > 0) {
+	int res = poll(fds.data(), num, -1);
+	if (res < 0) {
+	    if (errno == EINTR)
+		continue;
+	    opserr << "WARNING SamplingWorkers::evaluate() - poll failed\n";
+	    return -1;
+	}
+
+	for (int i = 0; i < num; i++) {
+	    if (fds[i].revents == 0)
+		continue;
+
+	    long k;
+	    int st;
+	    if (readAll(fromWorker[i], &k, sizeof(k)) != 0 ||
+		readAll(fromWorker[i], &st, sizeof(st)) != 0 ||
+		k < first || k >= last ||
+		readAll(fromWorker[i], &results[(k-first)*resultSize],
+			resultSize*sizeof(double)) != 0) {
+		opserr << "WARNING SamplingWorkers::evaluate() - lost worker " << i << endln;
+		return -1;
+	    }
+	    status[k-first] = st;
+	    busy--;
+
+	    if (next < last) {
+		if (writeAll(toWorker[i], &next, sizeof(next)) != 0) {
+		    opserr << "WARNING SamplingWorkers::evaluate() - lost worker " << i << endln;
+		    return -1;
+		}
+		next++;
+		busy++;
+	    }
+	}
+    }
+
+    return 0;
+#else
+    return -1;
+#endif
+}
+
+void
+SamplingWorkers::stop(void)
+{
+#ifdef _SAMPLING_WORKERS
+    long done = -1;
+    for (int i = 0; i < (int)pids.size(); i++) {
+	writeAll(toWorker[i], &done, sizeof(done));
+	close(toWorker[i]);
+	close(fromWorker[i]);
+    }
+    for (int i = 0; i < (int)pids.size(); i++) {
+	int wstatus;
+	while (waitpid(pids[i], &wstatus, 0) < 0 && errno == EINTR)
+	    ;
+    }
+    if (pipeIgnored)
+	signal(SIGPIPE, oldPipeHandler);
+    pipeIgnored = false;
+#endif
+    pids.clear();
+    toWorker.clear();
+    fromWorker.clear();
+}
@@ -0,0 +1,77 @@
+/* ****************************************************************** **
+**    OpenSees - Open System for Earthquake Engineering Simulation    **
+**          Pacific Earthquake Engineering Research Center            **
+**                                                                    **
+**                                                                    **
+** (C) Copyright 2001, The Regents of the University of California    **
+** All Rights Reserved.                                               **
+**                                                                    **
+** Commercial use of this program without express permission of the   **
+** University of California, Berkeley, is strictly prohibited.  See   **
+** file 'COPYRIGHT'  in main directory for information on usage and   **
+** redistribution,  and for a DISCLAIMER OF ALL WARRANTIES.           **
+**                                                                    **
+** Developed by:                                                      **
+**   Frank McKenna (fmckenna@ce.berkeley.edu)                         **
+**   Gregory L. Fenves (fenves@ce.berkeley.edu)                       **
+**   Filip C. Filippou (filippou@ce.berkeley.edu)                     **
+**                                                                    **
+** Reliability module developed by:                                   **
+**   Terje Haukaas (haukaas@ce.berkeley.edu)                          **
+**   Armen Der Kiureghian (adk@ce.berkeley.edu)                       **
+**                                                                    **
+** ****************************************************************** */
+
+// Description: SamplingWorkers evaluates the samples of a sampling
+// analysis in worker processes. The workers are forked from the running
+// program, so each one holds its own copy of the interpreter, the
+// reliability domain and the FE model, and runs the analysis of a sample
+// exactly as the serial analysis would. The parent hands out samples one
+// at a time to whichever worker is idle and gathers the results of a
+// batch in sample order, so the statistics can be reduced online and the
+// result does not depend on the number of workers.
+//
+// Workers are only available on POSIX systems in the sequential build.
+// The workers inherit the open files and only the calling thread of the
+// program, so they must not be started while recorders are defined or
+// other threads are running.
+
+#ifndef SamplingWorkers_h
+#define SamplingWorkers_h
+
+#include <functional>
+#include <vector>
+
+class SamplingWorkers
+{
+  public:
+    // evaluates sample k into res[0..resultSize-1], returns < 0 on failure
+    typedef std::function<int(long k, double *res)> Evaluator;
+
+    SamplingWorkers(int numWorkers, int resultSize);
+    ~SamplingWorkers();
+
+    static bool available(void);
+
+    int start(Evaluator eval);
+    int evaluate(long first, long count, double *results, int *status);
+    void stop(void);
+
+    int getNumWorkers(void) const {return numWorkers;}
+
+  private:
+    void workerLoop(int in, int out);
+
+    typedef void (*SignalHandler)(int);
+
+    int numWorkers;
+    int resultSize;
+    SignalHandler oldPipeHandler;
+    bool pipeIgnored;
+    Evaluator theEvaluator;
+    std::vector<int> pids;
+    std::vector<int> toWorker;
+    std::vector<int> fromWorker;
+};
+
+#endif
@@ -0,0 +1,66 @@
+/* ****************************************************************** **
+**    OpenSees - Open System for Earthquake Engineering Simulation    **
+**          Pacific Earthquake Engineering Research Center            **
+**                                                                    **
+**                                                                    **
+** (C) Copyright 2001, The Regents of the University of California    **
+** All Rights Reserved.                                               **
+**                                                                    **
+** Commercial use of this program without express permission of the   **
+** University of California, Berkeley, is strictly prohibited.  See   **
+** file 'COPYRIGHT'  in main directory for information on usage and   **
+** redistribution,  and for a DISCLAIMER OF ALL WARRANTIES.           **
+**                                                                    **
+** Developed by:                                                      **
+**   Frank McKenna (fmckenna@ce.berkeley.edu)                         **
+**   Gregory L. Fenves (fenves@ce.berkeley.edu)                       **
+**   Filip C. Filippou (filippou@ce.berkeley.edu)                     **
+**                                                                    **
+** Reliability module developed by:                                   **
+**   Terje Haukaas (haukaas@ce.berkeley.edu)                          **
+**   Armen Der Kiureghian (adk@ce.berkeley.edu)                       **
+**                                                                    **
+** ****************************************************************** */
+
+// Description: the Philox4x32-10 bijection (Salmon et al., "Parallel
+// random numbers: as easy as 1, 2, 3", SC11), with the constants and the
+// key schedule of the Random123 reference, so its output can be checked
+// against the Random123 known-answer vectors. The counters of a batch are
+// held in four arrays; the loops over the blocks are independent and are
+// vectorized by the compiler.
+
+#ifndef Philox4x32_h
+#define Philox4x32_h
+
+static const unsigned int PHILOX_M0 = 0xD2511F53u;
+static const unsigned int PHILOX_M1 = 0xCD9E8D57u;
+static const unsigned int PHILOX_W0 = 0x9E3779B9u;
+static const unsigned int PHILOX_W1 = 0xBB67AE85u;
+
+// encrypts the num counters (c0[i], c1[i], c2[i], c3[i]) in place with the
+// key (k0, k1)
+inline void
+philox4x32_10(unsigned int *c0, unsigned int *c1, unsigned int *c2, unsigned int *c3,
+	      int num, unsigned int k0, unsigned int k1)
+{
+	unsigned int key0 = k0, key1 = k1;
+	for (int r = 0; r < 10; r++) {
+		// the key is bumped before each round but the first
+		if (r > 0) {
+			key0 += PHILOX_W0;
+			key1 += PHILOX_W1;
+		}
+		for (int i = 0; i < num; i++) {
+			unsigned long long p0 = (unsigned long long)PHILOX_M0 * c0[i];
+			unsigned long long p1 = (unsigned long long)PHILOX_M1 * c2[i];
+			unsigned int n0 = (unsigned int)(p1 >> 32) ^ c1[i] ^ key0;
+			unsigned int n2 = (unsigned int)(p0 >> 32) ^ c3[i] ^ key1;
+			c1[i] = (unsigned int)p1;
+			c3[i] = (unsigned int)p0;
+			c0[i] = n0;
+			c2[i] = n2;
+		}
+	}
+}
+
+#endif
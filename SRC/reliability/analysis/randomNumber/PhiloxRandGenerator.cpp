@@ -0,0 +1,252 @@
+/* ****************************************************************** **
+**    OpenSees - Open System for Earthquake Engineering Simulation    **
+**          Pacific Earthquake Engineering Research Center            **
+**                                                                    **
+**                                                                    **
+** (C) Copyright 2001, The Regents of the University of California    **
+** All Rights Reserved.                                               **
+**                                                                    **
+** Commercial use of this program without express permission of the   **
+** University of California, Berkeley, is strictly prohibited.  See   **
+** file 'COPYRIGHT'  in main directory for information on usage and   **
+** redistribution,  and for a DISCLAIMER OF ALL WARRANTIES.           **
+**                                                                    **
+** Developed by:                                                      **
+**   Frank McKenna (fmckenna@ce.berkeley.edu)                         **
+**   Gregory L. Fenves (fenves@ce.berkeley.edu)                       **
+**   Filip C. Filippou (filippou@ce.berkeley.edu)                     **
+**                                                                    **
+** Reliability module developed by:                                   **
+**   Terje Haukaas (haukaas@ce.berkeley.edu)                          **
+**   Armen Der Kiureghian (adk@ce.berkeley.edu)                       **
+**                                                                    **
+** ****************************************************************** */
+
+#include <PhiloxRandGenerator.h>
+#include <Philox4x32.h>
+#include <Vector.h>
+#include <math.h>
+#include <stdio.h>
+#include <time.h>
+#include <iostream>
+#include <string>
+#include <vector>
+
+// number of blocks generated at a time
+static const int PHILOX_BATCH = 64;
+
+PhiloxRandGenerator::PhiloxRandGenerator(int passedSeed)
+:RandomNumberGenerator(), generatedNumbers(0), seed(0), stream(0), counter(0)
+{
+	setSeed(passedSeed);
+}
+
+
+PhiloxRandGenerator::~PhiloxRandGenerator()
+{
+	if (generatedNumbers != 0)
+		delete generatedNumbers;
+}
+
+
+void
+PhiloxRandGenerator::nextBlocks(unsigned int *words, int numBlocks)
+{
+	unsigned int k0 = (unsigned int)seed;
+	unsigned int k1 = 0;
+
+	unsigned int c0[PHILOX_BATCH], c1[PHILOX_BATCH], c2[PHILOX_BATCH], c3[PHILOX_BATCH];
+
+	for (int first = 0; first < numBlocks; first += PHILOX_BATCH) {
+		int num = numBlocks - first;
+		if (num > PHILOX_BATCH)
+			num = PHILOX_BATCH;
+
+		// counters of the blocks
+		for (int i = 0; i < num; i++) {
+			unsigned long long c = counter + i;
+			c0[i] = (unsigned int)c;
+			c1[i] = (unsigned int)(c >> 32);
+			c2[i] = (unsigned int)stream;
+			c3[i] = (unsigned int)(stream >> 32);
+		}
+
+		philox4x32_10(c0, c1, c2, c3, num, k0, k1);
+
+		for (int i = 0; i < num; i++) {
+			unsigned int *w = &words[4*(first+i)];
+			w[0] = c0[i];
+			w[1] = c1[i];
+			w[2] = c2[i];
+			w[3] = c3[i];
+		}
+		counter += num;
+	}
+}
+
+
+void
+PhiloxRandGenerator::fillUniform(double *x, int n, double lower, double upper)
+{
+	// two words per number
+	int numBlocks = (n+1)/2;
+	std::vector<unsigned int> words(4*numBlocks);
+	nextBlocks(&words[0], numBlocks);
+
+	// 53 bit numbers in (0,1)
+	const double scale = 1.0/9007199254740992.0;
+	const double range = upper - lower;
+	for (int j = 0; j < n; j++) {
+		double u = ((words[2*j] >> 5)*67108864.0 + (words[2*j+1] >> 6) + 0.5)*scale;
+		x[j] = lower + range*u;
+	}
+}
+
+
+void
+PhiloxRandGenerator::fillStdNormal(double *x, int n)
+{
+	// Box-Muller, two numbers from each block
+	int numBlocks = (n+1)/2;
+	std::vector<unsigned int> words(4*numBlocks);
+	nextBlocks(&words[0], numBlocks);
+
+	static const double twopi = 2.0*acos(-1.0);
+	const double scale = 1.0/9007199254740992.0;
+	for (int b = 0; b < numBlocks; b++) {
+		const unsigned int *w = &words[4*b];
+		double u1 = ((w[0] >> 5)*67108864.0 + (w[1] >> 6) + 0.5)*scale;
+		double u2 = ((w[2] >> 5)*67108864.0 + (w[3] >> 6) + 0.5)*scale;
+		double r = sqrt(-2.0*log(u1));
+		double t = twopi*u2;
+		x[2*b] = r*cos(t);
+		if (2*b+1 < n)
+			x[2*b+1] = r*sin(t);
+	}
+}
+
+
+Vector *
+PhiloxRandGenerator::resize(int n)
+{
+	if (generatedNumbers == 0) {
+		generatedNumbers = new Vector(n);
+	}
+	else if (generatedNumbers->Size() != n) {
+		delete generatedNumbers;
+		generatedNumbers = new Vector(n);
+	}
+	return generatedNumbers;
+}
+
+
+int
+PhiloxRandGenerator::generate_nIndependentUniformNumbers(int n, double lower, double upper, int seedIn)
+{
+	// set RNG seed if necessary
+	if (seedIn != 0)
+		setSeed(seedIn);
+
+	Vector &randomArray = *resize(n);
+	if (n > 0)
+		fillUniform(&randomArray(0), n, lower, upper);
+
+	return 0;
+}
+
+
+int
+PhiloxRandGenerator::generate_nIndependentStdNormalNumbers(int n, int seedIn)
+{
+	// set RNG seed if necessary
+	if (seedIn != 0)
+		setSeed(seedIn);
+
+	Vector &randomArray = *resize(n);
+	if (n > 0)
+		fillStdNormal(&randomArray(0), n);
+
+	return 0;
+}
+
+
+const Vector&
+PhiloxRandGenerator::getGeneratedNumbers()
+{
+	return (*generatedNumbers);
+}
+
+
+int
+PhiloxRandGenerator::getSeed()
+{
+	return seed;
+}
+
+
+void
+PhiloxRandGenerator::setSeed(int passedSeed)
+{
+	if (passedSeed != 0)
+		seed = passedSeed;
+	else
+		seed = (int)time(NULL);
+	stream = 0;
+	counter = 0;
+}
+
+
+int
+PhiloxRandGenerator::setStream(int passedSeed, long passedStream)
+{
+	setSeed(passedSeed);
+	stream = (unsigned long long)passedStream;
+	return 0;
+}
+
+
+void
+PhiloxRandGenerator::writeState(std::ostream &s)
+{
+	// the seed alone would restart the stream from its first number
+	s << seed << " " << stream << " " << counter;
+}
+
+
+int
+PhiloxRandGenerator::readState(std::istream &s)
+{
+	std::string line;
+	s >> std::ws;
+	if (!std::getline(s, line))
+		return -1;
+
+	// a line with just a seed starts its first stream
+	int passedSeed = 0;
+	unsigned long long passedStream = 0, passedCounter = 0;
+	if (sscanf(line.c_str(), "%d %llu %llu", &passedSeed, &passedStream, &passedCounter) < 1)
+		return -1;
+
+	setSeed(passedSeed);
+	stream = passedStream;
+	counter = passedCounter;
+	return 0;
+}
+
+
+double
+PhiloxRandGenerator::generate_singleUniformNumber(double lower, double upper)
+{
+	double x;
+	fillUniform(&x, 1, lower, upper);
+	return x;
+}
+
+
+double
+PhiloxRandGenerator::generate_singleStdNormalNumber(void)
+{
+	double x;
+	fillStdNormal(&x, 1);
+	return x;
+}
@@ -0,0 +1,82 @@
+/* ****************************************************************** **
+**    OpenSees - Open System for Earthquake Engineering Simulation    **
+**          Pacific Earthquake Engineering Research Center            **
+**                                                                    **
+**                                                                    **
+** (C) Copyright 2001, The Regents of the University of California    **
+** All Rights Reserved.                                               **
+**                                                                    **
+** Commercial use of this program without express permission of the   **
+** University of California, Berkeley, is strictly prohibited.  See   **
+** file 'COPYRIGHT'  in main directory for information on usage and   **
+** redistribution,  and for a DISCLAIMER OF ALL WARRANTIES.           **
+**                                                                    **
+** Developed by:                                                      **
+**   Frank McKenna (fmckenna@ce.berkeley.edu)                         **
+**   Gregory L. Fenves (fenves@ce.berkeley.edu)                       **
+**   Filip C. Filippou (filippou@ce.berkeley.edu)                     **
+**                                                                    **
+** Reliability module developed by:                                   **
+**   Terje Haukaas (haukaas@ce.berkeley.edu)                          **
+**   Armen Der Kiureghian (adk@ce.berkeley.edu)                       **
+**                                                                    **
+** ****************************************************************** */
+
+// Description: PhiloxRandGenerator is a counter-based generator using
+// the Philox4x32-10 bijection (Salmon et al., "Parallel random numbers:
+// as easy as 1, 2, 3", SC11). Block i of a stream is the encryption of
+// the 128 bit counter (i, stream) with the key (seed, 0), so the numbers
+// have no hidden global state, any stream (a sample, a thread) can be
+// generated independently and the position in a stream can be restored.
+// Numbers are generated in blocks of four 32 bit words; uniform numbers
+// use 53 bits, standard normal numbers use the Box-Muller transform.
+
+#ifndef PhiloxRandGenerator_h
+#define PhiloxRandGenerator_h
+
+#include <RandomNumberGenerator.h>
+#include <Vector.h>
+
+class PhiloxRandGenerator : public RandomNumberGenerator
+{
+
+public:
+	PhiloxRandGenerator(int seed = 0);
+	~PhiloxRandGenerator();
+
+	int     generate_nIndependentStdNormalNumbers(int n, int seed=0);
+	int     generate_nIndependentUniformNumbers(int n, double lower, double upper, int seed=0);
+	const   Vector& getGeneratedNumbers();
+	int     getSeed();
+
+	double  generate_singleStdNormalNumber();
+	double  generate_singleUniformNumber(double lower=0.0, double upper=1.0);
+	void    setSeed(int passedSeed=0);
+
+	int     setStream(int seed, long stream);
+
+	// seed, stream and position in the stream
+	void    writeState(std::ostream &s);
+	int     readState(std::istream &s);
+
+	// bulk generation into an array
+	void    fillUniform(double *x, int n, double lower = 0.0, double upper = 1.0);
+	void    fillStdNormal(double *x, int n);
+
+	// position in the current stream, in blocks of four words
+	unsigned long long getCounter() const {return counter;}
+	void    setCounter(unsigned long long c) {counter = c;}
+
+protected:
+
+private:
+	void    nextBlocks(unsigned int *words, int numBlocks);
+	Vector *resize(int n);
+
+	Vector *generatedNumbers;
+	int seed;
+	unsigned long long stream;
+	unsigned long long counter;
+};
+
+#endif
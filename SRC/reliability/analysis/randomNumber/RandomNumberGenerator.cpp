@@ -32,6 +32,9 @@
 //
 
 #include <RandomNumberGenerator.h>
+#include <stdio.h>
+#include <iostream>
+#include <string>
 
 RandomNumberGenerator::RandomNumberGenerator()
 {
@@ -42,3 +45,47 @@ RandomNumberGenerator::~RandomNumberGenerator()
 }
 
 
+
+int
+RandomNumberGenerator::setStream(int seed, long stream)
+{
+	this->setSeed(streamSeed(seed, stream));
+	return 0;
+}
+
+int
+RandomNumberGenerator::streamSeed(int seed, long stream)
+{
+	// splitmix64 of the seed and the stream number
+	unsigned long long x = ((unsigned long long)(unsigned int)seed << 32) ^ (unsigned long long)stream;
+	x += 0x9e3779b97f4a7c15ULL;
+	x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ULL;
+	x = (x ^ (x >> 27)) * 0x94d049bb133111ebULL;
+	x = x ^ (x >> 31);
+
+	// a seed of 0 means a seed from the clock to the generators
+	int res = (int)(x & 0x7fffffff);
+	return res == 0 ? 1 : res;
+}
+
+void
+RandomNumberGenerator::writeState(std::ostream &s)
+{
+	s << this->getSeed();
+}
+
+int
+RandomNumberGenerator::readState(std::istream &s)
+{
+	std::string line;
+	s >> std::ws;
+	if (!std::getline(s, line))
+		return -1;
+
+	int seed;
+	if (sscanf(line.c_str(), "%d", &seed) != 1)
+		return -1;
+
+	this->setSeed(seed);
+	return 0;
+}
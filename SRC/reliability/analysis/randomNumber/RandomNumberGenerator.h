@@ -35,6 +35,7 @@
 #define RandomNumberGenerator_h
 
 #include <Vector.h>
+#include <iosfwd>
 
 class RandomNumberGenerator
 {
@@ -53,6 +54,16 @@ public:
 	virtual double  generate_singleUniformNumber(double lower=0.0, double upper=1.0)=0;		
 	virtual void setSeed(int)=0;
 
+	// independent, reproducible stream of numbers, e.g. for a sample or
+	// a thread; generators without streams are seeded by streamSeed()
+	virtual int setStream(int seed, long stream);
+	static int streamSeed(int seed, long stream);
+
+	// position of the generator on one line, e.g. for a restart file;
+	// by default the position is the seed
+	virtual void writeState(std::ostream &s);
+	virtual int readState(std::istream &s);
+
 
 protected:
 
@@ -102,6 +102,7 @@ using std::setiosflags;
 #include <SearchWithStepSizeAndStepDirection.h>
 #include <RandomNumberGenerator.h>
 #include <CStdLibRandGenerator.h>
+#include <PhiloxRandGenerator.h>
 #include <FindCurvatures.h>
 #include <FirstPrincipalCurvature.h>
 #include <CurvaturesBySearchAlgorithm.h>
@@ -124,6 +125,7 @@ using std::setiosflags;
 #include <GFunVisualizationAnalysis.h>
 #include <OutCrossingAnalysis.h>
 #include <ImportanceSamplingAnalysis.h>
+#include <SamplingWorkers.h>
 #include <SORMAnalysis.h>
 #include <SystemAnalysis.h>
 #include <PCM.h>
@@ -2202,6 +2204,15 @@ TclReliabilityModelBuilder_addRandomNumberGenerator(ClientData clientData, Tcl_I
   if (strcmp(argv[1],"CStdLib") == 0) {
 	  theRandomNumberGenerator = new CStdLibRandGenerator();
   }
+  else if (strcmp(argv[1],"Philox") == 0) {
+	  // optional seed, 0 seeds from the clock
+	  int seed = 0;
+	  if (argc > 2 && Tcl_GetInt(interp, argv[2], &seed) != TCL_OK) {
+		  opserr << "ERROR: invalid seed for Philox RandomNumberGenerator \n";
+		  return TCL_ERROR;
+	  }
+	  theRandomNumberGenerator = new PhiloxRandGenerator(seed);
+  }
   else {
 	opserr << "ERROR: unrecognized type of RandomNumberGenerator \n";
 	return TCL_ERROR;
@@ -4158,8 +4169,14 @@ TclReliabilityModelBuilder_runImportanceSamplingAnalysis(ClientData clientData,
 	//     -print 1   (print to screen)
 	//     -print 2   (print to restart file)
 	//
+	//     -numWorkers 1  ....................... this is the default,
+	//                                            more run the samples
+	//                                            in worker processes
+	//
+	//     -seed 1  ............................. this is the default
+	//
 
-	if (argc!=2 && argc!=4 && argc!=6 && argc!=8 && argc!=10 && argc!=12) {
+	if (argc < 2 || argc > 16 || argc%2 != 0) {
 		opserr << "ERROR: Wrong number of arguments to Sampling analysis" << endln;
 		return TCL_ERROR;
 	}
@@ -4171,6 +4188,8 @@ TclReliabilityModelBuilder_runImportanceSamplingAnalysis(ClientData clientData,
 	double samplingVariance	= 1.0;
 	int printFlag			= 0;
 	int analysisTypeTag		= 1;
+	int numWorkers			= 1;
+	int seed			= 1;
 
 
 	for (int i=2; i<argc; i=i+2) {
@@ -4240,6 +4259,20 @@ TclReliabilityModelBuilder_runImportanceSamplingAnalysis(ClientData clientData,
 				return TCL_ERROR;
 			}
 		}
+		else if (strcmp(argv[i],"-numWorkers") == 0) {
+			// GET INPUT PARAMETER (integer)
+			if (Tcl_GetInt(interp, argv[i+1], &numWorkers) != TCL_OK) {
+				opserr << "ERROR: invalid input: numWorkers \n";
+				return TCL_ERROR;
+			}
+		}
+		else if (strcmp(argv[i],"-seed") == 0) {
+			// GET INPUT PARAMETER (integer)
+			if (Tcl_GetInt(interp, argv[i+1], &seed) != TCL_OK) {
+				opserr << "ERROR: invalid input: seed \n";
+				return TCL_ERROR;
+			}
+		}
 		else {
 			opserr << "ERROR: invalid input to sampling analysis. " << endln;
 			return TCL_ERROR;
@@ -4252,6 +4285,11 @@ TclReliabilityModelBuilder_runImportanceSamplingAnalysis(ClientData clientData,
 			<< " used together with the response statistics option. " << endln;
 		return TCL_ERROR;
 	}
+	if (numWorkers > 1 && !SamplingWorkers::available()) {
+		opserr << "WARNING: worker processes are not available in this build, " << endln
+			<< " the samples are run serially." << endln;
+		numWorkers = 1;
+	}
 	
 	
 	theImportanceSamplingAnalysis 
@@ -4263,7 +4301,8 @@ TclReliabilityModelBuilder_runImportanceSamplingAnalysis(ClientData clientData,
 							 numberOfSimulations, targetCOV, samplingVariance,
 							 printFlag,
 							 argv[1],
-							 analysisTypeTag);
+							 analysisTypeTag,
+							 numWorkers, seed);
 
 	if (theImportanceSamplingAnalysis == 0) {
 		opserr << "ERROR: could not create theImportanceSamplingAnalysis \n";
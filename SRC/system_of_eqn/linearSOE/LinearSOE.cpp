@@ -32,6 +32,8 @@
 
 #include<LinearSOE.h>
 #include<LinearSOESolver.h>
+#include<Matrix.h>
+#include<Vector.h>
 
 LinearSOE::LinearSOE(LinearSOESolver &theLinearSOESolver, int classtag)
     :MovableObject(classtag), theModel(0), theSolver(&theLinearSOESolver)
@@ -61,6 +63,66 @@ LinearSOE::solve(void)
     return -1;
 }
 
+// solves A X = B for the columns of B. Solvers that support it solve
+// all columns with a single factorization of A, otherwise the columns
+// are set as B of the system and solved one at a time.
+int
+LinearSOE::solveMultiple(const Matrix &B, Matrix &X)
+{
+  int n = this->getNumEqn();
+  int nrhs = B.noCols();
+  if (B.noRows() != n) {
+    opserr << "WARNING LinearSOE::solveMultiple() - B has " << B.noRows();
+    opserr << " rows, the system has " << n << " equations\n";
+    return -1;
+  }
+  if (X.noRows() != n || X.noCols() != nrhs)
+    X.resize(n, nrhs);
+  if (n == 0 || nrhs == 0)
+    return 0;
+
+  if (theSolver != 0 && theSolver->supportsMultipleRHS()) {
+    double *work = new double[n*nrhs];
+    for (int j=0; j<nrhs; j++)
+      for (int i=0; i<n; i++)
+	work[j*n+i] = B(i,j);
+
+    int res = theSolver->solveMultiple(work, nrhs);
+
+    for (int j=0; j<nrhs; j++)
+      for (int i=0; i<n; i++)
+	X(i,j) = work[j*n+i];
+    delete [] work;
+    return res;
+  }
+
+  return this->solveColumns(B, X);
+}
+
+// solves A X = B by setting each column of B as B of the system
+int
+LinearSOE::solveColumns(const Matrix &B, Matrix &X)
+{
+  int n = this->getNumEqn();
+  int nrhs = B.noCols();
+  if (X.noRows() != n || X.noCols() != nrhs)
+    X.resize(n, nrhs);
+
+  Vector b(n);
+  for (int j=0; j<nrhs; j++) {
+    for (int i=0; i<n; i++)
+      b(i) = B(i,j);
+    this->setB(b);
+    int res = this->solve();
+    if (res < 0)
+      return res;
+    const Vector &x = this->getX();
+    for (int i=0; i<n; i++)
+      X(i,j) = x(i);
+  }
+  return 0;
+}
+
 int
 LinearSOE::formAp(const Vector &p, Vector &Ap)
 {
@@ -56,6 +56,7 @@ class LinearSOE : public MovableObject
     virtual ~LinearSOE();
 
     virtual int solve(void);    
+    virtual int solveMultiple(const Matrix &B, Matrix &X);
     virtual int setLinks(AnalysisModel &theModel);    
 
     // pure virtual functions
@@ -87,6 +88,7 @@ class LinearSOE : public MovableObject
     
   protected:
     int setSolver(LinearSOESolver &newSolver);	        
+    int solveColumns(const Matrix &B, Matrix &X);
     AnalysisModel* theModel;
     
   private:
@@ -49,6 +49,12 @@ class LinearSOESolver : public MovableObject
     virtual int solve(void) = 0;
     virtual int setSize(void) = 0;
     virtual double getDeterminant(void) {return 1.0;};
+
+    // solution for several right-hand sides with one factorization of A,
+    // X holds the right-hand sides column by column on entry and the
+    // solutions on return. Only called if supportsMultipleRHS() is true.
+    virtual bool supportsMultipleRHS(void) {return false;};
+    virtual int solveMultiple(double *X, int nrhs) {return -1;};
     
   protected:
     
@@ -89,6 +89,27 @@ BandGenLinLapackSolver::solve(void)
 	return -1;
     }
 
+    int n = theSOE->size;    
+    double *Xptr = theSOE->X;
+    double *Bptr = theSOE->B;
+    
+    // first copy B into X
+    for (int i=0; i<n; i++) {
+	*(Xptr++) = *(Bptr++);
+    }
+
+    return this->solveMultiple(theSOE->X, 1);
+}
+
+int
+BandGenLinLapackSolver::solveMultiple(double *X, int nrhs)
+{
+    if (theSOE == 0) {
+	opserr << "WARNING BandGenLinLapackSolver::solve(void)- ";
+	opserr << " No LinearSOE object has been set\n";
+	return -1;
+    }
+
     int n = theSOE->size;    
     // check iPiv is large enough
     if (iPivSize < n) {
@@ -100,21 +121,13 @@ BandGenLinLapackSolver::solve(void)
     int kl = theSOE->numSubD;
     int ku = theSOE->numSuperD;
     int ldA = 2*kl + ku +1;
-    int nrhs = 1;
     int ldB = n;
     int info;
     double *Aptr = theSOE->A;
-    double *Xptr = theSOE->X;
-    double *Bptr = theSOE->B;
+    double *Xptr = X;
     int    *iPIV = iPiv;
-    
-    // first copy B into X
-    for (int i=0; i<n; i++) {
-	*(Xptr++) = *(Bptr++);
-    }
-    Xptr = theSOE->X;
 
-    // now solve AX = B
+    // now solve AX = B, the columns of X hold the right-hand sides
 
 #ifdef _WIN32
     {if (theSOE->factored == false)  
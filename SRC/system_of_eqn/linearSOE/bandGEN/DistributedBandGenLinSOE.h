@@ -55,6 +55,8 @@ class DistributedBandGenLinSOE : public BandGenLinSOE
     void zeroB(void);
     const Vector &getB(void);
     int solve(void);
+    // B is assembled across processes in solve(), so solve column by column
+    int solveMultiple(const Matrix &B, Matrix &X) {return this->solveColumns(B, X);};
 
     int sendSelf(int commitTag, Channel &theChannel);
     int recvSelf(int commitTag, Channel &theChannel, FEM_ObjectBroker &theBroker);    
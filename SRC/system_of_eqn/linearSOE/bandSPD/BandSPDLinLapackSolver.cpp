@@ -87,21 +87,34 @@ BandSPDLinLapackSolver::solve(void)
     }
 
     int n = theSOE->size;
-    int kd = theSOE->half_band -1;
-    int ldA = kd +1;
-    int nrhs = 1;
-    int ldB = n;
-    int info;
-    double *Aptr = theSOE->A;
     double *Xptr = theSOE->X;
     double *Bptr = theSOE->B;
 
     // first copy B into X
     for (int i=0; i<n; i++)
 	*(Xptr++) = *(Bptr++);
-    Xptr = theSOE->X;
 
-    // now solve AX = Y
+    return this->solveMultiple(theSOE->X, 1);
+}
+
+int
+BandSPDLinLapackSolver::solveMultiple(double *X, int nrhs)
+{
+    if (theSOE == 0) {
+	opserr << "WARNING BandSPDLinLapackSolver::solve(void)- ";
+	opserr << " No LinearSOE object has been set\n";
+	return -1;
+    }
+
+    int n = theSOE->size;
+    int kd = theSOE->half_band -1;
+    int ldA = kd +1;
+    int ldB = n;
+    int info;
+    double *Aptr = theSOE->A;
+    double *Xptr = X;
+
+    // now solve AX = Y, the columns of X hold the right-hand sides
 
 	
 
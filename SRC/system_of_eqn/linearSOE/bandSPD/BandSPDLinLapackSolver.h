@@ -45,6 +45,8 @@ class BandSPDLinLapackSolver : public BandSPDLinSolver
     ~BandSPDLinLapackSolver();
 
     int solve(void);
+    bool supportsMultipleRHS(void) {return true;};
+    int solveMultiple(double *X, int nrhs);
     int setSize(void);
     
     int sendSelf(int commitTag, Channel &theChannel);
@@ -54,6 +54,8 @@ class DistributedBandSPDLinSOE : public BandSPDLinSOE
     void zeroB(void);
     int setSize(Graph &theGraph);
     int solve(void);
+    // B is assembled across processes in solve(), so solve column by column
+    int solveMultiple(const Matrix &B, Matrix &X) {return this->solveColumns(B, X);};
     const Vector &getB(void);
 
     int sendSelf(int commitTag, Channel &theChannel);
@@ -0,0 +1,397 @@
+/* ****************************************************************** **
+**    OpenSees - Open System for Earthquake Engineering Simulation    **
+**          Pacific Earthquake Engineering Research Center            **
+**                                                                    **
+**                                                                    **
+** (C) Copyright 1999, The Regents of the University of California    **
+** All Rights Reserved.                                               **
+**                                                                    **
+** Commercial use of this program without express permission of the   **
+** University of California, Berkeley, is strictly prohibited.  See   **
+** file 'COPYRIGHT'  in main directory for information on usage and   **
+** redistribution,  and for a DISCLAIMER OF ALL WARRANTIES.           **
+**                                                                    **
+** Developed by:                                                      **
+**   Frank McKenna (fmckenna@ce.berkeley.edu)                         **
+**   Gregory L. Fenves (fenves@ce.berkeley.edu)                       **
+**   Filip C. Filippou (filippou@ce.berkeley.edu)                     **
+**                                                                    **
+** ****************************************************************** */
+
+// Description: This file contains the implementation for
+// ElementByElementLinSOE.
+
+#include <ElementByElementLinSOE.h>
+#include <ElementByElementSolver.h>
+#include <Matrix.h>
+#include <ID.h>
+#include <Graph.h>
+#include <AnalysisModel.h>
+#include <DOF_Group.h>
+#include <DOF_GrpIter.h>
+#include <math.h>
+#include <stdlib.h>
+
+#include <Channel.h>
+#include <FEM_ObjectBroker.h>
+
+ElementByElementLinSOE::ElementByElementLinSOE(ElementByElementSolver &the_Solver)
+:LinearSOE(the_Solver, LinSOE_TAGS_ElementByElementLinSOE),
+ size(0), B(0), X(0), vectX(0), vectB(0), isAfactored(false),
+ numMatrices(0), numBlocks(0)
+{
+  the_Solver.setLinearSOE(*this);
+  matStart.push_back(0);
+  matValStart.push_back(0);
+}
+
+
+ElementByElementLinSOE::~ElementByElementLinSOE()
+{
+  if (B != 0) delete [] B;
+  if (X != 0) delete [] X;
+  if (vectX != 0) delete vectX;
+  if (vectB != 0) delete vectB;
+}
+
+
+int
+ElementByElementLinSOE::getNumEqn(void) const
+{
+  return size;
+}
+
+int
+ElementByElementLinSOE::getNumMatrices(void) const
+{
+  return numMatrices;
+}
+
+int
+ElementByElementLinSOE::setSize(Graph &theGraph)
+{
+  int oldSize = size;
+  size = theGraph.getNumVertex();
+
+  if (size > oldSize) {
+    if (B != 0) delete [] B;
+    if (X != 0) delete [] X;
+    B = new double[size];
+    X = new double[size];
+  }
+
+  if (size != oldSize && size != 0) {
+    if (vectX != 0) delete vectX;
+    if (vectB != 0) delete vectB;
+    vectX = new Vector(X,size);
+    vectB = new Vector(B,size);
+  }
+
+  for (int i=0; i<size; i++) {
+    B[i] = 0;
+    X[i] = 0;
+  }
+
+  this->setBlocks();
+  this->zeroA();
+
+  // invoke setSize() on the Solver
+  LinearSOESolver *the_Solver = this->getSolver();
+  int solverOK = the_Solver->setSize();
+  if (solverOK < 0) {
+    opserr << "WARNING ElementByElementLinSOE::setSize :";
+    opserr << " solver failed setSize()\n";
+    return solverOK;
+  }
+
+  return 0;
+}
+
+void
+ElementByElementLinSOE::setBlocks(void)
+{
+  // one block for the equations of each DOF_Group, and one for
+  // each equation not in any (the Lagrange multipliers)
+  blockOfEqn.assign(size, -1);
+  posInBlock.assign(size, 0);
+  blockStart.clear();
+  blockEqn.clear();
+  blockStart.push_back(0);
+  numBlocks = 0;
+
+  if (theModel != 0) {
+    DOF_GrpIter &theDOFs = theModel->getDOFs();
+    DOF_Group *dofPtr;
+    while ((dofPtr = theDOFs()) != 0) {
+      const ID &theID = dofPtr->getID();
+      int numInBlock = 0;
+      for (int i=0; i<theID.Size(); i++) {
+	int eqn = theID(i);
+	if (eqn >= 0 && eqn < size && blockOfEqn[eqn] < 0) {
+	  blockOfEqn[eqn] = numBlocks;
+	  posInBlock[eqn] = numInBlock++;
+	  blockEqn.push_back(eqn);
+	}
+      }
+      if (numInBlock > 0) {
+	numBlocks++;
+	blockStart.push_back(int(blockEqn.size()));
+      }
+    }
+  }
+
+  for (int eqn=0; eqn<size; eqn++)
+    if (blockOfEqn[eqn] < 0) {
+      blockOfEqn[eqn] = numBlocks++;
+      blockEqn.push_back(eqn);
+      blockStart.push_back(int(blockEqn.size()));
+    }
+
+  blockValStart.resize(numBlocks+1);
+  blockValStart[0] = 0;
+  for (int b=0; b<numBlocks; b++) {
+    int nb = blockStart[b+1] - blockStart[b];
+    blockValStart[b+1] = blockValStart[b] + nb*nb;
+  }
+  blockVal.assign(blockValStart[numBlocks], 0.0);
+}
+
+int
+ElementByElementLinSOE::addA(const Matrix &m, const ID &id, double fact)
+{
+  // check for a quick return
+  if (fact == 0.0)  return 0;
+
+  int idSize = id.Size();
+  if (idSize != m.noRows() && idSize != m.noCols()) {
+    opserr << "ElementByElementLinSOE::addA() - Matrix and ID not of similar sizes\n";
+    return -1;
+  }
+
+  // the free equations of the matrix
+  localEqn.clear();
+  for (int i=0; i<idSize; i++) {
+    int pos = id(i);
+    if (pos >= 0 && pos < size)
+      localEqn.push_back(i);
+  }
+  int n = int(localEqn.size());
+  if (n == 0)
+    return 0;
+
+  for (int i=0; i<n; i++)
+    matEqn.push_back(id(localEqn[i]));
+  matStart.push_back(int(matEqn.size()));
+
+  size_t valStart = matVal.size();
+  matVal.resize(valStart + size_t(n)*n);
+  matValStart.push_back(matVal.size());
+  double *val = &matVal[valStart];
+
+  for (int j=0; j<n; j++) {
+    int col = localEqn[j];
+    int eqnJ = id(col);
+    int block = blockOfEqn[eqnJ];
+    int nb = blockStart[block+1] - blockStart[block];
+    double *blockCol = &blockVal[blockValStart[block] + nb*posInBlock[eqnJ]];
+    for (int i=0; i<n; i++) {
+      double value = m(localEqn[i], col)*fact;
+      *val++ = value;
+      int eqnI = id(localEqn[i]);
+      if (blockOfEqn[eqnI] == block)
+	blockCol[posInBlock[eqnI]] += value;
+    }
+  }
+
+  numMatrices++;
+  return 0;
+}
+
+
+int
+ElementByElementLinSOE::addB(const Vector &v, const ID &id, double fact)
+{
+  // check for a quick return
+  if (fact == 0.0)  return 0;
+
+  for (int i=0; i<id.Size(); i++) {
+    int pos = id(i);
+    if (pos <size && pos >= 0)
+      B[pos] += v(i) * fact;
+  }
+  return 0;
+}
+
+
+int
+ElementByElementLinSOE::setB(const Vector &v, double fact)
+{
+  // check for a quick return
+  if (fact == 0.0)  return 0;
+
+  if (v.Size() != size) {
+    opserr << "WARNING ElementByElementLinSOE::setB() -";
+    opserr << " incomptable sizes " << size << " and " << v.Size() << endln;
+    return -1;
+  }
+
+  for (int i=0; i<size; i++)
+    B[i] = v(i) * fact;
+
+  return 0;
+}
+
+void
+ElementByElementLinSOE::zeroA(void)
+{
+  // keep the storage, the same matrices come back with the next tangent
+  numMatrices = 0;
+  matStart.resize(1);
+  matEqn.clear();
+  matValStart.resize(1);
+  matVal.clear();
+
+  for (size_t i=0; i<blockVal.size(); i++)
+    blockVal[i] = 0.0;
+
+  isAfactored = false;
+}
+
+void
+ElementByElementLinSOE::zeroB(void)
+{
+  for (int i=0; i<size; i++)
+    B[i] = 0;
+}
+
+void
+ElementByElementLinSOE::multiply(const double *p, double *Ap)
+{
+  if (matWork.size() < matEqn.size())
+    matWork.resize(matEqn.size());
+  double *work = matWork.size() != 0 ? &matWork[0] : 0;
+
+  // the products of the matrices, in parallel, then their assembly
+#pragma omp parallel for schedule(dynamic, 64)
+  for (int e=0; e<numMatrices; e++) {
+    int start = matStart[e];
+    int n = matStart[e+1] - start;
+    const int *eqn = &matEqn[start];
+    const double *val = &matVal[matValStart[e]];
+    double *y = work + start;
+    for (int i=0; i<n; i++)
+      y[i] = 0.0;
+    for (int j=0; j<n; j++) {
+      double pj = p[eqn[j]];
+      if (pj != 0.0)
+	for (int i=0; i<n; i++)
+	  y[i] += val[i]*pj;
+      val += n;
+    }
+  }
+
+  for (int i=0; i<size; i++)
+    Ap[i] = 0.0;
+  int numEntries = int(matEqn.size());
+  for (int k=0; k<numEntries; k++)
+    Ap[matEqn[k]] += work[k];
+}
+
+int
+ElementByElementLinSOE::formAp(const Vector &p, Vector &Ap)
+{
+  if (p.Size() != size || Ap.Size() != size) {
+    opserr << "ElementByElementLinSOE::formAp -- vectors not of correct size\n";
+    return -1;
+  }
+  if (size == 0)
+    return 0;
+
+  std::vector<double> pData(size), ApData(size);
+  for (int i=0; i<size; i++)
+    pData[i] = p(i);
+  this->multiply(&pData[0], &ApData[0]);
+  for (int i=0; i<size; i++)
+    Ap(i) = ApData[i];
+  return 0;
+}
+
+void
+ElementByElementLinSOE::setX(int loc, double value)
+{
+  if (loc < size && loc >=0)
+    X[loc] = value;
+}
+
+void
+ElementByElementLinSOE::setX(const Vector &x)
+{
+  if (x.Size() == size && vectX != 0)
+    *vectX = x;
+}
+
+const Vector &
+ElementByElementLinSOE::getX(void)
+{
+  if (vectX == 0) {
+    opserr << "FATAL ElementByElementLinSOE::getX - vectX == 0";
+    exit(-1);
+  }
+  return *vectX;
+}
+
+const Vector &
+ElementByElementLinSOE::getB(void)
+{
+  if (vectB == 0) {
+    opserr << "FATAL ElementByElementLinSOE::getB - vectB == 0";
+    exit(-1);
+  }
+  return *vectB;
+}
+
+double
+ElementByElementLinSOE::normRHS(void)
+{
+  double norm =0.0;
+  for (int i=0; i<size; i++) {
+    double Yi = B[i];
+    norm += Yi*Yi;
+  }
+  return sqrt(norm);
+}
+
+
+int
+ElementByElementLinSOE::setElementByElementSolver(ElementByElementSolver &newSolver)
+{
+  newSolver.setLinearSOE(*this);
+
+  if (size != 0) {
+    int solverOK = newSolver.setSize();
+    if (solverOK < 0) {
+      opserr << "WARNING:ElementByElementLinSOE::setSolver :";
+      opserr << "the new solver could not setSeize() - staying with old\n";
+      return -1;
+    }
+  }
+
+  return this->setSolver(newSolver);
+}
+
+
+int
+ElementByElementLinSOE::sendSelf(int cTag, Channel &theChannel)
+{
+  // the element matrices are numbered by the local analysis model, they are not sent
+  opserr << "ElementByElementLinSOE::sendSelf() - not available in a parallel run\n";
+  return -1;
+}
+
+
+int
+ElementByElementLinSOE::recvSelf(int cTag, Channel &theChannel, FEM_ObjectBroker &theBroker)
+{
+  opserr << "ElementByElementLinSOE::recvSelf() - not available in a parallel run\n";
+  return -1;
+}
@@ -0,0 +1,105 @@
+/* ****************************************************************** **
+**    OpenSees - Open System for Earthquake Engineering Simulation    **
+**          Pacific Earthquake Engineering Research Center            **
+**                                                                    **
+**                                                                    **
+** (C) Copyright 1999, The Regents of the University of California    **
+** All Rights Reserved.                                               **
+**                                                                    **
+** Commercial use of this program without express permission of the   **
+** University of California, Berkeley, is strictly prohibited.  See   **
+** file 'COPYRIGHT'  in main directory for information on usage and   **
+** redistribution,  and for a DISCLAIMER OF ALL WARRANTIES.           **
+**                                                                    **
+** Developed by:                                                      **
+**   Frank McKenna (fmckenna@ce.berkeley.edu)                         **
+**   Gregory L. Fenves (fenves@ce.berkeley.edu)                       **
+**   Filip C. Filippou (filippou@ce.berkeley.edu)                     **
+**                                                                    **
+** ****************************************************************** */
+
+#ifndef ElementByElementLinSOE_h
+#define ElementByElementLinSOE_h
+
+// Description: This file contains the class definition for
+// ElementByElementLinSOE. ElementByElementLinSOE is a subclass of
+// LinearSOE that never assembles A: the matrices passed to addA() by
+// the integrator are kept as they are, over their free equations, and
+// A*p is formed element by element. The memory needed grows with the
+// number of elements and not with the fill-in of a factorization.
+//
+// The diagonal blocks of A, one per DOF_Group, are assembled as the
+// element matrices are added so that a Jacobi or block Jacobi
+// preconditioner can be formed without A.
+
+#include <LinearSOE.h>
+#include <Vector.h>
+#include <vector>
+
+class ElementByElementSolver;
+
+class ElementByElementLinSOE : public LinearSOE
+{
+  public:
+    ElementByElementLinSOE(ElementByElementSolver &theSolver);
+    ~ElementByElementLinSOE();
+
+    int getNumEqn(void) const;
+    int setSize(Graph &theGraph);
+    int addA(const Matrix &, const ID &, double fact = 1.0);
+    int addB(const Vector &, const ID &, double fact = 1.0);
+    int setB(const Vector &, double fact = 1.0);
+
+    void zeroA(void);
+    void zeroB(void);
+
+    int formAp(const Vector &p, Vector &Ap);
+
+    void setX(int loc, double value);
+    void setX(const Vector &x);
+
+    const Vector &getX(void);
+    const Vector &getB(void);
+    double normRHS(void);
+
+    int getNumMatrices(void) const;
+
+    int setElementByElementSolver(ElementByElementSolver &newSolver);
+
+    int sendSelf(int commitTag, Channel &theChannel);
+    int recvSelf(int commitTag, Channel &theChannel, FEM_ObjectBroker &theBroker);
+
+    friend class ElementByElementSolver;
+
+  protected:
+
+  private:
+    void multiply(const double *p, double *Ap);
+    void setBlocks(void);
+
+    int size;
+    double *B, *X;
+    Vector *vectX;
+    Vector *vectB;
+    bool isAfactored;          // false until the solver has seen the new A
+
+    // the matrices added, each stored by column over its free equations
+    int numMatrices;
+    std::vector<int> matStart;      // first entry of each in matEqn
+    std::vector<int> matEqn;        // the equations of the matrices
+    std::vector<size_t> matValStart;// first entry of each in matVal
+    std::vector<double> matVal;
+    std::vector<double> matWork;    // the products of the matrices with p
+    std::vector<int> localEqn;
+
+    // the diagonal blocks, stored by column
+    int numBlocks;
+    std::vector<int> blockOfEqn;    // block of each equation
+    std::vector<int> posInBlock;    // position of each equation in its block
+    std::vector<int> blockStart;    // first equation of each block in blockEqn
+    std::vector<int> blockEqn;
+    std::vector<int> blockValStart; // first entry of each block in blockVal
+    std::vector<double> blockVal;
+};
+
+#endif
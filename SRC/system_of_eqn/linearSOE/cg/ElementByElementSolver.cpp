@@ -0,0 +1,519 @@
+/* ****************************************************************** **
+**    OpenSees - Open System for Earthquake Engineering Simulation    **
+**          Pacific Earthquake Engineering Research Center            **
+**                                                                    **
+**                                                                    **
+** (C) Copyright 1999, The Regents of the University of California    **
+** All Rights Reserved.                                               **
+**                                                                    **
+** Commercial use of this program without express permission of the   **
+** University of California, Berkeley, is strictly prohibited.  See   **
+** file 'COPYRIGHT'  in main directory for information on usage and   **
+** redistribution,  and for a DISCLAIMER OF ALL WARRANTIES.           **
+**                                                                    **
+** Developed by:                                                      **
+**   Frank McKenna (fmckenna@ce.berkeley.edu)                         **
+**   Gregory L. Fenves (fenves@ce.berkeley.edu)                       **
+**   Filip C. Filippou (filippou@ce.berkeley.edu)                     **
+**                                                                    **
+** ****************************************************************** */
+
+// Description: This file contains the implementation for
+// ElementByElementSolver.
+
+#include <ElementByElementSolver.h>
+#include <ElementByElementLinSOE.h>
+#include <Vector.h>
+#include <Channel.h>
+#include <FEM_ObjectBroker.h>
+#include <elementAPI.h>
+
+#include <math.h>
+#include <string.h>
+
+void* OPS_ElementByElementSolver()
+{
+  int method = ElementByElementSolver::CG;
+  int preconditioner = ElementByElementSolver::Block;
+  double tol = 1.0e-8;
+  int maxIter = 1000;
+  int restart = 50;
+  bool printIter = false;
+
+  int numData = 1;
+  while (OPS_GetNumRemainingInputArgs() > 0) {
+    const char *opt = OPS_GetString();
+
+    if (strcmp(opt, "-print") == 0) {
+      printIter = true;
+      continue;
+    }
+
+    if (OPS_GetNumRemainingInputArgs() < 1) {
+      opserr << "WARNING system ElementByElement - no value given for " << opt << "\n";
+      return 0;
+    }
+
+    if (strcmp(opt, "-solver") == 0) {
+      const char *type = OPS_GetString();
+      if (strcmp(type, "cg") == 0 || strcmp(type, "CG") == 0 || strcmp(type, "pcg") == 0)
+	method = ElementByElementSolver::CG;
+      else if (strcmp(type, "gmres") == 0 || strcmp(type, "GMRES") == 0)
+	method = ElementByElementSolver::GMRES;
+      else {
+	opserr << "WARNING system ElementByElement - unknown solver " << type << ", want cg or gmres\n";
+	return 0;
+      }
+    } else if (strcmp(opt, "-pre") == 0) {
+      const char *type = OPS_GetString();
+      if (strcmp(type, "none") == 0)
+	preconditioner = ElementByElementSolver::None;
+      else if (strcmp(type, "jacobi") == 0 || strcmp(type, "diagonal") == 0)
+	preconditioner = ElementByElementSolver::Jacobi;
+      else if (strcmp(type, "block") == 0 || strcmp(type, "blockJacobi") == 0)
+	preconditioner = ElementByElementSolver::Block;
+      else {
+	opserr << "WARNING system ElementByElement - unknown preconditioner " << type << ", want none, jacobi or block\n";
+	return 0;
+      }
+    } else if (strcmp(opt, "-tol") == 0) {
+      if (OPS_GetDoubleInput(numData, &tol) < 0) {
+	opserr << "WARNING system ElementByElement - invalid tol\n";
+	return 0;
+      }
+    } else if (strcmp(opt, "-maxIter") == 0) {
+      if (OPS_GetIntInput(numData, &maxIter) < 0) {
+	opserr << "WARNING system ElementByElement - invalid maxIter\n";
+	return 0;
+      }
+    } else if (strcmp(opt, "-restart") == 0) {
+      if (OPS_GetIntInput(numData, &restart) < 0) {
+	opserr << "WARNING system ElementByElement - invalid restart\n";
+	return 0;
+      }
+    } else {
+      opserr << "WARNING system ElementByElement - unknown option " << opt << "\n";
+      return 0;
+    }
+  }
+
+  ElementByElementSolver *theSolver =
+    new ElementByElementSolver(method, preconditioner, tol, maxIter, restart, printIter);
+  return new ElementByElementLinSOE(*theSolver);
+}
+
+
+// vector operations
+static double
+dot(int n, const double *a, const double *b)
+{
+  double sum = 0.0;
+#pragma omp parallel for reduction(+:sum)
+  for (int i=0; i<n; i++)
+    sum += a[i]*b[i];
+  return sum;
+}
+
+static void
+axpy(int n, double alpha, const double *x, double *y)
+{
+#pragma omp parallel for
+  for (int i=0; i<n; i++)
+    y[i] += alpha*x[i];
+}
+
+
+ElementByElementSolver::ElementByElementSolver(int meth, int precond,
+					       double tolerance, int max,
+					       int restrt, bool print)
+:LinearSOESolver(SOLVER_TAGS_ElementByElementSolver),
+ theSOE(0), method(meth), preconditioner(precond), tol(tolerance),
+ maxIter(max), restart(restrt), printIter(print), numIter(0), residual(0.0)
+{
+  if (restart < 1)
+    restart = 1;
+}
+
+ElementByElementSolver::~ElementByElementSolver()
+{
+
+}
+
+int
+ElementByElementSolver::setLinearSOE(ElementByElementLinSOE &theEBESOE)
+{
+  theSOE = &theEBESOE;
+  return 0;
+}
+
+int
+ElementByElementSolver::setSize(void)
+{
+  return 0;
+}
+
+int
+ElementByElementSolver::getNumIterations(void) const
+{
+  return numIter;
+}
+
+void
+ElementByElementSolver::formPreconditioner(void)
+{
+  int numBlocks = theSOE->numBlocks;
+  const std::vector<double> &blockVal = theSOE->blockVal;
+  const std::vector<int> &blockValStart = theSOE->blockValStart;
+  const std::vector<int> &blockStart = theSOE->blockStart;
+
+  blockInv.assign(blockVal.size(), 0.0);
+
+#pragma omp parallel for schedule(dynamic, 256)
+  for (int b=0; b<numBlocks; b++) {
+    int nb = blockStart[b+1] - blockStart[b];
+    const double *a = &blockVal[blockValStart[b]];
+    double *inv = &blockInv[blockValStart[b]];
+
+    bool singular = false;
+    if (preconditioner == Block && nb > 1) {
+
+      // Gauss-Jordan with partial pivoting, on a copy of the block
+      double lu[64*64];
+      if (nb > 64)
+	singular = true;
+      else {
+	for (int k=0; k<nb*nb; k++) {
+	  lu[k] = a[k];
+	  inv[k] = 0.0;
+	}
+	for (int i=0; i<nb; i++)
+	  inv[i*nb+i] = 1.0;
+
+	double scale = 0.0;
+	for (int k=0; k<nb*nb; k++)
+	  if (fabs(a[k]) > scale)
+	    scale = fabs(a[k]);
+
+	for (int k=0; k<nb && singular == false; k++) {
+	  int p = k;
+	  for (int i=k+1; i<nb; i++)
+	    if (fabs(lu[k*nb+i]) > fabs(lu[k*nb+p]))
+	      p = i;
+	  if (fabs(lu[k*nb+p]) <= 1.0e-14*scale) {
+	    singular = true;
+	    break;
+	  }
+	  if (p != k)
+	    for (int j=0; j<nb; j++) {
+	      double tmp = lu[j*nb+k]; lu[j*nb+k] = lu[j*nb+p]; lu[j*nb+p] = tmp;
+	      tmp = inv[j*nb+k]; inv[j*nb+k] = inv[j*nb+p]; inv[j*nb+p] = tmp;
+	    }
+	  double pivot = 1.0/lu[k*nb+k];
+	  for (int j=0; j<nb; j++) {
+	    lu[j*nb+k] *= pivot;
+	    inv[j*nb+k] *= pivot;
+	  }
+	  for (int i=0; i<nb; i++) {
+	    if (i == k)
+	      continue;
+	    double f = lu[k*nb+i];
+	    if (f != 0.0)
+	      for (int j=0; j<nb; j++) {
+		lu[j*nb+i] -= f*lu[j*nb+k];
+		inv[j*nb+i] -= f*inv[j*nb+k];
+	      }
+	  }
+	}
+      }
+    }
+
+    // Jacobi, also for the blocks that could not be inverted
+    if (preconditioner != Block || nb == 1 || singular == true) {
+      for (int k=0; k<nb*nb; k++)
+	inv[k] = 0.0;
+      for (int i=0; i<nb; i++) {
+	double d = a[i*nb+i];
+	inv[i*nb+i] = (d != 0.0) ? 1.0/d : 1.0;
+      }
+    }
+  }
+}
+
+void
+ElementByElementSolver::precondition(const double *r, double *z)
+{
+  int n = theSOE->size;
+  if (preconditioner == None) {
+    for (int i=0; i<n; i++)
+      z[i] = r[i];
+    return;
+  }
+
+  int numBlocks = theSOE->numBlocks;
+  const int *blockStart = &theSOE->blockStart[0];
+  const int *blockEqn = &theSOE->blockEqn[0];
+  const int *blockValStart = &theSOE->blockValStart[0];
+
+#pragma omp parallel for schedule(dynamic, 256)
+  for (int b=0; b<numBlocks; b++) {
+    int nb = blockStart[b+1] - blockStart[b];
+    const int *eqn = blockEqn + blockStart[b];
+    const double *inv = &blockInv[blockValStart[b]];
+    for (int i=0; i<nb; i++) {
+      double sum = 0.0;
+      for (int j=0; j<nb; j++)
+	sum += inv[j*nb+i]*r[eqn[j]];
+      z[eqn[i]] = sum;
+    }
+  }
+}
+
+int
+ElementByElementSolver::solve(void)
+{
+  if (theSOE == 0) {
+    opserr << "WARNING ElementByElementSolver::solve() - no LinearSOE has been set\n";
+    return -1;
+  }
+
+  int n = theSOE->size;
+  if (n == 0)
+    return 0;
+
+  if (theSOE->isAfactored == false) {
+    if (preconditioner != None)
+      this->formPreconditioner();
+    theSOE->isAfactored = true;
+  }
+
+  double *x = theSOE->X;
+  const double *b = theSOE->B;
+  for (int i=0; i<n; i++)
+    x[i] = 0.0;
+  numIter = 0;
+  residual = 0.0;
+
+  if (dot(n, b, b) == 0.0)
+    return 0;
+
+  int result = (method == GMRES) ? this->solveGMRES() : this->solveCG();
+
+  if (printIter == true)
+    opserr << "ElementByElementSolver::solve() - " << numIter
+	   << " iterations, relative residual " << residual << endln;
+
+  if (result < 0)
+    opserr << "WARNING ElementByElementSolver::solve() - no convergence in " << numIter
+	   << " iterations, relative residual " << residual << endln;
+
+  return result;
+}
+
+int
+ElementByElementSolver::solveCG(void)
+{
+  int n = theSOE->size;
+  double *x = theSOE->X;
+  const double *b = theSOE->B;
+
+  work.resize(4*size_t(n));
+  double *r = &work[0];
+  double *z = r + n;
+  double *p = z + n;
+  double *q = p + n;
+
+  for (int i=0; i<n; i++)
+    r[i] = b[i];
+  double normB = sqrt(dot(n, b, b));
+
+  this->precondition(r, z);
+  for (int i=0; i<n; i++)
+    p[i] = z[i];
+  double rz = dot(n, r, z);
+
+  for (numIter=1; numIter<=maxIter; numIter++) {
+    theSOE->multiply(p, q);
+    double pq = dot(n, p, q);
+    if (pq == 0.0)
+      break;
+
+    double alpha = rz/pq;
+    axpy(n, alpha, p, x);
+    axpy(n, -alpha, q, r);
+
+    residual = sqrt(dot(n, r, r))/normB;
+    if (residual <= tol)
+      return 0;
+
+    this->precondition(r, z);
+    double rzNew = dot(n, r, z);
+    double beta = rzNew/rz;
+    rz = rzNew;
+
+#pragma omp parallel for
+    for (int i=0; i<n; i++)
+      p[i] = z[i] + beta*p[i];
+  }
+
+  if (numIter > maxIter)
+    numIter = maxIter;
+  return -1;
+}
+
+int
+ElementByElementSolver::solveGMRES(void)
+{
+  int n = theSOE->size;
+  double *x = theSOE->X;
+  const double *b = theSOE->B;
+  int m = restart;
+
+  // the Krylov basis, then two more vectors
+  work.resize((m+3)*size_t(n));
+  double *V = &work[0];
+  double *z = V + (m+1)*size_t(n);
+  double *u = z + n;
+
+  std::vector<double> H((m+1)*m);
+  std::vector<double> cs(m), sn(m), g(m+1), yk(m);
+
+  double normB = sqrt(dot(n, b, b));
+
+  // r = b for x = 0
+  for (int i=0; i<n; i++)
+    V[i] = b[i];
+  double beta = normB;
+
+  numIter = 0;
+  while (numIter < maxIter) {
+
+    double s = 1.0/beta;
+    for (int i=0; i<n; i++)
+      V[i] *= s;
+    for (int i=0; i<=m; i++)
+      g[i] = 0.0;
+    g[0] = beta;
+
+    int j = 0;
+    bool converged = false;
+    for (j=0; j<m && numIter<maxIter; j++) {
+      numIter++;
+      double *vj = V + j*size_t(n);
+      double *vj1 = vj + n;
+
+      this->precondition(vj, z);
+      theSOE->multiply(z, vj1);
+
+      // modified Gram-Schmidt
+      for (int i=0; i<=j; i++) {
+	double *vi = V + i*size_t(n);
+	double h = dot(n, vi, vj1);
+	H[i*m+j] = h;
+	axpy(n, -h, vi, vj1);
+      }
+      double h = sqrt(dot(n, vj1, vj1));
+      H[(j+1)*m+j] = h;
+      if (h != 0.0) {
+	double sh = 1.0/h;
+	for (int i=0; i<n; i++)
+	  vj1[i] *= sh;
+      }
+
+      // the previous rotations, then a new one for the column
+      for (int i=0; i<j; i++) {
+	double hi = H[i*m+j];
+	double hi1 = H[(i+1)*m+j];
+	H[i*m+j] = cs[i]*hi + sn[i]*hi1;
+	H[(i+1)*m+j] = -sn[i]*hi + cs[i]*hi1;
+      }
+      double hjj = H[j*m+j];
+      double hj1 = H[(j+1)*m+j];
+      double rho = sqrt(hjj*hjj + hj1*hj1);
+      if (rho == 0.0) {
+	cs[j] = 1.0;
+	sn[j] = 0.0;
+      } else {
+	cs[j] = hjj/rho;
+	sn[j] = hj1/rho;
+      }
+      H[j*m+j] = rho;
+      H[(j+1)*m+j] = 0.0;
+      g[j+1] = -sn[j]*g[j];
+      g[j] = cs[j]*g[j];
+
+      residual = fabs(g[j+1])/normB;
+      if (residual <= tol || h == 0.0) {
+	converged = true;
+	j++;
+	break;
+      }
+    }
+
+    // x += inv(M) V y with H y = g
+    for (int i=j-1; i>=0; i--) {
+      double sum = g[i];
+      for (int k=i+1; k<j; k++)
+	sum -= H[i*m+k]*yk[k];
+      yk[i] = (H[i*m+i] != 0.0) ? sum/H[i*m+i] : 0.0;
+    }
+    for (int i=0; i<n; i++)
+      u[i] = 0.0;
+    for (int k=0; k<j; k++)
+      axpy(n, yk[k], V + k*size_t(n), u);
+    this->precondition(u, z);
+    axpy(n, 1.0, z, x);
+
+    // the true residual for the restart
+    theSOE->multiply(x, V);
+#pragma omp parallel for
+    for (int i=0; i<n; i++)
+      V[i] = b[i] - V[i];
+    beta = sqrt(dot(n, V, V));
+    residual = beta/normB;
+
+    if (converged == true || residual <= tol)
+      return (residual <= 10.0*tol) ? 0 : -1;
+    if (beta == 0.0)
+      return 0;
+  }
+
+  return -1;
+}
+
+int
+ElementByElementSolver::sendSelf(int cTag, Channel &theChannel)
+{
+  static Vector data(6);
+  data(0) = method;
+  data(1) = preconditioner;
+  data(2) = tol;
+  data(3) = maxIter;
+  data(4) = restart;
+  data(5) = printIter ? 1 : 0;
+
+  if (theChannel.sendVector(this->getDbTag(), cTag, data) < 0) {
+    opserr << "ElementByElementSolver::sendSelf() - failed to send data\n";
+    return -1;
+  }
+  return 0;
+}
+
+int
+ElementByElementSolver::recvSelf(int cTag, Channel &theChannel,
+				 FEM_ObjectBroker &theBroker)
+{
+  static Vector data(6);
+  if (theChannel.recvVector(this->getDbTag(), cTag, data) < 0) {
+    opserr << "ElementByElementSolver::recvSelf() - failed to receive data\n";
+    return -1;
+  }
+
+  method = int(data(0));
+  preconditioner = int(data(1));
+  tol = data(2);
+  maxIter = int(data(3));
+  restart = int(data(4));
+  printIter = (data(5) != 0.0);
+
+  return 0;
+}
@@ -0,0 +1,87 @@
+/* ****************************************************************** **
+**    OpenSees - Open System for Earthquake Engineering Simulation    **
+**          Pacific Earthquake Engineering Research Center            **
+**                                                                    **
+**                                                                    **
+** (C) Copyright 1999, The Regents of the University of California    **
+** All Rights Reserved.                                               **
+**                                                                    **
+** Commercial use of this program without express permission of the   **
+** University of California, Berkeley, is strictly prohibited.  See   **
+** file 'COPYRIGHT'  in main directory for information on usage and   **
+** redistribution,  and for a DISCLAIMER OF ALL WARRANTIES.           **
+**                                                                    **
+** Developed by:                                                      **
+**   Frank McKenna (fmckenna@ce.berkeley.edu)                         **
+**   Gregory L. Fenves (fenves@ce.berkeley.edu)                       **
+**   Filip C. Filippou (filippou@ce.berkeley.edu)                     **
+**                                                                    **
+** ****************************************************************** */
+
+#ifndef ElementByElementSolver_h
+#define ElementByElementSolver_h
+
+// Description: This file contains the class definition for
+// ElementByElementSolver. ElementByElementSolver is a subclass of
+// LinearSOESolver that solves an ElementByElementLinSOE with a Krylov
+// method, using only products of A with a vector:
+//
+//   CG    - preconditioned conjugate gradients, for symmetric A
+//   GMRES - restarted GMRES, right preconditioned, for any A
+//
+// The preconditioner is none, Jacobi, or block Jacobi on the diagonal
+// blocks of the DOF_Groups.
+//
+//   system ElementByElement <-solver cg|gmres> <-pre none|jacobi|block>
+//                           <-tol tol> <-maxIter n> <-restart m> <-print>
+
+#include <LinearSOESolver.h>
+#include <vector>
+
+class ElementByElementLinSOE;
+
+class ElementByElementSolver : public LinearSOESolver
+{
+  public:
+    enum Method {CG = 0, GMRES};
+    enum Preconditioner {None = 0, Jacobi, Block};
+
+    ElementByElementSolver(int method = CG, int preconditioner = Block,
+			   double tol = 1.0e-8, int maxIter = 1000,
+			   int restart = 50, bool printIter = false);
+    ~ElementByElementSolver();
+
+    int solve(void);
+    int setSize(void);
+    int setLinearSOE(ElementByElementLinSOE &theSOE);
+
+    int getNumIterations(void) const;
+
+    int sendSelf(int commitTag, Channel &theChannel);
+    int recvSelf(int commitTag, Channel &theChannel,
+		 FEM_ObjectBroker &theBroker);
+
+  protected:
+
+  private:
+    void formPreconditioner(void);
+    void precondition(const double *r, double *z);
+    int solveCG(void);
+    int solveGMRES(void);
+
+    ElementByElementLinSOE *theSOE;
+
+    int method;
+    int preconditioner;
+    double tol;
+    int maxIter;
+    int restart;
+    bool printIter;
+
+    std::vector<double> blockInv;   // inverses of the diagonal blocks
+    int numIter;
+    double residual;
+    std::vector<double> work;
+};
+
+#endif
@@ -85,6 +85,31 @@ FullGenLinLapackSolver::solve(void)
     // check for quick return
     if (n == 0)
 	return 0;
+
+    double *Xptr = theSOE->X;
+    double *Bptr = theSOE->B;
+    
+    // first copy B into X
+    for (int i=0; i<n; i++)
+	*(Xptr++) = *(Bptr++);
+
+    return this->solveMultiple(theSOE->X, 1);
+}
+
+int
+FullGenLinLapackSolver::solveMultiple(double *X, int nrhs)
+{
+    if (theSOE == 0) {
+	opserr << "WARNING FullGenLinLapackSolver::solve(void)- ";
+	opserr << " No LinearSOE object has been set\n";
+	return -1;
+    }
+    
+    int n = theSOE->size;
+    
+    // check for quick return
+    if (n == 0 || nrhs == 0)
+	return 0;
     
     // check iPiv is large enough
     if (sizeIpiv < n) {
@@ -94,20 +119,13 @@ FullGenLinLapackSolver::solve(void)
     }	
 	
     int ldA = n;
-    int nrhs = 1;
     int ldB = n;
     int info;
     double *Aptr = theSOE->A;
-    double *Xptr = theSOE->X;
-    double *Bptr = theSOE->B;
+    double *Xptr = X;
     int *iPIV = iPiv;
-    
-    // first copy B into X
-    for (int i=0; i<n; i++)
-	*(Xptr++) = *(Bptr++);
-    Xptr = theSOE->X;
 
-    // now solve AX = Y
+    // now solve AX = Y, the columns of X hold the right-hand sides
 
 #ifdef _WIN32
     {if (theSOE->factored == false)  
@@ -47,6 +47,8 @@ class FullGenLinLapackSolver : public FullGenLinSolver
     ~FullGenLinLapackSolver();
 
     int solve(void);
+    bool supportsMultipleRHS(void) {return true;};
+    int solveMultiple(double *X, int nrhs);
     int setSize(void);
     
     int sendSelf(int commitTag, Channel &theChannel);
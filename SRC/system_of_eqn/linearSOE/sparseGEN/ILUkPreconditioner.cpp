@@ -0,0 +1,226 @@
+/* ****************************************************************** **
+**    OpenSees - Open System for Earthquake Engineering Simulation    **
+**          Pacific Earthquake Engineering Research Center            **
+**                                                                    **
+**                                                                    **
+** (C) Copyright 1999, The Regents of the University of California    **
+** All Rights Reserved.                                               **
+**                                                                    **
+** Commercial use of this program without express permission of the   **
+** University of California, Berkeley, is strictly prohibited.  See   **
+** file 'COPYRIGHT'  in main directory for information on usage and   **
+** redistribution,  and for a DISCLAIMER OF ALL WARRANTIES.           **
+**                                                                    **
+** Developed by:                                                      **
+**   Frank McKenna (fmckenna@ce.berkeley.edu)                         **
+**   Gregory L. Fenves (fenves@ce.berkeley.edu)                       **
+**   Filip C. Filippou (filippou@ce.berkeley.edu)                     **
+**                                                                    **
+** ****************************************************************** */
+
+// Description: This file contains the implementation of
+// ILUkPreconditioner.
+
+#include <ILUkPreconditioner.h>
+#include <OPS_Globals.h>
+
+#include <math.h>
+#include <vector>
+
+ILUkPreconditioner::ILUkPreconditioner(int fill)
+:KrylovPreconditioner(), levelOfFill(fill), size(0),
+ luRowStart(0), luCol(0), luDiag(0), luA(0), luSize(0),
+ marker(0)
+{
+  if (levelOfFill < 0)
+    levelOfFill = 0;
+}
+
+ILUkPreconditioner::~ILUkPreconditioner()
+{
+  if (luRowStart != 0) delete [] luRowStart;
+  if (luCol != 0) delete [] luCol;
+  if (luDiag != 0) delete [] luDiag;
+  if (luA != 0) delete [] luA;
+  if (marker != 0) delete [] marker;
+}
+
+int
+ILUkPreconditioner::symbolic(int n, const int *rowStart, const int *colA)
+{
+  // the columns of the current row are kept in a sorted linked list,
+  // with n as its head, together with their level of fill
+  std::vector<int> next(n+1);
+  std::vector<int> level(n, 0);
+
+  std::vector<int> rowPtr(n+1);
+  std::vector<int> cols;
+  std::vector<int> levels;
+  cols.reserve(rowStart[n]);
+  levels.reserve(rowStart[n]);
+
+  rowPtr[0] = 0;
+  for (int i=0; i<n; i++) {
+
+    // the entries of A, and the diagonal in case it is missing
+    int prev = n;
+    bool hasDiag = false;
+    for (int k=rowStart[i]; k<rowStart[i+1]; k++) {
+      int col = colA[k];
+      if (col > i && hasDiag == false) {
+	next[prev] = i; level[i] = 0; prev = i;
+	hasDiag = true;
+      }
+      if (col == i)
+	hasDiag = true;
+      next[prev] = col; level[col] = 0; prev = col;
+    }
+    if (hasDiag == false) {
+      next[prev] = i; level[i] = 0; prev = i;
+    }
+    next[prev] = -1;
+
+    // fill from the rows above
+    if (levelOfFill > 0) {
+      for (int k = next[n]; k != -1 && k < i; k = next[k]) {
+	int levelK = level[k];
+	int pos = k;
+	for (int q=rowPtr[k]; q<rowPtr[k+1]; q++) {
+	  int j = cols[q];
+	  if (j <= k)
+	    continue;
+	  int newLevel = levelK + levels[q] + 1;
+	  if (newLevel > levelOfFill)
+	    continue;
+	  while (next[pos] != -1 && next[pos] < j)
+	    pos = next[pos];
+	  if (next[pos] == j) {
+	    if (newLevel < level[j])
+	      level[j] = newLevel;
+	  } else {
+	    next[j] = next[pos];
+	    next[pos] = j;
+	    level[j] = newLevel;
+	  }
+	  pos = j;
+	}
+      }
+    }
+
+    for (int col = next[n]; col != -1; col = next[col]) {
+      cols.push_back(col);
+      levels.push_back(level[col]);
+    }
+    rowPtr[i+1] = int(cols.size());
+  }
+
+  // now copy into the arrays of the factors
+  if (luRowStart != 0) delete [] luRowStart;
+  if (luDiag != 0) delete [] luDiag;
+  if (marker != 0) delete [] marker;
+  if (int(cols.size()) > luSize) {
+    if (luCol != 0) delete [] luCol;
+    if (luA != 0) delete [] luA;
+    luSize = int(cols.size());
+    luCol = new int[luSize];
+    luA = new double[luSize];
+  }
+  luRowStart = new int[n+1];
+  luDiag = new int[n];
+  marker = new int[n];
+
+  for (int i=0; i<=n; i++)
+    luRowStart[i] = rowPtr[i];
+  for (int i=0; i<n; i++) {
+    marker[i] = -1;
+    for (int p=rowPtr[i]; p<rowPtr[i+1]; p++) {
+      luCol[p] = cols[p];
+      if (cols[p] == i)
+	luDiag[i] = p;
+    }
+  }
+
+  size = n;
+  return 0;
+}
+
+int
+ILUkPreconditioner::build(int n, const int *rowStart, const int *colA,
+			  const double *A, bool newPattern)
+{
+  if (newPattern == true || n != size || luRowStart == 0)
+    if (this->symbolic(n, rowStart, colA) < 0)
+      return -1;
+
+  int numSmallPivots = 0;
+
+  for (int i=0; i<n; i++) {
+    int start = luRowStart[i];
+    int end = luRowStart[i+1];
+
+    // scatter the row of A into the pattern of the factors
+    for (int p=start; p<end; p++) {
+      marker[luCol[p]] = p;
+      luA[p] = 0.0;
+    }
+    double rowMax = 0.0;
+    for (int k=rowStart[i]; k<rowStart[i+1]; k++) {
+      luA[marker[colA[k]]] += A[k];
+      if (fabs(A[k]) > rowMax)
+	rowMax = fabs(A[k]);
+    }
+
+    // eliminate with the rows above, in increasing order
+    for (int p=start; p<luDiag[i]; p++) {
+      int k = luCol[p];
+      double lik = luA[p] / luA[luDiag[k]];
+      luA[p] = lik;
+      for (int q=luDiag[k]+1; q<luRowStart[k+1]; q++) {
+	int loc = marker[luCol[q]];
+	if (loc >= 0)
+	  luA[loc] -= lik*luA[q];
+      }
+    }
+
+    // keep the pivot away from zero
+    double &pivot = luA[luDiag[i]];
+    double minPivot = 1.0e-12*rowMax;
+    if (minPivot == 0.0)
+      minPivot = 1.0e-12;
+    if (fabs(pivot) < minPivot) {
+      pivot = (pivot < 0.0) ? -minPivot : minPivot;
+      numSmallPivots++;
+    }
+
+    for (int p=start; p<end; p++)
+      marker[luCol[p]] = -1;
+  }
+
+  if (numSmallPivots != 0)
+    opserr << "WARNING ILUkPreconditioner::build() - " << numSmallPivots
+	   << " small pivots replaced\n";
+
+  return 0;
+}
+
+int
+ILUkPreconditioner::apply(const double *r, double *z)
+{
+  // forward substitution with L, unit diagonal
+  for (int i=0; i<size; i++) {
+    double sum = r[i];
+    for (int p=luRowStart[i]; p<luDiag[i]; p++)
+      sum -= luA[p]*z[luCol[p]];
+    z[i] = sum;
+  }
+
+  // backward substitution with U
+  for (int i=size-1; i>=0; i--) {
+    double sum = z[i];
+    for (int p=luDiag[i]+1; p<luRowStart[i+1]; p++)
+      sum -= luA[p]*z[luCol[p]];
+    z[i] = sum/luA[luDiag[i]];
+  }
+
+  return 0;
+}
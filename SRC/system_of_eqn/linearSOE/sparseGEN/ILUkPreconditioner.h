@@ -0,0 +1,61 @@
+/* ****************************************************************** **
+**    OpenSees - Open System for Earthquake Engineering Simulation    **
+**          Pacific Earthquake Engineering Research Center            **
+**                                                                    **
+**                                                                    **
+** (C) Copyright 1999, The Regents of the University of California    **
+** All Rights Reserved.                                               **
+**                                                                    **
+** Commercial use of this program without express permission of the   **
+** University of California, Berkeley, is strictly prohibited.  See   **
+** file 'COPYRIGHT'  in main directory for information on usage and   **
+** redistribution,  and for a DISCLAIMER OF ALL WARRANTIES.           **
+**                                                                    **
+** Developed by:                                                      **
+**   Frank McKenna (fmckenna@ce.berkeley.edu)                         **
+**   Gregory L. Fenves (fenves@ce.berkeley.edu)                       **
+**   Filip C. Filippou (filippou@ce.berkeley.edu)                     **
+**                                                                    **
+** ****************************************************************** */
+
+#ifndef ILUkPreconditioner_h
+#define ILUkPreconditioner_h
+
+// Description: This file contains the class definition for
+// ILUkPreconditioner. ILUkPreconditioner is a KrylovPreconditioner
+// holding the incomplete LU factorization of A with level of fill k:
+// an entry is kept in the factors if it is in A or is created by fill
+// of level at most k. The symbolic factorization is done only when the
+// pattern of A changes. For a symmetric matrix the factors are
+// U = D L^T, i.e. the incomplete Cholesky factorization, and the
+// preconditioner is symmetric as needed by PCG and MINRES.
+
+#include <KrylovPreconditioner.h>
+
+class ILUkPreconditioner : public KrylovPreconditioner
+{
+  public:
+    ILUkPreconditioner(int levelOfFill = 0);
+    ~ILUkPreconditioner();
+
+    int build(int n, const int *rowStart, const int *colA,
+	      const double *A, bool newPattern);
+    int apply(const double *r, double *z);
+
+  private:
+    int symbolic(int n, const int *rowStart, const int *colA);
+
+    int levelOfFill;
+    int size;
+
+    // the factors in one row compressed array, L below the diagonal
+    // (unit diagonal not stored) and U from the diagonal on
+    int *luRowStart, *luCol, *luDiag;
+    double *luA;
+    int luSize;
+
+    // location of each column in the current row, -1 if not in it
+    int *marker;
+};
+
+#endif
@@ -0,0 +1,83 @@
+/* ****************************************************************** **
+**    OpenSees - Open System for Earthquake Engineering Simulation    **
+**          Pacific Earthquake Engineering Research Center            **
+**                                                                    **
+**                                                                    **
+** (C) Copyright 1999, The Regents of the University of California    **
+** All Rights Reserved.                                               **
+**                                                                    **
+** Commercial use of this program without express permission of the   **
+** University of California, Berkeley, is strictly prohibited.  See   **
+** file 'COPYRIGHT'  in main directory for information on usage and   **
+** redistribution,  and for a DISCLAIMER OF ALL WARRANTIES.           **
+**                                                                    **
+** Developed by:                                                      **
+**   Frank McKenna (fmckenna@ce.berkeley.edu)                         **
+**   Gregory L. Fenves (fenves@ce.berkeley.edu)                       **
+**   Filip C. Filippou (filippou@ce.berkeley.edu)                     **
+**                                                                    **
+** ****************************************************************** */
+
+// Description: This file contains the implementation of
+// KrylovPreconditioner and JacobiPreconditioner.
+
+#include <KrylovPreconditioner.h>
+#include <OPS_Globals.h>
+
+KrylovPreconditioner::KrylovPreconditioner()
+{
+
+}
+
+KrylovPreconditioner::~KrylovPreconditioner()
+{
+
+}
+
+
+JacobiPreconditioner::JacobiPreconditioner()
+:KrylovPreconditioner(), size(0), invDiag(0)
+{
+
+}
+
+JacobiPreconditioner::~JacobiPreconditioner()
+{
+  if (invDiag != 0)
+    delete [] invDiag;
+}
+
+int
+JacobiPreconditioner::build(int n, const int *rowStart, const int *colA,
+			    const double *A, bool newPattern)
+{
+  if (n != size) {
+    if (invDiag != 0)
+      delete [] invDiag;
+    invDiag = new double[n];
+    size = n;
+  }
+
+  for (int i=0; i<n; i++) {
+    double diag = 0.0;
+    for (int k=rowStart[i]; k<rowStart[i+1]; k++)
+      if (colA[k] == i) {
+	diag = A[k];
+	break;
+      }
+    // a zero diagonal is left unscaled
+    invDiag[i] = (diag != 0.0) ? 1.0/diag : 1.0;
+  }
+
+  return 0;
+}
+
+int
+JacobiPreconditioner::apply(const double *r, double *z)
+{
+#pragma omp parallel for
+  for (int i=0; i<size; i++)
+    z[i] = invDiag[i]*r[i];
+
+  return 0;
+}
@@ -0,0 +1,66 @@
+/* ****************************************************************** **
+**    OpenSees - Open System for Earthquake Engineering Simulation    **
+**          Pacific Earthquake Engineering Research Center            **
+**                                                                    **
+**                                                                    **
+** (C) Copyright 1999, The Regents of the University of California    **
+** All Rights Reserved.                                               **
+**                                                                    **
+** Commercial use of this program without express permission of the   **
+** University of California, Berkeley, is strictly prohibited.  See   **
+** file 'COPYRIGHT'  in main directory for information on usage and   **
+** redistribution,  and for a DISCLAIMER OF ALL WARRANTIES.           **
+**                                                                    **
+** Developed by:                                                      **
+**   Frank McKenna (fmckenna@ce.berkeley.edu)                         **
+**   Gregory L. Fenves (fenves@ce.berkeley.edu)                       **
+**   Filip C. Filippou (filippou@ce.berkeley.edu)                     **
+**                                                                    **
+** ****************************************************************** */
+
+#ifndef KrylovPreconditioner_h
+#define KrylovPreconditioner_h
+
+// Description: This file contains the class definition for
+// KrylovPreconditioner. KrylovPreconditioner is an abstract base class
+// for the preconditioners used by the KrylovSolver. A preconditioner is
+// built from a matrix in compressed row storage (with the columns of
+// each row in increasing order, as the SparseGenRowLinSOE keeps them)
+// and then applied any number of times, z = inv(M) r. The matrix given
+// to build() must stay allocated while the preconditioner is used.
+//
+// JacobiPreconditioner, the diagonal scaling, is also defined here.
+
+class KrylovPreconditioner
+{
+  public:
+    KrylovPreconditioner();
+    virtual ~KrylovPreconditioner();
+
+    // newPattern is false when only the values of A have changed
+    // since the last build
+    virtual int build(int n, const int *rowStart, const int *colA,
+		      const double *A, bool newPattern) = 0;
+    virtual int apply(const double *r, double *z) = 0;
+
+  protected:
+
+  private:
+};
+
+class JacobiPreconditioner : public KrylovPreconditioner
+{
+  public:
+    JacobiPreconditioner();
+    ~JacobiPreconditioner();
+
+    int build(int n, const int *rowStart, const int *colA,
+	      const double *A, bool newPattern);
+    int apply(const double *r, double *z);
+
+  private:
+    int size;
+    double *invDiag;
+};
+
+#endif
@@ -0,0 +1,624 @@
+/* ****************************************************************** **
+**    OpenSees - Open System for Earthquake Engineering Simulation    **
+**          Pacific Earthquake Engineering Research Center            **
+**                                                                    **
+**                                                                    **
+** (C) Copyright 1999, The Regents of the University of California    **
+** All Rights Reserved.                                               **
+**                                                                    **
+** Commercial use of this program without express permission of the   **
+** University of California, Berkeley, is strictly prohibited.  See   **
+** file 'COPYRIGHT'  in main directory for information on usage and   **
+** redistribution,  and for a DISCLAIMER OF ALL WARRANTIES.           **
+**                                                                    **
+** Developed by:                                                      **
+**   Frank McKenna (fmckenna@ce.berkeley.edu)                         **
+**   Gregory L. Fenves (fenves@ce.berkeley.edu)                       **
+**   Filip C. Filippou (filippou@ce.berkeley.edu)                     **
+**                                                                    **
+** ****************************************************************** */
+
+// Description: This file contains the implementation of KrylovSolver.
+
+#include <KrylovSolver.h>
+#include <SparseGenRowLinSOE.h>
+#include <KrylovPreconditioner.h>
+#include <ILUkPreconditioner.h>
+#include <SmoothedAggregationAMG.h>
+#include <Vector.h>
+#include <Channel.h>
+#include <FEM_ObjectBroker.h>
+#include <elementAPI.h>
+
+#include <math.h>
+#include <string.h>
+
+void* OPS_KrylovSolver()
+{
+  int method = KrylovSolver::CG;
+  int preconditioner = KrylovSolver::Jacobi;
+  double tol = 1.0e-8;
+  int maxIter = 1000;
+  int restart = 50;
+  int levelOfFill = 0;
+  int blockSize = 1;
+  double reuseRatio = 2.0;
+  bool printIter = false;
+
+  int numData = 1;
+  while (OPS_GetNumRemainingInputArgs() > 0) {
+    const char *opt = OPS_GetString();
+
+    if (strcmp(opt, "-print") == 0) {
+      printIter = true;
+      continue;
+    }
+
+    if (OPS_GetNumRemainingInputArgs() < 1) {
+      opserr << "WARNING system Krylov - no value given for " << opt << "\n";
+      return 0;
+    }
+
+    if (strcmp(opt, "-solver") == 0) {
+      const char *type = OPS_GetString();
+      if (strcmp(type, "cg") == 0 || strcmp(type, "CG") == 0 || strcmp(type, "pcg") == 0)
+	method = KrylovSolver::CG;
+      else if (strcmp(type, "minres") == 0 || strcmp(type, "MINRES") == 0)
+	method = KrylovSolver::MINRES;
+      else if (strcmp(type, "gmres") == 0 || strcmp(type, "GMRES") == 0)
+	method = KrylovSolver::GMRES;
+      else {
+	opserr << "WARNING system Krylov - unknown solver " << type << ", want cg, minres or gmres\n";
+	return 0;
+      }
+    } else if (strcmp(opt, "-pre") == 0) {
+      const char *type = OPS_GetString();
+      if (strcmp(type, "none") == 0)
+	preconditioner = KrylovSolver::None;
+      else if (strcmp(type, "jacobi") == 0 || strcmp(type, "diagonal") == 0)
+	preconditioner = KrylovSolver::Jacobi;
+      else if (strcmp(type, "ilu") == 0 || strcmp(type, "ic") == 0)
+	preconditioner = KrylovSolver::ILU;
+      else if (strcmp(type, "amg") == 0)
+	preconditioner = KrylovSolver::AMG;
+      else {
+	opserr << "WARNING system Krylov - unknown preconditioner " << type << ", want none, jacobi, ilu or amg\n";
+	return 0;
+      }
+    } else if (strcmp(opt, "-tol") == 0) {
+      if (OPS_GetDoubleInput(numData, &tol) < 0) {
+	opserr << "WARNING system Krylov - invalid tol\n";
+	return 0;
+      }
+    } else if (strcmp(opt, "-maxIter") == 0) {
+      if (OPS_GetIntInput(numData, &maxIter) < 0) {
+	opserr << "WARNING system Krylov - invalid maxIter\n";
+	return 0;
+      }
+    } else if (strcmp(opt, "-restart") == 0) {
+      if (OPS_GetIntInput(numData, &restart) < 0) {
+	opserr << "WARNING system Krylov - invalid restart\n";
+	return 0;
+      }
+    } else if (strcmp(opt, "-fill") == 0) {
+      if (OPS_GetIntInput(numData, &levelOfFill) < 0) {
+	opserr << "WARNING system Krylov - invalid fill\n";
+	return 0;
+      }
+    } else if (strcmp(opt, "-blockSize") == 0) {
+      if (OPS_GetIntInput(numData, &blockSize) < 0) {
+	opserr << "WARNING system Krylov - invalid blockSize\n";
+	return 0;
+      }
+    } else if (strcmp(opt, "-reuse") == 0) {
+      if (OPS_GetDoubleInput(numData, &reuseRatio) < 0) {
+	opserr << "WARNING system Krylov - invalid reuse ratio\n";
+	return 0;
+      }
+    } else {
+      opserr << "WARNING system Krylov - unknown option " << opt << "\n";
+      return 0;
+    }
+  }
+
+  KrylovSolver *theSolver = new KrylovSolver(method, preconditioner, tol, maxIter,
+					     restart, levelOfFill, blockSize,
+					     reuseRatio, printIter);
+  return new SparseGenRowLinSOE(*theSolver);
+}
+
+
+// vector operations
+static double
+dot(int n, const double *a, const double *b)
+{
+  double sum = 0.0;
+#pragma omp parallel for reduction(+:sum)
+  for (int i=0; i<n; i++)
+    sum += a[i]*b[i];
+  return sum;
+}
+
+static void
+axpy(int n, double alpha, const double *x, double *y)
+{
+#pragma omp parallel for
+  for (int i=0; i<n; i++)
+    y[i] += alpha*x[i];
+}
+
+
+KrylovSolver::KrylovSolver(int meth, int precond, double tolerance,
+			   int max, int restrt, int fill, int bs,
+			   double ratio, bool print)
+:SparseGenRowLinSolver(SOLVER_TAGS_KrylovSolver),
+ method(meth), preconditioner(precond), tol(tolerance), maxIter(max),
+ restart(restrt), levelOfFill(fill), blockSize(bs), reuseRatio(ratio),
+ printIter(print),
+ thePreconditioner(0), newPattern(true), numIter(0), numIterBuild(0),
+ residual(0.0)
+{
+  if (restart < 1)
+    restart = 1;
+}
+
+KrylovSolver::~KrylovSolver()
+{
+  if (thePreconditioner != 0)
+    delete thePreconditioner;
+}
+
+int
+KrylovSolver::getNumIterations(void) const
+{
+  return numIter;
+}
+
+int
+KrylovSolver::setSize(void)
+{
+  // the preconditioner has to start again
+  newPattern = true;
+  return 0;
+}
+
+void
+KrylovSolver::multiplyA(const double *x, double *y)
+{
+  int n = theSOE->size;
+  const int *rowStart = theSOE->rowStartA;
+  const int *colA = theSOE->colA;
+  const double *A = theSOE->A;
+
+#pragma omp parallel for
+  for (int i=0; i<n; i++) {
+    double sum = 0.0;
+    for (int k=rowStart[i]; k<rowStart[i+1]; k++)
+      sum += A[k]*x[colA[k]];
+    y[i] = sum;
+  }
+}
+
+void
+KrylovSolver::precondition(const double *r, double *z)
+{
+  if (thePreconditioner != 0)
+    thePreconditioner->apply(r, z);
+  else {
+    int n = theSOE->size;
+    for (int i=0; i<n; i++)
+      z[i] = r[i];
+  }
+}
+
+int
+KrylovSolver::buildPreconditioner(bool pattern)
+{
+  if (preconditioner == None)
+    return 0;
+
+  if (thePreconditioner == 0) {
+    if (preconditioner == ILU)
+      thePreconditioner = new ILUkPreconditioner(levelOfFill);
+    else if (preconditioner == AMG)
+      thePreconditioner = new SmoothedAggregationAMG(blockSize);
+    else
+      thePreconditioner = new JacobiPreconditioner();
+    pattern = true;
+  }
+
+  return thePreconditioner->build(theSOE->size, theSOE->rowStartA,
+				  theSOE->colA, theSOE->A, pattern);
+}
+
+int
+KrylovSolver::solve(void)
+{
+  int n = theSOE->size;
+  if (n == 0)
+    return 0;
+
+  // rebuild the preconditioner if A has a new pattern or the old one
+  // has started to cost too many iterations
+  bool matrixChanged = (theSOE->factored == false);
+  bool built = false;
+  if (preconditioner != None) {
+    int numIterLimit = (numIterBuild > 10) ? numIterBuild : 10;
+    if (thePreconditioner == 0 || newPattern == true ||
+	(matrixChanged == true && (reuseRatio <= 0.0 || numIter > reuseRatio*numIterLimit))) {
+      if (this->buildPreconditioner(newPattern) < 0) {
+	opserr << "WARNING KrylovSolver::solve() - failed to build the preconditioner\n";
+	return -1;
+      }
+      newPattern = false;
+      built = true;
+    }
+  }
+
+  int result = this->iterate();
+
+  // the old preconditioner no longer does, try a new one
+  if (result < 0 && built == false && preconditioner != None) {
+    if (this->buildPreconditioner(false) < 0) {
+      opserr << "WARNING KrylovSolver::solve() - failed to build the preconditioner\n";
+      return -1;
+    }
+    built = true;
+    result = this->iterate();
+  }
+
+  if (built == true)
+    numIterBuild = numIter;
+
+  theSOE->factored = true;
+
+  if (printIter == true)
+    opserr << "KrylovSolver::solve() - " << numIter << " iterations, relative residual "
+	   << residual << (built ? " (new preconditioner)\n" : "\n");
+
+  if (result < 0)
+    opserr << "WARNING KrylovSolver::solve() - no convergence in " << numIter
+	   << " iterations, relative residual " << residual << endln;
+
+  return result;
+}
+
+int
+KrylovSolver::iterate(void)
+{
+  int n = theSOE->size;
+  double *x = theSOE->X;
+  const double *b = theSOE->B;
+
+  for (int i=0; i<n; i++)
+    x[i] = 0.0;
+  numIter = 0;
+  residual = 0.0;
+
+  double normB = sqrt(dot(n, b, b));
+  if (normB == 0.0)
+    return 0;
+
+  if (method == MINRES)
+    return this->solveMINRES();
+  else if (method == GMRES)
+    return this->solveGMRES();
+  else
+    return this->solveCG();
+}
+
+int
+KrylovSolver::solveCG(void)
+{
+  int n = theSOE->size;
+  double *x = theSOE->X;
+  const double *b = theSOE->B;
+
+  work.resize(4*size_t(n));
+  double *r = &work[0];
+  double *z = r + n;
+  double *p = z + n;
+  double *q = p + n;
+
+  for (int i=0; i<n; i++)
+    r[i] = b[i];
+  double normB = sqrt(dot(n, b, b));
+
+  this->precondition(r, z);
+  for (int i=0; i<n; i++)
+    p[i] = z[i];
+  double rz = dot(n, r, z);
+
+  for (numIter=1; numIter<=maxIter; numIter++) {
+    this->multiplyA(p, q);
+    double pq = dot(n, p, q);
+    if (pq == 0.0)
+      break;
+
+    double alpha = rz/pq;
+    axpy(n, alpha, p, x);
+    axpy(n, -alpha, q, r);
+
+    residual = sqrt(dot(n, r, r))/normB;
+    if (residual <= tol)
+      return 0;
+
+    this->precondition(r, z);
+    double rzNew = dot(n, r, z);
+    double beta = rzNew/rz;
+    rz = rzNew;
+
+#pragma omp parallel for
+    for (int i=0; i<n; i++)
+      p[i] = z[i] + beta*p[i];
+  }
+
+  if (numIter > maxIter)
+    numIter = maxIter;
+  return -1;
+}
+
+int
+KrylovSolver::solveMINRES(void)
+{
+  // preconditioned MINRES of Paige and Saunders, the residual is
+  // measured in the norm of the preconditioner
+  int n = theSOE->size;
+  double *x = theSOE->X;
+  const double *b = theSOE->B;
+
+  work.resize(7*size_t(n));
+  double *r1 = &work[0];
+  double *r2 = r1 + n;
+  double *y = r2 + n;
+  double *v = y + n;
+  double *w = v + n;
+  double *w1 = w + n;
+  double *w2 = w1 + n;
+
+  for (int i=0; i<n; i++) {
+    r1[i] = b[i];
+    r2[i] = b[i];
+    w[i] = 0.0;
+    w2[i] = 0.0;
+  }
+  this->precondition(r1, y);
+
+  double beta1 = dot(n, r1, y);
+  if (beta1 <= 0.0) {
+    opserr << "WARNING KrylovSolver::solve() - MINRES needs a positive definite preconditioner\n";
+    return -2;
+  }
+  beta1 = sqrt(beta1);
+
+  double oldb = 0.0, beta = beta1, dbar = 0.0, epsln = 0.0;
+  double phibar = beta1, cs = -1.0, sn = 0.0;
+
+  for (numIter=1; numIter<=maxIter; numIter++) {
+    double s = 1.0/beta;
+    for (int i=0; i<n; i++)
+      v[i] = s*y[i];
+
+    this->multiplyA(v, y);
+    if (numIter >= 2)
+      axpy(n, -beta/oldb, r1, y);
+    double alfa = dot(n, v, y);
+    axpy(n, -alfa/beta, r2, y);
+
+    double *tmp = r1;
+    r1 = r2;
+    r2 = y;
+    y = tmp;
+    this->precondition(r2, y);
+
+    oldb = beta;
+    beta = dot(n, r2, y);
+    if (beta < 0.0) {
+      opserr << "WARNING KrylovSolver::solve() - MINRES needs a positive definite preconditioner\n";
+      return -2;
+    }
+    beta = sqrt(beta);
+
+    double oldeps = epsln;
+    double delta = cs*dbar + sn*alfa;
+    double gbar = sn*dbar - cs*alfa;
+    epsln = sn*beta;
+    dbar = -cs*beta;
+
+    double gamma = sqrt(gbar*gbar + beta*beta);
+    if (gamma < 1.0e-300)
+      gamma = 1.0e-300;
+    cs = gbar/gamma;
+    sn = beta/gamma;
+    double phi = cs*phibar;
+    phibar = sn*phibar;
+
+    double denom = 1.0/gamma;
+    tmp = w1;
+    w1 = w2;
+    w2 = w;
+    w = tmp;
+
+#pragma omp parallel for
+    for (int i=0; i<n; i++) {
+      w[i] = (v[i] - oldeps*w1[i] - delta*w2[i])*denom;
+      x[i] += phi*w[i];
+    }
+
+    residual = phibar/beta1;
+    if (residual <= tol || beta == 0.0)
+      return 0;
+  }
+
+  numIter = maxIter;
+  return -1;
+}
+
+int
+KrylovSolver::solveGMRES(void)
+{
+  int n = theSOE->size;
+  double *x = theSOE->X;
+  const double *b = theSOE->B;
+  int m = restart;
+
+  // the Krylov basis, then two more vectors
+  work.resize((m+3)*size_t(n));
+  double *V = &work[0];
+  double *z = V + (m+1)*size_t(n);
+  double *u = z + n;
+
+  std::vector<double> H((m+1)*m);
+  std::vector<double> cs(m), sn(m), g(m+1), yk(m);
+
+  double normB = sqrt(dot(n, b, b));
+
+  // r = b for x = 0
+  for (int i=0; i<n; i++)
+    V[i] = b[i];
+  double beta = normB;
+
+  numIter = 0;
+  while (numIter < maxIter) {
+
+    double s = 1.0/beta;
+    for (int i=0; i<n; i++)
+      V[i] *= s;
+    for (int i=0; i<=m; i++)
+      g[i] = 0.0;
+    g[0] = beta;
+
+    int j = 0;
+    bool converged = false;
+    for (j=0; j<m && numIter<maxIter; j++) {
+      numIter++;
+      double *vj = V + j*size_t(n);
+      double *vj1 = vj + n;
+
+      this->precondition(vj, z);
+      this->multiplyA(z, vj1);
+
+      // modified Gram-Schmidt
+      for (int i=0; i<=j; i++) {
+	double *vi = V + i*size_t(n);
+	double h = dot(n, vi, vj1);
+	H[i*m+j] = h;
+	axpy(n, -h, vi, vj1);
+      }
+      double h = sqrt(dot(n, vj1, vj1));
+      H[(j+1)*m+j] = h;
+      if (h != 0.0) {
+	double sh = 1.0/h;
+	for (int i=0; i<n; i++)
+	  vj1[i] *= sh;
+      }
+
+      // the previous rotations, then a new one for the column
+      for (int i=0; i<j; i++) {
+	double hi = H[i*m+j];
+	double hi1 = H[(i+1)*m+j];
+	H[i*m+j] = cs[i]*hi + sn[i]*hi1;
+	H[(i+1)*m+j] = -sn[i]*hi + cs[i]*hi1;
+      }
+      double hjj = H[j*m+j];
+      double hj1 = H[(j+1)*m+j];
+      double rho = sqrt(hjj*hjj + hj1*hj1);
+      if (rho == 0.0) {
+	cs[j] = 1.0;
+	sn[j] = 0.0;
+      } else {
+	cs[j] = hjj/rho;
+	sn[j] = hj1/rho;
+      }
+      H[j*m+j] = rho;
+      H[(j+1)*m+j] = 0.0;
+      g[j+1] = -sn[j]*g[j];
+      g[j] = cs[j]*g[j];
+
+      residual = fabs(g[j+1])/normB;
+      if (residual <= tol || h == 0.0) {
+	converged = true;
+	j++;
+	break;
+      }
+    }
+
+    // x += inv(M) V y with H y = g
+    for (int i=j-1; i>=0; i--) {
+      double sum = g[i];
+      for (int k=i+1; k<j; k++)
+	sum -= H[i*m+k]*yk[k];
+      yk[i] = (H[i*m+i] != 0.0) ? sum/H[i*m+i] : 0.0;
+    }
+    for (int i=0; i<n; i++)
+      u[i] = 0.0;
+    for (int k=0; k<j; k++)
+      axpy(n, yk[k], V + k*size_t(n), u);
+    this->precondition(u, z);
+    axpy(n, 1.0, z, x);
+
+    // the true residual for the restart
+    this->multiplyA(x, V);
+#pragma omp parallel for
+    for (int i=0; i<n; i++)
+      V[i] = b[i] - V[i];
+    beta = sqrt(dot(n, V, V));
+    residual = beta/normB;
+
+    if (converged == true || residual <= tol)
+      return (residual <= 10.0*tol) ? 0 : -1;
+    if (beta == 0.0)
+      return 0;
+  }
+
+  return -1;
+}
+
+int
+KrylovSolver::sendSelf(int cTag, Channel &theChannel)
+{
+  static Vector data(9);
+  data(0) = method;
+  data(1) = preconditioner;
+  data(2) = tol;
+  data(3) = maxIter;
+  data(4) = restart;
+  data(5) = levelOfFill;
+  data(6) = blockSize;
+  data(7) = reuseRatio;
+  data(8) = printIter ? 1 : 0;
+
+  if (theChannel.sendVector(this->getDbTag(), cTag, data) < 0) {
+    opserr << "KrylovSolver::sendSelf() - failed to send data\n";
+    return -1;
+  }
+  return 0;
+}
+
+int
+KrylovSolver::recvSelf(int cTag, Channel &theChannel,
+		       FEM_ObjectBroker &theBroker)
+{
+  static Vector data(9);
+  if (theChannel.recvVector(this->getDbTag(), cTag, data) < 0) {
+    opserr << "KrylovSolver::recvSelf() - failed to receive data\n";
+    return -1;
+  }
+
+  method = int(data(0));
+  preconditioner = int(data(1));
+  tol = data(2);
+  maxIter = int(data(3));
+  restart = int(data(4));
+  levelOfFill = int(data(5));
+  blockSize = int(data(6));
+  reuseRatio = data(7);
+  printIter = (data(8) != 0.0);
+
+  if (thePreconditioner != 0)
+    delete thePreconditioner;
+  thePreconditioner = 0;
+  newPattern = true;
+
+  return 0;
+}
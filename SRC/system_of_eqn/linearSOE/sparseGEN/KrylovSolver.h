@@ -0,0 +1,103 @@
+/* ****************************************************************** **
+**    OpenSees - Open System for Earthquake Engineering Simulation    **
+**          Pacific Earthquake Engineering Research Center            **
+**                                                                    **
+**                                                                    **
+** (C) Copyright 1999, The Regents of the University of California    **
+** All Rights Reserved.                                               **
+**                                                                    **
+** Commercial use of this program without express permission of the   **
+** University of California, Berkeley, is strictly prohibited.  See   **
+** file 'COPYRIGHT'  in main directory for information on usage and   **
+** redistribution,  and for a DISCLAIMER OF ALL WARRANTIES.           **
+**                                                                    **
+** Developed by:                                                      **
+**   Frank McKenna (fmckenna@ce.berkeley.edu)                         **
+**   Gregory L. Fenves (fenves@ce.berkeley.edu)                       **
+**   Filip C. Filippou (filippou@ce.berkeley.edu)                     **
+**                                                                    **
+** ****************************************************************** */
+
+#ifndef KrylovSolver_h
+#define KrylovSolver_h
+
+// Description: This file contains the class definition for KrylovSolver.
+// KrylovSolver is a SparseGenRowLinSolver solving the equations with a
+// preconditioned Krylov method:
+//
+//   CG     - conjugate gradients, for symmetric positive definite A
+//   MINRES - for symmetric, possibly indefinite, A
+//   GMRES  - restarted GMRES, right preconditioned, for any A
+//
+// The preconditioner is none, Jacobi, ILU(k) or smoothed aggregation
+// AMG. It is kept from one solve to the next as long as it works: when
+// A has changed it is rebuilt only if the previous solve needed more
+// than reuseRatio times the iterations of the first solve with it, or
+// if the solve with the old preconditioner does not converge. A
+// reuseRatio of 0 rebuilds it whenever A changes.
+//
+// The products with A and the vector operations are threaded with
+// OpenMP when it is enabled.
+//
+//   system Krylov <-solver cg|minres|gmres> <-pre none|jacobi|ilu|amg>
+//                 <-tol tol> <-maxIter n> <-restart m> <-fill k>
+//                 <-blockSize ndf> <-reuse ratio> <-print>
+
+#include <SparseGenRowLinSolver.h>
+#include <vector>
+
+class KrylovPreconditioner;
+
+class KrylovSolver : public SparseGenRowLinSolver
+{
+  public:
+    enum Method {CG = 0, MINRES, GMRES};
+    enum Preconditioner {None = 0, Jacobi, ILU, AMG};
+
+    KrylovSolver(int method = CG, int preconditioner = Jacobi,
+		 double tol = 1.0e-8, int maxIter = 1000, int restart = 50,
+		 int levelOfFill = 0, int blockSize = 1,
+		 double reuseRatio = 2.0, bool printIter = false);
+    ~KrylovSolver();
+
+    int solve(void);
+    int setSize(void);
+
+    int getNumIterations(void) const;
+
+    int sendSelf(int commitTag, Channel &theChannel);
+    int recvSelf(int commitTag, Channel &theChannel,
+		 FEM_ObjectBroker &theBroker);
+
+  protected:
+
+  private:
+    int buildPreconditioner(bool newPattern);
+    int iterate(void);
+    int solveCG(void);
+    int solveMINRES(void);
+    int solveGMRES(void);
+
+    void multiplyA(const double *x, double *y);
+    void precondition(const double *r, double *z);
+
+    int method;
+    int preconditioner;
+    double tol;
+    int maxIter;
+    int restart;
+    int levelOfFill;
+    int blockSize;
+    double reuseRatio;
+    bool printIter;
+
+    KrylovPreconditioner *thePreconditioner;
+    bool newPattern;
+    int numIter;               // iterations of the last solve
+    int numIterBuild;          // iterations of the first solve after a build
+    double residual;           // relative residual of the last solve
+
+    std::vector<double> work;  // work vectors of the methods
+};
+
+#endif
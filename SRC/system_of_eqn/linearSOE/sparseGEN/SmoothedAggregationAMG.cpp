@@ -0,0 +1,596 @@
+/* ****************************************************************** **
+**    OpenSees - Open System for Earthquake Engineering Simulation    **
+**          Pacific Earthquake Engineering Research Center            **
+**                                                                    **
+**                                                                    **
+** (C) Copyright 1999, The Regents of the University of California    **
+** All Rights Reserved.                                               **
+**                                                                    **
+** Commercial use of this program without express permission of the   **
+** University of California, Berkeley, is strictly prohibited.  See   **
+** file 'COPYRIGHT'  in main directory for information on usage and   **
+** redistribution,  and for a DISCLAIMER OF ALL WARRANTIES.           **
+**                                                                    **
+** Developed by:                                                      **
+**   Frank McKenna (fmckenna@ce.berkeley.edu)                         **
+**   Gregory L. Fenves (fenves@ce.berkeley.edu)                       **
+**   Filip C. Filippou (filippou@ce.berkeley.edu)                     **
+**                                                                    **
+** ****************************************************************** */
+
+// Description: This file contains the implementation of
+// SmoothedAggregationAMG.
+
+#include <SmoothedAggregationAMG.h>
+#include <OPS_Globals.h>
+
+#include <math.h>
+#include <algorithm>
+#include <utility>
+
+typedef SmoothedAggregationAMG::SparseMatrix SparseMatrix;
+
+// the coarsest matrix is factored if it is no larger than this,
+// otherwise it is smoothed
+static const int maxDenseSize = 4000;
+
+SparseMatrix::SparseMatrix()
+:numRows(0), numCols(0), rowStart(0), col(0), val(0)
+{
+
+}
+
+void
+SparseMatrix::setData(void)
+{
+  rowStart = rowStartData.data();
+  col = colData.data();
+  val = valData.data();
+}
+
+// y = A x
+static void
+multiply(const SparseMatrix &A, const double *x, double *y)
+{
+  const int *rowStart = A.rowStart;
+  const int *col = A.col;
+  const double *val = A.val;
+  int n = A.numRows;
+
+#pragma omp parallel for
+  for (int i=0; i<n; i++) {
+    double sum = 0.0;
+    for (int k=rowStart[i]; k<rowStart[i+1]; k++)
+      sum += val[k]*x[col[k]];
+    y[i] = sum;
+  }
+}
+
+// C = A B
+static void
+multiply(const SparseMatrix &A, const SparseMatrix &B, SparseMatrix &C)
+{
+  C.numRows = A.numRows;
+  C.numCols = B.numCols;
+  C.rowStartData.assign(A.numRows+1, 0);
+  C.colData.clear();
+  C.valData.clear();
+
+  std::vector<int> marker(B.numCols, -1);
+  std::vector<std::pair<int,double> > row;
+
+  for (int i=0; i<A.numRows; i++) {
+    int start = int(C.colData.size());
+    for (int p=A.rowStart[i]; p<A.rowStart[i+1]; p++) {
+      int k = A.col[p];
+      double a = A.val[p];
+      for (int q=B.rowStart[k]; q<B.rowStart[k+1]; q++) {
+	int j = B.col[q];
+	if (marker[j] < start) {
+	  marker[j] = int(C.colData.size());
+	  C.colData.push_back(j);
+	  C.valData.push_back(a*B.val[q]);
+	} else
+	  C.valData[marker[j]] += a*B.val[q];
+      }
+    }
+
+    // keep the columns in increasing order
+    int end = int(C.colData.size());
+    row.resize(end-start);
+    for (int p=start; p<end; p++)
+      row[p-start] = std::make_pair(C.colData[p], C.valData[p]);
+    std::sort(row.begin(), row.end());
+    for (int p=start; p<end; p++) {
+      C.colData[p] = row[p-start].first;
+      C.valData[p] = row[p-start].second;
+    }
+    C.rowStartData[i+1] = end;
+  }
+
+  C.setData();
+}
+
+// T = A^T
+static void
+transpose(const SparseMatrix &A, SparseMatrix &T)
+{
+  T.numRows = A.numCols;
+  T.numCols = A.numRows;
+  int nnz = A.rowStart[A.numRows];
+  T.rowStartData.assign(A.numCols+1, 0);
+  T.colData.resize(nnz);
+  T.valData.resize(nnz);
+
+  for (int k=0; k<nnz; k++)
+    T.rowStartData[A.col[k]+1]++;
+  for (int j=0; j<A.numCols; j++)
+    T.rowStartData[j+1] += T.rowStartData[j];
+
+  std::vector<int> next(T.rowStartData.begin(), T.rowStartData.end()-1);
+  for (int i=0; i<A.numRows; i++)
+    for (int k=A.rowStart[i]; k<A.rowStart[i+1]; k++) {
+      int loc = next[A.col[k]]++;
+      T.colData[loc] = i;
+      T.valData[loc] = A.val[k];
+    }
+
+  T.setData();
+}
+
+// the Gauss-Seidel sweeps, forward and backward
+static void
+forwardSweep(const SparseMatrix &A, const std::vector<int> &diag,
+	     const double *b, double *x)
+{
+  for (int i=0; i<A.numRows; i++) {
+    double sum = b[i];
+    double d = 0.0;
+    for (int k=A.rowStart[i]; k<A.rowStart[i+1]; k++) {
+      if (k == diag[i])
+	d = A.val[k];
+      else
+	sum -= A.val[k]*x[A.col[k]];
+    }
+    if (d != 0.0)
+      x[i] = sum/d;
+  }
+}
+
+static void
+backwardSweep(const SparseMatrix &A, const std::vector<int> &diag,
+	      const double *b, double *x)
+{
+  for (int i=A.numRows-1; i>=0; i--) {
+    double sum = b[i];
+    double d = 0.0;
+    for (int k=A.rowStart[i]; k<A.rowStart[i+1]; k++) {
+      if (k == diag[i])
+	d = A.val[k];
+      else
+	sum -= A.val[k]*x[A.col[k]];
+    }
+    if (d != 0.0)
+      x[i] = sum/d;
+  }
+}
+
+
+SmoothedAggregationAMG::SmoothedAggregationAMG(int bs, double th,
+					       int maxCoarse, int maxLev)
+:KrylovPreconditioner(), blockSize(bs), theta(th),
+ maxCoarseSize(maxCoarse), maxLevels(maxLev), numLevels(0)
+{
+  if (blockSize < 1)
+    blockSize = 1;
+  if (maxLevels < 1)
+    maxLevels = 1;
+}
+
+SmoothedAggregationAMG::~SmoothedAggregationAMG()
+{
+  for (int i=0; i<int(theLevels.size()); i++)
+    delete theLevels[i];
+}
+
+int
+SmoothedAggregationAMG::getNumLevels(void) const
+{
+  return numLevels;
+}
+
+int
+SmoothedAggregationAMG::aggregate(const SparseMatrix &A, int bs,
+				  std::vector<int> &aggregates)
+{
+  int numNodes = A.numRows/bs;
+
+  // norms of the diagonal blocks
+  std::vector<double> diagNorm(numNodes, 0.0);
+  for (int i=0; i<A.numRows; i++) {
+    int I = i/bs;
+    for (int k=A.rowStart[i]; k<A.rowStart[i+1]; k++)
+      if (A.col[k]/bs == I)
+	diagNorm[I] += A.val[k]*A.val[k];
+  }
+  for (int I=0; I<numNodes; I++)
+    diagNorm[I] = sqrt(diagNorm[I]);
+
+  // the strong connections, |A_IJ| > theta sqrt(|A_II| |A_JJ|)
+  std::vector<int> strongStart(numNodes+1, 0);
+  std::vector<int> strong;
+  std::vector<double> sum(numNodes, 0.0);
+  std::vector<int> mark(numNodes, -1);
+  std::vector<int> touched;
+  for (int I=0; I<numNodes; I++) {
+    touched.clear();
+    for (int i=I*bs; i<(I+1)*bs; i++)
+      for (int k=A.rowStart[i]; k<A.rowStart[i+1]; k++) {
+	int J = A.col[k]/bs;
+	if (J == I)
+	  continue;
+	if (mark[J] != I) {
+	  mark[J] = I;
+	  sum[J] = 0.0;
+	  touched.push_back(J);
+	}
+	sum[J] += A.val[k]*A.val[k];
+      }
+    for (int t=0; t<int(touched.size()); t++) {
+      int J = touched[t];
+      if (sqrt(sum[J]) > theta*sqrt(diagNorm[I]*diagNorm[J]))
+	strong.push_back(J);
+    }
+    strongStart[I+1] = int(strong.size());
+  }
+
+  aggregates.assign(numNodes, -1);
+  int numAggregates = 0;
+
+  // 1: nodes with no aggregated strong neighbour start an aggregate
+  for (int I=0; I<numNodes; I++) {
+    if (aggregates[I] != -1)
+      continue;
+    bool isFree = true;
+    for (int s=strongStart[I]; s<strongStart[I+1]; s++)
+      if (aggregates[strong[s]] != -1) {
+	isFree = false;
+	break;
+      }
+    if (isFree == false)
+      continue;
+    aggregates[I] = numAggregates;
+    for (int s=strongStart[I]; s<strongStart[I+1]; s++)
+      aggregates[strong[s]] = numAggregates;
+    numAggregates++;
+  }
+
+  // 2: the others join an aggregate of a strong neighbour
+  std::vector<int> firstPass(aggregates);
+  for (int I=0; I<numNodes; I++) {
+    if (aggregates[I] != -1)
+      continue;
+    for (int s=strongStart[I]; s<strongStart[I+1]; s++)
+      if (firstPass[strong[s]] != -1) {
+	aggregates[I] = firstPass[strong[s]];
+	break;
+      }
+  }
+
+  // 3: what is left forms new aggregates
+  for (int I=0; I<numNodes; I++) {
+    if (aggregates[I] != -1)
+      continue;
+    aggregates[I] = numAggregates;
+    for (int s=strongStart[I]; s<strongStart[I+1]; s++)
+      if (aggregates[strong[s]] == -1)
+	aggregates[strong[s]] = numAggregates;
+    numAggregates++;
+  }
+
+  return numAggregates;
+}
+
+int
+SmoothedAggregationAMG::setupLevel(int l, int bs, bool reuseAggregates)
+{
+  Level &fine = *theLevels[l];
+  const SparseMatrix &A = fine.A;
+  int n = A.numRows;
+  int numNodes = n/bs;
+
+  // the aggregates, kept if only the values have changed
+  int numAggregates = 0;
+  if (reuseAggregates == true && int(fine.aggregates.size()) == numNodes) {
+    for (int I=0; I<numNodes; I++)
+      if (fine.aggregates[I] >= numAggregates)
+	numAggregates = fine.aggregates[I] + 1;
+  } else
+    numAggregates = this->aggregate(A, bs, fine.aggregates);
+
+  int numCoarse = numAggregates*bs;
+  if (numCoarse == 0 || numCoarse*10 > n*9)
+    return 1; // not coarsening enough
+
+  // the tentative prolongator
+  std::vector<int> aggregateSize(numAggregates, 0);
+  for (int I=0; I<numNodes; I++)
+    aggregateSize[fine.aggregates[I]]++;
+
+  SparseMatrix Ptent;
+  Ptent.numRows = n;
+  Ptent.numCols = numCoarse;
+  Ptent.rowStartData.resize(n+1);
+  Ptent.colData.resize(n);
+  Ptent.valData.resize(n);
+  for (int i=0; i<n; i++) {
+    int agg = fine.aggregates[i/bs];
+    Ptent.rowStartData[i] = i;
+    Ptent.colData[i] = agg*bs + i%bs;
+    Ptent.valData[i] = 1.0/sqrt(double(aggregateSize[agg]));
+  }
+  Ptent.rowStartData[n] = n;
+  Ptent.setData();
+
+  // spectral radius of inv(D) A by power iteration
+  std::vector<double> invDiag(n, 1.0);
+  for (int i=0; i<n; i++)
+    if (fine.diag[i] >= 0 && A.val[fine.diag[i]] != 0.0)
+      invDiag[i] = 1.0/A.val[fine.diag[i]];
+
+  std::vector<double> v(n), w(n);
+  for (int i=0; i<n; i++)
+    v[i] = 1.0 + 0.1*(i%7);
+  double rho = 1.0;
+  for (int iter=0; iter<15; iter++) {
+    multiply(A, v.data(), w.data());
+    double normV = 0.0, normW = 0.0;
+    for (int i=0; i<n; i++) {
+      w[i] *= invDiag[i];
+      normV += v[i]*v[i];
+      normW += w[i]*w[i];
+    }
+    if (normW == 0.0 || normV == 0.0)
+      break;
+    rho = sqrt(normW/normV);
+    double scale = 1.0/sqrt(normW);
+    for (int i=0; i<n; i++)
+      v[i] = w[i]*scale;
+  }
+  double omega = 4.0/(3.0*rho);
+
+  // P = (I - omega inv(D) A) Ptent
+  SparseMatrix AP;
+  multiply(A, Ptent, AP);
+
+  SparseMatrix &P = fine.P;
+  P.numRows = n;
+  P.numCols = numCoarse;
+  P.rowStartData.assign(n+1, 0);
+  P.colData.clear();
+  P.valData.clear();
+  P.colData.reserve(AP.colData.size() + n);
+  P.valData.reserve(AP.colData.size() + n);
+  for (int i=0; i<n; i++) {
+    int tentCol = Ptent.col[i];
+    double tentVal = Ptent.val[i];
+    double scale = -omega*invDiag[i];
+    bool added = false;
+    for (int k=AP.rowStart[i]; k<AP.rowStart[i+1]; k++) {
+      int j = AP.col[k];
+      double value = scale*AP.val[k];
+      if (added == false && j >= tentCol) {
+	if (j == tentCol)
+	  value += tentVal;
+	else {
+	  P.colData.push_back(tentCol);
+	  P.valData.push_back(tentVal);
+	}
+	added = true;
+      }
+      P.colData.push_back(j);
+      P.valData.push_back(value);
+    }
+    if (added == false) {
+      P.colData.push_back(tentCol);
+      P.valData.push_back(tentVal);
+    }
+    P.rowStartData[i+1] = int(P.colData.size());
+  }
+  P.setData();
+
+  transpose(P, fine.R);
+
+  // the coarse matrix, R A P
+  if (int(theLevels.size()) <= l+1)
+    theLevels.push_back(new Level);
+  Level &coarse = *theLevels[l+1];
+  SparseMatrix AP2;
+  multiply(A, P, AP2);
+  multiply(fine.R, AP2, coarse.A);
+
+  coarse.diag.assign(numCoarse, -1);
+  for (int i=0; i<numCoarse; i++)
+    for (int k=coarse.A.rowStart[i]; k<coarse.A.rowStart[i+1]; k++)
+      if (coarse.A.col[k] == i)
+	coarse.diag[i] = k;
+
+  return 0;
+}
+
+int
+SmoothedAggregationAMG::setupCoarse(void)
+{
+  Level &coarsest = *theLevels[numLevels-1];
+  const SparseMatrix &A = coarsest.A;
+  int n = A.numRows;
+
+  coarseLU.clear();
+  coarsePivot.clear();
+  if (n > maxDenseSize)
+    return 0;
+
+  coarseLU.assign(size_t(n)*n, 0.0);
+  coarsePivot.resize(n);
+  for (int i=0; i<n; i++)
+    for (int k=A.rowStart[i]; k<A.rowStart[i+1]; k++)
+      coarseLU[size_t(i)*n + A.col[k]] = A.val[k];
+
+  // LU with partial pivoting, row k swapped with row coarsePivot[k]
+  double *LU = coarseLU.data();
+  double maxDiag = 0.0;
+  for (int i=0; i<n; i++)
+    if (fabs(LU[size_t(i)*n+i]) > maxDiag)
+      maxDiag = fabs(LU[size_t(i)*n+i]);
+  double tiny = 1.0e-14*maxDiag;
+  if (tiny == 0.0)
+    tiny = 1.0e-14;
+
+  for (int k=0; k<n; k++) {
+    int p = k;
+    for (int i=k+1; i<n; i++)
+      if (fabs(LU[size_t(i)*n+k]) > fabs(LU[size_t(p)*n+k]))
+	p = i;
+    coarsePivot[k] = p;
+    if (p != k)
+      for (int j=0; j<n; j++)
+	std::swap(LU[size_t(k)*n+j], LU[size_t(p)*n+j]);
+
+    // a singular coarse matrix, e.g. from a mechanism, is regularised
+    if (fabs(LU[size_t(k)*n+k]) < tiny)
+      LU[size_t(k)*n+k] = tiny;
+
+    double pivot = LU[size_t(k)*n+k];
+    for (int i=k+1; i<n; i++) {
+      double lik = LU[size_t(i)*n+k]/pivot;
+      LU[size_t(i)*n+k] = lik;
+      if (lik != 0.0)
+	for (int j=k+1; j<n; j++)
+	  LU[size_t(i)*n+j] -= lik*LU[size_t(k)*n+j];
+    }
+  }
+
+  return 0;
+}
+
+int
+SmoothedAggregationAMG::build(int n, const int *rowStart, const int *colA,
+			      const double *A, bool newPattern)
+{
+  int bs = blockSize;
+  if (n % bs != 0) {
+    opserr << "WARNING SmoothedAggregationAMG::build() - size " << n
+	   << " not a multiple of the block size " << blockSize
+	   << ", using a block size of 1\n";
+    bs = 1;
+  }
+
+  bool reuseAggregates = (newPattern == false && numLevels > 0 &&
+			  theLevels[0]->A.numRows == n);
+
+  if (theLevels.empty())
+    theLevels.push_back(new Level);
+
+  // the finest level is the matrix of the SOE
+  Level &fine = *theLevels[0];
+  fine.A.numRows = n;
+  fine.A.numCols = n;
+  fine.A.rowStart = rowStart;
+  fine.A.col = colA;
+  fine.A.val = A;
+  fine.diag.assign(n, -1);
+  for (int i=0; i<n; i++)
+    for (int k=rowStart[i]; k<rowStart[i+1]; k++)
+      if (colA[k] == i)
+	fine.diag[i] = k;
+
+  numLevels = 1;
+  while (numLevels < maxLevels &&
+	 theLevels[numLevels-1]->A.numRows > maxCoarseSize) {
+    if (this->setupLevel(numLevels-1, bs, reuseAggregates) != 0)
+      break;
+    numLevels++;
+  }
+
+  for (int l=0; l<numLevels; l++) {
+    Level &level = *theLevels[l];
+    int size = level.A.numRows;
+    level.x.resize(size);
+    level.b.resize(size);
+    level.r.resize(size);
+  }
+
+  return this->setupCoarse();
+}
+
+void
+SmoothedAggregationAMG::vcycle(int l, const double *b, double *x)
+{
+  Level &level = *theLevels[l];
+  const SparseMatrix &A = level.A;
+  int n = A.numRows;
+
+  for (int i=0; i<n; i++)
+    x[i] = 0.0;
+
+  if (l == numLevels-1) {
+    if (coarseLU.empty()) {
+      for (int sweep=0; sweep<10; sweep++) {
+	forwardSweep(A, level.diag, b, x);
+	backwardSweep(A, level.diag, b, x);
+      }
+      return;
+    }
+
+    const double *LU = coarseLU.data();
+    for (int i=0; i<n; i++)
+      x[i] = b[i];
+    for (int k=0; k<n; k++)
+      if (coarsePivot[k] != k)
+	std::swap(x[k], x[coarsePivot[k]]);
+    for (int i=0; i<n; i++) {
+      double sum = x[i];
+      for (int j=0; j<i; j++)
+	sum -= LU[size_t(i)*n+j]*x[j];
+      x[i] = sum;
+    }
+    for (int i=n-1; i>=0; i--) {
+      double sum = x[i];
+      for (int j=i+1; j<n; j++)
+	sum -= LU[size_t(i)*n+j]*x[j];
+      x[i] = sum/LU[size_t(i)*n+i];
+    }
+    return;
+  }
+
+  // pre-smoothing
+  forwardSweep(A, level.diag, b, x);
+
+  // restrict the residual
+  double *r = level.r.data();
+  multiply(A, x, r);
+  for (int i=0; i<n; i++)
+    r[i] = b[i] - r[i];
+
+  Level &coarse = *theLevels[l+1];
+  multiply(level.R, r, coarse.b.data());
+  this->vcycle(l+1, coarse.b.data(), coarse.x.data());
+
+  // prolongate the correction
+  multiply(level.P, coarse.x.data(), r);
+  for (int i=0; i<n; i++)
+    x[i] += r[i];
+
+  // post-smoothing
+  backwardSweep(A, level.diag, b, x);
+}
+
+int
+SmoothedAggregationAMG::apply(const double *r, double *z)
+{
+  if (numLevels == 0)
+    return -1;
+
+  this->vcycle(0, r, z);
+  return 0;
+}
@@ -0,0 +1,96 @@
+/* ****************************************************************** **
+**    OpenSees - Open System for Earthquake Engineering Simulation    **
+**          Pacific Earthquake Engineering Research Center            **
+**                                                                    **
+**                                                                    **
+** (C) Copyright 1999, The Regents of the University of California    **
+** All Rights Reserved.                                               **
+**                                                                    **
+** Commercial use of this program without express permission of the   **
+** University of California, Berkeley, is strictly prohibited.  See   **
+** file 'COPYRIGHT'  in main directory for information on usage and   **
+** redistribution,  and for a DISCLAIMER OF ALL WARRANTIES.           **
+**                                                                    **
+** Developed by:                                                      **
+**   Frank McKenna (fmckenna@ce.berkeley.edu)                         **
+**   Gregory L. Fenves (fenves@ce.berkeley.edu)                       **
+**   Filip C. Filippou (filippou@ce.berkeley.edu)                     **
+**                                                                    **
+** ****************************************************************** */
+
+#ifndef SmoothedAggregationAMG_h
+#define SmoothedAggregationAMG_h
+
+// Description: This file contains the class definition for
+// SmoothedAggregationAMG. SmoothedAggregationAMG is a KrylovPreconditioner
+// applying one V-cycle of smoothed aggregation algebraic multigrid:
+//
+//  - the unknowns are grouped in blocks of blockSize (the dofs of a
+//    node when the numberer keeps them together) and blocks strongly
+//    connected through A are aggregated
+//  - the tentative prolongator takes the constant of each component
+//    over an aggregate (the translations for solid and structural
+//    models), and is smoothed with one damped Jacobi step
+//  - the coarse matrices are the Galerkin products P^T A P, down to a
+//    size solved with a dense LU factorization
+//  - the smoother is one symmetric Gauss-Seidel sweep, forward before
+//    and backward after the coarse correction, so that the cycle is a
+//    symmetric preconditioner
+//
+// When only the values of A have changed the aggregates are kept and
+// just the prolongators and coarse matrices are recomputed.
+
+#include <KrylovPreconditioner.h>
+#include <vector>
+
+class SmoothedAggregationAMG : public KrylovPreconditioner
+{
+  public:
+    SmoothedAggregationAMG(int blockSize = 1, double theta = 0.08,
+			   int maxCoarseSize = 500, int maxLevels = 10);
+    ~SmoothedAggregationAMG();
+
+    int build(int n, const int *rowStart, const int *colA,
+	      const double *A, bool newPattern);
+    int apply(const double *r, double *z);
+
+    int getNumLevels(void) const;
+
+    // matrix in compressed row storage, owning its arrays or not
+    struct SparseMatrix {
+      int numRows, numCols;
+      const int *rowStart, *col;
+      const double *val;
+      std::vector<int> rowStartData, colData;
+      std::vector<double> valData;
+      SparseMatrix();
+      void setData(void);
+    };
+
+  private:
+    struct Level {
+      SparseMatrix A, P, R;
+      std::vector<int> diag;
+      std::vector<int> aggregates;
+      std::vector<double> x, b, r;
+    };
+
+    int aggregate(const SparseMatrix &A, int bs, std::vector<int> &aggregates);
+    int setupLevel(int level, int bs, bool reuseAggregates);
+    int setupCoarse(void);
+    void vcycle(int level, const double *b, double *x);
+
+    int blockSize;
+    double theta;
+    int maxCoarseSize;
+    int maxLevels;
+
+    std::vector<Level *> theLevels;
+    int numLevels;
+
+    // dense LU factors of the coarsest matrix
+    std::vector<double> coarseLU;
+    std::vector<int> coarsePivot;
+};
+
+#endif
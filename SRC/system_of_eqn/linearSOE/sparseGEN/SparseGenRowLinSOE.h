@@ -71,6 +71,7 @@ class SparseGenRowLinSOE : public LinearSOE
     friend class CulaSparseSolverS4;    
     friend class CulaSparseSolverS5;    
 	friend class CuSPSolver;
+    friend class KrylovSolver;
 
   protected:
     
@@ -60,16 +60,29 @@ UmfpackGenLinSolver::~UmfpackGenLinSolver()
 
 int
 UmfpackGenLinSolver::solve(void)
+{
+    if (theSOE->X.Size() == 0) return 0;
+
+    return this->solveColumns(&(theSOE->X(0)), &(theSOE->B(0)), 1);
+}
+
+int
+UmfpackGenLinSolver::solveMultiple(double *X, int nrhs)
+{
+    // the right-hand sides are in X
+    return this->solveColumns(X, 0, nrhs);
+}
+
+int
+UmfpackGenLinSolver::solveColumns(double *X, const double *B, int nrhs)
 {
     int n = theSOE->X.Size();
     int nnz = (int)theSOE->Ai.size();
-    if (n == 0 || nnz==0) return 0;
+    if (n == 0 || nnz==0 || nrhs == 0) return 0;
     
     int* Ap = &(theSOE->Ap[0]);
     int* Ai = &(theSOE->Ai[0]);
     double* Ax = &(theSOE->Ax[0]);
-    double* X = &(theSOE->X(0));
-    double* B = &(theSOE->B(0));
 
     // check if symbolic is done
     if (Symbolic == 0) {
@@ -77,7 +90,7 @@ UmfpackGenLinSolver::solve(void)
 	return -1;
     }
     
-    // numerical analysis
+    // numerical analysis, once for all right-hand sides
     void* Numeric = 0;
     int status = umfpack_di_numeric(Ap,Ai,Ax,Symbolic,&Numeric,Control,Info);
 
@@ -87,8 +100,25 @@ UmfpackGenLinSolver::solve(void)
 	return -1;
     }
 
-    // solve
-    status = umfpack_di_solve(UMFPACK_A,Ap,Ai,Ax,X,B,Numeric,Control,Info);
+    // solve each column, a copy of the column is the right-hand side
+    // when it is solved in place
+    std::vector<double> column;
+    if (B == 0) {
+	column.resize(n);
+    }
+    for (int j=0; j<nrhs && status==UMFPACK_OK; ++j) {
+	double* x = X + (long)j*n;
+	const double* b = 0;
+	if (B == 0) {
+	    for (int i=0; i<n; ++i) {
+		column[i] = x[i];
+	    }
+	    b = &column[0];
+	} else {
+	    b = B + (long)j*n;
+	}
+	status = umfpack_di_solve(UMFPACK_A,Ap,Ai,Ax,x,b,Numeric,Control,Info);
+    }
 
     // delete Numeric
     if (Numeric != 0) {
@@ -104,7 +134,6 @@ UmfpackGenLinSolver::solve(void)
     return 0;
 }
 
-
 int
 UmfpackGenLinSolver::setSize()
 {
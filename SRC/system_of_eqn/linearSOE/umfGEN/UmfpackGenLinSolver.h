@@ -47,6 +47,8 @@ class UmfpackGenLinSolver : public LinearSOESolver
     ~UmfpackGenLinSolver();
 
     int solve(void);
+    bool supportsMultipleRHS(void) {return true;};
+    int solveMultiple(double *X, int nrhs);
     int setSize(void);
 
     int setLinearSOE(UmfpackGenLinSOE &theSOE);
@@ -58,6 +60,9 @@ class UmfpackGenLinSolver : public LinearSOESolver
   protected:
 
   private:
+    // factors the matrix and solves nrhs columns, in place in X if B is 0
+    int solveColumns(double *X, const double *B, int nrhs);
+
     void *Symbolic;
     double Control[UMFPACK_CONTROL], Info[UMFPACK_INFO];
     UmfpackGenLinSOE *theSOE;
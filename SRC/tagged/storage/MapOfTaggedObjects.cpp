@@ -77,6 +77,13 @@ MapOfTaggedObjects::addComponent(TaggedObject *newComponent)
     MAP_TAGGED_ITERATOR theEle;
     int tag = newComponent->getTag();
 
+    // components added in increasing order of their tags, as by the
+    // bulk model commands and mesh generators, go at the end directly
+    if (theMap.empty() || theMap.rbegin()->first < tag) {
+      theMap.insert(theMap.end(), MAP_TAGGED_TYPE(tag,newComponent));
+      return true;
+    }
+
     // check if the ele already in map, if not we add
     std::pair<MAP_TAGGED_ITERATOR,bool> res = theMap.insert(MAP_TAGGED_TYPE(tag,newComponent));    
     if (res.second == false) {
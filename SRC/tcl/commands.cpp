@@ -116,6 +116,7 @@ extern "C" int         OPS_ResetInputNoBuilder(ClientData clientData, Tcl_Interp
 #include <NodalLoadIter.h>
 #include <ElementalLoad.h>
 #include <ElementalLoadIter.h>
+#include <MappedTimeSeries.h>
 #include <ParameterIter.h>
 #include <SP_Constraint.h> //Joey UC Davis
 #include <SP_ConstraintIter.h> //Joey UC Davis
@@ -210,6 +211,8 @@ FileStream* CmdStrmPtr = &CmdLogStream;
 // transformations
 #include <CrdTransf.h>
 
+extern void* OPS_KrylovSolver(void);
+extern void* OPS_ElementByElementSolver(void);
 extern void* OPS_NewtonRaphsonAlgorithm(void);
 extern void* OPS_ExpressNewton(void);
 extern void* OPS_ModifiedNewton(void);
@@ -442,6 +445,8 @@ ModelBuilder* theBuilder = 0;
 #include <ShadowSubdomain.h>
 #include <MetisWrapper.h>
 #include <ShedHeaviest.h>
+#include <SwapHeavierToLighterNeighbours.h>
+#include <ReleaseHeavierToLighterNeighbours.h>
 #include <DomainPartitioner.h>
 #include <GraphPartitioner.h>
 #include <FEM_ObjectBrokerAllClasses.h>
@@ -594,6 +599,7 @@ static Timer* theTimer = 0;
 
 #include <FileStream.h>
 #include <SimulationInformation.h>
+#include <MemoryStats.h>
 SimulationInformation simulationInfo;
 SimulationInformation* theSimulationInfoPtr = 0;
 
@@ -661,6 +667,9 @@ opsRecv(ClientData clientData, Tcl_Interp* interp, int argc, TCL_Char** argv);
 int
 opsPartition(ClientData clientData, Tcl_Interp* interp, int argc, TCL_Char** argv);
 
+int
+opsLoadBalancer(ClientData clientData, Tcl_Interp* interp, int argc, TCL_Char** argv);
+
 
 int
 peerNGA(ClientData clientData, Tcl_Interp* interp, int argc, TCL_Char** argv);
@@ -690,6 +699,9 @@ convertBinaryToText(ClientData clientData, Tcl_Interp* interp, int argc, TCL_Cha
 int
 convertTextToBinary(ClientData clientData, Tcl_Interp* interp, int argc, TCL_Char** argv);
 
+int
+convertTimeSeries(ClientData clientData, Tcl_Interp* interp, int argc, TCL_Char** argv);
+
 int
 maxOpenFiles(ClientData clientData, Tcl_Interp* interp, int argc, TCL_Char** argv);
 
@@ -854,6 +866,8 @@ int OpenSeesAppInit(Tcl_Interp* interp) {
 		(ClientData)NULL, (Tcl_CmdDeleteProc*)NULL);
 	Tcl_CreateCommand(interp, "nodeEleConnects", &OPS_NodeEleConnectsCmd,
 		(ClientData)NULL, (Tcl_CmdDeleteProc*)NULL);
+	Tcl_CreateCommand(interp, "energyBalance", &OPS_EnergyBalanceCmd,
+		(ClientData)NULL, (Tcl_CmdDeleteProc*)NULL);
 #endif // _CSS
 
 	Tcl_CreateObjCommand(interp, "pset", &OPS_SetObjCmd,
@@ -886,6 +900,10 @@ int OpenSeesAppInit(Tcl_Interp* interp) {
 		(ClientData)NULL, (Tcl_CmdDeleteProc*)NULL);
 	Tcl_CreateCommand(interp, "getTime", &getTime,
 		(ClientData)NULL, (Tcl_CmdDeleteProc*)NULL);
+	Tcl_CreateCommand(interp, "memoryStats", &memoryStats,
+		(ClientData)NULL, (Tcl_CmdDeleteProc*)NULL);
+	Tcl_CreateCommand(interp, "nodalStatePool", &nodalStatePool,
+		(ClientData)NULL, (Tcl_CmdDeleteProc*)NULL);
 	Tcl_CreateCommand(interp, "getLoadFactor", &getLoadFactor,
 		(ClientData)NULL, (Tcl_CmdDeleteProc*)NULL);
 
@@ -1027,6 +1045,8 @@ int OpenSeesAppInit(Tcl_Interp* interp) {
 		(ClientData)NULL, (Tcl_CmdDeleteProc*)NULL);
 	Tcl_CreateCommand(interp, "partition", &opsPartition,
 		(ClientData)NULL, (Tcl_CmdDeleteProc*)NULL);
+	Tcl_CreateCommand(interp, "loadBalancer", &opsLoadBalancer,
+		(ClientData)NULL, (Tcl_CmdDeleteProc*)NULL);
 	Tcl_CreateCommand(interp, "searchPeerNGA", &peerNGA,
 		(ClientData)NULL, (Tcl_CmdDeleteProc*)NULL);
 
@@ -1038,6 +1058,7 @@ int OpenSeesAppInit(Tcl_Interp* interp) {
 	Tcl_CreateCommand(interp, "stripXML", &stripOpenSeesXML, (ClientData)NULL, NULL);
 	Tcl_CreateCommand(interp, "convertBinaryToText", &convertBinaryToText, (ClientData)NULL, NULL);
 	Tcl_CreateCommand(interp, "convertTextToBinary", &convertTextToBinary, (ClientData)NULL, NULL);
+	Tcl_CreateCommand(interp, "convertTimeSeries", &convertTimeSeries, (ClientData)NULL, NULL);
 
 	Tcl_CreateCommand(interp, "getEleTags", &getEleTags,
 		(ClientData)NULL, (Tcl_CmdDeleteProc*)NULL);
@@ -1720,6 +1741,34 @@ int OPS_NodeEleConnectsCmd(ClientData clientData, Tcl_Interp* interp, int argc,
 	return TCL_OK;
 
 }
+// energyBalance <on|off>
+//   turns the tracking of the energies of all the elements and of the work
+//   of the applied loads on or off; without arguments returns the kinetic,
+//   damping, hysteretic, input and motion energies of the domain
+int OPS_EnergyBalanceCmd(ClientData clientData, Tcl_Interp* interp, int argc, TCL_Char** argv)
+{
+	if (argc > 1) {
+		if (strcmp(argv[1], "on") == 0 || strcmp(argv[1], "1") == 0)
+			theDomain.setEnergyBalance(true);
+		else if (strcmp(argv[1], "off") == 0 || strcmp(argv[1], "0") == 0)
+			theDomain.setEnergyBalance(false);
+		else {
+			opserr << "WARNING energyBalance " << argv[1] << " - want on or off\n";
+			return TCL_ERROR;
+		}
+		return TCL_OK;
+	}
+
+	Vector energies(5);
+	theDomain.getEnergyBalance(energies);
+	char buffer[40];
+	for (int i = 0; i < 5; i++) {
+		sprintf(buffer, "%.16g ", energies(i));
+		Tcl_AppendResult(interp, buffer, NULL);
+	}
+
+	return TCL_OK;
+}
 int OPS_LogCommandsCmd(ClientData clientData, Tcl_Interp* interp, int argc, TCL_Char** argv)
 {
 	std::string file = "commandsLog.tcl";
@@ -1958,6 +2007,61 @@ getTime(ClientData clientData, Tcl_Interp* interp, int argc, TCL_Char** argv)
 	return TCL_OK;
 }
 
+int
+memoryStats(ClientData clientData, Tcl_Interp* interp, int argc, TCL_Char** argv)
+{
+	// memoryStats -on/-off switches the counting, which is off by default
+	if (argc > 1 && (strcmp(argv[1], "-on") == 0 || strcmp(argv[1], "-off") == 0)) {
+		MemoryStats::setEnabled(strcmp(argv[1], "-on") == 0);
+		return TCL_OK;
+	}
+
+	// print the report, to a file if one is given
+	if (argc > 1) {
+		FileStream outputFile;
+		if (outputFile.setFile(argv[1], OVERWRITE) < 0) {
+			opserr << "WARNING memoryStats " << argv[1] << " failed to set the file\n";
+			return TCL_ERROR;
+		}
+		MemoryStats::Print(outputFile);
+	}
+	else
+		MemoryStats::Print(opserr);
+
+	// return the live and peak heap, then the bytes of each subsystem
+	char buffer[40];
+	sprintf(buffer, "%.0f ", (double)MemoryStats::getLiveBytes());
+	Tcl_AppendResult(interp, buffer, NULL);
+	sprintf(buffer, "%.0f ", (double)MemoryStats::getPeakBytes());
+	Tcl_AppendResult(interp, buffer, NULL);
+	for (int i = 0; i < MemoryStats::NumSubsystems; i++) {
+		sprintf(buffer, "%.0f ", (double)MemoryStats::getBytes(i));
+		Tcl_AppendResult(interp, buffer, NULL);
+	}
+
+	return TCL_OK;
+}
+
+int
+nodalStatePool(ClientData clientData, Tcl_Interp* interp, int argc, TCL_Char** argv)
+{
+	if (argc < 2) {
+		opserr << "WARNING want - nodalStatePool on|off\n";
+		return TCL_ERROR;
+	}
+
+	if (strcmp(argv[1], "on") == 0 || strcmp(argv[1], "1") == 0)
+		theDomain.setNodalStatePool(true);
+	else if (strcmp(argv[1], "off") == 0 || strcmp(argv[1], "0") == 0)
+		theDomain.setNodalStatePool(false);
+	else {
+		opserr << "WARNING nodalStatePool " << argv[1] << " - want on or off\n";
+		return TCL_ERROR;
+	}
+
+	return TCL_OK;
+}
+
 int
 getLoadFactor(ClientData clientData, Tcl_Interp* interp, int argc, TCL_Char** argv)
 {
@@ -2109,10 +2213,11 @@ partitionModel(int eleTag)
 
 	// create a partitioner & partition the domain
 	if (OPS_DOMAIN_PARTITIONER == 0) {
-		//      OPS_BALANCER = new ShedHeaviest();
 		OPS_GRAPH_PARTITIONER = new Metis;
-		//OPS_DOMAIN_PARTITIONER = new DomainPartitioner(*OPS_GRAPH_PARTITIONER, *OPS_BALANCER);
-		OPS_DOMAIN_PARTITIONER = new DomainPartitioner(*OPS_GRAPH_PARTITIONER);
+		if (OPS_BALANCER != 0)
+			OPS_DOMAIN_PARTITIONER = new DomainPartitioner(*OPS_GRAPH_PARTITIONER, *OPS_BALANCER);
+		else
+			OPS_DOMAIN_PARTITIONER = new DomainPartitioner(*OPS_GRAPH_PARTITIONER);
 		theDomain.setPartitioner(OPS_DOMAIN_PARTITIONER);
 	}
 
@@ -2182,6 +2287,86 @@ opsPartition(ClientData clientData, Tcl_Interp* interp, int argc, TCL_Char** arg
 	return TCL_OK;
 }
 
+//
+// command invoked to set the LoadBalancer used to migrate elements between
+// the subdomains at commit when their measured costs are out of balance
+//  loadBalancer type? <-threshold $t> <-factor $f> <-numReleases $n>
+//
+int
+opsLoadBalancer(ClientData clientData, Tcl_Interp* interp, int argc, TCL_Char** argv)
+{
+#ifdef _CSS
+	printArgv(interp, argc, argv); //SAJalali
+#endif // _CSS
+#ifdef _PARALLEL_PROCESSING
+	if (argc < 2) {
+		opserr << "WARNING want - loadBalancer type? <-threshold $t> <-factor $f> <-numReleases $n>\n";
+		return TCL_ERROR;
+	}
+
+	if (OPS_DOMAIN_PARTITIONER != 0) {
+		opserr << "WARNING loadBalancer - must be defined before the model is partitioned\n";
+		return TCL_ERROR;
+	}
+
+	double threshold = 0.0;
+	double factor = 1.0;
+	int numReleases = 1;
+
+	int argPos = 2;
+	while (argPos < argc) {
+		if (strcmp(argv[argPos], "-threshold") == 0 && argPos + 1 < argc) {
+			if (Tcl_GetDouble(interp, argv[argPos + 1], &threshold) != TCL_OK) {
+				opserr << "WARNING loadBalancer - invalid threshold " << argv[argPos + 1] << endln;
+				return TCL_ERROR;
+			}
+			argPos += 2;
+		}
+		else if (strcmp(argv[argPos], "-factor") == 0 && argPos + 1 < argc) {
+			if (Tcl_GetDouble(interp, argv[argPos + 1], &factor) != TCL_OK) {
+				opserr << "WARNING loadBalancer - invalid factor " << argv[argPos + 1] << endln;
+				return TCL_ERROR;
+			}
+			argPos += 2;
+		}
+		else if (strcmp(argv[argPos], "-numReleases") == 0 && argPos + 1 < argc) {
+			if (Tcl_GetInt(interp, argv[argPos + 1], &numReleases) != TCL_OK) {
+				opserr << "WARNING loadBalancer - invalid numReleases " << argv[argPos + 1] << endln;
+				return TCL_ERROR;
+			}
+			argPos += 2;
+		}
+		else {
+			opserr << "WARNING loadBalancer - unknown option " << argv[argPos] << endln;
+			return TCL_ERROR;
+		}
+	}
+
+	LoadBalancer* theBalancer = 0;
+	if (strcmp(argv[1], "ShedHeaviest") == 0)
+		theBalancer = new ShedHeaviest(factor, numReleases, true);
+	else if (strcmp(argv[1], "SwapHeavierToLighterNeighbours") == 0)
+		theBalancer = new SwapHeavierToLighterNeighbours(factor, numReleases);
+	else if (strcmp(argv[1], "ReleaseHeavierToLighterNeighbours") == 0)
+		theBalancer = new ReleaseHeavierToLighterNeighbours(factor, numReleases, true);
+	else {
+		opserr << "WARNING loadBalancer - unknown type " << argv[1] << endln;
+		return TCL_ERROR;
+	}
+
+	theBalancer->setImbalanceThreshold(threshold);
+
+	if (OPS_BALANCER != 0)
+		delete OPS_BALANCER;
+	OPS_BALANCER = theBalancer;
+
+	return TCL_OK;
+#else
+	opserr << "WARNING loadBalancer - only available in the parallel interpreter\n";
+	return TCL_ERROR;
+#endif
+}
+
 //
 // command invoked to build the model, i.e. to invoke analyze() 
 // on the Analysis object
@@ -3871,6 +4056,21 @@ specifySOE(ClientData clientData, Tcl_Interp* interp, int argc, TCL_Char** argv)
 
 #endif
 
+	// SPARSE GENERAL SOE * PRECONDITIONED KRYLOV SOLVER
+	else if (strcmp(argv[1], "Krylov") == 0) {
+		OPS_ResetInputNoBuilder(clientData, interp, 2, argc, argv, &theDomain);
+		theSOE = (LinearSOE*)OPS_KrylovSolver();
+		if (theSOE == 0)
+			return TCL_ERROR;
+	}
+
+	// MATRIX FREE SOE & KRYLOV SOLVER
+	else if (strcmp(argv[1], "ElementByElement") == 0 || strcmp(argv[1], "MatrixFree") == 0) {
+		OPS_ResetInputNoBuilder(clientData, interp, 2, argc, argv, &theDomain);
+		theSOE = (LinearSOE*)OPS_ElementByElementSolver();
+		if (theSOE == 0)
+			return TCL_ERROR;
+	}
 
 	else {
 
@@ -10652,6 +10852,47 @@ int convertTextToBinary(ClientData clientData, Tcl_Interp* interp, int argc, TCL
 	return textToBinary(inputFile, outputFile);
 }
 
+// convertTimeSeries textFile binaryFile <-dt dt? <-startTime t0?>>
+//   writes the binary record read by timeSeries Mapped; without -dt the
+//   first column of the text file holds the times
+int convertTimeSeries(ClientData clientData, Tcl_Interp* interp, int argc, TCL_Char** argv)
+{
+#ifdef _CSS
+	printArgv(interp, argc, argv); //SAJalali
+#endif // _CSS
+
+	if (argc < 3) {
+		opserr << "WARNING incorrect # args - convertTimeSeries textFile binaryFile <-dt dt?> <-startTime t0?>\n";
+		return TCL_ERROR;
+	}
+
+	double dt = 0.0;
+	double startTime = 0.0;
+	for (int i = 3; i < argc; i++) {
+		if (strcmp(argv[i], "-dt") == 0 && i + 1 < argc) {
+			if (Tcl_GetDouble(interp, argv[++i], &dt) != TCL_OK) {
+				opserr << "WARNING convertTimeSeries - invalid dt " << argv[i] << endln;
+				return TCL_ERROR;
+			}
+		}
+		else if (strcmp(argv[i], "-startTime") == 0 && i + 1 < argc) {
+			if (Tcl_GetDouble(interp, argv[++i], &startTime) != TCL_OK) {
+				opserr << "WARNING convertTimeSeries - invalid startTime " << argv[i] << endln;
+				return TCL_ERROR;
+			}
+		}
+		else {
+			opserr << "WARNING convertTimeSeries - unknown option " << argv[i] << endln;
+			return TCL_ERROR;
+		}
+	}
+
+	if (MappedTimeSeries::convertTextFile(argv[1], argv[2], dt, startTime) < 0)
+		return TCL_ERROR;
+
+	return TCL_OK;
+}
+
 int domainChange(ClientData clientData, Tcl_Interp* interp, int argc, TCL_Char** argv)
 {
 #ifdef _CSS
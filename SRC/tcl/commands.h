@@ -41,6 +41,7 @@ int OPS_recorderValue(ClientData clientData, Tcl_Interp *interp, int argc, TCL_C
 int printArgv(Tcl_Interp* interp, int argc, TCL_Char** argv, bool hasBlock = false);
 int OPS_LogCommandsCmd(ClientData clientData, Tcl_Interp* interp, int argc, TCL_Char** argv);
 int OPS_NodeEleConnectsCmd(ClientData clientData, Tcl_Interp* interp, int argc, TCL_Char** argv);
+int OPS_EnergyBalanceCmd(ClientData clientData, Tcl_Interp* interp, int argc, TCL_Char** argv);
 
 #endif // _CSS
 
@@ -83,6 +84,12 @@ setTime(ClientData clientData, Tcl_Interp *interp, int argc, TCL_Char **argv);
 int 
 getTime(ClientData clientData, Tcl_Interp *interp, int argc, TCL_Char **argv);
 
+int 
+memoryStats(ClientData clientData, Tcl_Interp *interp, int argc, TCL_Char **argv);
+
+int 
+nodalStatePool(ClientData clientData, Tcl_Interp *interp, int argc, TCL_Char **argv);
+
 int 
 getLoadFactor(ClientData clientData, Tcl_Interp *interp, int argc, TCL_Char **argv);
 
@@ -0,0 +1,492 @@
+"""
+Benchmarks of the analysis hot paths.
+
+Each benchmark builds a representative model through the Python interpreter
+and times its phases (model building, gravity, eigen, transient, remeshing,
+...). For every phase the wall and cpu times are reported together with the
+solver statistics (steps, failed steps, iterations, number of equations), and
+for every benchmark the peak resident set size of the process and the objects
+and bytes the memoryStats command charged to each subsystem (the bytes are
+only counted by a build with -D_MEMORY_STATS).
+
+    python benchmark.py                       run all benchmarks
+    python benchmark.py frame shell           run some of them
+    python benchmark.py -o results.json       save the results
+    python benchmark.py -c baseline.json      compare with saved results
+
+Each benchmark runs in its own process, so that the peak memory is measured per
+model. A benchmark whose process exits with an error is reported as failed,
+together with the end of its error output. When comparing with a baseline the script exits with status 1 if a phase
+is slower than the baseline by more than the tolerance (-t, default 0.10).
+"""
+
+import os
+import sys
+import json
+import time
+import platform
+import argparse
+import subprocess
+import tempfile
+
+TEST_DIR = os.path.dirname(os.path.abspath(__file__)) + "/"
+INTERPRETER_PATH = TEST_DIR + "../interpreter/"
+sys.path.append(INTERPRETER_PATH)
+
+
+class Phases:
+    """collects the timings and solver statistics of the phases of a benchmark"""
+
+    def __init__(self):
+        self.phases = []
+        self.current = None
+
+    def start(self, name):
+        self.current = {'name': name, 'steps': 0, 'failed_steps': 0, 'iterations': 0, 'equations': 0,
+                        '_wall': time.perf_counter(), '_cpu': time.process_time()}
+
+    def step(self, opy, ok):
+        # one analysis step, with its number of iterations
+        self.current['steps'] += 1
+        if ok < 0:
+            self.current['failed_steps'] += 1
+        self.current['iterations'] += opy.testIter()
+        self.current['equations'] = opy.systemSize()
+
+    def stop(self):
+        p = self.current
+        p['wall'] = time.perf_counter() - p.pop('_wall')
+        p['cpu'] = time.process_time() - p.pop('_cpu')
+        self.phases.append(p)
+        self.current = None
+
+
+def analyze(opy, phases, num_steps, *args):
+    for i in range(num_steps):
+        phases.step(opy, opy.analyze(1, *args))
+
+
+def bench_frame(opy, phases):
+    # 3D moment frame of fiber force-based beam-columns, gravity then ground motion
+    nbay, nstory = 4, 8
+    bay, height = 6.0, 3.5
+    phases.start('model')
+    opy.wipe()
+    opy.model('basic', '-ndm', 3, '-ndf', 6)
+    def tag(i, j, k):
+        return 1 + i + j * (nbay + 1) + k * (nbay + 1) ** 2
+    for k in range(nstory + 1):
+        for j in range(nbay + 1):
+            for i in range(nbay + 1):
+                opy.node(tag(i, j, k), i * bay, j * bay, k * height)
+                if k == 0:
+                    opy.fix(tag(i, j, k), 1, 1, 1, 1, 1, 1)
+                else:
+                    opy.mass(tag(i, j, k), 10.0, 10.0, 10.0, 0.0, 0.0, 0.0)
+    opy.uniaxialMaterial('Concrete01', 1, -30.0e3, -0.002, -6.0e3, -0.006)
+    opy.uniaxialMaterial('Steel02', 2, 420.0e3, 200.0e6, 0.01, 18.0, 0.925, 0.15)
+    opy.section('Fiber', 1, '-GJ', 1.0e6)
+    opy.patch('rect', 1, 10, 10, -0.25, -0.25, 0.25, 0.25)
+    opy.layer('straight', 2, 4, 5.0e-4, -0.21, -0.21, -0.21, 0.21)
+    opy.layer('straight', 2, 4, 5.0e-4, 0.21, -0.21, 0.21, 0.21)
+    opy.geomTransf('PDelta', 1, 1.0, 0.0, 0.0)
+    opy.geomTransf('Linear', 2, 0.0, 0.0, 1.0)
+    opy.beamIntegration('Lobatto', 1, 1, 5)
+    ele = 1
+    for k in range(nstory):
+        for j in range(nbay + 1):
+            for i in range(nbay + 1):
+                opy.element('forceBeamColumn', ele, tag(i, j, k), tag(i, j, k + 1), 1, 1)
+                ele += 1
+    for k in range(1, nstory + 1):
+        for j in range(nbay + 1):
+            for i in range(nbay):
+                opy.element('forceBeamColumn', ele, tag(i, j, k), tag(i + 1, j, k), 2, 1)
+                ele += 1
+        for i in range(nbay + 1):
+            for j in range(nbay):
+                opy.element('forceBeamColumn', ele, tag(i, j, k), tag(i, j + 1, k), 2, 1)
+                ele += 1
+    phases.stop()
+
+    phases.start('gravity')
+    opy.timeSeries('Linear', 1)
+    opy.pattern('Plain', 1, 1)
+    for k in range(1, nstory + 1):
+        for j in range(nbay + 1):
+            for i in range(nbay + 1):
+                opy.load(tag(i, j, k), 0.0, 0.0, -100.0, 0.0, 0.0, 0.0)
+    opy.constraints('Plain')
+    opy.numberer('RCM')
+    opy.system('UmfPack')
+    opy.test('NormDispIncr', 1.0e-8, 20)
+    opy.algorithm('Newton')
+    opy.integrator('LoadControl', 0.1)
+    opy.analysis('Static')
+    analyze(opy, phases, 10)
+    opy.loadConst('-time', 0.0)
+    phases.stop()
+
+    phases.start('transient')
+    opy.rayleigh(0.0, 0.0, 0.0, 0.002)
+    opy.timeSeries('Trig', 2, 0.0, 10.0, 0.5, '-factor', 3.0)
+    opy.pattern('UniformExcitation', 2, 1, '-accel', 2)
+    opy.wipeAnalysis()
+    opy.constraints('Plain')
+    opy.numberer('RCM')
+    opy.system('UmfPack')
+    opy.test('NormDispIncr', 1.0e-8, 20)
+    opy.algorithm('Newton')
+    opy.integrator('Newmark', 0.5, 0.25)
+    opy.analysis('Transient')
+    analyze(opy, phases, 200, 0.01)
+    phases.stop()
+
+
+def bench_shell(opy, phases):
+    # core-wall building of ASDShellQ4 walls and slabs, eigen then ground motion
+    n, nstory, nsub = 8, 10, 2
+    size, height = 16.0, 3.2
+    phases.start('model')
+    opy.wipe()
+    opy.model('basic', '-ndm', 3, '-ndf', 6)
+    opy.section('ElasticMembranePlateSection', 1, 30.0e6, 0.2, 0.3, 2.5)
+    opy.section('ElasticMembranePlateSection', 2, 30.0e6, 0.2, 0.2, 2.5)
+    perimeter = [(i, 0) for i in range(n)] + [(n, j) for j in range(n)] + \
+                [(i, n) for i in range(n, 0, -1)] + [(0, j) for j in range(n, 0, -1)]
+    nodes = {}
+    def node(i, j, k):
+        key = (i, j, k)
+        if key not in nodes:
+            nodes[key] = len(nodes) + 1
+            opy.node(nodes[key], i * size / n, j * size / n, k * height / nsub)
+            if k == 0:
+                opy.fix(nodes[key], 1, 1, 1, 1, 1, 1)
+        return nodes[key]
+    ele = 1
+    for k in range(nstory * nsub):
+        for a in range(len(perimeter)):
+            (ia, ja), (ib, jb) = perimeter[a], perimeter[(a + 1) % len(perimeter)]
+            opy.element('ASDShellQ4', ele, node(ia, ja, k), node(ib, jb, k), node(ib, jb, k + 1), node(ia, ja, k + 1), 1)
+            ele += 1
+    for s in range(1, nstory + 1):
+        k = s * nsub
+        for j in range(n):
+            for i in range(n):
+                opy.element('ASDShellQ4', ele, node(i, j, k), node(i + 1, j, k), node(i + 1, j + 1, k), node(i, j + 1, k), 2)
+                ele += 1
+    phases.stop()
+
+    phases.start('eigen')
+    opy.eigen(10)
+    phases.stop()
+
+    phases.start('transient')
+    opy.rayleigh(0.0, 0.0, 0.0, 0.002)
+    opy.timeSeries('Trig', 1, 0.0, 10.0, 0.4, '-factor', 2.0)
+    opy.pattern('UniformExcitation', 1, 1, '-accel', 1)
+    opy.constraints('Plain')
+    opy.numberer('RCM')
+    opy.system('UmfPack')
+    opy.test('NormDispIncr', 1.0e-8, 20)
+    opy.algorithm('Newton')
+    opy.integrator('Newmark', 0.5, 0.25)
+    opy.analysis('Transient')
+    analyze(opy, phases, 100, 0.01)
+    phases.stop()
+
+
+def bench_soil(opy, phases):
+    # 3D soil block of SSPbrick elements, elastic gravity then plastic shaking
+    nx, ny, nz = 10, 10, 10
+    size = 1.0
+    phases.start('model')
+    opy.wipe()
+    opy.model('basic', '-ndm', 3, '-ndf', 3)
+    def tag(i, j, k):
+        return 1 + i + j * (nx + 1) + k * (nx + 1) * (ny + 1)
+    for k in range(nz + 1):
+        for j in range(ny + 1):
+            for i in range(nx + 1):
+                opy.node(tag(i, j, k), i * size, j * size, k * size)
+                if k == 0:
+                    opy.fix(tag(i, j, k), 1, 1, 1)
+    # periodic lateral boundaries
+    for k in range(1, nz + 1):
+        for j in range(ny + 1):
+            opy.equalDOF(tag(0, j, k), tag(nx, j, k), 1, 2, 3)
+        for i in range(1, nx):
+            opy.equalDOF(tag(i, 0, k), tag(i, ny, k), 1, 2, 3)
+    opy.nDMaterial('PressureDependMultiYield02', 1, 3, 1.9, 9.0e4, 2.2e5, 32.0, 0.1, 101.0, 0.5,
+                   26.0, 0.067, 0.23, 0.06, 0.27)
+    ele = 1
+    for k in range(nz):
+        for j in range(ny):
+            for i in range(nx):
+                opy.element('SSPbrick', ele, tag(i, j, k), tag(i + 1, j, k), tag(i + 1, j + 1, k), tag(i, j + 1, k),
+                            tag(i, j, k + 1), tag(i + 1, j, k + 1), tag(i + 1, j + 1, k + 1), tag(i, j + 1, k + 1),
+                            1, 0.0, 0.0, -9.81 * 1.9)
+                ele += 1
+    phases.stop()
+
+    phases.start('gravity')
+    opy.updateMaterialStage('-material', 1, '-stage', 0)
+    opy.constraints('Transformation')
+    opy.numberer('RCM')
+    opy.system('UmfPack')
+    opy.test('NormDispIncr', 1.0e-6, 30)
+    opy.algorithm('Newton')
+    opy.integrator('Newmark', 0.5, 0.25)
+    opy.analysis('Transient')
+    analyze(opy, phases, 10, 1.0e2)
+    opy.updateMaterialStage('-material', 1, '-stage', 1)
+    analyze(opy, phases, 10, 1.0e2)
+    opy.setTime(0.0)
+    opy.wipeAnalysis()
+    phases.stop()
+
+    phases.start('transient')
+    opy.timeSeries('Trig', 1, 0.0, 10.0, 0.5, '-factor', 2.0)
+    opy.pattern('UniformExcitation', 1, 1, '-accel', 1)
+    opy.constraints('Transformation')
+    opy.numberer('RCM')
+    opy.system('UmfPack')
+    opy.test('NormDispIncr', 1.0e-6, 30)
+    opy.algorithm('Newton')
+    opy.integrator('Newmark', 0.5, 0.25)
+    opy.analysis('Transient')
+    analyze(opy, phases, 100, 0.01)
+    phases.stop()
+
+
+def bench_pfem(opy, phases):
+    # 2D dam break with the background mesh of the particle finite element method
+    L, H, h = 0.146, 0.292, 0.0073
+    rho, mu, b2, g = 1000.0, 1.0e-4, -9.81, 9.81
+    phases.start('model')
+    opy.wipe()
+    opy.model('basic', '-ndm', 2, '-ndf', 2)
+    opy.mesh('part', 1, 'quad', 0.0, 0.0, L, 0.0, L, H, 0.0, H, int(L / h), int(H / h),
+             'PFEMElementBubble', rho, mu, 0.0, b2, 1.0, 2.2e9, '-vel', 0.0, 0.0, '-pressure', 0.0)
+    opy.node(100001, 4.0 * L, 0.0)
+    opy.node(100002, 4.0 * L, 2.0 * H)
+    opy.node(100003, -h / 2.0, 2.0 * H)
+    opy.node(100004, -h / 2.0, 0.0)
+    opy.mesh('line', 2, 4, 100003, 100004, 100001, 100002, 2, 2, h)
+    wall = opy.getNodeTags('-mesh', 2)
+    for nd in wall:
+        opy.fix(nd, 1, 1)
+    opy.mesh('bg', h, -h, -h, 4.0 * L + h, 2.0 * H + h, '-structure', 2, len(wall), *wall)
+    phases.stop()
+
+    phases.start('transient')
+    opy.constraints('Plain')
+    opy.numberer('Plain')
+    opy.system('PFEM', '-umfpack')
+    opy.test('PFEM', 1.0e-5, 1.0e-5, 1.0e-5, 1.0e-5, 1.0e-15, 1.0e-15, 20, 3, 1, 2)
+    opy.algorithm('Newton')
+    opy.integrator('PFEM', 0.5, 0.25)
+    opy.analysis('PFEM', 1.0e-3, 1.0e-6, g)
+    remesh = 0.0
+    while opy.getTime() < 0.1:
+        phases.step(opy, opy.analyze())
+        t0 = time.perf_counter()
+        opy.remesh()
+        remesh += time.perf_counter() - t0
+    phases.stop()
+    phases.phases[-1]['remesh'] = remesh
+
+
+def bench_form(opy, phases):
+    # FORM analysis of an elastic cantilever frame with lognormal stiffness and load
+    phases.start('model')
+    opy.wipe()
+    opy.model('basic', '-ndm', 2, '-ndf', 3)
+    nele = 20
+    for i in range(nele + 1):
+        opy.node(i + 1, 0.0, i * 0.5)
+    opy.fix(1, 1, 1, 1)
+    opy.geomTransf('Linear', 1)
+    for i in range(nele):
+        opy.element('elasticBeamColumn', i + 1, i + 1, i + 2, 0.09, 29.0e6, 6.75e-4, 1)
+    opy.timeSeries('Linear', 1)
+    opy.pattern('Plain', 1, 1)
+    opy.load(nele + 1, 10.0, 0.0, 0.0)
+    opy.randomVariable(1, 'lognormal', '-mean', 29.0e6, '-stdv', 2.9e6)
+    opy.randomVariable(2, 'lognormal', '-mean', 10.0, '-stdv', 2.0)
+    opy.parameter(1, 'randomVariable', 1)
+    for i in range(nele):
+        opy.addToParameter(1, 'element', i + 1, 'E')
+    opy.parameter(2, 'randomVariable', 2, 'loadPattern', 1, 'loadAtNode', nele + 1, 1)
+    opy.constraints('Transformation')
+    opy.numberer('RCM')
+    opy.system('BandGeneral')
+    opy.test('NormDispIncr', 1.0e-10, 10)
+    opy.algorithm('Newton')
+    opy.integrator('LoadControl', 1.0)
+    opy.analysis('Static')
+    opy.performanceFunction(1, '0.02 - {u_%d_1}' % (nele + 1))
+    opy.probabilityTransformation('Nataf')
+    opy.reliabilityConvergenceCheck('Standard', '-e1', 1.0e-3, '-e2', 1.0e-3)
+    opy.functionEvaluator('Python', '-file', 'opensees.analyze(1)')
+    opy.gradientEvaluator('FiniteDifference')
+    opy.searchDirection('iHLRF')
+    opy.meritFunctionCheck('AdkZhang', '-multi', 2.0, '-add', 10.0, '-factor', 0.5)
+    opy.stepSizeRule('Armijo', '-maxNum', 5, '-base', 0.5, '-initial', 1.0, 2)
+    opy.startPoint('Mean')
+    opy.findDesignPoint('StepSearch', '-maxNumIter', 30)
+    phases.stop()
+
+    phases.start('form')
+    opy.runFORMAnalysis(os.path.join(tempfile.gettempdir(), 'benchmark_form.out'))
+    phases.stop()
+
+
+BENCHMARKS = {
+    'frame': bench_frame,
+    'shell': bench_shell,
+    'soil': bench_soil,
+    'pfem': bench_pfem,
+    'form': bench_form,
+}
+
+
+def peak_rss():
+    # peak resident set size in bytes (None where it is not available)
+    try:
+        import resource
+    except ImportError:
+        return None
+    rss = resource.getrusage(resource.RUSAGE_SELF).ru_maxrss
+    return rss if sys.platform == 'darwin' else rss * 1024
+
+
+def memory_stats(opy):
+    # objects and bytes charged to each subsystem and class by the memoryStats command
+    path = os.path.join(tempfile.gettempdir(), 'benchmark_memory_%d.txt' % os.getpid())
+    values = opy.memoryStats(path)
+    stats = {'live_bytes': values[0], 'peak_bytes': values[1], 'subsystems': {}, 'classes': []}
+    with open(path) as f:
+        for line in f:
+            # fixed width columns: subsystem, class, then classTag, number and bytes
+            if len(line) < 50 or line.startswith('subsystem'):
+                continue
+            subsystem, cls, fields = line[:16].strip(), line[17:49].strip(), line[49:].split()
+            if cls == 'total' and len(fields) == 2:
+                stats['subsystems'][subsystem] = {'objects': int(fields[0]), 'bytes': int(fields[1])}
+            elif len(fields) == 4:
+                stats['classes'].append({'subsystem': subsystem, 'class': cls, 'classTag': int(fields[0]),
+                                         'objects': int(fields[1]), 'bytes': int(fields[2])})
+    os.remove(path)
+    return stats
+
+
+def run_one(name):
+    # runs a single benchmark in this process and prints its results
+    import opensees as opy
+    phases = Phases()
+    result = {'name': name, 'ok': True}
+    # the memory counts are only kept once switched on
+    opy.memoryStats('-on')
+    t0 = time.perf_counter()
+    try:
+        BENCHMARKS[name](opy, phases)
+    except Exception as e:
+        result['ok'] = False
+        result['error'] = str(e)
+    result['wall'] = time.perf_counter() - t0
+    result['phases'] = phases.phases
+    result['peak_rss'] = peak_rss()
+    try:
+        result['memory'] = memory_stats(opy)
+    except Exception as e:
+        result['ok'] = False
+        result['error'] = 'memoryStats: %s' % e
+    opy.wipe()
+    print('BENCHMARK ' + json.dumps(result))
+
+
+def run_all(names):
+    results = []
+    for name in names:
+        out = subprocess.run([sys.executable, os.path.abspath(__file__), '--run', name],
+                             stdout=subprocess.PIPE, stderr=subprocess.PIPE, universal_newlines=True)
+        lines = [l for l in out.stdout.splitlines() if l.startswith('BENCHMARK ')]
+        if lines:
+            result = json.loads(lines[-1][len('BENCHMARK '):])
+        else:
+            result = {'name': name, 'ok': False, 'error': 'no results', 'phases': []}
+        if out.returncode != 0:
+            # a crash or an interpreter error, the timings of the run mean nothing
+            result['ok'] = False
+            result['error'] = 'exit status %d' % out.returncode
+        print('%-8s %s' % (name, 'ok' if result['ok'] else 'FAILED (%s)' % result.get('error')))
+        if not result['ok']:
+            for l in out.stderr.splitlines()[-20:]:
+                print('    | ' + l)
+        for p in result['phases']:
+            print('    %-12s wall %8.3f s  cpu %8.3f s  steps %6d  iter %7d  neq %7d' %
+                  (p['name'], p['wall'], p['cpu'], p['steps'], p['iterations'], p['equations']))
+        if result.get('peak_rss'):
+            print('    peak rss %.1f MB' % (result['peak_rss'] / 1048576.0))
+        memory = result.get('memory')
+        if memory:
+            for subsystem, s in sorted(memory['subsystems'].items()):
+                print('    %-16s objects %9d  bytes %12d' % (subsystem, s['objects'], s['bytes']))
+        results.append(result)
+    return results
+
+
+def compare(results, baseline, tolerance):
+    # returns the list of phases slower than the baseline by more than tolerance
+    slower = []
+    base = {(b['name'], p['name']): p for b in baseline['benchmarks'] for p in b['phases']}
+    for r in results:
+        for p in r['phases']:
+            b = base.get((r['name'], p['name']))
+            if b is None or b['wall'] <= 0.0:
+                continue
+            ratio = p['wall'] / b['wall']
+            if ratio > 1.0 + tolerance:
+                slower.append((r['name'], p['name'], b['wall'], p['wall'], ratio))
+    return slower
+
+
+def main():
+    parser = argparse.ArgumentParser(description='OpenSees benchmarks')
+    parser.add_argument('names', nargs='*', help='benchmarks to run (%s)' % ', '.join(BENCHMARKS))
+    parser.add_argument('-o', '--output', help='save the results to this json file')
+    parser.add_argument('-c', '--compare', help='compare with the results in this json file')
+    parser.add_argument('-t', '--tolerance', type=float, default=0.10, help='allowed slowdown (default 0.10)')
+    parser.add_argument('--run', help=argparse.SUPPRESS)
+    args = parser.parse_args()
+
+    if args.run:
+        run_one(args.run)
+        return 0
+
+    names = args.names or list(BENCHMARKS)
+    for name in names:
+        if name not in BENCHMARKS:
+            print('unknown benchmark %s' % name)
+            return 2
+
+    results = run_all(names)
+    report = {'platform': platform.platform(), 'python': platform.python_version(),
+              'date': time.strftime('%Y-%m-%d %H:%M:%S'), 'benchmarks': results}
+    if args.output:
+        with open(args.output, 'w') as f:
+            json.dump(report, f, indent=1)
+
+    status = 0 if all(r['ok'] for r in results) else 1
+    if args.compare:
+        with open(args.compare) as f:
+            baseline = json.load(f)
+        for name, phase, t_base, t_new, ratio in compare(results, baseline, args.tolerance):
+            print('SLOWER %s/%s: %.3f s -> %.3f s (x%.2f)' % (name, phase, t_base, t_new, ratio))
+            status = 1
+    return status
+
+
+if __name__ == '__main__':
+    sys.exit(main())
@@ -0,0 +1,88 @@
+/**
+ * Known-answer test of the Philox4x32-10 bijection used by
+ * PhiloxRandGenerator, with the philox4x32 10 vectors of the Random123
+ * distribution (kat_vectors). It needs no other part of OpenSees:
+ *
+ *   c++ -I../reliability/analysis/randomNumber test_philox.cpp -o test_philox
+ *   ./test_philox
+ *
+ * The exit status is 0 if all the vectors pass.
+ */
+
+#include <Philox4x32.h>
+#include <stdio.h>
+
+struct PhiloxKAT {
+  unsigned int ctr[4];
+  unsigned int key[2];
+  unsigned int expected[4];
+};
+
+static const PhiloxKAT katVectors[] = {
+  {{0x00000000u, 0x00000000u, 0x00000000u, 0x00000000u},
+   {0x00000000u, 0x00000000u},
+   {0x6627e8d5u, 0xe169c58du, 0xbc57ac4cu, 0x9b00dbd8u}},
+  {{0xffffffffu, 0xffffffffu, 0xffffffffu, 0xffffffffu},
+   {0xffffffffu, 0xffffffffu},
+   {0x408f276du, 0x41c83b0eu, 0xa20bc7c6u, 0x6d5451fdu}},
+  {{0x243f6a88u, 0x85a308d3u, 0x13198a2eu, 0x03707344u},
+   {0xa4093822u, 0x299f31d0u},
+   {0xd16cfe09u, 0x94fdccebu, 0x5001e420u, 0x24126ea1u}},
+};
+
+static const int numVectors = sizeof(katVectors)/sizeof(katVectors[0]);
+
+// each vector on its own
+static bool
+test_single(void)
+{
+  bool ok = true;
+  for (int v = 0; v < numVectors; v++) {
+    const PhiloxKAT &kat = katVectors[v];
+    unsigned int c0 = kat.ctr[0], c1 = kat.ctr[1], c2 = kat.ctr[2], c3 = kat.ctr[3];
+    philox4x32_10(&c0, &c1, &c2, &c3, 1, kat.key[0], kat.key[1]);
+    if (c0 != kat.expected[0] || c1 != kat.expected[1] ||
+        c2 != kat.expected[2] || c3 != kat.expected[3]) {
+      printf("vector %d: got %08x %08x %08x %08x, expected %08x %08x %08x %08x\n", v,
+             c0, c1, c2, c3, kat.expected[0], kat.expected[1], kat.expected[2], kat.expected[3]);
+      ok = false;
+    }
+  }
+  return ok;
+}
+
+// a batch of counters with the same key, as the generator encrypts them
+static bool
+test_batch(void)
+{
+  const int num = 37;
+  unsigned int c0[num], c1[num], c2[num], c3[num];
+  const PhiloxKAT &kat = katVectors[2];
+  for (int i = 0; i < num; i++) {
+    c0[i] = (i % 2 == 0) ? kat.ctr[0] : (unsigned int)i;
+    c1[i] = kat.ctr[1];
+    c2[i] = kat.ctr[2];
+    c3[i] = kat.ctr[3];
+  }
+  philox4x32_10(c0, c1, c2, c3, num, kat.key[0], kat.key[1]);
+
+  bool ok = true;
+  for (int i = 0; i < num; i += 2) {
+    if (c0[i] != kat.expected[0] || c1[i] != kat.expected[1] ||
+        c2[i] != kat.expected[2] || c3[i] != kat.expected[3]) {
+      printf("batch block %d does not match vector 2\n", i);
+      ok = false;
+    }
+  }
+  return ok;
+}
+
+int
+main(void)
+{
+  bool single = test_single();
+  bool batch = test_batch();
+  printf("philox4x32-10 known-answer vectors: %s\n", single ? "passed" : "FAILED");
+  printf("philox4x32-10 batch: %s\n", batch ? "passed" : "FAILED");
+  return (single && batch) ? 0 : 1;
+}
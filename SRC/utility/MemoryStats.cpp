@@ -0,0 +1,365 @@
+/* ****************************************************************** **
+**    OpenSees - Open System for Earthquake Engineering Simulation    **
+**          Pacific Earthquake Engineering Research Center            **
+**                                                                    **
+**                                                                    **
+** (C) Copyright 1999, The Regents of the University of California    **
+** All Rights Reserved.                                               **
+**                                                                    **
+** Commercial use of this program without express permission of the   **
+** University of California, Berkeley, is strictly prohibited.  See   **
+** file 'COPYRIGHT'  in main directory for information on usage and   **
+** redistribution,  and for a DISCLAIMER OF ALL WARRANTIES.           **
+**                                                                    **
+** Developed by:                                                      **
+**   Frank McKenna (fmckenna@ce.berkeley.edu)                         **
+**   Gregory L. Fenves (fenves@ce.berkeley.edu)                       **
+**   Filip C. Filippou (filippou@ce.berkeley.edu)                     **
+**                                                                    **
+** ****************************************************************** */
+
+// File: ~/utility/MemoryStats.cpp
+//
+// Description: This file contains the implementation of MemoryStats and,
+// in an instrumented build, the counting global operator new and delete.
+
+#include <MemoryStats.h>
+#include <OPS_Globals.h>
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <atomic>
+#include <map>
+#include <mutex>
+#include <new>
+#include <string>
+
+#ifndef _WIN32
+#include <sys/resource.h>
+#endif
+
+static std::atomic<long long> liveBytes(0);
+static std::atomic<long long> peakBytes(0);
+
+#ifdef _MEMORY_STATS
+
+// each block starts with its size; the header keeps the alignment
+// malloc gives the block
+static const size_t headerSize = 16;
+
+static void *
+countedAlloc(size_t numBytes)
+{
+  char *block = (char *)malloc(numBytes + headerSize);
+  if (block == 0)
+    return 0;
+  *(size_t *)block = numBytes;
+
+  long long live = liveBytes.fetch_add((long long)numBytes, std::memory_order_relaxed) + (long long)numBytes;
+  long long peak = peakBytes.load(std::memory_order_relaxed);
+  while (live > peak && !peakBytes.compare_exchange_weak(peak, live, std::memory_order_relaxed))
+    ;
+
+  return block + headerSize;
+}
+
+static void
+countedFree(void *p)
+{
+  if (p == 0)
+    return;
+  char *block = (char *)p - headerSize;
+  liveBytes.fetch_sub((long long)(*(size_t *)block), std::memory_order_relaxed);
+  free(block);
+}
+
+void *operator new(size_t numBytes)
+{
+  void *p = countedAlloc(numBytes != 0 ? numBytes : 1);
+  if (p == 0)
+    throw std::bad_alloc();
+  return p;
+}
+
+void *operator new[](size_t numBytes)
+{
+  void *p = countedAlloc(numBytes != 0 ? numBytes : 1);
+  if (p == 0)
+    throw std::bad_alloc();
+  return p;
+}
+
+void *operator new(size_t numBytes, const std::nothrow_t &) noexcept
+{
+  return countedAlloc(numBytes != 0 ? numBytes : 1);
+}
+
+void *operator new[](size_t numBytes, const std::nothrow_t &) noexcept
+{
+  return countedAlloc(numBytes != 0 ? numBytes : 1);
+}
+
+void operator delete(void *p) noexcept { countedFree(p); }
+void operator delete[](void *p) noexcept { countedFree(p); }
+void operator delete(void *p, const std::nothrow_t &) noexcept { countedFree(p); }
+void operator delete[](void *p, const std::nothrow_t &) noexcept { countedFree(p); }
+void operator delete(void *p, size_t) noexcept { countedFree(p); }
+void operator delete[](void *p, size_t) noexcept { countedFree(p); }
+
+#endif // _MEMORY_STATS
+
+namespace {
+
+  struct StatsKey {
+    int subsystem;
+    int classTag;
+    std::string classType;
+    bool operator<(const StatsKey &other) const {
+      if (subsystem != other.subsystem) return subsystem < other.subsystem;
+      if (classTag != other.classTag) return classTag < other.classTag;
+      return classType < other.classType;
+    }
+  };
+
+  struct StatsEntry {
+    long long numObjects;
+    long long bytes;
+  };
+
+  std::map<StatsKey, StatsEntry> &
+  theStats(void)
+  {
+    static std::map<StatsKey, StatsEntry> stats;
+    return stats;
+  }
+
+#ifdef _MEMORY_STATS
+  std::atomic<bool> statsEnabled(true);
+#else
+  std::atomic<bool> statsEnabled(false);
+#endif
+
+  // objects may be added from more than one thread
+  std::mutex statsMutex;
+  std::atomic<long long> markBytes(0);
+  long long subsystemBytes[MemoryStats::NumSubsystems] = {0, 0, 0, 0};
+
+  StatsKey
+  makeKey(int subsystem, int classTag, const char *classType)
+  {
+    StatsKey key;
+    key.subsystem = subsystem;
+    key.classTag = classTag;
+    key.classType = (classType != 0) ? classType : "UnknownType";
+    return key;
+  }
+
+  const char *subsystemNames[MemoryStats::NumSubsystems] = {
+    "domain", "analysis model", "SOE", "recorders"
+  };
+}
+
+bool
+MemoryStats::isInstrumented(void)
+{
+#ifdef _MEMORY_STATS
+  return true;
+#else
+  return false;
+#endif
+}
+
+void
+MemoryStats::setEnabled(bool enabled)
+{
+  statsEnabled.store(enabled, std::memory_order_relaxed);
+  if (enabled == true)
+    markBytes.store(getLiveBytes(), std::memory_order_relaxed);
+}
+
+bool
+MemoryStats::isEnabled(void)
+{
+  return statsEnabled.load(std::memory_order_relaxed);
+}
+
+long long
+MemoryStats::getLiveBytes(void)
+{
+  return liveBytes.load(std::memory_order_relaxed);
+}
+
+long long
+MemoryStats::getPeakBytes(void)
+{
+  return peakBytes.load(std::memory_order_relaxed);
+}
+
+long long
+MemoryStats::getBytes(int subsystem)
+{
+  if (subsystem < 0 || subsystem >= NumSubsystems)
+    return 0;
+  std::lock_guard<std::mutex> lock(statsMutex);
+  return subsystemBytes[subsystem];
+}
+
+void
+MemoryStats::mark(void)
+{
+  if (statsEnabled.load(std::memory_order_relaxed) == false)
+    return;
+  markBytes.store(getLiveBytes(), std::memory_order_relaxed);
+}
+
+void
+MemoryStats::charge(int subsystem, int classTag, const char *classType,
+		    int numObjects)
+{
+  if (statsEnabled.load(std::memory_order_relaxed) == false)
+    return;
+  if (subsystem < 0 || subsystem >= NumSubsystems)
+    return;
+
+  long long bytes = getLiveBytes() - markBytes.load(std::memory_order_relaxed);
+  StatsKey key = makeKey(subsystem, classTag, classType);
+
+  std::lock_guard<std::mutex> lock(statsMutex);
+  StatsEntry &entry = theStats()[key];
+  entry.numObjects += numObjects;
+  entry.bytes += bytes;
+  subsystemBytes[subsystem] += bytes;
+
+  // the bookkeeping itself is not charged to anyone
+  markBytes.store(getLiveBytes(), std::memory_order_relaxed);
+}
+
+void
+MemoryStats::resize(int subsystem, int classTag, const char *classType)
+{
+  if (statsEnabled.load(std::memory_order_relaxed) == false)
+    return;
+
+  bool charged = false;
+  {
+    std::lock_guard<std::mutex> lock(statsMutex);
+    std::map<StatsKey, StatsEntry>::iterator p = theStats().find(makeKey(subsystem, classTag, classType));
+    charged = p != theStats().end() && p->second.numObjects != 0;
+  }
+
+  charge(subsystem, classTag, classType, charged ? 0 : 1);
+}
+
+void
+MemoryStats::uncharge(int subsystem, int classTag, const char *classType,
+		      int numObjects)
+{
+  if (statsEnabled.load(std::memory_order_relaxed) == false)
+    return;
+  if (subsystem < 0 || subsystem >= NumSubsystems)
+    return;
+
+  std::lock_guard<std::mutex> lock(statsMutex);
+  std::map<StatsKey, StatsEntry>::iterator p = theStats().find(makeKey(subsystem, classTag, classType));
+  if (p == theStats().end() || p->second.numObjects <= 0)
+    return;
+
+  // the bytes of one object are not known any more, take the average
+  StatsEntry &entry = p->second;
+  if (numObjects > entry.numObjects)
+    numObjects = (int)entry.numObjects;
+  long long bytes = entry.bytes / entry.numObjects * numObjects;
+  entry.numObjects -= numObjects;
+  entry.bytes -= bytes;
+  subsystemBytes[subsystem] -= bytes;
+  if (entry.numObjects == 0)
+    theStats().erase(p);
+}
+
+void
+MemoryStats::clear(int subsystem)
+{
+  if (subsystem < 0 || subsystem >= NumSubsystems)
+    return;
+
+  std::lock_guard<std::mutex> lock(statsMutex);
+  std::map<StatsKey, StatsEntry> &stats = theStats();
+  std::map<StatsKey, StatsEntry>::iterator p = stats.begin();
+  while (p != stats.end()) {
+    if (p->first.subsystem == subsystem)
+      p = stats.erase(p);
+    else
+      p++;
+  }
+  subsystemBytes[subsystem] = 0;
+  markBytes.store(getLiveBytes(), std::memory_order_relaxed);
+}
+
+void
+MemoryStats::clearAll(void)
+{
+  for (int i = 0; i < NumSubsystems; i++)
+    clear(i);
+}
+
+void
+MemoryStats::Print(OPS_Stream &s)
+{
+  char buffer[256];
+  bool instrumented = isInstrumented();
+
+  s << "Memory use by subsystem and class\n";
+  if (isEnabled() == false)
+    s << "(not counted, enable with memoryStats -on)\n";
+  if (instrumented == false)
+    s << "(bytes are counted only in a build with -D_MEMORY_STATS)\n";
+
+  sprintf(buffer, "%-16s %-32s %8s %12s %16s %12s\n",
+	  "subsystem", "class", "classTag", "number", "bytes", "bytes/object");
+  s << buffer;
+
+  std::lock_guard<std::mutex> lock(statsMutex);
+  std::map<StatsKey, StatsEntry> &stats = theStats();
+  long long attributed = 0;
+  for (int i = 0; i < NumSubsystems; i++) {
+    long long numObjects = 0;
+    std::map<StatsKey, StatsEntry>::iterator p;
+    for (p = stats.begin(); p != stats.end(); p++) {
+      if (p->first.subsystem != i)
+	continue;
+      const StatsEntry &entry = p->second;
+      long long perObject = (entry.numObjects > 0) ? entry.bytes/entry.numObjects : 0;
+      sprintf(buffer, "%-16s %-32.32s %8d %12lld %16lld %12lld\n",
+	      subsystemNames[i], p->first.classType.c_str(), p->first.classTag,
+	      entry.numObjects, entry.bytes, perObject);
+      s << buffer;
+      numObjects += entry.numObjects;
+    }
+    sprintf(buffer, "%-16s %-32s %8s %12lld %16lld\n",
+	    subsystemNames[i], "total", "", numObjects, subsystemBytes[i]);
+    s << buffer;
+    attributed += subsystemBytes[i];
+  }
+
+  if (instrumented == true) {
+    long long live = getLiveBytes();
+    sprintf(buffer, "%-16s %-32s %8s %12s %16lld\n", "other", "", "", "", live - attributed);
+    s << buffer;
+    sprintf(buffer, "heap in use: %lld bytes, peak: %lld bytes\n", live, getPeakBytes());
+    s << buffer;
+  }
+
+#ifndef _WIN32
+  struct rusage usage;
+  if (getrusage(RUSAGE_SELF, &usage) == 0) {
+#if defined(_MAC) || defined(__APPLE__)
+    long long maxRSS = (long long)usage.ru_maxrss;
+#else
+    long long maxRSS = (long long)usage.ru_maxrss * 1024;
+#endif
+    sprintf(buffer, "peak resident set size: %lld bytes\n", maxRSS);
+    s << buffer;
+  }
+#endif
+}
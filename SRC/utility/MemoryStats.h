@@ -0,0 +1,93 @@
+/* ****************************************************************** **
+**    OpenSees - Open System for Earthquake Engineering Simulation    **
+**          Pacific Earthquake Engineering Research Center            **
+**                                                                    **
+**                                                                    **
+** (C) Copyright 1999, The Regents of the University of California    **
+** All Rights Reserved.                                               **
+**                                                                    **
+** Commercial use of this program without express permission of the   **
+** University of California, Berkeley, is strictly prohibited.  See   **
+** file 'COPYRIGHT'  in main directory for information on usage and   **
+** redistribution,  and for a DISCLAIMER OF ALL WARRANTIES.           **
+**                                                                    **
+** Developed by:                                                      **
+**   Frank McKenna (fmckenna@ce.berkeley.edu)                         **
+**   Gregory L. Fenves (fenves@ce.berkeley.edu)                       **
+**   Filip C. Filippou (filippou@ce.berkeley.edu)                     **
+**                                                                    **
+** ****************************************************************** */
+
+// File: ~/utility/MemoryStats.h
+//
+// Description: This file contains the class definition for MemoryStats.
+// MemoryStats keeps track of where the heap of a run goes. The objects
+// are charged to a subsystem (domain, analysis model, SOE, recorders)
+// and to their class tag by the container they are added to: the bytes
+// the heap grew by since the last mark() are charged to the object
+// passed to charge(), which includes the copies of materials, sections
+// and transformations an element makes of its prototypes.
+//
+// Nothing is counted until the stats are enabled (memoryStats -on), except
+// in an instrumented build (compiled with -D_MEMORY_STATS), where they are
+// enabled from the start. The number of objects of each class is then
+// counted, and an instrumented build also counts the bytes: it replaces
+// the global operator new and delete with versions that keep a running
+// total of the live heap. Objects removed from their container are
+// uncharged with the average bytes of their class.
+
+#ifndef MemoryStats_h
+#define MemoryStats_h
+
+class OPS_Stream;
+
+class MemoryStats
+{
+  public:
+    enum Subsystem {
+      Domain = 0,
+      AnalysisModel,
+      SOE,
+      Recorders,
+      NumSubsystems
+    };
+
+    // true if the bytes are counted
+    static bool isInstrumented(void);
+
+    // charge() and friends do nothing while the stats are disabled
+    static void setEnabled(bool enabled);
+    static bool isEnabled(void);
+
+    // bytes currently allocated with new and the most there have been
+    static long long getLiveBytes(void);
+    static long long getPeakBytes(void);
+
+    // the bytes charged to a subsystem
+    static long long getBytes(int subsystem);
+
+    // start a new object, the heap growth since the last charge is
+    // left unattributed
+    static void mark(void);
+
+    // charge the heap growth since the last mark to an object
+    static void charge(int subsystem, int classTag, const char *classType,
+		       int numObjects = 1);
+
+    // charge the heap growth since the last mark to an object charged
+    // before, e.g. a system of equations that has been resized
+    static void resize(int subsystem, int classTag, const char *classType);
+
+    // an object charged before has been removed from its container
+    static void uncharge(int subsystem, int classTag, const char *classType,
+			 int numObjects = 1);
+
+    // forget what was charged to a subsystem, e.g. once its objects
+    // have been deleted
+    static void clear(int subsystem);
+    static void clearAll(void);
+
+    static void Print(OPS_Stream &s);
+};
+
+#endif